@@ -4,12 +4,20 @@
 #include "basic.h"
 
 #include "allocator.h"
+#include "bit.h"
 #include "functional.h"
 #include "iterator.h"
+#include "nontemporal.h"
+#include "simd.h"
+#include "thread_pool.h"
 #include "type_traits.h"
 #include "utility.h"
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <cstring>
+#include <functional>
+#include <type_traits>
 #include <utility>
 
 #include <algorithm>
@@ -21,7 +29,384 @@ template <class T, class Allocator = mSTL::allocator<T>>
 class uninitialized_mem_func;
 
 //<- Non-modifying sequence operations
-// ....
+// all_of() / any_of() / none_of(): 是否全部 / 存在 / 没有元素满足 pred  O(N)
+// find() / find_if() / find_if_not(): 首个等于 value / 满足 / 不满足 pred 的元素  O(N)
+// count() / count_if(): 等于 value / 满足 pred 的元素个数  O(N)
+// mismatch(): 两区间首个不相等 (不满足 pred) 的位置  O(N)
+// adjacent_find(): 首对相等 (满足 pred) 的相邻元素中的前一个  O(N)
+// search_n(): 首个由 count 个连续等于 value (满足 pred) 的元素组成的子区间  O(N)
+// 区间为连续的算术类型 (bool 除外) 指针时逐向量比较，内核由 simd 按处理器选择
+//   find / count / search_n 要求 value 与元素同类型
+//   谓词须为 compare_with(std::less<T>() 等, value)，比较器须为 std::equal_to<T> 等六种标准比较
+
+// value_predicate
+// 与定值比较的一元谓词 comp(x, value)，由 compare_with() 构造
+// Compare 为标准比较且类型与元素一致时，find_if / count_if 等可向量化
+template <class Compare, class T>
+struct value_predicate {
+	Compare comp;
+	T       value;
+
+	template <class U>
+	bool operator()(const U& x) const {
+		return comp(x, value);
+	}
+};
+
+template <class Compare, class T>
+inline value_predicate<Compare, T> compare_with(Compare comp, const T& value) {
+	value_predicate<Compare, T> pred = {comp, value};
+	return pred;
+}
+
+// 默认的相等比较 a == b，两侧类型可以不同
+struct _equal_to {
+	template <class T1, class T2>
+	bool operator()(const T1& a, const T2& b) const {
+		return a == b;
+	}
+};
+
+// 比较器对应的 simd::compare_op，不可向量化时为 -1
+template <class Compare, class T>
+struct _scan_op : std::integral_constant<int, -1> {};
+template <class T>
+struct _scan_op<_equal_to, T> : std::integral_constant<int, simd::op_eq> {};
+template <class T>
+struct _scan_op<std::equal_to<T>, T>
+    : std::integral_constant<int, simd::op_eq> {};
+template <class T>
+struct _scan_op<std::not_equal_to<T>, T>
+    : std::integral_constant<int, simd::op_ne> {};
+template <class T>
+struct _scan_op<std::less<T>, T> : std::integral_constant<int, simd::op_lt> {};
+template <class T>
+struct _scan_op<std::less_equal<T>, T>
+    : std::integral_constant<int, simd::op_le> {};
+template <class T>
+struct _scan_op<std::greater<T>, T>
+    : std::integral_constant<int, simd::op_gt> {};
+template <class T>
+struct _scan_op<std::greater_equal<T>, T>
+    : std::integral_constant<int, simd::op_ge> {};
+
+// 迭代器为指向可扫描类型的指针且比较器可向量化
+template <class Iterator, class Compare>
+struct _is_scannable {
+	typedef _false_type type;
+};
+
+template <class T, class Compare>
+struct _is_scannable<T*, Compare> {
+	typedef typename std::remove_const<T>::type U;
+	typedef typename IfThenElse<simd::is_scan_type<U>::value &&
+	                                (_scan_op<Compare, U>::value >= 0),
+	                            _true_type, _false_type>::result type;
+};
+
+template <class Iterator, class Predicate>
+struct _is_scannable_predicate {
+	typedef _false_type type;
+};
+
+template <class Iterator, class Compare, class T>
+struct _is_scannable_predicate<Iterator, value_predicate<Compare, T>>
+    : _is_scannable<Iterator, Compare> {};
+
+// 两个指针指向同一可扫描类型
+template <class Iterator1, class Iterator2, class Compare>
+struct _is_pair_scannable {
+	typedef _false_type type;
+};
+
+template <class T1, class T2, class Compare>
+struct _is_pair_scannable<T1*, T2*, Compare> {
+	typedef typename IfThenElse<
+	    std::is_same<typename std::remove_const<T1>::type,
+	                 typename std::remove_const<T2>::type>::value,
+	    typename _is_scannable<T1*, Compare>::type, _false_type>::result type;
+};
+
+//----------------- find_if / find_if_not -------------------
+// 首个 pred(*first) != negate 的位置
+template <class InputIterator, class UnaryPredicate>
+InputIterator _find_if_aux(InputIterator first, InputIterator last,
+                           UnaryPredicate pred, bool negate, _false_type) {
+	while (first != last && static_cast<bool>(pred(*first)) == negate)
+		++first;
+	return first;
+}
+
+template <class T, class Compare, class V>
+inline T* _find_if_aux(T* first, T* last,
+                       const value_predicate<Compare, V>& pred, bool negate,
+                       _true_type) {
+	typedef typename std::remove_const<T>::type U;
+	return first + simd::find_value<_scan_op<Compare, U>::value>(
+	                   first, static_cast<size_t>(last - first),
+	                   static_cast<U>(pred.value), negate);
+}
+
+template <class InputIterator, class UnaryPredicate>
+inline InputIterator find_if(InputIterator first, InputIterator last,
+                             UnaryPredicate pred) {
+	typedef typename _is_scannable_predicate<InputIterator,
+	                                         UnaryPredicate>::type isScannable;
+	return _find_if_aux(first, last, pred, false, isScannable());
+}
+
+template <class InputIterator, class UnaryPredicate>
+inline InputIterator find_if_not(InputIterator first, InputIterator last,
+                                 UnaryPredicate pred) {
+	typedef typename _is_scannable_predicate<InputIterator,
+	                                         UnaryPredicate>::type isScannable;
+	return _find_if_aux(first, last, pred, true, isScannable());
+}
+
+//----------------- all_of / any_of / none_of -------------------
+template <class InputIterator, class UnaryPredicate>
+inline bool all_of(InputIterator first, InputIterator last,
+                   UnaryPredicate pred) {
+	return mSTL::find_if_not(first, last, pred) == last;
+}
+
+template <class InputIterator, class UnaryPredicate>
+inline bool any_of(InputIterator first, InputIterator last,
+                   UnaryPredicate pred) {
+	return mSTL::find_if(first, last, pred) != last;
+}
+
+template <class InputIterator, class UnaryPredicate>
+inline bool none_of(InputIterator first, InputIterator last,
+                    UnaryPredicate pred) {
+	return mSTL::find_if(first, last, pred) == last;
+}
+
+//----------------- find -------------------
+template <class InputIterator, class T>
+InputIterator _find_aux(InputIterator first, InputIterator last,
+                        const T& value, _false_type) {
+	while (first != last && !(*first == value))
+		++first;
+	return first;
+}
+
+template <class T, class V>
+inline T* _find_aux(T* first, T* last, const V& value, _true_type) {
+	return first + simd::find_value<simd::op_eq>(
+	                   first, static_cast<size_t>(last - first), value);
+}
+
+template <class InputIterator, class T>
+inline InputIterator find(InputIterator first, InputIterator last,
+                          const T& value) {
+	typedef typename _is_scannable<InputIterator, std::equal_to<T>>::type
+	    isScannable;
+	return _find_aux(first, last, value, isScannable());
+}
+
+//----------------- count / count_if -------------------
+template <class InputIterator, class T>
+typename iterator_traits<InputIterator>::difference_type
+_count_aux(InputIterator first, InputIterator last, const T& value,
+           _false_type) {
+	typename iterator_traits<InputIterator>::difference_type n = 0;
+	for (; first != last; ++first)
+		if (*first == value)
+			++n;
+	return n;
+}
+
+template <class T, class V>
+inline ptrdiff_t _count_aux(T* first, T* last, const V& value, _true_type) {
+	return static_cast<ptrdiff_t>(simd::count_value<simd::op_eq>(
+	    first, static_cast<size_t>(last - first), value));
+}
+
+template <class InputIterator, class T>
+inline typename iterator_traits<InputIterator>::difference_type
+count(InputIterator first, InputIterator last, const T& value) {
+	typedef typename _is_scannable<InputIterator, std::equal_to<T>>::type
+	    isScannable;
+	return _count_aux(first, last, value, isScannable());
+}
+
+template <class InputIterator, class UnaryPredicate>
+typename iterator_traits<InputIterator>::difference_type
+_count_if_aux(InputIterator first, InputIterator last, UnaryPredicate pred,
+              _false_type) {
+	typename iterator_traits<InputIterator>::difference_type n = 0;
+	for (; first != last; ++first)
+		if (pred(*first))
+			++n;
+	return n;
+}
+
+template <class T, class Compare, class V>
+inline ptrdiff_t _count_if_aux(T* first, T* last,
+                               const value_predicate<Compare, V>& pred,
+                               _true_type) {
+	typedef typename std::remove_const<T>::type U;
+	return static_cast<ptrdiff_t>(
+	    simd::count_value<_scan_op<Compare, U>::value>(
+	        first, static_cast<size_t>(last - first),
+	        static_cast<U>(pred.value)));
+}
+
+template <class InputIterator, class UnaryPredicate>
+inline typename iterator_traits<InputIterator>::difference_type
+count_if(InputIterator first, InputIterator last, UnaryPredicate pred) {
+	typedef typename _is_scannable_predicate<InputIterator,
+	                                         UnaryPredicate>::type isScannable;
+	return _count_if_aux(first, last, pred, isScannable());
+}
+
+//----------------- mismatch -------------------
+template <class InputIterator1, class InputIterator2, class BinaryPredicate>
+std::pair<InputIterator1, InputIterator2>
+_mismatch_aux(InputIterator1 first1, InputIterator1 last1,
+              InputIterator2 first2, BinaryPredicate pred, _false_type) {
+	while (first1 != last1 && pred(*first1, *first2)) {
+		++first1;
+		++first2;
+	}
+	return std::pair<InputIterator1, InputIterator2>(first1, first2);
+}
+
+template <class T1, class T2, class BinaryPredicate>
+inline std::pair<T1*, T2*> _mismatch_aux(T1* first1, T1* last1, T2* first2,
+                                         BinaryPredicate, _true_type) {
+	typedef typename std::remove_const<T1>::type U;
+	const size_t i = simd::find_pair<_scan_op<BinaryPredicate, U>::value>(
+	    first1, first2, static_cast<size_t>(last1 - first1), true);
+	return std::pair<T1*, T2*>(first1 + i, first2 + i);
+}
+
+template <class InputIterator1, class InputIterator2, class BinaryPredicate>
+inline std::pair<InputIterator1, InputIterator2>
+mismatch(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2,
+         BinaryPredicate pred) {
+	typedef typename _is_pair_scannable<InputIterator1, InputIterator2,
+	                                    BinaryPredicate>::type isScannable;
+	return _mismatch_aux(first1, last1, first2, pred, isScannable());
+}
+
+template <class InputIterator1, class InputIterator2>
+inline std::pair<InputIterator1, InputIterator2>
+mismatch(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2) {
+	return mSTL::mismatch(first1, last1, first2, _equal_to());
+}
+
+//----------------- adjacent_find -------------------
+template <class ForwardIterator, class BinaryPredicate>
+ForwardIterator _adjacent_find_aux(ForwardIterator first, ForwardIterator last,
+                                   BinaryPredicate pred, _false_type) {
+	if (first == last)
+		return last;
+	ForwardIterator next = first;
+	while (++next != last) {
+		if (pred(*first, *next))
+			return first;
+		first = next;
+	}
+	return last;
+}
+
+// 以错开一个元素的两个指针逐对比较
+template <class T, class BinaryPredicate>
+inline T* _adjacent_find_aux(T* first, T* last, BinaryPredicate, _true_type) {
+	typedef typename std::remove_const<T>::type U;
+	if (last - first < 2)
+		return last;
+	const size_t n = static_cast<size_t>(last - first) - 1;
+	const size_t i =
+	    simd::find_pair<_scan_op<BinaryPredicate, U>::value>(first, first + 1, n);
+	return i == n ? last : first + i;
+}
+
+template <class ForwardIterator, class BinaryPredicate>
+inline ForwardIterator adjacent_find(ForwardIterator first,
+                                     ForwardIterator last,
+                                     BinaryPredicate pred) {
+	typedef typename _is_scannable<ForwardIterator, BinaryPredicate>::type
+	    isScannable;
+	return _adjacent_find_aux(first, last, pred, isScannable());
+}
+
+template <class ForwardIterator>
+inline ForwardIterator adjacent_find(ForwardIterator first,
+                                     ForwardIterator last) {
+	return mSTL::adjacent_find(first, last, _equal_to());
+}
+
+//----------------- search_n -------------------
+template <class ForwardIterator, class Size, class T, class BinaryPredicate>
+ForwardIterator _search_n_aux(ForwardIterator first, ForwardIterator last,
+                              Size count, const T& value, BinaryPredicate pred,
+                              _false_type) {
+	if (count <= 0)
+		return first;
+	for (;;) {
+		while (first != last && !pred(*first, value))
+			++first;
+		if (first == last)
+			return last;
+		ForwardIterator start = first;
+		Size            matched = 1;
+		for (;;) {
+			if (matched == count)
+				return start;
+			if (++first == last)
+				return last;
+			if (!pred(*first, value))
+				break;
+			++matched;
+		}
+		++first;
+	}
+}
+
+// 向量查找候选起点，再检查其后 count 个元素，失败时从不匹配元素之后继续
+template <class T, class Size, class V, class BinaryPredicate>
+T* _search_n_aux(T* first, T* last, Size count, const V& value,
+                 BinaryPredicate, _true_type) {
+	typedef typename std::remove_const<T>::type U;
+	const int Op = _scan_op<BinaryPredicate, U>::value;
+	if (count <= 0)
+		return first;
+	const U      key = static_cast<U>(value);
+	const size_t n = static_cast<size_t>(last - first);
+	const size_t need = static_cast<size_t>(count);
+	size_t       i = 0;
+	while (n - i >= need) {
+		i += simd::find_value<Op>(first + i, n - i, key);
+		if (n - i < need)
+			break;
+		const size_t run = simd::find_value<Op>(first + i, need, key, true);
+		if (run == need)
+			return first + i;
+		i += run + 1;
+	}
+	return last;
+}
+
+template <class ForwardIterator, class Size, class T, class BinaryPredicate>
+inline ForwardIterator search_n(ForwardIterator first, ForwardIterator last,
+                                Size count, const T& value,
+                                BinaryPredicate pred) {
+	typedef typename _is_scannable<ForwardIterator, BinaryPredicate>::type
+	    isScannable;
+	return _search_n_aux(first, last, count, value, pred, isScannable());
+}
+
+template <class ForwardIterator, class Size, class T>
+inline ForwardIterator search_n(ForwardIterator first, ForwardIterator last,
+                                Size count, const T& value) {
+	typedef typename _is_scannable<ForwardIterator, std::equal_to<T>>::type
+	    isScannable;
+	return _search_n_aux(first, last, count, value, _equal_to(),
+	                     isScannable());
+}
 
 //<- Modifying sequence operations
 
@@ -52,255 +437,3840 @@ OutputIterator copy_n(InputIterator first, Size n, OutputIterator result) {
 		++first;
 		--n;
 	}
-	return result;
+	return result;
+}
+
+//----------------- copy_if -------------------
+template <class InputIterator, class OutputIterator, class UnaryPredicate>
+OutputIterator copy_if(InputIterator first, InputIterator last,
+                       OutputIterator result, UnaryPredicate pred) {
+	while (first != last) {
+		if (pred(*first)) {
+			*result = *first;
+			++result;
+		}
+		++first;
+	}
+	return result;
+}
+
+//--------------- copy_backward ---------------
+template <class BidirectionalIterator1, class BidirectionalIterator2>
+BidirectionalIterator2 copy_backward(BidirectionalIterator1 first,
+                                     BidirectionalIterator1 last,
+                                     BidirectionalIterator2 result) {
+	while (last != first)
+		*(--result) = *(--last);
+	return result;
+}
+
+///<- move series
+// copy(): [first, last) -> [result, result + (last - first))  O(N)
+// copy_backward(): [first, last) -> [result - (last - first), result)  O(N)
+//-------------------- move ----------------------
+template <class InputIterator, class OutputIterator>
+OutputIterator move(InputIterator first, InputIterator last,
+                    OutputIterator result) {
+	while (first != last) {
+		*result = std::move(*first);
+		++result;
+		++first;
+	}
+	return result;
+}
+
+//-------------- move_backward -------------------
+template <class BidirIterator1, class BidirIterator2>
+BidirIterator2 move_backward(BidirIterator1 first, BidirIterator1 last,
+                             BidirIterator2 result) {
+	while (first != last)
+		*(--result) = std::move(*(--last));
+	return result;
+}
+
+///<- fill series
+// fill(): value -> [first, end)  O(N)
+// fill_n(): value -> [first, first + n)  O(N)
+//-------------------- fill ----------------------
+template <class ForwardIterator, class T>
+void fill(ForwardIterator first, ForwardIterator last, const T& value) {
+	while (first != last) {
+		*first = value;
+		++first;
+	}
+}
+
+inline void fill(char* first, char* last, const char& value) {
+	memset(first, static_cast<unsigned char>(value), last - first);
+}
+inline void fill(wchar_t* first, wchar_t* last, const wchar_t& value) {
+	memset(first, static_cast<unsigned char>(value),
+	       (last - first) * sizeof(wchar_t));
+}
+
+//------------------- fill_n ---------------------
+template <class OutputIterator, class Size, class T>
+OutputIterator fill_n(OutputIterator first, Size n, const T& value) {
+	while (n > 0) {
+		*first = value;
+		--n;
+		++first;
+	}
+	return first;
+}
+
+template <class Size>
+char* fill_n(char* first, Size n, const char& value) {
+	memset(first, static_cast<unsigned char>(value), n);
+	return first + n;
+}
+template <class Size>
+wchar_t* fill_n(wchar_t* first, Size n, const wchar_t& value) {
+	memset(first, static_cast<unsigned char>(value), n * sizeof(wchar_t));
+	return first + n;
+}
+
+///<- transform series
+///<- generate series
+///<- remove series
+// remove(): 移除 [first, last) 中等于 value 的元素，返回新的尾后迭代器  O(N)
+// remove_if(): 移除 [first, last) 中满足 pred 的元素，返回新的尾后迭代器  O(N)
+// remove_indices(): 移除 [first, last) 中位于下标序列 [index_first, index_last) 的元素  O(N + K)
+// 均为稳定的单趟压缩，保留元素相对顺序，[新尾后, last) 中的元素处于有效但未指定的状态
+
+//----------------- remove_if --------------------
+// 通用版本: 跳过前缀中的保留元素，此后仅对保留元素执行 move 赋值
+template <class ForwardIterator, class UnaryPredicate, class PODType,
+          class Category>
+ForwardIterator _remove_if_aux(ForwardIterator first, ForwardIterator last,
+                               UnaryPredicate pred, PODType, Category) {
+	while (first != last && !pred(*first))
+		++first;
+	if (first == last)
+		return first;
+
+	ForwardIterator result = first;
+	for (++first; first != last; ++first) {
+		if (!pred(*first)) {
+			*result = std::move(*first);
+			++result;
+		}
+	}
+	return result;
+}
+
+// POD 类型且可随机访问: 无分支压缩
+// 每个元素均写入 result 处，仅在保留时推进 result，谓词结果随机时避免分支预测失败
+// result 始终不超过读取位置，先读后写，覆盖安全
+template <class RandomAccessIterator, class UnaryPredicate>
+RandomAccessIterator _remove_if_aux(RandomAccessIterator first,
+                                    RandomAccessIterator last,
+                                    UnaryPredicate pred, _true_type,
+                                    random_access_iterator_tag) {
+	using value_type = typename iterator_traits<RandomAccessIterator>::value_type;
+
+	while (first != last && !pred(*first))
+		++first;
+	if (first == last)
+		return first;
+
+	RandomAccessIterator result = first;
+	for (++first; first != last; ++first) {
+		value_type value = *first;
+		*result = value;
+		result += !pred(value);
+	}
+	return result;
+}
+
+template <class ForwardIterator, class UnaryPredicate>
+ForwardIterator remove_if(ForwardIterator first, ForwardIterator last,
+                          UnaryPredicate pred) {
+	typedef typename _type_traits<
+	    typename iterator_traits<ForwardIterator>::value_type>::is_POD_type
+	    isPODType;
+	return _remove_if_aux(first, last, pred, isPODType(),
+	                      iterator_category(first));
+}
+
+//------------------- remove ---------------------
+template <class ForwardIterator, class T>
+ForwardIterator remove(ForwardIterator first, ForwardIterator last,
+                       const T& value) {
+	using value_type = typename iterator_traits<ForwardIterator>::value_type;
+	return mSTL::remove_if(first, last,
+	                       [&value](const value_type& x) { return x == value; });
+}
+
+//--------------- remove_indices -----------------
+// 下标相对 first，须升序排列，允许重复；超出 [0, last - first) 的下标被忽略
+// 相邻待移除下标之间的保留元素整段前移
+template <class ForwardIterator, class InputIterator>
+ForwardIterator remove_indices(ForwardIterator first, ForwardIterator last,
+                               InputIterator index_first,
+                               InputIterator index_last) {
+	ForwardIterator result = first;
+	size_t          position = 0; // first 对应的下标
+	bool            removed = false;
+
+	for (; index_first != index_last && first != last; ++index_first) {
+		size_t index = static_cast<size_t>(*index_first);
+		if (index < position)
+			continue;
+
+		// 首个移除点之前 result 与 first 重合，无需移动
+		for (; position < index && first != last; ++position, ++first) {
+			if (removed)
+				*result = std::move(*first);
+			++result;
+		}
+		if (first == last)
+			break;
+
+		++first;
+		++position;
+		removed = true;
+	}
+
+	if (!removed)
+		return last;
+	for (; first != last; ++first, ++result)
+		*result = std::move(*first);
+	return result;
+}
+
+///<- replace series
+
+///<- swap series
+/// swap()  &a <-> &b  O(1)
+/// iter_swap() *a <-> *b  O(1)
+/// swap_ranges() [first1, last1) <-> [first2, first2 + (last1 - first1))  O(N)
+/// swap()(a[], b[])  a[] <-> b[]  O(N)
+//------------------ swap() ---------------------
+template <class T>
+void swap(T& a, T& b) {
+	T temp = std::move(a);
+	a = std::move(b);
+	b = std::move(temp);
+}
+
+//--------------- iter_swap() -----------------
+template <class ForwardIt1, class ForwardIt2>
+void iter_swap(ForwardIt1 a, ForwardIt2 b) {
+	swap(*a, *b);
+}
+
+//--------------- swap_ranges() -----------------
+template <class ForwardIt1, class ForwardIt2>
+ForwardIt2 swap_ranges(ForwardIt1 first1, ForwardIt1 last1, ForwardIt2 first2) {
+	for (; first1 != last1; ++first1, (void)++first2)
+		std::iter_swap(first1, first2);
+	return first2;
+}
+
+//------------- swap()(a[], b[])  -----------------
+template <class T, size_t N>
+void swap(T (&a)[N], T (&b)[N]) {
+	swap_ranges(a, (a + N), b);
+}
+
+///<- reverse series
+///<- rotate series
+///<- unique series
+
+//<- Partitioning operations
+//<- Sorting operations
+// is_sorted() / is_sorted_until(): 是否有序 / 最长有序前缀的末尾  O(N)
+//   连续算术类型且比较器为标准比较时，以错开一个元素的向量比较查找首个逆序对
+// sort(): [first, last) 不稳定排序，pdqsort  平均 O(NlogN)，最坏 O(NlogN)
+//
+// pdqsort (pattern-defeating quicksort, Orson Peters)
+// 小区间插入排序；枢轴取三数中值，区间较大时取九数中值 (ninther)
+// 划分结果严重失衡时打乱部分元素破坏对抗性模式，失衡次数超过 log2(N) 后退化为堆排序
+// 划分前区间已有序时尝试有限步数的插入排序，使有序 / 逆序输入达到 O(N)
+// 与前一枢轴相等的元素集中划分至左侧，大量重复元素时同样为 O(N)
+// 算术类型且比较器为 std::less / std::greater 时使用无分支块划分 (BlockQuicksort)
+
+//----------------- is_sorted / is_sorted_until -------------------
+template <class ForwardIterator, class Compare>
+ForwardIterator _is_sorted_until_aux(ForwardIterator first,
+                                     ForwardIterator last, Compare comp,
+                                     _false_type) {
+	if (first == last)
+		return last;
+	ForwardIterator next = first;
+	while (++next != last) {
+		if (comp(*next, *first))
+			return next;
+		first = next;
+	}
+	return last;
+}
+
+template <class T, class Compare>
+inline T* _is_sorted_until_aux(T* first, T* last, Compare, _true_type) {
+	typedef typename std::remove_const<T>::type U;
+	if (last - first < 2)
+		return last;
+	return first + 1 +
+	       simd::find_pair<_scan_op<Compare, U>::value>(
+	           first + 1, first, static_cast<size_t>(last - first) - 1);
+}
+
+template <class ForwardIterator, class Compare>
+inline ForwardIterator is_sorted_until(ForwardIterator first,
+                                       ForwardIterator last, Compare comp) {
+	typedef typename _is_scannable<ForwardIterator, Compare>::type isScannable;
+	return _is_sorted_until_aux(first, last, comp, isScannable());
+}
+
+template <class ForwardIterator>
+inline ForwardIterator is_sorted_until(ForwardIterator first,
+                                       ForwardIterator last) {
+	typedef typename iterator_traits<ForwardIterator>::value_type T;
+	return mSTL::is_sorted_until(first, last, std::less<T>());
+}
+
+template <class ForwardIterator, class Compare>
+inline bool is_sorted(ForwardIterator first, ForwardIterator last,
+                      Compare comp) {
+	return mSTL::is_sorted_until(first, last, comp) == last;
+}
+
+template <class ForwardIterator>
+inline bool is_sorted(ForwardIterator first, ForwardIterator last) {
+	return mSTL::is_sorted_until(first, last) == last;
+}
+
+enum {
+	_SORT_INSERTION_THRESHOLD = 24,
+	_SORT_NINTHER_THRESHOLD = 128,
+	_SORT_PARTIAL_INSERTION_LIMIT = 8,
+	_SORT_BLOCK_SIZE = 64,
+	_SORT_CACHELINE_SIZE = 64
+};
+
+///<- heap helpers
+// _adjust_heap(): 自 hole 处下沉至叶节点后再上浮放置 value，维护 [first, first + len) 大顶堆
+// _make_heap(): 自最后一个内部节点起逐个下沉 (Floyd)  O(N)
+// _sort_heap(): 依次弹出堆顶，结果按 comp 升序  O(NlogN)
+// _heap_sort(): 建堆后排序，作为 pdqsort 的最坏情况保证
+template <class RandomAccessIterator, class Distance, class T, class Compare>
+void _adjust_heap(RandomAccessIterator first, Distance hole, Distance len,
+                  T value, Compare comp) {
+	const Distance top = hole;
+	Distance       child = 2 * hole + 2;
+	while (child < len) {
+		if (comp(*(first + child), *(first + (child - 1))))
+			--child;
+		*(first + hole) = std::move(*(first + child));
+		hole = child;
+		child = 2 * child + 2;
+	}
+	if (child == len) {
+		*(first + hole) = std::move(*(first + (child - 1)));
+		hole = child - 1;
+	}
+
+	Distance parent = (hole - 1) / 2;
+	while (hole > top && comp(*(first + parent), value)) {
+		*(first + hole) = std::move(*(first + parent));
+		hole = parent;
+		parent = (hole - 1) / 2;
+	}
+	*(first + hole) = std::move(value);
+}
+
+template <class RandomAccessIterator, class Compare>
+void _make_heap(RandomAccessIterator first, RandomAccessIterator last,
+                Compare comp) {
+	typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+	typedef typename iterator_traits<RandomAccessIterator>::difference_type
+	    Distance;
+
+	Distance len = last - first;
+	if (len < 2)
+		return;
+	for (Distance parent = (len - 2) / 2;; --parent) {
+		T value = std::move(*(first + parent));
+		_adjust_heap(first, parent, len, std::move(value), comp);
+		if (parent == 0)
+			break;
+	}
+}
+
+template <class RandomAccessIterator, class Compare>
+void _sort_heap(RandomAccessIterator first, RandomAccessIterator last,
+                Compare comp) {
+	typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+	typedef typename iterator_traits<RandomAccessIterator>::difference_type
+	    Distance;
+
+	while (last - first > 1) {
+		--last;
+		T value = std::move(*last);
+		*last = std::move(*first);
+		_adjust_heap(first, Distance(0), Distance(last - first), std::move(value),
+		             comp);
+	}
+}
+
+template <class RandomAccessIterator, class Compare>
+void _heap_sort(RandomAccessIterator first, RandomAccessIterator last,
+                Compare comp) {
+	_make_heap(first, last, comp);
+	_sort_heap(first, last, comp);
+}
+
+///<- insertion sort series
+// _insertion_sort(): [first, last) 插入排序
+// _unguarded_insertion_sort(): 要求 *(first - 1) 不大于区间内任一元素，省去左边界检查
+// _partial_insertion_sort(): 移动次数超过 _SORT_PARTIAL_INSERTION_LIMIT 时放弃并返回 false
+template <class RandomAccessIterator, class Compare>
+void _insertion_sort(RandomAccessIterator first, RandomAccessIterator last,
+                     Compare comp) {
+	typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+	if (first == last)
+		return;
+
+	for (RandomAccessIterator current = first + 1; current != last; ++current) {
+		RandomAccessIterator sift = current;
+		RandomAccessIterator sift_1 = current - 1;
+		if (comp(*sift, *sift_1)) {
+			T temp = std::move(*sift);
+			do {
+				*sift-- = std::move(*sift_1);
+			} while (sift != first && comp(temp, *--sift_1));
+			*sift = std::move(temp);
+		}
+	}
+}
+
+template <class RandomAccessIterator, class Compare>
+void _unguarded_insertion_sort(RandomAccessIterator first,
+                               RandomAccessIterator last, Compare comp) {
+	typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+	if (first == last)
+		return;
+
+	for (RandomAccessIterator current = first + 1; current != last; ++current) {
+		RandomAccessIterator sift = current;
+		RandomAccessIterator sift_1 = current - 1;
+		if (comp(*sift, *sift_1)) {
+			T temp = std::move(*sift);
+			do {
+				*sift-- = std::move(*sift_1);
+			} while (comp(temp, *--sift_1));
+			*sift = std::move(temp);
+		}
+	}
+}
+
+template <class RandomAccessIterator, class Compare>
+bool _partial_insertion_sort(RandomAccessIterator first,
+                             RandomAccessIterator last, Compare comp) {
+	typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+	if (first == last)
+		return true;
+
+	size_t moves = 0;
+	for (RandomAccessIterator current = first + 1; current != last; ++current) {
+		RandomAccessIterator sift = current;
+		RandomAccessIterator sift_1 = current - 1;
+		if (comp(*sift, *sift_1)) {
+			T temp = std::move(*sift);
+			do {
+				*sift-- = std::move(*sift_1);
+			} while (sift != first && comp(temp, *--sift_1));
+			*sift = std::move(temp);
+
+			moves += static_cast<size_t>(current - sift);
+			if (moves > _SORT_PARTIAL_INSERTION_LIMIT)
+				return false;
+		}
+	}
+	return true;
+}
+
+///<- pdqsort partition series
+template <class RandomAccessIterator, class Compare>
+inline void _sort2(RandomAccessIterator a, RandomAccessIterator b,
+                   Compare comp) {
+	if (comp(*b, *a))
+		std::iter_swap(a, b);
+}
+
+template <class RandomAccessIterator, class Compare>
+inline void _sort3(RandomAccessIterator a, RandomAccessIterator b,
+                   RandomAccessIterator c, Compare comp) {
+	_sort2(a, b, comp);
+	_sort2(b, c, comp);
+	_sort2(a, b, comp);
+}
+
+inline unsigned char* _align_cacheline(unsigned char* p) noexcept {
+	uintptr_t address = reinterpret_cast<uintptr_t>(p);
+	address = (address + _SORT_CACHELINE_SIZE - 1) &
+	          ~static_cast<uintptr_t>(_SORT_CACHELINE_SIZE - 1);
+	return reinterpret_cast<unsigned char*>(address);
+}
+
+// 交换块划分中记录的 num 对错位元素
+// 左右个数相等时逐对交换，否则以循环移动减少一半赋值
+template <class RandomAccessIterator>
+inline void _swap_offsets(RandomAccessIterator first, RandomAccessIterator last,
+                          const unsigned char* offsets_l,
+                          const unsigned char* offsets_r, size_t num,
+                          bool use_swaps) {
+	typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+	if (use_swaps) {
+		for (size_t i = 0; i < num; ++i)
+			std::iter_swap(first + offsets_l[i], last - offsets_r[i]);
+	} else if (num > 0) {
+		RandomAccessIterator l = first + offsets_l[0];
+		RandomAccessIterator r = last - offsets_r[0];
+		T                    temp(std::move(*l));
+		*l = std::move(*r);
+		for (size_t i = 1; i < num; ++i) {
+			l = first + offsets_l[i];
+			*r = std::move(*l);
+			r = last - offsets_r[i];
+			*l = std::move(*r);
+		}
+		*r = std::move(temp);
+	}
+}
+
+// 以 *first 为枢轴划分，小于枢轴的元素位于左侧
+// 返回枢轴最终位置及划分前是否已经有序
+// 无分支版本: 每块 64 个元素先记录错位元素的偏移，再批量交换
+template <class RandomAccessIterator, class Compare>
+std::pair<RandomAccessIterator, bool>
+_partition_right_branchless(RandomAccessIterator begin,
+                            RandomAccessIterator end, Compare comp) {
+	typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+
+	T                    pivot(std::move(*begin));
+	RandomAccessIterator first = begin;
+	RandomAccessIterator last = end;
+
+	// 三数中值保证左侧存在不小于枢轴的元素
+	while (comp(*++first, pivot))
+		;
+	if (first - 1 == begin)
+		while (first < last && !comp(*--last, pivot))
+			;
+	else
+		while (!comp(*--last, pivot))
+			;
+
+	bool already_partitioned = first >= last;
+	if (!already_partitioned) {
+		std::iter_swap(first, last);
+		++first;
+
+		unsigned char offsets_l_storage[_SORT_BLOCK_SIZE + _SORT_CACHELINE_SIZE];
+		unsigned char offsets_r_storage[_SORT_BLOCK_SIZE + _SORT_CACHELINE_SIZE];
+		unsigned char* offsets_l = _align_cacheline(offsets_l_storage);
+		unsigned char* offsets_r = _align_cacheline(offsets_r_storage);
+
+		RandomAccessIterator offsets_l_base = first;
+		RandomAccessIterator offsets_r_base = last;
+		size_t               num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+
+		while (first < last) {
+			size_t num_unknown = static_cast<size_t>(last - first);
+			size_t left_split =
+			    num_l == 0 ? (num_r == 0 ? num_unknown / 2 : num_unknown) : 0;
+			size_t right_split = num_r == 0 ? (num_unknown - left_split) : 0;
+
+			if (left_split > _SORT_BLOCK_SIZE)
+				left_split = _SORT_BLOCK_SIZE;
+			for (size_t i = 0; i < left_split; ++i) {
+				offsets_l[num_l] = static_cast<unsigned char>(i);
+				num_l += !comp(*first, pivot);
+				++first;
+			}
+
+			if (right_split > _SORT_BLOCK_SIZE)
+				right_split = _SORT_BLOCK_SIZE;
+			for (size_t i = 0; i < right_split;) {
+				offsets_r[num_r] = static_cast<unsigned char>(++i);
+				num_r += comp(*--last, pivot);
+			}
+
+			size_t num = num_l < num_r ? num_l : num_r;
+			_swap_offsets(offsets_l_base, offsets_r_base, offsets_l + start_l,
+			              offsets_r + start_r, num, num_l == num_r);
+			num_l -= num;
+			num_r -= num;
+			start_l += num;
+			start_r += num;
+
+			if (num_l == 0) {
+				start_l = 0;
+				offsets_l_base = first;
+			}
+			if (num_r == 0) {
+				start_r = 0;
+				offsets_r_base = last;
+			}
+		}
+
+		// 剩余一侧的错位元素逐个交换至分界处
+		if (num_l) {
+			offsets_l += start_l;
+			while (num_l--)
+				std::iter_swap(offsets_l_base + offsets_l[num_l], --last);
+			first = last;
+		}
+		if (num_r) {
+			offsets_r += start_r;
+			while (num_r--) {
+				std::iter_swap(offsets_r_base - offsets_r[num_r], first);
+				++first;
+			}
+			last = first;
+		}
+	}
+
+	RandomAccessIterator pivot_pos = first - 1;
+	*begin = std::move(*pivot_pos);
+	*pivot_pos = std::move(pivot);
+	return std::make_pair(pivot_pos, already_partitioned);
+}
+
+template <class RandomAccessIterator, class Compare>
+std::pair<RandomAccessIterator, bool>
+_partition_right(RandomAccessIterator begin, RandomAccessIterator end,
+                 Compare comp) {
+	typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+
+	T                    pivot(std::move(*begin));
+	RandomAccessIterator first = begin;
+	RandomAccessIterator last = end;
+
+	while (comp(*++first, pivot))
+		;
+	if (first - 1 == begin)
+		while (first < last && !comp(*--last, pivot))
+			;
+	else
+		while (!comp(*--last, pivot))
+			;
+
+	bool already_partitioned = first >= last;
+
+	// 此前交换过的元素充当哨兵，循环内无需边界检查
+	while (first < last) {
+		std::iter_swap(first, last);
+		while (comp(*++first, pivot))
+			;
+		while (!comp(*--last, pivot))
+			;
+	}
+
+	RandomAccessIterator pivot_pos = first - 1;
+	*begin = std::move(*pivot_pos);
+	*pivot_pos = std::move(pivot);
+	return std::make_pair(pivot_pos, already_partitioned);
+}
+
+// 与 _partition_right 相反，等于枢轴的元素划分至左侧，返回枢轴位置
+template <class RandomAccessIterator, class Compare>
+RandomAccessIterator _partition_left(RandomAccessIterator begin,
+                                     RandomAccessIterator end, Compare comp) {
+	typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+
+	T                    pivot(std::move(*begin));
+	RandomAccessIterator first = begin;
+	RandomAccessIterator last = end;
+
+	while (comp(pivot, *--last))
+		;
+	if (last + 1 == end)
+		while (first < last && !comp(pivot, *++first))
+			;
+	else
+		while (!comp(pivot, *++first))
+			;
+
+	while (first < last) {
+		std::iter_swap(first, last);
+		while (comp(pivot, *--last))
+			;
+		while (!comp(pivot, *++first))
+			;
+	}
+
+	RandomAccessIterator pivot_pos = last;
+	*begin = std::move(*pivot_pos);
+	*pivot_pos = std::move(pivot);
+	return pivot_pos;
+}
+
+template <class RandomAccessIterator, class Compare>
+inline std::pair<RandomAccessIterator, bool>
+_pdq_partition_right(RandomAccessIterator begin, RandomAccessIterator end,
+                     Compare comp, _true_type) {
+	return _partition_right_branchless(begin, end, comp);
+}
+
+template <class RandomAccessIterator, class Compare>
+inline std::pair<RandomAccessIterator, bool>
+_pdq_partition_right(RandomAccessIterator begin, RandomAccessIterator end,
+                     Compare comp, _false_type) {
+	return _partition_right(begin, end, comp);
+}
+
+// 比较开销小且结果不可预测时无分支块划分更快
+template <class T, class Compare>
+struct _is_branchless_sortable {
+	typedef typename IfThenElse<
+	    std::is_arithmetic<T>::value &&
+	        (std::is_same<Compare, std::less<T>>::value ||
+	         std::is_same<Compare, std::greater<T>>::value),
+	    _true_type, _false_type>::result type;
+};
+
+template <class Size>
+inline int _sort_log2(Size n) {
+	int log = 0;
+	while (n >>= 1)
+		++log;
+	return log;
+}
+
+template <class RandomAccessIterator, class Compare, class Branchless>
+void _pdqsort_loop(RandomAccessIterator begin, RandomAccessIterator end,
+                   Compare comp, int bad_allowed, bool leftmost,
+                   Branchless branchless) {
+	typedef typename iterator_traits<RandomAccessIterator>::difference_type
+	    Distance;
+
+	// 右侧区间以循环代替尾递归
+	while (true) {
+		Distance size = end - begin;
+
+		if (size < _SORT_INSERTION_THRESHOLD) {
+			if (leftmost)
+				_insertion_sort(begin, end, comp);
+			else
+				_unguarded_insertion_sort(begin, end, comp);
+			return;
+		}
+
+		// 三数中值或九数中值，结果置于 *begin
+		Distance s2 = size / 2;
+		if (size > _SORT_NINTHER_THRESHOLD) {
+			_sort3(begin, begin + s2, end - 1, comp);
+			_sort3(begin + 1, begin + (s2 - 1), end - 2, comp);
+			_sort3(begin + 2, begin + (s2 + 1), end - 3, comp);
+			_sort3(begin + (s2 - 1), begin + s2, begin + (s2 + 1), comp);
+			std::iter_swap(begin, begin + s2);
+		} else {
+			_sort3(begin + s2, begin, end - 1, comp);
+		}
+
+		// *(begin - 1) 为上一次划分的枢轴，不大于本区间任一元素
+		// 若与当前枢轴相等，则等于枢轴的元素全部归入左侧且无需继续排序
+		if (!leftmost && !comp(*(begin - 1), *begin)) {
+			begin = _partition_left(begin, end, comp) + 1;
+			continue;
+		}
+
+		std::pair<RandomAccessIterator, bool> part =
+		    _pdq_partition_right(begin, end, comp, branchless);
+		RandomAccessIterator pivot_pos = part.first;
+		bool                 already_partitioned = part.second;
+
+		Distance l_size = pivot_pos - begin;
+		Distance r_size = end - (pivot_pos + 1);
+		bool     highly_unbalanced = l_size < size / 8 || r_size < size / 8;
+
+		if (highly_unbalanced) {
+			// 失衡次数过多，退化为堆排序保证 O(NlogN)
+			if (--bad_allowed == 0) {
+				_heap_sort(begin, end, comp);
+				return;
+			}
+
+			// 交换部分元素以破坏导致失衡的模式
+			if (l_size >= _SORT_INSERTION_THRESHOLD) {
+				std::iter_swap(begin, begin + l_size / 4);
+				std::iter_swap(pivot_pos - 1, pivot_pos - l_size / 4);
+				if (l_size > _SORT_NINTHER_THRESHOLD) {
+					std::iter_swap(begin + 1, begin + (l_size / 4 + 1));
+					std::iter_swap(begin + 2, begin + (l_size / 4 + 2));
+					std::iter_swap(pivot_pos - 2, pivot_pos - (l_size / 4 + 1));
+					std::iter_swap(pivot_pos - 3, pivot_pos - (l_size / 4 + 2));
+				}
+			}
+			if (r_size >= _SORT_INSERTION_THRESHOLD) {
+				std::iter_swap(pivot_pos + 1, pivot_pos + (1 + r_size / 4));
+				std::iter_swap(end - 1, end - r_size / 4);
+				if (r_size > _SORT_NINTHER_THRESHOLD) {
+					std::iter_swap(pivot_pos + 2, pivot_pos + (2 + r_size / 4));
+					std::iter_swap(pivot_pos + 3, pivot_pos + (3 + r_size / 4));
+					std::iter_swap(end - 2, end - (1 + r_size / 4));
+					std::iter_swap(end - 3, end - (2 + r_size / 4));
+				}
+			}
+		} else if (already_partitioned &&
+		           _partial_insertion_sort(begin, pivot_pos, comp) &&
+		           _partial_insertion_sort(pivot_pos + 1, end, comp)) {
+			// 划分均衡且原本有序，插入排序已完成排序
+			return;
+		}
+
+		_pdqsort_loop(begin, pivot_pos, comp, bad_allowed, leftmost, branchless);
+		begin = pivot_pos + 1;
+		leftmost = false;
+	}
+}
+
+//-------------------- sort ----------------------
+template <class RandomAccessIterator, class Compare>
+void sort(RandomAccessIterator first, RandomAccessIterator last,
+          Compare comp) {
+	typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+	typedef typename _is_branchless_sortable<T, Compare>::type isBranchless;
+
+	if (last - first < 2)
+		return;
+	_pdqsort_loop(first, last, comp, _sort_log2(last - first), true,
+	              isBranchless());
+}
+
+template <class RandomAccessIterator>
+void sort(RandomAccessIterator first, RandomAccessIterator last) {
+	typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+	mSTL::sort(first, last, std::less<T>());
+}
+
+///<- stable sort series
+// stable_sort(): [first, last) 稳定排序，TimSort  O(NlogN)，有序或由少量有序段组成时接近 O(N)
+//
+// 自左向右识别自然有序段 (严格降序段就地翻转)，不足 minrun 的段以二分插入排序补足
+// 有序段依次入栈，维持栈上段长的不变式 (含 2015 年修正的第三层检查)，保证归并均衡
+// 归并前以 gallop 跳过两段首尾已就位的部分，仅将较短一段移入暂存区
+// 归并中一侧连续胜出 min_gallop 次后切换为指数搜索整段移动，min_gallop 随收益自适应调整
+// 暂存区经 mSTL::allocator 按需分配 (小块来自内存池)，也可由调用者提供
+
+enum {
+	_TIMSORT_MIN_MERGE = 64,
+	_TIMSORT_MIN_GALLOP = 7,
+	_TIMSORT_MAX_RUNS = 85 // 段长满足不变式时 2^64 个元素所需的栈深
+};
+
+template <class RandomAccessIterator, class Compare>
+class _timsort {
+private:
+	typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+	typedef typename iterator_traits<RandomAccessIterator>::difference_type
+	    Distance;
+
+	RandomAccessIterator base_;
+	Compare              comp_;
+	Distance             min_gallop_;
+
+	T*     buffer_;
+	size_t capacity_;
+	bool   owns_buffer_;
+
+	Distance size_;
+	Distance run_base_[_TIMSORT_MAX_RUNS];
+	Distance run_len_[_TIMSORT_MAX_RUNS];
+	size_t   stack_size_;
+
+public:
+	_timsort(RandomAccessIterator first, Compare comp)
+	    : base_(first)
+	    , comp_(comp)
+	    , min_gallop_(_TIMSORT_MIN_GALLOP)
+	    , buffer_(nullptr)
+	    , capacity_(0)
+	    , owns_buffer_(true)
+	    , size_(0)
+	    , stack_size_(0) {}
+
+	// buffer 为 capacity 个已构造元素，capacity 不小于区间长度的一半时不再分配
+	_timsort(RandomAccessIterator first, Compare comp, T* buffer,
+	         size_t capacity)
+	    : base_(first)
+	    , comp_(comp)
+	    , min_gallop_(_TIMSORT_MIN_GALLOP)
+	    , buffer_(buffer)
+	    , capacity_(capacity)
+	    , owns_buffer_(false)
+	    , size_(0)
+	    , stack_size_(0) {}
+
+	_timsort(const _timsort&) = delete;
+	_timsort& operator=(const _timsort&) = delete;
+
+	~_timsort() { release(); }
+
+	void sort(Distance n) {
+		size_ = n;
+		if (n < 2)
+			return;
+
+		if (n < _TIMSORT_MIN_MERGE) {
+			Distance run = count_run_and_make_ascending(0, n);
+			binary_insertion_sort(0, n, run);
+			return;
+		}
+
+		const Distance min_run = min_run_length(n);
+		Distance       low = 0, remaining = n;
+		do {
+			Distance run = count_run_and_make_ascending(low, low + remaining);
+			if (run < min_run) {
+				Distance force = remaining < min_run ? remaining : min_run;
+				binary_insertion_sort(low, low + force, low + run);
+				run = force;
+			}
+
+			run_base_[stack_size_] = low;
+			run_len_[stack_size_] = run;
+			++stack_size_;
+			merge_collapse();
+
+			low += run;
+			remaining -= run;
+		} while (remaining != 0);
+
+		merge_force_collapse();
+	}
+
+private:
+	typename iterator_traits<RandomAccessIterator>::reference
+	at(Distance i) const {
+		return *(base_ + i);
+	}
+
+	// n 不小于 _TIMSORT_MIN_MERGE 时返回 [32, 64]，使 n / minrun 接近且不超过 2 的幂
+	static Distance min_run_length(Distance n) noexcept {
+		Distance r = 0;
+		while (n >= _TIMSORT_MIN_MERGE) {
+			r |= n & 1;
+			n >>= 1;
+		}
+		return n + r;
+	}
+
+	// 自 low 起的有序段长度，严格降序段翻转为升序 (严格保证稳定)
+	Distance count_run_and_make_ascending(Distance low, Distance high) {
+		Distance run_high = low + 1;
+		if (run_high == high)
+			return 1;
+
+		if (comp_(at(run_high++), at(low))) {
+			while (run_high < high && comp_(at(run_high), at(run_high - 1)))
+				++run_high;
+			std::reverse(base_ + low, base_ + run_high);
+		} else {
+			while (run_high < high && !comp_(at(run_high), at(run_high - 1)))
+				++run_high;
+		}
+		return run_high - low;
+	}
+
+	// [low, start) 已有序，将 [start, high) 依次二分插入，插入点位于相等元素之后
+	void binary_insertion_sort(Distance low, Distance high, Distance start) {
+		if (start == low)
+			++start;
+		for (; start < high; ++start) {
+			T        pivot = std::move(at(start));
+			Distance left = low, right = start;
+			while (left < right) {
+				Distance mid = left + (right - left) / 2;
+				if (comp_(pivot, at(mid)))
+					right = mid;
+				else
+					left = mid + 1;
+			}
+			mSTL::move_backward(base_ + left, base_ + start, base_ + (start + 1));
+			at(left) = std::move(pivot);
+		}
+	}
+
+	void merge_collapse() {
+		while (stack_size_ > 1) {
+			size_t n = stack_size_ - 2;
+			if ((n > 0 && run_len_[n - 1] <= run_len_[n] + run_len_[n + 1]) ||
+			    (n > 1 && run_len_[n - 2] <= run_len_[n - 1] + run_len_[n])) {
+				if (run_len_[n - 1] < run_len_[n + 1])
+					--n;
+			} else if (run_len_[n] > run_len_[n + 1]) {
+				break;
+			}
+			merge_at(n);
+		}
+	}
+
+	void merge_force_collapse() {
+		while (stack_size_ > 1) {
+			size_t n = stack_size_ - 2;
+			if (n > 0 && run_len_[n - 1] < run_len_[n + 1])
+				--n;
+			merge_at(n);
+		}
+	}
+
+	// 归并栈上第 i 与 i + 1 段
+	void merge_at(size_t i) {
+		Distance base1 = run_base_[i], len1 = run_len_[i];
+		Distance base2 = run_base_[i + 1], len2 = run_len_[i + 1];
+
+		run_len_[i] = len1 + len2;
+		if (i == stack_size_ - 3) {
+			run_base_[i + 1] = run_base_[i + 2];
+			run_len_[i + 1] = run_len_[i + 2];
+		}
+		--stack_size_;
+
+		// 第一段中不大于第二段首元素的前缀、第二段中不小于第一段末元素的后缀均已就位
+		Distance k = gallop_right(at(base2), base_ + base1, len1, 0);
+		base1 += k;
+		len1 -= k;
+		if (len1 == 0)
+			return;
+
+		len2 = gallop_left(at(base1 + len1 - 1), base_ + base2, len2, len2 - 1);
+		if (len2 == 0)
+			return;
+
+		if (len1 <= len2)
+			merge_low(base1, len1, base2, len2);
+		else
+			merge_high(base1, len1, base2, len2);
+	}
+
+	// 有序区间 [base, base + len) 中 key 的插入位置，位于相等元素之前
+	// 自 hint 起指数搜索定位区间后二分
+	template <class Iterator>
+	Distance gallop_left(const T& key, Iterator base, Distance len,
+	                     Distance hint) {
+		Distance last_ofs = 0, ofs = 1;
+		if (comp_(*(base + hint), key)) {
+			Distance max_ofs = len - hint;
+			while (ofs < max_ofs && comp_(*(base + (hint + ofs)), key)) {
+				last_ofs = ofs;
+				ofs = (ofs << 1) + 1;
+			}
+			if (ofs > max_ofs)
+				ofs = max_ofs;
+			last_ofs += hint;
+			ofs += hint;
+		} else {
+			Distance max_ofs = hint + 1;
+			while (ofs < max_ofs && !comp_(*(base + (hint - ofs)), key)) {
+				last_ofs = ofs;
+				ofs = (ofs << 1) + 1;
+			}
+			if (ofs > max_ofs)
+				ofs = max_ofs;
+			Distance temp = last_ofs;
+			last_ofs = hint - ofs;
+			ofs = hint - temp;
+		}
+
+		++last_ofs;
+		while (last_ofs < ofs) {
+			Distance mid = last_ofs + (ofs - last_ofs) / 2;
+			if (comp_(*(base + mid), key))
+				last_ofs = mid + 1;
+			else
+				ofs = mid;
+		}
+		return ofs;
+	}
+
+	// 同 gallop_left，插入位置位于相等元素之后
+	template <class Iterator>
+	Distance gallop_right(const T& key, Iterator base, Distance len,
+	                      Distance hint) {
+		Distance last_ofs = 0, ofs = 1;
+		if (comp_(key, *(base + hint))) {
+			Distance max_ofs = hint + 1;
+			while (ofs < max_ofs && comp_(key, *(base + (hint - ofs)))) {
+				last_ofs = ofs;
+				ofs = (ofs << 1) + 1;
+			}
+			if (ofs > max_ofs)
+				ofs = max_ofs;
+			Distance temp = last_ofs;
+			last_ofs = hint - ofs;
+			ofs = hint - temp;
+		} else {
+			Distance max_ofs = len - hint;
+			while (ofs < max_ofs && !comp_(key, *(base + (hint + ofs)))) {
+				last_ofs = ofs;
+				ofs = (ofs << 1) + 1;
+			}
+			if (ofs > max_ofs)
+				ofs = max_ofs;
+			last_ofs += hint;
+			ofs += hint;
+		}
+
+		++last_ofs;
+		while (last_ofs < ofs) {
+			Distance mid = last_ofs + (ofs - last_ofs) / 2;
+			if (comp_(key, *(base + mid)))
+				ofs = mid;
+			else
+				last_ofs = mid + 1;
+		}
+		return ofs;
+	}
+
+	// len1 <= len2: 第一段移入暂存区，自左向右归并
+	// 进入时第二段首元素小于第一段首元素，第一段末元素大于第二段末元素
+	void merge_low(Distance base1, Distance len1, Distance base2,
+	               Distance len2) {
+		T* temp = ensure_capacity(len1);
+		mSTL::move(base_ + base1, base_ + (base1 + len1), temp);
+
+		T*       cursor1 = temp;
+		Distance cursor2 = base2, dest = base1;
+
+		at(dest++) = std::move(at(cursor2++));
+		if (--len2 == 0) {
+			mSTL::move(cursor1, cursor1 + len1, base_ + dest);
+			return;
+		}
+		if (len1 == 1) {
+			mSTL::move(base_ + cursor2, base_ + (cursor2 + len2), base_ + dest);
+			at(dest + len2) = std::move(*cursor1);
+			return;
+		}
+
+		Distance min_gallop = min_gallop_;
+		while (true) {
+			Distance count1 = 0, count2 = 0;
+
+			// 逐个比较，直至一侧连续胜出 min_gallop 次
+			do {
+				if (comp_(at(cursor2), *cursor1)) {
+					at(dest++) = std::move(at(cursor2++));
+					++count2;
+					count1 = 0;
+					if (--len2 == 0)
+						goto done;
+				} else {
+					at(dest++) = std::move(*cursor1++);
+					++count1;
+					count2 = 0;
+					if (--len1 == 1)
+						goto done;
+				}
+			} while ((count1 | count2) < min_gallop);
+
+			// 指数搜索整段移动，直至两侧均不再有长段胜出
+			do {
+				count1 = gallop_right(at(cursor2), cursor1, len1, 0);
+				if (count1 != 0) {
+					mSTL::move(cursor1, cursor1 + count1, base_ + dest);
+					dest += count1;
+					cursor1 += count1;
+					len1 -= count1;
+					if (len1 <= 1)
+						goto done;
+				}
+				at(dest++) = std::move(at(cursor2++));
+				if (--len2 == 0)
+					goto done;
+
+				count2 = gallop_left(*cursor1, base_ + cursor2, len2, 0);
+				if (count2 != 0) {
+					mSTL::move(base_ + cursor2, base_ + (cursor2 + count2),
+					           base_ + dest);
+					dest += count2;
+					cursor2 += count2;
+					len2 -= count2;
+					if (len2 == 0)
+						goto done;
+				}
+				at(dest++) = std::move(*cursor1++);
+				if (--len1 == 1)
+					goto done;
+				--min_gallop;
+			} while (count1 >= _TIMSORT_MIN_GALLOP ||
+			         count2 >= _TIMSORT_MIN_GALLOP);
+
+			if (min_gallop < 0)
+				min_gallop = 0;
+			min_gallop += 2;
+		}
+
+	done:
+		min_gallop_ = min_gallop < 1 ? 1 : min_gallop;
+		if (len1 == 1) {
+			mSTL::move(base_ + cursor2, base_ + (cursor2 + len2), base_ + dest);
+			at(dest + len2) = std::move(*cursor1);
+		} else {
+			// 比较器不满足严格弱序时 len1 可能为 0，此时无元素需要移动
+			mSTL::move(cursor1, cursor1 + len1, base_ + dest);
+		}
+	}
+
+	// len1 > len2: 第二段移入暂存区，自右向左归并
+	void merge_high(Distance base1, Distance len1, Distance base2,
+	                Distance len2) {
+		T* temp = ensure_capacity(len2);
+		mSTL::move(base_ + base2, base_ + (base2 + len2), temp);
+
+		Distance cursor1 = base1 + len1 - 1;
+		Distance cursor2 = len2 - 1;
+		Distance dest = base2 + len2 - 1;
+
+		at(dest--) = std::move(at(cursor1--));
+		if (--len1 == 0) {
+			mSTL::move(temp, temp + len2, base_ + (dest - (len2 - 1)));
+			return;
+		}
+		if (len2 == 1) {
+			dest -= len1;
+			cursor1 -= len1;
+			mSTL::move_backward(base_ + (cursor1 + 1),
+			                    base_ + (cursor1 + 1 + len1),
+			                    base_ + (dest + 1 + len1));
+			at(dest) = std::move(temp[cursor2]);
+			return;
+		}
+
+		Distance min_gallop = min_gallop_;
+		while (true) {
+			Distance count1 = 0, count2 = 0;
+
+			do {
+				if (comp_(temp[cursor2], at(cursor1))) {
+					at(dest--) = std::move(at(cursor1--));
+					++count1;
+					count2 = 0;
+					if (--len1 == 0)
+						goto done;
+				} else {
+					at(dest--) = std::move(temp[cursor2--]);
+					++count2;
+					count1 = 0;
+					if (--len2 == 1)
+						goto done;
+				}
+			} while ((count1 | count2) < min_gallop);
+
+			do {
+				count1 = len1 - gallop_right(temp[cursor2], base_ + base1, len1,
+				                             len1 - 1);
+				if (count1 != 0) {
+					dest -= count1;
+					cursor1 -= count1;
+					len1 -= count1;
+					mSTL::move_backward(base_ + (cursor1 + 1),
+					                    base_ + (cursor1 + 1 + count1),
+					                    base_ + (dest + 1 + count1));
+					if (len1 == 0)
+						goto done;
+				}
+				at(dest--) = std::move(temp[cursor2--]);
+				if (--len2 == 1)
+					goto done;
+
+				count2 = len2 - gallop_left(at(cursor1), temp, len2, len2 - 1);
+				if (count2 != 0) {
+					dest -= count2;
+					cursor2 -= count2;
+					len2 -= count2;
+					mSTL::move(temp + (cursor2 + 1), temp + (cursor2 + 1 + count2),
+					           base_ + (dest + 1));
+					if (len2 <= 1)
+						goto done;
+				}
+				at(dest--) = std::move(at(cursor1--));
+				if (--len1 == 0)
+					goto done;
+				--min_gallop;
+			} while (count1 >= _TIMSORT_MIN_GALLOP ||
+			         count2 >= _TIMSORT_MIN_GALLOP);
+
+			if (min_gallop < 0)
+				min_gallop = 0;
+			min_gallop += 2;
+		}
+
+	done:
+		min_gallop_ = min_gallop < 1 ? 1 : min_gallop;
+		if (len2 == 1) {
+			dest -= len1;
+			cursor1 -= len1;
+			mSTL::move_backward(base_ + (cursor1 + 1),
+			                    base_ + (cursor1 + 1 + len1),
+			                    base_ + (dest + 1 + len1));
+			at(dest) = std::move(temp[cursor2]);
+		} else if (len2 > 0) {
+			mSTL::move(temp, temp + len2, base_ + (dest - (len2 - 1)));
+		}
+	}
+
+	// 暂存区不足时按 2 的幂扩容 (不超过区间长度的一半)，元素以区间首元素为种子依次移动构造
+	T* ensure_capacity(Distance needed) {
+		size_t min_capacity = static_cast<size_t>(needed);
+		if (capacity_ >= min_capacity)
+			return buffer_;
+
+		size_t capacity = 256;
+		while (capacity < min_capacity)
+			capacity <<= 1;
+		if (capacity > static_cast<size_t>(size_ / 2))
+			capacity = min_capacity > static_cast<size_t>(size_ / 2)
+			               ? min_capacity
+			               : static_cast<size_t>(size_ / 2);
+		release();
+
+		buffer_ = allocator<T>::allocate(capacity);
+		capacity_ = capacity;
+		owns_buffer_ = true;
+
+		T* prev = buffer_;
+		allocator<T>::construct(prev, std::move(*base_));
+		for (T* current = prev + 1; current != buffer_ + capacity; prev = current++)
+			allocator<T>::construct(current, std::move(*prev));
+		*base_ = std::move(*prev);
+		return buffer_;
+	}
+
+	void release() noexcept {
+		if (!owns_buffer_ || buffer_ == nullptr)
+			return;
+		allocator<T>::destroy(buffer_, buffer_ + capacity_);
+		allocator<T>::deallocate(buffer_, capacity_);
+		buffer_ = nullptr;
+		capacity_ = 0;
+	}
+};
+
+//----------------- stable_sort ------------------
+template <class RandomAccessIterator, class Compare>
+void stable_sort(RandomAccessIterator first, RandomAccessIterator last,
+                 Compare comp) {
+	_timsort<RandomAccessIterator, Compare> sorter(first, comp);
+	sorter.sort(last - first);
+}
+
+template <class RandomAccessIterator>
+void stable_sort(RandomAccessIterator first, RandomAccessIterator last) {
+	typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+	mSTL::stable_sort(first, last, std::less<T>());
+}
+
+///<- parallel sort series
+// sort(par, ...): 并行样本排序 (sample sort)  不稳定
+//     抽样排序后选取分割元素，各线程分段将元素归入桶，再以桶为单位并行 pdqsort
+//     每个分割元素附带一个相等桶，大量重复元素时相等桶无需再排序
+// stable_sort(par, ...): 并行归并排序  稳定
+//     各线程分段 TimSort，随后逐轮两两归并，每轮按输出位置切分 (merge path) 并行归并
+// 均使用 thread_pool::instance()，暂存区由 mSTL::allocator 分配
+// 元素数小于 _PARALLEL_SORT_THRESHOLD 或线程池无工作线程时串行执行
+
+// 并行执行策略，作为首个参数传入算法
+struct parallel_policy {};
+constexpr parallel_policy par{};
+
+enum {
+	_PARALLEL_SORT_THRESHOLD = 1 << 15,
+	_SAMPLE_SORT_OVERSAMPLING = 32,
+	_SAMPLE_SORT_MAX_SPLITTERS = 127, // 2 * 127 + 1 个桶，桶号以 unsigned char 存储
+	_PARALLEL_MERGE_GRAIN = 1 << 12
+};
+
+// 排序暂存区，内存由 mSTL::allocator 分配，元素的构造与析构由使用者负责
+// construct() 以 seed 依次移动构造 [begin, end)，结束后将值移回 seed
+// 仅需 n + 1 次移动，暂存区内均为移动后状态的元素
+template <class T>
+class _temporary_buffer {
+private:
+	T*     buffer_;
+	size_t size_;
+
+public:
+	explicit _temporary_buffer(size_t n)
+	    : buffer_(allocator<T>::allocate(n))
+	    , size_(n) {}
+	~_temporary_buffer() { allocator<T>::deallocate(buffer_, size_); }
+
+	_temporary_buffer(const _temporary_buffer&) = delete;
+	_temporary_buffer& operator=(const _temporary_buffer&) = delete;
+
+	T*     data() const noexcept { return buffer_; }
+	size_t size() const noexcept { return size_; }
+
+	template <class ForwardIterator>
+	void construct(size_t begin, size_t end, ForwardIterator seed) {
+		if (begin == end)
+			return;
+		T* prev = buffer_ + begin;
+		allocator<T>::construct(prev, std::move(*seed));
+		for (T* current = prev + 1; current != buffer_ + end; prev = current++)
+			allocator<T>::construct(current, std::move(*prev));
+		*seed = std::move(*prev);
+	}
+
+	void destroy(size_t begin, size_t end) noexcept {
+		allocator<T>::destroy(buffer_ + begin, buffer_ + end);
+	}
+};
+
+// 稳定归并，相等时先取第一区间的元素
+template <class InputIterator1, class InputIterator2, class OutputIterator,
+          class Compare>
+OutputIterator _merge_move(InputIterator1 first1, InputIterator1 last1,
+                           InputIterator2 first2, InputIterator2 last2,
+                           OutputIterator result, Compare comp) {
+	while (first1 != last1 && first2 != last2) {
+		if (comp(*first2, *first1))
+			*result = std::move(*first2++);
+		else
+			*result = std::move(*first1++);
+		++result;
+	}
+	return mSTL::move(first2, last2, mSTL::move(first1, last1, result));
+}
+
+// 稳定归并 a[0, na) 与 b[0, nb) 时，前 k 个输出中来自 a 的元素个数
+template <class RandomAccessIterator1, class RandomAccessIterator2,
+          class Compare>
+size_t _merge_path(RandomAccessIterator1 a, size_t na, RandomAccessIterator2 b,
+                   size_t nb, size_t k, Compare comp) {
+	size_t low = k > nb ? k - nb : 0;
+	size_t high = k < na ? k : na;
+	while (low < high) {
+		size_t mid = low + (high - low) / 2;
+		if (!comp(*(b + (k - mid - 1)), *(a + mid)))
+			low = mid + 1;
+		else
+			high = mid;
+	}
+	return low;
+}
+
+// 一轮并行归并: 相邻 width 个段两两归并，src -> dst
+// 按输出位置切分为等长分块，先以 _merge_path 求出各分块边界在两侧的位置，再各自归并
+// 归并时会移走 src 中的元素，两步须分开执行
+template <class RandomAccessIterator1, class RandomAccessIterator2,
+          class Compare>
+void _parallel_merge_pass(RandomAccessIterator1 src, RandomAccessIterator2 dst,
+                          size_t n, const size_t* bounds, size_t runs,
+                          size_t width, Compare comp, thread_pool& pool) {
+	size_t grain = n / (pool.concurrency() * 8);
+	if (grain < _PARALLEL_MERGE_GRAIN)
+		grain = _PARALLEL_MERGE_GRAIN;
+	const size_t chunks = (n + grain - 1) / grain;
+
+	// 第 run 段所在组的起点、中点与终点
+	auto group = [&](size_t run, size_t& low, size_t& mid, size_t& high) {
+		low = bounds[run];
+		mid = bounds[runs - run > width ? run + width : runs];
+		high = bounds[runs - run > 2 * width ? run + 2 * width : runs];
+	};
+
+	// splits[chunk]: 输出位置 chunk * grain 在其所在组内来自前一段的元素个数
+	_temporary_buffer<size_t> split_buffer(chunks + 1);
+	size_t*                   splits = split_buffer.data();
+	pool.parallel_for(1, chunks, 1, [&](size_t chunk, size_t) {
+		size_t k = chunk * grain, low, mid, high;
+		size_t run = 0;
+		for (group(run, low, mid, high); high <= k; group(run, low, mid, high))
+			run += 2 * width;
+		splits[chunk] = _merge_path(src + low, mid - low, src + mid, high - mid,
+		                            k - low, comp);
+	});
+
+	pool.parallel_for(0, chunks, 1, [&](size_t chunk, size_t) {
+		size_t begin = chunk * grain;
+		size_t end = n - begin > grain ? begin + grain : n;
+		for (size_t run = 0; run < runs; run += 2 * width) {
+			size_t low, mid, high;
+			group(run, low, mid, high);
+			if (high <= begin)
+				continue;
+			if (low >= end)
+				break;
+
+			size_t k0 = begin > low ? begin - low : 0;
+			size_t i0 = begin > low ? splits[chunk] : 0;
+			size_t k1 = end < high ? end - low : high - low;
+			size_t i1 = end < high ? splits[chunk + 1] : mid - low;
+			_merge_move(src + (low + i0), src + (low + i1),
+			            src + (mid + (k0 - i0)), src + (mid + (k1 - i1)),
+			            dst + (low + k0), comp);
+		}
+	});
+}
+
+// 分割元素 splitters[0, count) 严格递增
+// 小于 splitters[i] 且不小于 splitters[i - 1] 的元素归入 2i 号桶，等于 splitters[i] 的归入 2i + 1 号桶
+template <class T, class RandomAccessIterator, class Compare>
+inline unsigned char _sample_sort_bucket(const T& value,
+                                         const RandomAccessIterator* splitters,
+                                         size_t count, Compare& comp) {
+	size_t low = 0, high = count;
+	while (low < high) {
+		size_t mid = (low + high) / 2;
+		if (comp(*splitters[mid], value))
+			low = mid + 1;
+		else
+			high = mid;
+	}
+	return static_cast<unsigned char>(
+	    2 * low + (low < count && !comp(value, *splitters[low])));
+}
+
+// n 个元素均分为 blocks 段时第 block 段的起点，各段长度相差不超过 1
+// 段数多于元素数时靠后的段为空
+inline size_t _block_bound(size_t n, size_t blocks, size_t block) {
+	return n / blocks * block + n % blocks * block / blocks;
+}
+
+template <class RandomAccessIterator, class Compare>
+void _sample_sort(RandomAccessIterator first, RandomAccessIterator last,
+                  Compare comp, thread_pool& pool) {
+	typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+
+	const size_t n = static_cast<size_t>(last - first);
+	const size_t threads = pool.concurrency();
+
+	// 抽样: 随机元素交换至区间头部并排序，等距选取分割元素并去重
+	size_t wanted = threads * 4 - 1;
+	if (wanted > _SAMPLE_SORT_MAX_SPLITTERS)
+		wanted = _SAMPLE_SORT_MAX_SPLITTERS;
+	const size_t sample = (wanted + 1) * _SAMPLE_SORT_OVERSAMPLING;
+
+	uint64_t state = 0x9e3779b97f4a7c15ULL ^ n;
+	for (size_t i = 0; i < sample; ++i) {
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		std::iter_swap(first + i, first + (i + state % (n - i)));
+	}
+	mSTL::sort(first, first + sample, comp);
+
+	RandomAccessIterator splitters[_SAMPLE_SORT_MAX_SPLITTERS];
+	size_t               count = 0;
+	for (size_t i = 1; i <= wanted; ++i) {
+		RandomAccessIterator candidate =
+		    first + (i * _SAMPLE_SORT_OVERSAMPLING - 1);
+		if (count == 0 || comp(*splitters[count - 1], *candidate))
+			splitters[count++] = candidate;
+	}
+	const size_t buckets = 2 * count + 1;
+
+	// 分段计算桶号与各段各桶元素数
+	const size_t                     blocks = threads;
+	_temporary_buffer<unsigned char> bucket_of(n);
+	_temporary_buffer<size_t>        offsets(blocks * buckets);
+	_temporary_buffer<size_t>        bucket_bounds(buckets + 1);
+	size_t*                          offset = offsets.data();
+	size_t*                          bound = bucket_bounds.data();
+	memset(offset, 0, blocks * buckets * sizeof(size_t));
+
+	pool.parallel_for(0, blocks, 1, [&](size_t block, size_t) {
+		size_t  begin = _block_bound(n, blocks, block);
+		size_t  end = _block_bound(n, blocks, block + 1);
+		size_t* count_of = offset + block * buckets;
+		for (size_t i = begin; i < end; ++i) {
+			unsigned char bucket =
+			    _sample_sort_bucket(*(first + i), splitters, count, comp);
+			bucket_of.data()[i] = bucket;
+			++count_of[bucket];
+		}
+	});
+
+	// 按桶优先、段次之的顺序求前缀和，得到各段各桶的写入位置
+	size_t position = 0;
+	for (size_t bucket = 0; bucket < buckets; ++bucket) {
+		bound[bucket] = position;
+		for (size_t block = 0; block < blocks; ++block) {
+			size_t items = offset[block * buckets + bucket];
+			offset[block * buckets + bucket] = position;
+			position += items;
+		}
+	}
+	bound[buckets] = n;
+
+	// 分段移动至暂存区，再按桶移回并排序，相等桶无需排序
+	_temporary_buffer<T> buffer(n);
+	pool.parallel_for(0, blocks, 1, [&](size_t block, size_t) {
+		size_t  begin = _block_bound(n, blocks, block);
+		size_t  end = _block_bound(n, blocks, block + 1);
+		size_t* position_of = offset + block * buckets;
+		for (size_t i = begin; i < end; ++i)
+			allocator<T>::construct(
+			    buffer.data() + position_of[bucket_of.data()[i]]++,
+			    std::move(*(first + i)));
+	});
+
+	pool.parallel_for(0, buckets, 1, [&](size_t bucket, size_t) {
+		size_t begin = bound[bucket], end = bound[bucket + 1];
+		mSTL::move(buffer.data() + begin, buffer.data() + end, first + begin);
+		buffer.destroy(begin, end);
+		if (bucket % 2 == 0)
+			mSTL::sort(first + begin, first + end, comp);
+	});
+}
+
+template <class RandomAccessIterator, class Compare>
+void _parallel_merge_sort(RandomAccessIterator first, RandomAccessIterator last,
+                          Compare comp, thread_pool& pool) {
+	typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+
+	const size_t n = static_cast<size_t>(last - first);
+	const size_t runs = pool.concurrency();
+
+	_temporary_buffer<size_t> run_bounds(runs + 1);
+	size_t*                   bounds = run_bounds.data();
+	for (size_t run = 0; run <= runs; ++run)
+		bounds[run] = n / runs * run + (n % runs) * run / runs;
+
+	// 各段在自己的暂存区间上构造元素并稳定排序，全部分块执行完毕后暂存区均已构造
+	_temporary_buffer<T> buffer(n);
+	T*                   scratch = buffer.data();
+	try {
+		pool.parallel_for(0, runs, 1, [&](size_t run, size_t) {
+			size_t begin = bounds[run], end = bounds[run + 1];
+			buffer.construct(begin, end, first + begin);
+			_timsort<RandomAccessIterator, Compare> sorter(
+			    first + begin, comp, scratch + begin, end - begin);
+			sorter.sort(static_cast<typename iterator_traits<
+			                RandomAccessIterator>::difference_type>(end - begin));
+		});
+
+		bool in_buffer = false;
+		for (size_t width = 1; width < runs; width *= 2) {
+			if (in_buffer)
+				_parallel_merge_pass(scratch, first, n, bounds, runs, width, comp,
+				                     pool);
+			else
+				_parallel_merge_pass(first, scratch, n, bounds, runs, width, comp,
+				                     pool);
+			in_buffer = !in_buffer;
+		}
+
+		if (in_buffer)
+			pool.parallel_for(0, n, n / runs + 1, [&](size_t begin, size_t end) {
+				mSTL::move(scratch + begin, scratch + end, first + begin);
+			});
+	} catch (...) {
+		buffer.destroy(0, n);
+		throw;
+	}
+	buffer.destroy(0, n);
+}
+
+//-------------------- sort(par) -----------------
+template <class RandomAccessIterator, class Compare>
+void sort(const parallel_policy&, RandomAccessIterator first,
+          RandomAccessIterator last, Compare comp) {
+	thread_pool& pool = thread_pool::instance();
+	if (last - first < _PARALLEL_SORT_THRESHOLD || pool.concurrency() == 1) {
+		mSTL::sort(first, last, comp);
+		return;
+	}
+	_sample_sort(first, last, comp, pool);
+}
+
+template <class RandomAccessIterator>
+void sort(const parallel_policy& policy, RandomAccessIterator first,
+          RandomAccessIterator last) {
+	typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+	mSTL::sort(policy, first, last, std::less<T>());
+}
+
+//---------------- stable_sort(par) --------------
+template <class RandomAccessIterator, class Compare>
+void stable_sort(const parallel_policy&, RandomAccessIterator first,
+                 RandomAccessIterator last, Compare comp) {
+	thread_pool& pool = thread_pool::instance();
+	if (last - first < _PARALLEL_SORT_THRESHOLD || pool.concurrency() == 1) {
+		mSTL::stable_sort(first, last, comp);
+		return;
+	}
+	_parallel_merge_sort(first, last, comp, pool);
+}
+
+template <class RandomAccessIterator>
+void stable_sort(const parallel_policy& policy, RandomAccessIterator first,
+                 RandomAccessIterator last) {
+	typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+	mSTL::stable_sort(policy, first, last, std::less<T>());
+}
+
+///<- radix sort series
+// radix_sort(): [first, last) 按整数 / 浮点键基数排序  O(N * w)  不稳定
+//     key_fn 自元素提取算术类型的键，缺省为元素本身
+//     键映射为同宽度无符号整数后按无符号序排序
+//     有符号整数翻转符号位；浮点数为负时按位取反，否则翻转符号位 (-0.0 排在 0.0 之前，NaN 位于两端)
+//     元素数不小于 _RADIX_LSD_THRESHOLD 时 LSD 排序，较大输入使用 11 位数字减少趟数
+//     各趟的计数一次遍历求出，所有元素该位相同的趟直接跳过
+//     超过 _RADIX_MSD_THRESHOLD 时先按最高非平凡 8 位分桶，各桶再 LSD 排序
+//     较小的输入 (桶) 以原地 MSD American flag sort 排序，不足 _RADIX_INSERTION_THRESHOLD 个元素时插入排序
+// radix_sort(par, ...): 分桶的计数与移动分段并行，随后以桶为单位并行排序剩余低位
+
+enum {
+	_RADIX_INSERTION_THRESHOLD = 32,
+	_RADIX_LSD_THRESHOLD = 1 << 11,
+	_RADIX_MSD_THRESHOLD = 1 << 18,
+	_RADIX_WIDE_DIGIT_THRESHOLD = 1 << 16
+};
+
+template <size_t Size>
+struct _radix_unsigned;
+template <>
+struct _radix_unsigned<1> {
+	typedef uint8_t type;
+};
+template <>
+struct _radix_unsigned<2> {
+	typedef uint16_t type;
+};
+template <>
+struct _radix_unsigned<4> {
+	typedef uint32_t type;
+};
+template <>
+struct _radix_unsigned<8> {
+	typedef uint64_t type;
+};
+
+// 键 -> 无符号整数，保持大小顺序
+template <class Key, bool IsFloat = std::is_floating_point<Key>::value>
+struct _radix_traits {
+	static_assert(std::is_integral<Key>::value,
+	              "radix_sort key must be an arithmetic type");
+
+	typedef typename _radix_unsigned<sizeof(Key)>::type type;
+
+	static type encode(Key key) noexcept {
+		type bits = static_cast<type>(key);
+		if (std::is_signed<Key>::value)
+			bits ^= static_cast<type>(type(1) << (sizeof(type) * 8 - 1));
+		return bits;
+	}
+};
+
+template <class Key>
+struct _radix_traits<Key, true> {
+	typedef typename _radix_unsigned<sizeof(Key)>::type type;
+
+	static type encode(Key key) noexcept {
+		const type sign = static_cast<type>(type(1) << (sizeof(type) * 8 - 1));
+		type       bits;
+		memcpy(&bits, &key, sizeof(bits));
+		return static_cast<type>((bits & sign) ? ~bits : (bits | sign));
+	}
+};
+
+struct _radix_identity {
+	template <class T>
+	const T& operator()(const T& value) const noexcept {
+		return value;
+	}
+};
+
+template <class Key, class KeyFunction>
+struct _radix_encoder {
+	typedef _radix_traits<Key>    traits;
+	typedef typename traits::type type;
+	KeyFunction                   key;
+
+	template <class T>
+	type operator()(const T& value) const {
+		return traits::encode(key(value));
+	}
+};
+
+// 按 (encode(x) >> shift) & mask 将 src 中 n 个元素移动至 dst，offset 为各桶写入位置
+template <class RandomAccessIterator1, class RandomAccessIterator2,
+          class Encoder>
+void _radix_scatter(RandomAccessIterator1 src, size_t n,
+                    RandomAccessIterator2 dst, size_t* offset,
+                    const Encoder& encode, unsigned shift, size_t mask) {
+	for (size_t i = 0; i < n; ++i) {
+		size_t digit = static_cast<size_t>(encode(*(src + i)) >> shift) & mask;
+		*(dst + offset[digit]++) = std::move(*(src + i));
+	}
+}
+
+// 按低 bits 位 LSD 排序 data[0, n)，scratch 为 n 个已构造元素
+// 返回 true 表示结果位于 scratch
+template <class RandomAccessIterator1, class RandomAccessIterator2,
+          class Encoder>
+bool _radix_sort_lsd(RandomAccessIterator1 data, RandomAccessIterator2 scratch,
+                     size_t n, const Encoder& encode, unsigned bits) {
+	const unsigned digit = n >= _RADIX_WIDE_DIGIT_THRESHOLD && bits > 16 ? 11 : 8;
+	const size_t   radix = size_t(1) << digit;
+	const size_t   mask = radix - 1;
+	const unsigned passes = (bits + digit - 1) / digit;
+
+	_temporary_buffer<size_t> histogram(passes * radix);
+	size_t*                   counts = histogram.data();
+	memset(counts, 0, passes * radix * sizeof(size_t));
+	for (size_t i = 0; i < n; ++i) {
+		typename Encoder::type key = encode(*(data + i));
+		for (unsigned pass = 0; pass < passes; ++pass)
+			++counts[pass * radix + (static_cast<size_t>(key >> (pass * digit)) & mask)];
+	}
+
+	bool in_scratch = false;
+	for (unsigned pass = 0; pass < passes; ++pass) {
+		size_t* count = counts + pass * radix;
+		bool    trivial = false;
+		size_t  sum = 0;
+		for (size_t d = 0; d < radix; ++d) {
+			size_t items = count[d];
+			trivial = trivial || items == n;
+			count[d] = sum;
+			sum += items;
+		}
+		if (trivial)
+			continue;
+
+		if (in_scratch)
+			_radix_scatter(scratch, n, data, count, encode, pass * digit, mask);
+		else
+			_radix_scatter(data, n, scratch, count, encode, pass * digit, mask);
+		in_scratch = !in_scratch;
+	}
+	return in_scratch;
+}
+
+// 原地 MSD 基数排序，每次处理 8 位，按低 bits 位排序
+// 依次将各桶首个错位元素沿置换环放入目标桶
+template <class RandomAccessIterator, class Encoder>
+void _american_flag_sort(RandomAccessIterator first, RandomAccessIterator last,
+                         const Encoder& encode, unsigned bits) {
+	typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+
+	size_t n = static_cast<size_t>(last - first);
+	if (n < _RADIX_INSERTION_THRESHOLD) {
+		_insertion_sort(first, last, [&](const T& a, const T& b) {
+			return encode(a) < encode(b);
+		});
+		return;
+	}
+
+	size_t   count[256];
+	unsigned shift = bits > 8 ? bits - 8 : 0;
+	while (true) {
+		memset(count, 0, sizeof(count));
+		for (RandomAccessIterator it = first; it != last; ++it)
+			++count[static_cast<size_t>(encode(*it) >> shift) & 0xff];
+		if (count[static_cast<size_t>(encode(*first) >> shift) & 0xff] != n)
+			break;
+		if (shift == 0)
+			return;
+		shift = shift > 8 ? shift - 8 : 0;
+	}
+
+	size_t head[256], tail[256];
+	size_t sum = 0;
+	for (size_t d = 0; d < 256; ++d) {
+		head[d] = sum;
+		sum += count[d];
+		tail[d] = sum;
+	}
+
+	for (size_t bucket = 0; bucket < 256; ++bucket) {
+		while (head[bucket] < tail[bucket]) {
+			T      value = std::move(*(first + head[bucket]));
+			size_t d = static_cast<size_t>(encode(value) >> shift) & 0xff;
+			while (d != bucket) {
+				std::swap(value, *(first + head[d]++));
+				d = static_cast<size_t>(encode(value) >> shift) & 0xff;
+			}
+			*(first + head[bucket]++) = std::move(value);
+		}
+	}
+
+	if (shift == 0)
+		return;
+	for (size_t bucket = 0, begin = 0; bucket < 256; begin = tail[bucket++])
+		if (tail[bucket] - begin > 1)
+			_american_flag_sort(first + begin, first + tail[bucket], encode,
+			                    shift);
+}
+
+// 以 func(i) 处理 [0, count)，pool 为空时串行执行
+template <class Func>
+void _radix_for_each(thread_pool* pool, size_t count, Func&& func) {
+	if (pool == nullptr) {
+		for (size_t i = 0; i < count; ++i)
+			func(i);
+		return;
+	}
+	pool->parallel_for(0, count, 1, [&](size_t i, size_t) { func(i); });
+}
+
+// MSD + LSD: 先按最高非平凡 8 位分桶至暂存区，各桶数据量可驻留缓存后再排序剩余低位
+// 较大的桶以暂存区为数据、原区间为辅助 LSD 排序，较小的桶移回后原地排序
+// pool 非空时分段计数、移动以及各桶排序均并行执行
+// 串行时若最大的桶超过 1/8 (如浮点数指数集中)，分桶无助于缓存局部性，返回 false 且不移动元素
+template <class RandomAccessIterator, class Encoder>
+bool _radix_sort_msd(RandomAccessIterator first, size_t n,
+                     const Encoder& encode, thread_pool* pool) {
+	typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+	typedef typename Encoder::type                                     U;
+
+	const size_t blocks = pool == nullptr ? 1 : pool->concurrency();
+
+	// 与首元素键按位异或求或，最高的非零位即最高的非平凡位
+	const U              pivot = encode(*first);
+	_temporary_buffer<U> block_diffs(blocks);
+	U*                   diffs = block_diffs.data();
+	_radix_for_each(pool, blocks, [&](size_t block) {
+		size_t begin = _block_bound(n, blocks, block);
+		size_t end = _block_bound(n, blocks, block + 1);
+		U      diff = 0;
+		for (size_t i = begin; i < end; ++i)
+			diff |= encode(*(first + i)) ^ pivot;
+		diffs[block] = diff;
+	});
+	U diff = 0;
+	for (size_t block = 0; block < blocks; ++block)
+		diff |= diffs[block];
+	if (diff == 0)
+		return true;
+
+	const unsigned high = static_cast<unsigned>(mSTL::bit_width(diff));
+	const unsigned shift = high > 8 ? high - 8 : 0;
+
+	// 各段计数，桶优先求前缀和得到各段各桶的写入位置
+	_temporary_buffer<size_t> offsets(blocks * 256);
+	_temporary_buffer<size_t> bucket_bounds(257);
+	size_t*                   offset = offsets.data();
+	size_t*                   bound = bucket_bounds.data();
+	memset(offset, 0, blocks * 256 * sizeof(size_t));
+
+	_radix_for_each(pool, blocks, [&](size_t block) {
+		size_t  begin = _block_bound(n, blocks, block);
+		size_t  end = _block_bound(n, blocks, block + 1);
+		size_t* count_of = offset + block * 256;
+		for (size_t i = begin; i < end; ++i)
+			++count_of[static_cast<size_t>(encode(*(first + i)) >> shift) & 0xff];
+	});
+
+	size_t position = 0, largest = 0;
+	for (size_t bucket = 0; bucket < 256; ++bucket) {
+		bound[bucket] = position;
+		for (size_t block = 0; block < blocks; ++block) {
+			size_t items = offset[block * 256 + bucket];
+			offset[block * 256 + bucket] = position;
+			position += items;
+		}
+		if (position - bound[bucket] > largest)
+			largest = position - bound[bucket];
+	}
+	bound[256] = n;
+	if (pool == nullptr && largest > n / 8)
+		return false;
+
+	_temporary_buffer<T> buffer(n);
+	_radix_for_each(pool, blocks, [&](size_t block) {
+		size_t  begin = _block_bound(n, blocks, block);
+		size_t  end = _block_bound(n, blocks, block + 1);
+		size_t* position_of = offset + block * 256;
+		for (size_t i = begin; i < end; ++i) {
+			size_t bucket =
+			    static_cast<size_t>(encode(*(first + i)) >> shift) & 0xff;
+			allocator<T>::construct(buffer.data() + position_of[bucket]++,
+			                        std::move(*(first + i)));
+		}
+	});
+
+	_radix_for_each(pool, 256, [&](size_t bucket) {
+		size_t begin = bound[bucket], end = bound[bucket + 1];
+		T*     scratch = buffer.data();
+		try {
+			if (end - begin >= _RADIX_LSD_THRESHOLD && shift > 0) {
+				if (!_radix_sort_lsd(scratch + begin, first + begin, end - begin,
+				                     encode, shift))
+					mSTL::move(scratch + begin, scratch + end, first + begin);
+				buffer.destroy(begin, end);
+				return;
+			}
+			mSTL::move(scratch + begin, scratch + end, first + begin);
+		} catch (...) {
+			buffer.destroy(begin, end);
+			throw;
+		}
+		buffer.destroy(begin, end);
+		if (shift > 0)
+			_american_flag_sort(first + begin, first + end, encode, shift);
+	});
+	return true;
+}
+
+template <class RandomAccessIterator, class Encoder>
+void _radix_sort_aux(RandomAccessIterator first, size_t n,
+                     const Encoder& encode, unsigned bits) {
+	typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+
+	if (n < _RADIX_LSD_THRESHOLD) {
+		_american_flag_sort(first, first + n, encode, bits);
+		return;
+	}
+	if (n >= _RADIX_MSD_THRESHOLD && bits > 16 &&
+	    _radix_sort_msd(first, n, encode, nullptr))
+		return;
+
+	_temporary_buffer<T> buffer(n);
+	buffer.construct(0, n, first);
+	try {
+		if (_radix_sort_lsd(first, buffer.data(), n, encode, bits))
+			mSTL::move(buffer.data(), buffer.data() + n, first);
+	} catch (...) {
+		buffer.destroy(0, n);
+		throw;
+	}
+	buffer.destroy(0, n);
+}
+
+//------------------ radix_sort ------------------
+template <class RandomAccessIterator, class KeyFunction>
+void radix_sort(RandomAccessIterator first, RandomAccessIterator last,
+                KeyFunction key_fn) {
+	typedef typename std::decay<decltype(key_fn(*first))>::type Key;
+	typedef _radix_encoder<Key, KeyFunction>                      Encoder;
+
+	if (last - first < 2)
+		return;
+	Encoder encode = {key_fn};
+	_radix_sort_aux(first, static_cast<size_t>(last - first), encode,
+	                sizeof(typename Encoder::type) * 8);
+}
+
+template <class RandomAccessIterator>
+void radix_sort(RandomAccessIterator first, RandomAccessIterator last) {
+	mSTL::radix_sort(first, last, _radix_identity());
+}
+
+template <class RandomAccessIterator, class KeyFunction>
+void radix_sort(const parallel_policy&, RandomAccessIterator first,
+                RandomAccessIterator last, KeyFunction key_fn) {
+	typedef typename std::decay<decltype(key_fn(*first))>::type Key;
+	typedef _radix_encoder<Key, KeyFunction>                      Encoder;
+
+	thread_pool& pool = thread_pool::instance();
+	if (last - first < _PARALLEL_SORT_THRESHOLD || pool.concurrency() == 1) {
+		mSTL::radix_sort(first, last, key_fn);
+		return;
+	}
+	Encoder encode = {key_fn};
+	_radix_sort_msd(first, static_cast<size_t>(last - first), encode, &pool);
+}
+
+template <class RandomAccessIterator>
+void radix_sort(const parallel_policy& policy, RandomAccessIterator first,
+                RandomAccessIterator last) {
+	mSTL::radix_sort(policy, first, last, _radix_identity());
+}
+
+///<- selection series
+// nth_element(): 内省选择，*nth 为排序后应处的元素，左侧不大于、右侧不小于它  O(N)
+//   以三数 / 九数中值为枢轴划分，不平衡划分累计 log2(N) 次后改用中位数的中位数，保证最坏 O(N)
+// partial_sort(): [first, middle) 为最小的 middle - first 个元素并升序排列
+//   k 相对 N 较小时用堆选择  O(NlogK)，否则内省选择后排序前 k 个  O(N + KlogK)
+// partial_sort_copy(): 单遍扫描输入，在 [result_first, result_last) 上维护大顶堆  O(NlogK)
+// top_k(): 单遍扫描，[first, first + k) 上维护 k 个元素的小顶堆，结果按 comp 降序排列  O(NlogK)
+//   原地重排 [first, last)，不保留输入顺序；需保留输入时使用 partial_sort_copy
+//   连续算术类型且比较器为 std::less / std::greater 时，以 SIMD 跳过不超过堆顶的元素
+
+enum {
+	_SELECT_INSERTION_THRESHOLD = 16,
+	_SELECT_MEDIAN_GROUP = 5,
+	_PARTIAL_SORT_HEAP_RATIO = 16
+};
+
+template <class Compare>
+struct _reverse_compare {
+	Compare comp;
+
+	template <class T1, class T2>
+	bool operator()(const T1& a, const T2& b) const {
+		return comp(b, a);
+	}
+};
+
+// 堆选择中替换堆顶的条件 comp(x, top)，反转的比较器对应相反的扫描方向
+template <class T>
+struct _scan_op<_reverse_compare<std::less<T>>, T>
+    : std::integral_constant<int, simd::op_gt> {};
+template <class T>
+struct _scan_op<_reverse_compare<std::greater<T>>, T>
+    : std::integral_constant<int, simd::op_lt> {};
+
+// [first, middle) 建大顶堆后扫描 [middle, last)，小于堆顶者与堆顶交换并下沉
+// 被换出的元素留在原位置，整个区间始终是输入的一个排列
+template <class RandomAccessIterator, class Compare>
+void _heap_select(RandomAccessIterator first, RandomAccessIterator middle,
+                  RandomAccessIterator last, Compare comp, _false_type) {
+	typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+	typedef typename iterator_traits<RandomAccessIterator>::difference_type
+	    Distance;
+
+	_make_heap(first, middle, comp);
+	const Distance len = middle - first;
+	for (RandomAccessIterator i = middle; i < last; ++i) {
+		if (comp(*i, *first)) {
+			T value = std::move(*i);
+			*i = std::move(*first);
+			_adjust_heap(first, Distance(0), len, std::move(value), comp);
+		}
+	}
+}
+
+// 堆顶只会单调变化，以向量比较批量跳过不会进入堆的元素
+template <class T, class Compare>
+void _heap_select(T* first, T* middle, T* last, Compare comp, _true_type) {
+	_make_heap(first, middle, comp);
+	const ptrdiff_t len = middle - first;
+	for (T* i = middle; i < last; ++i) {
+		const size_t rest = static_cast<size_t>(last - i);
+		i += simd::find_value<_scan_op<Compare, T>::value>(i, rest, *first);
+		if (i == last)
+			break;
+		T value = *i;
+		*i = *first;
+		_adjust_heap(first, ptrdiff_t(0), len, value, comp);
+	}
+}
+
+template <class RandomAccessIterator, class Compare>
+inline void _heap_select(RandomAccessIterator first, RandomAccessIterator middle,
+                         RandomAccessIterator last, Compare comp) {
+	typedef typename _is_scannable<RandomAccessIterator, Compare>::type
+	    isScannable;
+	_heap_select(first, middle, last, comp, isScannable());
+}
+
+// 以 *first 为枢轴的 Hoare 划分，两侧遇到等于枢轴的元素均停下，大量重复元素时仍能均分
+// 返回枢轴最终位置 cut: [first, cut) 不大于枢轴，(cut, last) 不小于枢轴
+template <class RandomAccessIterator, class Compare>
+RandomAccessIterator _select_partition(RandomAccessIterator first,
+                                       RandomAccessIterator last,
+                                       Compare comp) {
+	RandomAccessIterator i = first;
+	RandomAccessIterator j = last;
+	for (;;) {
+		while (++i != last && comp(*i, *first))
+			;
+		while (comp(*first, *--j))
+			;
+		if (i >= j)
+			break;
+		std::iter_swap(i, j);
+	}
+	if (j != first)
+		std::iter_swap(first, j);
+	return j;
+}
+
+template <class RandomAccessIterator, class Compare>
+void _introselect(RandomAccessIterator first, RandomAccessIterator nth,
+                  RandomAccessIterator last, Compare comp, int bad_allowed);
+
+// 每 5 个元素一组取中值移至区间前部，再线性选择这些中值的中值，返回其位置
+template <class RandomAccessIterator, class Compare>
+RandomAccessIterator _median_of_medians(RandomAccessIterator first,
+                                        RandomAccessIterator last,
+                                        Compare comp) {
+	typedef typename iterator_traits<RandomAccessIterator>::difference_type
+	    Distance;
+
+	const Distance       group = _SELECT_MEDIAN_GROUP;
+	RandomAccessIterator medians = first;
+	for (RandomAccessIterator i = first; last - i >= group; i += group) {
+		_insertion_sort(i, i + group, comp);
+		std::iter_swap(medians++, i + group / 2);
+	}
+	RandomAccessIterator pivot = first + (medians - first) / 2;
+	_introselect(first, pivot, medians, comp, 0);
+	return pivot;
+}
+
+// bad_allowed 耗尽后每轮都以中位数的中位数为枢轴，两侧至少各有约 3/10 的元素
+template <class RandomAccessIterator, class Compare>
+void _introselect(RandomAccessIterator first, RandomAccessIterator nth,
+                  RandomAccessIterator last, Compare comp, int bad_allowed) {
+	typedef typename iterator_traits<RandomAccessIterator>::difference_type
+	    Distance;
+
+	while (last - first > _SELECT_INSERTION_THRESHOLD) {
+		const Distance size = last - first;
+		if (bad_allowed <= 0) {
+			std::iter_swap(first, _median_of_medians(first, last, comp));
+		} else {
+			const Distance s2 = size / 2;
+			if (size > _SORT_NINTHER_THRESHOLD) {
+				_sort3(first, first + s2, last - 1, comp);
+				_sort3(first + 1, first + (s2 - 1), last - 2, comp);
+				_sort3(first + 2, first + (s2 + 1), last - 3, comp);
+				_sort3(first + (s2 - 1), first + s2, first + (s2 + 1), comp);
+				std::iter_swap(first, first + s2);
+			} else {
+				_sort3(first + s2, first, last - 1, comp);
+			}
+		}
+
+		RandomAccessIterator cut = _select_partition(first, last, comp);
+		if (cut == nth)
+			return;
+
+		const Distance l_size = cut - first;
+		const Distance r_size = last - (cut + 1);
+		if ((l_size < r_size ? l_size : r_size) < size / 8)
+			--bad_allowed;
+
+		if (nth < cut)
+			last = cut;
+		else
+			first = cut + 1;
+	}
+	_insertion_sort(first, last, comp);
+}
+
+//-------------------- nth_element ----------------------
+template <class RandomAccessIterator, class Compare>
+void nth_element(RandomAccessIterator first, RandomAccessIterator nth,
+                 RandomAccessIterator last, Compare comp) {
+	if (nth == last || last - first < 2)
+		return;
+	_introselect(first, nth, last, comp, _sort_log2(last - first));
+}
+
+template <class RandomAccessIterator>
+void nth_element(RandomAccessIterator first, RandomAccessIterator nth,
+                 RandomAccessIterator last) {
+	typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+	mSTL::nth_element(first, nth, last, std::less<T>());
+}
+
+//-------------------- partial_sort ----------------------
+template <class RandomAccessIterator, class Compare>
+void partial_sort(RandomAccessIterator first, RandomAccessIterator middle,
+                  RandomAccessIterator last, Compare comp) {
+	if (first == middle)
+		return;
+	if ((middle - first) * _PARTIAL_SORT_HEAP_RATIO <= last - first) {
+		_heap_select(first, middle, last, comp);
+		_sort_heap(first, middle, comp);
+		return;
+	}
+	if (middle != last)
+		mSTL::nth_element(first, middle, last, comp);
+	mSTL::sort(first, middle, comp);
+}
+
+template <class RandomAccessIterator>
+void partial_sort(RandomAccessIterator first, RandomAccessIterator middle,
+                  RandomAccessIterator last) {
+	typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+	mSTL::partial_sort(first, middle, last, std::less<T>());
+}
+
+//-------------------- partial_sort_copy ----------------------
+template <class InputIterator, class RandomAccessIterator, class Compare>
+RandomAccessIterator
+partial_sort_copy(InputIterator first, InputIterator last,
+                  RandomAccessIterator result_first,
+                  RandomAccessIterator result_last, Compare comp) {
+	typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+	typedef typename iterator_traits<RandomAccessIterator>::difference_type
+	    Distance;
+
+	RandomAccessIterator result_real_last = result_first;
+	while (first != last && result_real_last != result_last) {
+		*result_real_last = *first;
+		++result_real_last;
+		++first;
+	}
+	if (result_real_last == result_first)
+		return result_real_last;
+
+	_make_heap(result_first, result_real_last, comp);
+	const Distance len = result_real_last - result_first;
+	for (; first != last; ++first)
+		if (comp(*first, *result_first))
+			_adjust_heap(result_first, Distance(0), len, T(*first), comp);
+	_sort_heap(result_first, result_real_last, comp);
+	return result_real_last;
+}
+
+template <class InputIterator, class RandomAccessIterator>
+RandomAccessIterator
+partial_sort_copy(InputIterator first, InputIterator last,
+                  RandomAccessIterator result_first,
+                  RandomAccessIterator result_last) {
+	typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+	return mSTL::partial_sort_copy(first, last, result_first, result_last,
+	                               std::less<T>());
+}
+
+//-------------------- top_k ----------------------
+// 返回 first + min(k, N)，[first, first + k) 为按 comp 最大的 k 个元素且最大者在前
+// [first, last) 被原地重排，其余元素位于 [first + k, last) 且顺序未指定
+template <class RandomAccessIterator, class Compare>
+RandomAccessIterator top_k(RandomAccessIterator first, RandomAccessIterator last,
+                           size_t k, Compare comp) {
+	typedef typename iterator_traits<RandomAccessIterator>::difference_type
+	    Distance;
+
+	_reverse_compare<Compare> reversed = {comp};
+	if (k >= static_cast<size_t>(last - first)) {
+		mSTL::sort(first, last, reversed);
+		return last;
+	}
+	RandomAccessIterator middle = first + static_cast<Distance>(k);
+	if (k > 0) {
+		_heap_select(first, middle, last, reversed);
+		_sort_heap(first, middle, reversed);
+	}
+	return middle;
+}
+
+template <class RandomAccessIterator>
+RandomAccessIterator top_k(RandomAccessIterator first, RandomAccessIterator last,
+                           size_t k) {
+	typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+	return mSTL::top_k(first, last, k, std::less<T>());
+}
+
+//<- Binary search operations(on sorted ranges)
+// lower_bound(): 首个不小于 value 的位置  O(logN)
+// upper_bound(): 首个大于 value 的位置  O(logN)
+// equal_range(): [lower_bound, upper_bound)  O(logN)
+// binary_search(): 是否存在与 value 等价的元素  O(logN)
+// lower_bound_many(): 对一组键分别求 lower_bound，结果依次写入 result  O(KlogN)
+//
+// 随机访问迭代器使用无分支二分: 每步以条件传送选择一半，循环次数只取决于 N，
+// 不产生分支预测失败；批量版本令 _SEARCH_BATCH 个查找同步推进，
+// 连续内存上预取下一步的两个候选位置，多个缓存缺失并行等待
+// eytzinger_index: 有序数据按 BFS (Eytzinger) 顺序重排，见下方说明
+
+///<- search helpers
+enum { _SEARCH_BATCH = 8, _SEARCH_CACHELINE_SIZE = 64 };
+
+inline void _prefetch(const void* address) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+	__builtin_prefetch(address);
+#else
+	(void)address;
+#endif
+}
+
+constexpr size_t _floor_power_of_two(size_t x) {
+	return x < 2 ? 1 : 2 * _floor_power_of_two(x / 2);
+}
+
+// 只对连续内存预取，其他迭代器解引用的代价可能高于预取收益
+template <class T>
+inline void _prefetch_at(T* p) noexcept {
+	_prefetch(p);
+}
+
+template <class Iterator>
+inline void _prefetch_at(const Iterator&) noexcept {}
+
+//-------------------- lower_bound ----------------------
+template <class ForwardIterator, class T, class Compare>
+ForwardIterator _lower_bound_aux(ForwardIterator first, ForwardIterator last,
+                                 const T& value, Compare comp,
+                                 forward_iterator_tag) {
+	typedef typename iterator_traits<ForwardIterator>::difference_type Distance;
+
+	Distance len = 0;
+	mSTL::distance(first, last, len);
+	while (len > 0) {
+		Distance        half = len / 2;
+		ForwardIterator middle = first;
+		mSTL::advance(middle, half);
+		if (comp(*middle, value)) {
+			first = ++middle;
+			len -= half + 1;
+		} else {
+			len = half;
+		}
+	}
+	return first;
+}
+
+// 不变式: 结果位于 [first, first + len]
+template <class RandomAccessIterator, class T, class Compare>
+RandomAccessIterator _lower_bound_aux(RandomAccessIterator first,
+                                      RandomAccessIterator last, const T& value,
+                                      Compare comp, random_access_iterator_tag) {
+	typedef typename iterator_traits<RandomAccessIterator>::difference_type
+	    Distance;
+
+	Distance len = last - first;
+	if (len == 0)
+		return first;
+	while (len > 1) {
+		const Distance half = len / 2;
+		first = comp(*(first + half), value) ? first + half : first;
+		len -= half;
+	}
+	return comp(*first, value) ? first + 1 : first;
+}
+
+template <class ForwardIterator, class T, class Compare>
+ForwardIterator lower_bound(ForwardIterator first, ForwardIterator last,
+                            const T& value, Compare comp) {
+	return _lower_bound_aux(first, last, value, comp, iterator_category(first));
+}
+
+template <class ForwardIterator, class T>
+ForwardIterator lower_bound(ForwardIterator first, ForwardIterator last,
+                            const T& value) {
+	typedef typename iterator_traits<ForwardIterator>::value_type value_type;
+	return mSTL::lower_bound(first, last, value, std::less<value_type>());
+}
+
+//-------------------- upper_bound ----------------------
+template <class ForwardIterator, class T, class Compare>
+ForwardIterator _upper_bound_aux(ForwardIterator first, ForwardIterator last,
+                                 const T& value, Compare comp,
+                                 forward_iterator_tag) {
+	typedef typename iterator_traits<ForwardIterator>::difference_type Distance;
+
+	Distance len = 0;
+	mSTL::distance(first, last, len);
+	while (len > 0) {
+		Distance        half = len / 2;
+		ForwardIterator middle = first;
+		mSTL::advance(middle, half);
+		if (!comp(value, *middle)) {
+			first = ++middle;
+			len -= half + 1;
+		} else {
+			len = half;
+		}
+	}
+	return first;
+}
+
+template <class RandomAccessIterator, class T, class Compare>
+RandomAccessIterator _upper_bound_aux(RandomAccessIterator first,
+                                      RandomAccessIterator last, const T& value,
+                                      Compare comp, random_access_iterator_tag) {
+	typedef typename iterator_traits<RandomAccessIterator>::difference_type
+	    Distance;
+
+	Distance len = last - first;
+	if (len == 0)
+		return first;
+	while (len > 1) {
+		const Distance half = len / 2;
+		first = !comp(value, *(first + half)) ? first + half : first;
+		len -= half;
+	}
+	return !comp(value, *first) ? first + 1 : first;
+}
+
+template <class ForwardIterator, class T, class Compare>
+ForwardIterator upper_bound(ForwardIterator first, ForwardIterator last,
+                            const T& value, Compare comp) {
+	return _upper_bound_aux(first, last, value, comp, iterator_category(first));
+}
+
+template <class ForwardIterator, class T>
+ForwardIterator upper_bound(ForwardIterator first, ForwardIterator last,
+                            const T& value) {
+	typedef typename iterator_traits<ForwardIterator>::value_type value_type;
+	return mSTL::upper_bound(first, last, value, std::less<value_type>());
+}
+
+//-------------------- equal_range ----------------------
+template <class ForwardIterator, class T, class Compare>
+std::pair<ForwardIterator, ForwardIterator>
+equal_range(ForwardIterator first, ForwardIterator last, const T& value,
+            Compare comp) {
+	first = mSTL::lower_bound(first, last, value, comp);
+	return std::make_pair(first, mSTL::upper_bound(first, last, value, comp));
+}
+
+template <class ForwardIterator, class T>
+std::pair<ForwardIterator, ForwardIterator>
+equal_range(ForwardIterator first, ForwardIterator last, const T& value) {
+	typedef typename iterator_traits<ForwardIterator>::value_type value_type;
+	return mSTL::equal_range(first, last, value, std::less<value_type>());
+}
+
+//-------------------- binary_search ----------------------
+template <class ForwardIterator, class T, class Compare>
+bool binary_search(ForwardIterator first, ForwardIterator last, const T& value,
+                   Compare comp) {
+	first = mSTL::lower_bound(first, last, value, comp);
+	return first != last && !comp(value, *first);
+}
+
+template <class ForwardIterator, class T>
+bool binary_search(ForwardIterator first, ForwardIterator last,
+                   const T& value) {
+	typedef typename iterator_traits<ForwardIterator>::value_type value_type;
+	return mSTL::binary_search(first, last, value, std::less<value_type>());
+}
+
+//-------------------- lower_bound_many ----------------------
+// 每组 _SEARCH_BATCH 个键同步二分，各查找的区间长度序列相同，只有起点不同
+template <class RandomAccessIterator, class ForwardIterator,
+          class OutputIterator, class Compare>
+OutputIterator lower_bound_many(RandomAccessIterator first,
+                                RandomAccessIterator last,
+                                ForwardIterator keys_first,
+                                ForwardIterator keys_last,
+                                OutputIterator result, Compare comp) {
+	typedef typename iterator_traits<RandomAccessIterator>::difference_type
+	    Distance;
+
+	const Distance len = last - first;
+	while (keys_first != keys_last) {
+		ForwardIterator      keys[_SEARCH_BATCH];
+		RandomAccessIterator bases[_SEARCH_BATCH];
+		size_t               count = 0;
+		for (; count < _SEARCH_BATCH && keys_first != keys_last; ++keys_first) {
+			keys[count] = keys_first;
+			bases[count++] = first;
+		}
+
+		if (len > 0) {
+			for (Distance n = len; n > 1;) {
+				const Distance half = n / 2;
+				n -= half;
+				for (size_t i = 0; i < count; ++i) {
+					bases[i] = comp(*(bases[i] + half), *keys[i]) ? bases[i] + half
+					                                              : bases[i];
+					_prefetch_at(bases[i] + n / 2);
+					_prefetch_at(bases[i] + (n / 2 + n / 2));
+				}
+			}
+			for (size_t i = 0; i < count; ++i)
+				if (comp(*bases[i], *keys[i]))
+					++bases[i];
+		}
+		for (size_t i = 0; i < count; ++i) {
+			*result = bases[i];
+			++result;
+		}
+	}
+	return result;
+}
+
+template <class RandomAccessIterator, class ForwardIterator,
+          class OutputIterator>
+OutputIterator lower_bound_many(RandomAccessIterator first,
+                                RandomAccessIterator last,
+                                ForwardIterator keys_first,
+                                ForwardIterator keys_last,
+                                OutputIterator result) {
+	typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+	return mSTL::lower_bound_many(first, last, keys_first, keys_last, result,
+	                              std::less<T>());
+}
+
+///<- eytzinger index
+// eytzinger_index
+// 有序数据按 BFS 顺序存放: 下标从 1 开始，节点 k 的子节点为 2k 与 2k + 1
+// 查找路径上的前几层集中在少数缓存行内，且节点 k 往下 4 层 (int) 的 16 个后代连续存放，
+// 每步预取 k * B (B 个元素恰好占满一个缓存行) 可提前 log2(B) 层取回数据
+// 查找为固定次数的无分支循环，最后由 k 的二进制尾部 1 的个数还原出结果节点
+// 迭代顺序为 BFS 顺序而非有序顺序
+template <class T, class Compare = std::less<T>>
+class eytzinger_index {
+public:
+	typedef T           value_type;
+	typedef const T*    const_iterator;
+	typedef const T&    const_reference;
+	typedef size_t      size_type;
+	typedef Compare     value_compare;
+
+private:
+	// 预取步长: 不超过一个缓存行的最大 2 的幂个元素
+	enum : size_type {
+		PREFETCH_STRIDE = _floor_power_of_two(_SEARCH_CACHELINE_SIZE / sizeof(T))
+	};
+
+	unsigned char* storage_;
+	size_type      bytes_;
+	T*             data_; // data_[1 .. size_]
+	size_type      size_;
+	Compare        comp_;
+
+public:
+	eytzinger_index() noexcept
+	    : storage_(nullptr)
+	    , bytes_(0)
+	    , data_(nullptr)
+	    , size_(0)
+	    , comp_() {}
+
+	// [first, last) 须按 comp 有序
+	template <class ForwardIterator>
+	eytzinger_index(ForwardIterator first, ForwardIterator last,
+	                const Compare& comp = Compare())
+	    : storage_(nullptr)
+	    , bytes_(0)
+	    , data_(nullptr)
+	    , size_(0)
+	    , comp_(comp) {
+		ptrdiff_t n = 0;
+		mSTL::distance(first, last, n);
+		if (n == 0)
+			return;
+		allocate(static_cast<size_type>(n));
+
+		// 中序遍历隐式完全二叉树即为有序顺序，依次构造
+		size_type k = first_inorder();
+		size_type constructed = 0;
+		try {
+			for (; first != last; ++first, ++constructed) {
+				allocator<T>::construct(data_ + k, T(*first));
+				k = next_inorder(k);
+			}
+		} catch (...) {
+			k = first_inorder();
+			for (size_type i = 0; i < constructed; ++i, k = next_inorder(k))
+				allocator<T>::destroy(data_ + k);
+			deallocate();
+			throw;
+		}
+	}
+
+	eytzinger_index(const eytzinger_index&) = delete;
+	eytzinger_index& operator=(const eytzinger_index&) = delete;
+
+	eytzinger_index(eytzinger_index&& other) noexcept
+	    : storage_(other.storage_)
+	    , bytes_(other.bytes_)
+	    , data_(other.data_)
+	    , size_(other.size_)
+	    , comp_(other.comp_) {
+		other.storage_ = nullptr;
+		other.bytes_ = 0;
+		other.data_ = nullptr;
+		other.size_ = 0;
+	}
+
+	eytzinger_index& operator=(eytzinger_index&& other) noexcept {
+		if (this != &other) {
+			clear();
+			storage_ = other.storage_;
+			bytes_ = other.bytes_;
+			data_ = other.data_;
+			size_ = other.size_;
+			comp_ = other.comp_;
+			other.storage_ = nullptr;
+			other.bytes_ = 0;
+			other.data_ = nullptr;
+			other.size_ = 0;
+		}
+		return *this;
+	}
+
+	~eytzinger_index() { clear(); }
+
+	const_iterator begin() const noexcept { return data_ + 1; }
+	const_iterator end() const noexcept { return data_ + size_ + 1; }
+	size_type      size() const noexcept { return size_; }
+	bool           empty() const noexcept { return size_ == 0; }
+
+	void clear() noexcept {
+		if (size_ != 0)
+			allocator<T>::destroy(data_ + 1, data_ + size_ + 1);
+		deallocate();
+	}
+
+	// 首个不小于 key 的元素，不存在时返回 end()
+	template <class Key>
+	const_iterator lower_bound(const Key& key) const {
+		size_type k = 1;
+		while (k <= size_) {
+			_prefetch(data_ + k * PREFETCH_STRIDE);
+			k = 2 * k + static_cast<size_type>(comp_(data_[k], key));
+		}
+		return node(k);
+	}
+
+	template <class Key>
+	bool contains(const Key& key) const {
+		const_iterator it = lower_bound(key);
+		return it != end() && !comp_(key, *it);
+	}
+
+	// 每组 _SEARCH_BATCH 个键同步下降，结果 (const_iterator) 依次写入 result
+	template <class ForwardIterator, class OutputIterator>
+	OutputIterator lower_bound_many(ForwardIterator keys_first,
+	                                ForwardIterator keys_last,
+	                                OutputIterator  result) const {
+		const int depth = mSTL::bit_width(size_);
+		while (keys_first != keys_last) {
+			ForwardIterator keys[_SEARCH_BATCH];
+			size_type       nodes[_SEARCH_BATCH];
+			size_t          count = 0;
+			for (; count < _SEARCH_BATCH && keys_first != keys_last;
+			     ++keys_first) {
+				keys[count] = keys_first;
+				nodes[count++] = 1;
+			}
+
+			// 叶节点位于最后两层，最后一轮部分查找已越过 size_
+			for (int level = 0; level < depth; ++level) {
+				for (size_t i = 0; i < count; ++i) {
+					const size_type k = nodes[i];
+					if (k <= size_) {
+						_prefetch(data_ + k * PREFETCH_STRIDE);
+						nodes[i] =
+						    2 * k + static_cast<size_type>(comp_(data_[k], *keys[i]));
+					}
+				}
+			}
+			for (size_t i = 0; i < count; ++i) {
+				*result = node(nodes[i]);
+				++result;
+			}
+		}
+		return result;
+	}
+
+private:
+	// 下降结束时 k 的二进制为 结果节点 + 0 + 若干个 1 (结果之后一路向右)
+	const_iterator node(size_type k) const noexcept {
+		k >>= mSTL::countr_zero(~static_cast<unsigned long long>(k)) + 1;
+		return k == 0 ? end() : data_ + k;
+	}
+
+	size_type first_inorder() const noexcept {
+		size_type k = 1;
+		while (2 * k <= size_)
+			k *= 2;
+		return k;
+	}
+
+	size_type next_inorder(size_type k) const noexcept {
+		if (2 * k + 1 <= size_) {
+			k = 2 * k + 1;
+			while (2 * k <= size_)
+				k *= 2;
+		} else {
+			while (k & 1)
+				k >>= 1;
+			k >>= 1;
+		}
+		return k;
+	}
+
+	// 多分配一个缓存行，使 data_ 按缓存行对齐，各组后代不跨行
+	void allocate(size_type n) {
+		bytes_ = (n + 1) * sizeof(T) + _SEARCH_CACHELINE_SIZE;
+		storage_ = allocator<unsigned char>::allocate(bytes_);
+		uintptr_t address = reinterpret_cast<uintptr_t>(storage_);
+		address = (address + _SEARCH_CACHELINE_SIZE - 1) &
+		          ~static_cast<uintptr_t>(_SEARCH_CACHELINE_SIZE - 1);
+		data_ = reinterpret_cast<T*>(address);
+		size_ = n;
+	}
+
+	void deallocate() noexcept {
+		if (storage_ != nullptr)
+			allocator<unsigned char>::deallocate(storage_, bytes_);
+		storage_ = nullptr;
+		bytes_ = 0;
+		data_ = nullptr;
+		size_ = 0;
+	}
+};
+
+//<- Other operations on sorted ranges
+// merge(): 合并两个有序区间，相等元素中第一个区间的在前 (稳定)  O(N1 + N2)
+// multiway_merge(): 以败者树合并 k 个有序区间，相等元素按区间顺序输出 (稳定)  O(NlogK)
+//
+// merge 与下方集合操作在两侧均为随机访问迭代器且长度相差 _SET_GALLOP_RATIO 倍以上时，
+// 较长一侧以倍增 (galloping) 查找整段跳过或整段复制，比较次数降为 O(N_small * log(N_large / N_small))
+
+///<- galloping helpers
+enum { _SET_GALLOP_RATIO = 16 };
+
+// pred(x) 为 comp(x, value)，满足 pred 的前缀即 lower_bound 之前的元素
+template <class Compare, class T>
+struct _less_than_value {
+	Compare  comp;
+	const T& value;
+
+	template <class U>
+	bool operator()(const U& x) const {
+		return comp(x, value);
+	}
+};
+
+// pred(x) 为 !comp(value, x)，满足 pred 的前缀即 upper_bound 之前的元素
+template <class Compare, class T>
+struct _not_greater_than_value {
+	Compare  comp;
+	const T& value;
+
+	template <class U>
+	bool operator()(const U& x) const {
+		return !comp(value, x);
+	}
+};
+
+// 依次检查 first + 1, 3, 7, 15 ... 直至越过满足 pred 的前缀，再在最后一段内二分
+// 返回首个不满足 pred 的位置，代价为 O(log d)，d 为跳过的元素个数
+template <class RandomAccessIterator, class Predicate>
+RandomAccessIterator _gallop(RandomAccessIterator first,
+                             RandomAccessIterator last, Predicate pred) {
+	typedef typename iterator_traits<RandomAccessIterator>::difference_type
+	    Distance;
+
+	const Distance len = last - first;
+	Distance       lo = 0;
+	Distance       hi = 1;
+	while (hi < len && pred(*(first + hi))) {
+		lo = hi + 1;
+		hi = 2 * hi + 1;
+	}
+	if (hi > len)
+		hi = len;
+	while (lo < hi) {
+		const Distance mid = lo + (hi - lo) / 2;
+		if (pred(*(first + mid)))
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	return first + lo;
+}
+
+template <class Size1, class Size2>
+inline bool _should_gallop(Size1 large, Size2 small) {
+	return static_cast<size_t>(large) / _SET_GALLOP_RATIO >
+	       static_cast<size_t>(small);
+}
+
+// 两侧均为随机访问迭代器时才可能倍增查找
+template <class Iterator1, class Iterator2>
+struct _sorted_ranges_category {
+	typedef typename IfThenElse<
+	    std::is_convertible<
+	        typename iterator_traits<Iterator1>::iterator_category,
+	        random_access_iterator_tag>::value &&
+	        std::is_convertible<
+	            typename iterator_traits<Iterator2>::iterator_category,
+	            random_access_iterator_tag>::value,
+	    random_access_iterator_tag, input_iterator_tag>::result type;
+};
+
+//-------------------- merge ----------------------
+template <class InputIterator1, class InputIterator2, class OutputIterator,
+          class Compare>
+OutputIterator _merge_aux(InputIterator1 first1, InputIterator1 last1,
+                          InputIterator2 first2, InputIterator2 last2,
+                          OutputIterator result, Compare comp,
+                          input_iterator_tag) {
+	while (first1 != last1 && first2 != last2) {
+		if (comp(*first2, *first1)) {
+			*result = *first2;
+			++first2;
+		} else {
+			*result = *first1;
+			++first1;
+		}
+		++result;
+	}
+	result = mSTL::copy(first1, last1, result);
+	return mSTL::copy(first2, last2, result);
+}
+
+template <class RandomAccessIterator1, class RandomAccessIterator2,
+          class OutputIterator, class Compare>
+OutputIterator _merge_aux(RandomAccessIterator1 first1,
+                          RandomAccessIterator1 last1,
+                          RandomAccessIterator2 first2,
+                          RandomAccessIterator2 last2, OutputIterator result,
+                          Compare comp, random_access_iterator_tag) {
+	typedef typename iterator_traits<RandomAccessIterator1>::value_type T1;
+	typedef typename iterator_traits<RandomAccessIterator2>::value_type T2;
+
+	const bool gallop1 = _should_gallop(last1 - first1, last2 - first2);
+	const bool gallop2 = _should_gallop(last2 - first2, last1 - first1);
+	if (!gallop1 && !gallop2)
+		return _merge_aux(first1, last1, first2, last2, result, comp,
+		                  input_iterator_tag());
+
+	while (first1 != last1 && first2 != last2) {
+		if (comp(*first2, *first1)) {
+			_less_than_value<Compare, T1> pred = {comp, *first1};
+			RandomAccessIterator2 next =
+			    gallop2 ? _gallop(first2, last2, pred) : first2 + 1;
+			result = mSTL::copy(first2, next, result);
+			first2 = next;
+		} else {
+			_not_greater_than_value<Compare, T2> pred = {comp, *first2};
+			RandomAccessIterator1 next =
+			    gallop1 ? _gallop(first1, last1, pred) : first1 + 1;
+			result = mSTL::copy(first1, next, result);
+			first1 = next;
+		}
+	}
+	result = mSTL::copy(first1, last1, result);
+	return mSTL::copy(first2, last2, result);
+}
+
+template <class InputIterator1, class InputIterator2, class OutputIterator,
+          class Compare>
+OutputIterator merge(InputIterator1 first1, InputIterator1 last1,
+                     InputIterator2 first2, InputIterator2 last2,
+                     OutputIterator result, Compare comp) {
+	typedef typename _sorted_ranges_category<InputIterator1,
+	                                         InputIterator2>::type category;
+	return _merge_aux(first1, last1, first2, last2, result, comp, category());
+}
+
+template <class InputIterator1, class InputIterator2, class OutputIterator>
+OutputIterator merge(InputIterator1 first1, InputIterator1 last1,
+                     InputIterator2 first2, InputIterator2 last2,
+                     OutputIterator result) {
+	typedef typename iterator_traits<InputIterator1>::value_type T;
+	return mSTL::merge(first1, last1, first2, last2, result, std::less<T>());
+}
+
+//-------------------- multiway_merge ----------------------
+// [first, last) 中每个元素为 std::pair<Iterator, Iterator> 表示的有序区间，合并过程中各区间的起点前移
+// 败者树: 叶节点 k ... 2k - 1 对应各区间，内部节点保存该处比赛的败者，tree[0] 为总冠军
+// 弹出冠军后只需沿其叶节点到根重赛一次，每个元素 log2(k) 次比较
+template <class RangeIterator, class Compare>
+struct _loser_tree_less {
+	RangeIterator ranges;
+	Compare       comp;
+
+	// a 是否先于 b 输出: 耗尽的区间视为无穷大，相等时序号小者优先
+	bool operator()(size_t a, size_t b) const {
+		if (ranges[a].first == ranges[a].second)
+			return false;
+		if (ranges[b].first == ranges[b].second)
+			return true;
+		if (comp(*ranges[a].first, *ranges[b].first))
+			return true;
+		if (comp(*ranges[b].first, *ranges[a].first))
+			return false;
+		return a < b;
+	}
+};
+
+template <class RangeIterator, class OutputIterator, class Compare>
+OutputIterator multiway_merge(RangeIterator first, RangeIterator last,
+                              OutputIterator result, Compare comp) {
+	const size_t k = static_cast<size_t>(last - first);
+	if (k == 0)
+		return result;
+	if (k == 1) {
+		result = mSTL::copy(first->first, first->second, result);
+		first->first = first->second;
+		return result;
+	}
+
+	_loser_tree_less<RangeIterator, Compare> before = {first, comp};
+	_temporary_buffer<size_t>                nodes(3 * k);
+	size_t*                                  tree = nodes.data();
+	size_t*                                  winners = tree + k;
+
+	// 先自底向上建胜者树，再由每场比赛的两名参赛者得到败者
+	for (size_t i = 0; i < k; ++i)
+		winners[k + i] = i;
+	for (size_t node = k - 1; node > 0; --node) {
+		const size_t l = winners[2 * node];
+		const size_t r = winners[2 * node + 1];
+		winners[node] = before(r, l) ? r : l;
+		tree[node] = winners[node] == l ? r : l;
+	}
+	size_t winner = winners[1];
+
+	while (first[winner].first != first[winner].second) {
+		*result = *first[winner].first;
+		++result;
+		++first[winner].first;
+		for (size_t node = (winner + k) / 2; node > 0; node /= 2)
+			if (before(tree[node], winner))
+				std::swap(tree[node], winner);
+	}
+	tree[0] = winner;
+	return result;
+}
+
+template <class RangeIterator, class OutputIterator>
+OutputIterator multiway_merge(RangeIterator first, RangeIterator last,
+                              OutputIterator result) {
+	typedef typename iterator_traits<RangeIterator>::value_type range_type;
+	typedef typename iterator_traits<
+	    typename range_type::first_type>::value_type T;
+	return mSTL::multiway_merge(first, last, result, std::less<T>());
+}
+
+//<- Set operations (on sorted ranges)
+// includes(): [first2, last2) 是否为 [first1, last1) 的子 (多重) 集合  O(N1 + N2)
+// set_difference(): 属于第一个区间而不属于第二个区间的元素  O(N1 + N2)
+// set_intersection(): 两区间共有的元素，取自第一个区间  O(N1 + N2)
+// set_union(): 两区间的并，相等元素取自第一个区间  O(N1 + N2)
+// 重复元素按多重集合计数: 交集取 min(m, n) 个，并集取 max(m, n) 个，差集取 max(m - n, 0) 个
+// 严格递增的 uint32_t 数组可直接使用 simd::intersect_sorted
+
+//-------------------- includes ----------------------
+template <class InputIterator1, class InputIterator2, class Compare>
+bool _includes_aux(InputIterator1 first1, InputIterator1 last1,
+                   InputIterator2 first2, InputIterator2 last2, Compare comp,
+                   input_iterator_tag) {
+	for (; first2 != last2; ++first1) {
+		if (first1 == last1 || comp(*first2, *first1))
+			return false;
+		if (!comp(*first1, *first2))
+			++first2;
+	}
+	return true;
+}
+
+template <class RandomAccessIterator1, class RandomAccessIterator2,
+          class Compare>
+bool _includes_aux(RandomAccessIterator1 first1, RandomAccessIterator1 last1,
+                   RandomAccessIterator2 first2, RandomAccessIterator2 last2,
+                   Compare comp, random_access_iterator_tag) {
+	typedef typename iterator_traits<RandomAccessIterator2>::value_type T2;
+
+	if (last2 - first2 > last1 - first1)
+		return false;
+	if (!_should_gallop(last1 - first1, last2 - first2))
+		return _includes_aux(first1, last1, first2, last2, comp,
+		                     input_iterator_tag());
+
+	for (; first2 != last2; ++first2) {
+		_less_than_value<Compare, T2> pred = {comp, *first2};
+		first1 = _gallop(first1, last1, pred);
+		if (first1 == last1 || comp(*first2, *first1))
+			return false;
+		++first1;
+	}
+	return true;
+}
+
+template <class InputIterator1, class InputIterator2, class Compare>
+bool includes(InputIterator1 first1, InputIterator1 last1,
+              InputIterator2 first2, InputIterator2 last2, Compare comp) {
+	typedef typename _sorted_ranges_category<InputIterator1,
+	                                         InputIterator2>::type category;
+	return _includes_aux(first1, last1, first2, last2, comp, category());
+}
+
+template <class InputIterator1, class InputIterator2>
+bool includes(InputIterator1 first1, InputIterator1 last1,
+              InputIterator2 first2, InputIterator2 last2) {
+	typedef typename iterator_traits<InputIterator1>::value_type T;
+	return mSTL::includes(first1, last1, first2, last2, std::less<T>());
+}
+
+//-------------------- set_difference ----------------------
+template <class InputIterator1, class InputIterator2, class OutputIterator,
+          class Compare>
+OutputIterator _set_difference_aux(InputIterator1 first1, InputIterator1 last1,
+                                   InputIterator2 first2, InputIterator2 last2,
+                                   OutputIterator result, Compare comp,
+                                   input_iterator_tag) {
+	while (first1 != last1 && first2 != last2) {
+		if (comp(*first1, *first2)) {
+			*result = *first1;
+			++result;
+			++first1;
+		} else if (comp(*first2, *first1)) {
+			++first2;
+		} else {
+			++first1;
+			++first2;
+		}
+	}
+	return mSTL::copy(first1, last1, result);
+}
+
+template <class RandomAccessIterator1, class RandomAccessIterator2,
+          class OutputIterator, class Compare>
+OutputIterator
+_set_difference_aux(RandomAccessIterator1 first1, RandomAccessIterator1 last1,
+                    RandomAccessIterator2 first2, RandomAccessIterator2 last2,
+                    OutputIterator result, Compare comp,
+                    random_access_iterator_tag) {
+	typedef typename iterator_traits<RandomAccessIterator1>::value_type T1;
+	typedef typename iterator_traits<RandomAccessIterator2>::value_type T2;
+
+	const bool gallop1 = _should_gallop(last1 - first1, last2 - first2);
+	const bool gallop2 = _should_gallop(last2 - first2, last1 - first1);
+	if (!gallop1 && !gallop2)
+		return _set_difference_aux(first1, last1, first2, last2, result, comp,
+		                           input_iterator_tag());
+
+	while (first1 != last1 && first2 != last2) {
+		if (comp(*first1, *first2)) {
+			_less_than_value<Compare, T2> pred = {comp, *first2};
+			RandomAccessIterator1 next =
+			    gallop1 ? _gallop(first1, last1, pred) : first1 + 1;
+			result = mSTL::copy(first1, next, result);
+			first1 = next;
+		} else if (comp(*first2, *first1)) {
+			_less_than_value<Compare, T1> pred = {comp, *first1};
+			first2 = gallop2 ? _gallop(first2, last2, pred) : first2 + 1;
+		} else {
+			++first1;
+			++first2;
+		}
+	}
+	return mSTL::copy(first1, last1, result);
+}
+
+template <class InputIterator1, class InputIterator2, class OutputIterator,
+          class Compare>
+OutputIterator set_difference(InputIterator1 first1, InputIterator1 last1,
+                              InputIterator2 first2, InputIterator2 last2,
+                              OutputIterator result, Compare comp) {
+	typedef typename _sorted_ranges_category<InputIterator1,
+	                                         InputIterator2>::type category;
+	return _set_difference_aux(first1, last1, first2, last2, result, comp,
+	                           category());
+}
+
+template <class InputIterator1, class InputIterator2, class OutputIterator>
+OutputIterator set_difference(InputIterator1 first1, InputIterator1 last1,
+                              InputIterator2 first2, InputIterator2 last2,
+                              OutputIterator result) {
+	typedef typename iterator_traits<InputIterator1>::value_type T;
+	return mSTL::set_difference(first1, last1, first2, last2, result,
+	                            std::less<T>());
+}
+
+//-------------------- set_intersection ----------------------
+template <class InputIterator1, class InputIterator2, class OutputIterator,
+          class Compare>
+OutputIterator
+_set_intersection_aux(InputIterator1 first1, InputIterator1 last1,
+                      InputIterator2 first2, InputIterator2 last2,
+                      OutputIterator result, Compare comp, input_iterator_tag) {
+	while (first1 != last1 && first2 != last2) {
+		if (comp(*first1, *first2)) {
+			++first1;
+		} else if (comp(*first2, *first1)) {
+			++first2;
+		} else {
+			*result = *first1;
+			++result;
+			++first1;
+			++first2;
+		}
+	}
+	return result;
+}
+
+template <class RandomAccessIterator1, class RandomAccessIterator2,
+          class OutputIterator, class Compare>
+OutputIterator
+_set_intersection_aux(RandomAccessIterator1 first1, RandomAccessIterator1 last1,
+                      RandomAccessIterator2 first2, RandomAccessIterator2 last2,
+                      OutputIterator result, Compare comp,
+                      random_access_iterator_tag) {
+	typedef typename iterator_traits<RandomAccessIterator1>::value_type T1;
+	typedef typename iterator_traits<RandomAccessIterator2>::value_type T2;
+
+	const bool gallop1 = _should_gallop(last1 - first1, last2 - first2);
+	const bool gallop2 = _should_gallop(last2 - first2, last1 - first1);
+	if (!gallop1 && !gallop2)
+		return _set_intersection_aux(first1, last1, first2, last2, result, comp,
+		                             input_iterator_tag());
+
+	while (first1 != last1 && first2 != last2) {
+		if (comp(*first1, *first2)) {
+			_less_than_value<Compare, T2> pred = {comp, *first2};
+			first1 = gallop1 ? _gallop(first1, last1, pred) : first1 + 1;
+		} else if (comp(*first2, *first1)) {
+			_less_than_value<Compare, T1> pred = {comp, *first1};
+			first2 = gallop2 ? _gallop(first2, last2, pred) : first2 + 1;
+		} else {
+			*result = *first1;
+			++result;
+			++first1;
+			++first2;
+		}
+	}
+	return result;
+}
+
+template <class InputIterator1, class InputIterator2, class OutputIterator,
+          class Compare>
+OutputIterator set_intersection(InputIterator1 first1, InputIterator1 last1,
+                                InputIterator2 first2, InputIterator2 last2,
+                                OutputIterator result, Compare comp) {
+	typedef typename _sorted_ranges_category<InputIterator1,
+	                                         InputIterator2>::type category;
+	return _set_intersection_aux(first1, last1, first2, last2, result, comp,
+	                             category());
+}
+
+template <class InputIterator1, class InputIterator2, class OutputIterator>
+OutputIterator set_intersection(InputIterator1 first1, InputIterator1 last1,
+                                InputIterator2 first2, InputIterator2 last2,
+                                OutputIterator result) {
+	typedef typename iterator_traits<InputIterator1>::value_type T;
+	return mSTL::set_intersection(first1, last1, first2, last2, result,
+	                              std::less<T>());
+}
+
+//-------------------- set_union ----------------------
+template <class InputIterator1, class InputIterator2, class OutputIterator,
+          class Compare>
+OutputIterator _set_union_aux(InputIterator1 first1, InputIterator1 last1,
+                              InputIterator2 first2, InputIterator2 last2,
+                              OutputIterator result, Compare comp,
+                              input_iterator_tag) {
+	while (first1 != last1 && first2 != last2) {
+		if (comp(*first1, *first2)) {
+			*result = *first1;
+			++first1;
+		} else if (comp(*first2, *first1)) {
+			*result = *first2;
+			++first2;
+		} else {
+			*result = *first1;
+			++first1;
+			++first2;
+		}
+		++result;
+	}
+	result = mSTL::copy(first1, last1, result);
+	return mSTL::copy(first2, last2, result);
+}
+
+template <class RandomAccessIterator1, class RandomAccessIterator2,
+          class OutputIterator, class Compare>
+OutputIterator _set_union_aux(RandomAccessIterator1 first1,
+                              RandomAccessIterator1 last1,
+                              RandomAccessIterator2 first2,
+                              RandomAccessIterator2 last2, OutputIterator result,
+                              Compare comp, random_access_iterator_tag) {
+	typedef typename iterator_traits<RandomAccessIterator1>::value_type T1;
+	typedef typename iterator_traits<RandomAccessIterator2>::value_type T2;
+
+	const bool gallop1 = _should_gallop(last1 - first1, last2 - first2);
+	const bool gallop2 = _should_gallop(last2 - first2, last1 - first1);
+	if (!gallop1 && !gallop2)
+		return _set_union_aux(first1, last1, first2, last2, result, comp,
+		                      input_iterator_tag());
+
+	while (first1 != last1 && first2 != last2) {
+		if (comp(*first1, *first2)) {
+			_less_than_value<Compare, T2> pred = {comp, *first2};
+			RandomAccessIterator1 next =
+			    gallop1 ? _gallop(first1, last1, pred) : first1 + 1;
+			result = mSTL::copy(first1, next, result);
+			first1 = next;
+		} else if (comp(*first2, *first1)) {
+			_less_than_value<Compare, T1> pred = {comp, *first1};
+			RandomAccessIterator2 next =
+			    gallop2 ? _gallop(first2, last2, pred) : first2 + 1;
+			result = mSTL::copy(first2, next, result);
+			first2 = next;
+		} else {
+			*result = *first1;
+			++result;
+			++first1;
+			++first2;
+		}
+	}
+	result = mSTL::copy(first1, last1, result);
+	return mSTL::copy(first2, last2, result);
+}
+
+template <class InputIterator1, class InputIterator2, class OutputIterator,
+          class Compare>
+OutputIterator set_union(InputIterator1 first1, InputIterator1 last1,
+                         InputIterator2 first2, InputIterator2 last2,
+                         OutputIterator result, Compare comp) {
+	typedef typename _sorted_ranges_category<InputIterator1,
+	                                         InputIterator2>::type category;
+	return _set_union_aux(first1, last1, first2, last2, result, comp,
+	                      category());
+}
+
+template <class InputIterator1, class InputIterator2, class OutputIterator>
+OutputIterator set_union(InputIterator1 first1, InputIterator1 last1,
+                         InputIterator2 first2, InputIterator2 last2,
+                         OutputIterator result) {
+	typedef typename iterator_traits<InputIterator1>::value_type T;
+	return mSTL::set_union(first1, last1, first2, last2, result,
+	                       std::less<T>());
+}
+
+//<- Heap operations
+// push_heap(): *(last - 1) 上浮，[first, last) 成为大顶堆  O(logN)
+// pop_heap(): 堆顶移至 *(last - 1)，[first, last - 1) 仍为堆  O(logN)
+// make_heap(): 自底向上逐个下沉建堆 (Floyd)  O(N)
+// sort_heap(): 依次弹出堆顶，结果按 comp 升序  O(NlogN)
+// is_heap_until(): 首个违反堆序的位置  O(N)
+// is_heap(): [first, last) 是否为堆  O(N)
+//
+// push_heap<D>(...) 等带编译期参数 D 的形式为 D 叉堆，节点 i 的子节点为 D*i+1 ... D*i+D
+// 树高为 log_D(N)，下沉时每层比较 D - 1 次，但同一组子节点连续存放，大堆上缓存缺失更少
+// 下沉与二叉版本相同: 沿较大子节点移至叶节点后再上浮放置，上浮每层只需一次比较
+
+///<- d-ary heap helpers
+template <size_t Arity, class RandomAccessIterator, class Distance, class T,
+          class Compare>
+void _push_dary_heap(RandomAccessIterator first, Distance hole, Distance top,
+                     T value, Compare comp) {
+	while (hole > top) {
+		const Distance parent = (hole - 1) / static_cast<Distance>(Arity);
+		if (!comp(*(first + parent), value))
+			break;
+		*(first + hole) = std::move(*(first + parent));
+		hole = parent;
+	}
+	*(first + hole) = std::move(value);
 }
 
-//----------------- copy_if -------------------
-template <class InputIterator, class OutputIterator, class UnaryPredicate>
-OutputIterator copy_if(InputIterator first, InputIterator last,
-                       OutputIterator result, UnaryPredicate pred) {
-	while (first != last) {
-		if (pred(*first)) {
-			*result = *first;
-			++result;
+// 子节点齐全时两两比较选出最大者，依赖链长度为 log2(D) 而非 D - 1
+template <size_t Count>
+struct _dary_largest_child {
+	template <class RandomAccessIterator, class Distance, class Compare>
+	static Distance get(RandomAccessIterator first, Distance child,
+	                    Compare comp) {
+		const Distance l =
+		    _dary_largest_child<Count / 2>::get(first, child, comp);
+		const Distance r = _dary_largest_child<Count - Count / 2>::get(
+		    first, child + static_cast<Distance>(Count / 2), comp);
+		return comp(*(first + l), *(first + r)) ? r : l;
+	}
+};
+
+template <>
+struct _dary_largest_child<1> {
+	template <class RandomAccessIterator, class Distance, class Compare>
+	static Distance get(RandomAccessIterator, Distance child, Compare) {
+		return child;
+	}
+};
+
+template <size_t Arity, class RandomAccessIterator, class Distance, class T,
+          class Compare>
+void _adjust_dary_heap(RandomAccessIterator first, Distance hole, Distance len,
+                       T value, Compare comp) {
+	const Distance arity = static_cast<Distance>(Arity);
+	const Distance top = hole;
+	Distance       child = arity * hole + 1;
+	while (child < len) {
+		const Distance count = len - child < arity ? len - child : arity;
+		Distance       largest = child;
+		if (count == arity) {
+			largest = _dary_largest_child<Arity>::get(first, child, comp);
+		} else {
+			for (Distance i = 1; i < count; ++i)
+				if (comp(*(first + largest), *(first + (child + i))))
+					largest = child + i;
 		}
-		++first;
+		*(first + hole) = std::move(*(first + largest));
+		hole = largest;
+		child = arity * hole + 1;
 	}
-	return result;
+	_push_dary_heap<Arity>(first, hole, top, std::move(value), comp);
 }
 
-//--------------- copy_backward ---------------
-template <class BidirectionalIterator1, class BidirectionalIterator2>
-BidirectionalIterator2 copy_backward(BidirectionalIterator1 first,
-                                     BidirectionalIterator1 last,
-                                     BidirectionalIterator2 result) {
-	while (last != first)
-		*(--result) = *(--last);
-	return result;
+//-------------------- push_heap ----------------------
+template <size_t Arity, class RandomAccessIterator, class Compare>
+void push_heap(RandomAccessIterator first, RandomAccessIterator last,
+               Compare comp) {
+	static_assert(Arity >= 2, "heap arity must be at least 2");
+	typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+	typedef typename iterator_traits<RandomAccessIterator>::difference_type
+	    Distance;
+
+	if (last - first < 2)
+		return;
+	T value = std::move(*(last - 1));
+	_push_dary_heap<Arity>(first, Distance(last - first - 1), Distance(0),
+	                       std::move(value), comp);
 }
 
-///<- move series
-// copy(): [first, last) -> [result, result + (last - first))  O(N)
-// copy_backward(): [first, last) -> [result - (last - first), result)  O(N)
-//-------------------- move ----------------------
-template <class InputIterator, class OutputIterator>
-OutputIterator move(InputIterator first, InputIterator last,
-                    OutputIterator result) {
-	while (first != last) {
-		*result = std::move(*first);
-		++result;
-		++first;
-	}
-	return result;
+template <size_t Arity, class RandomAccessIterator>
+void push_heap(RandomAccessIterator first, RandomAccessIterator last) {
+	typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+	mSTL::push_heap<Arity>(first, last, std::less<T>());
 }
 
-//-------------- move_backward -------------------
-template <class BidirIterator1, class BidirIterator2>
-BidirIterator2 move_backward(BidirIterator1 first, BidirIterator1 last,
-                             BidirIterator2 result) {
+template <class RandomAccessIterator, class Compare>
+void push_heap(RandomAccessIterator first, RandomAccessIterator last,
+               Compare comp) {
+	mSTL::push_heap<2>(first, last, comp);
+}
 
-	while (first != last)
-		*(result) = std::move(*(--last));
+template <class RandomAccessIterator>
+void push_heap(RandomAccessIterator first, RandomAccessIterator last) {
+	mSTL::push_heap<2>(first, last);
+}
 
-	return result;
+//-------------------- pop_heap ----------------------
+template <size_t Arity, class RandomAccessIterator, class Compare>
+void pop_heap(RandomAccessIterator first, RandomAccessIterator last,
+              Compare comp) {
+	static_assert(Arity >= 2, "heap arity must be at least 2");
+	typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+	typedef typename iterator_traits<RandomAccessIterator>::difference_type
+	    Distance;
+
+	if (last - first < 2)
+		return;
+	--last;
+	T value = std::move(*last);
+	*last = std::move(*first);
+	_adjust_dary_heap<Arity>(first, Distance(0), Distance(last - first),
+	                         std::move(value), comp);
 }
 
-///<- fill series
-// fill(): value -> [first, end)  O(N)
-// fill_n(): value -> [first, first + n)  O(N)
-//-------------------- fill ----------------------
-template <class ForwardIterator, class T>
-void fill(ForwardIterator first, ForwardIterator last, const T& value) {
-	while (first != last) {
-		*first = value;
-		++first;
+template <size_t Arity, class RandomAccessIterator>
+void pop_heap(RandomAccessIterator first, RandomAccessIterator last) {
+	typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+	mSTL::pop_heap<Arity>(first, last, std::less<T>());
+}
+
+template <class RandomAccessIterator, class Compare>
+void pop_heap(RandomAccessIterator first, RandomAccessIterator last,
+              Compare comp) {
+	typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+	typedef typename iterator_traits<RandomAccessIterator>::difference_type
+	    Distance;
+
+	if (last - first < 2)
+		return;
+	--last;
+	T value = std::move(*last);
+	*last = std::move(*first);
+	_adjust_heap(first, Distance(0), Distance(last - first), std::move(value),
+	             comp);
+}
+
+template <class RandomAccessIterator>
+void pop_heap(RandomAccessIterator first, RandomAccessIterator last) {
+	typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+	mSTL::pop_heap(first, last, std::less<T>());
+}
+
+//-------------------- make_heap ----------------------
+template <size_t Arity, class RandomAccessIterator, class Compare>
+void make_heap(RandomAccessIterator first, RandomAccessIterator last,
+               Compare comp) {
+	static_assert(Arity >= 2, "heap arity must be at least 2");
+	typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+	typedef typename iterator_traits<RandomAccessIterator>::difference_type
+	    Distance;
+
+	const Distance len = last - first;
+	if (len < 2)
+		return;
+	for (Distance parent = (len - 2) / static_cast<Distance>(Arity);;
+	     --parent) {
+		T value = std::move(*(first + parent));
+		_adjust_dary_heap<Arity>(first, parent, len, std::move(value), comp);
+		if (parent == 0)
+			break;
 	}
 }
 
-inline void fill(char* first, char* last, const char& value) {
-	memset(first, static_cast<unsigned char>(value), last - first);
+template <size_t Arity, class RandomAccessIterator>
+void make_heap(RandomAccessIterator first, RandomAccessIterator last) {
+	typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+	mSTL::make_heap<Arity>(first, last, std::less<T>());
 }
-inline void fill(wchar_t* first, wchar_t* last, const wchar_t& value) {
-	memset(first, static_cast<unsigned char>(value),
-	       (last - first) * sizeof(wchar_t));
+
+template <class RandomAccessIterator, class Compare>
+void make_heap(RandomAccessIterator first, RandomAccessIterator last,
+               Compare comp) {
+	_make_heap(first, last, comp);
 }
 
-//------------------- fill_n ---------------------
-template <class OutputIterator, class Size, class T>
-OutputIterator fill_n(OutputIterator first, Size n, const T& value) {
-	while (n > 0) {
-		*first = value;
-		--n;
-		++first;
+template <class RandomAccessIterator>
+void make_heap(RandomAccessIterator first, RandomAccessIterator last) {
+	typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+	_make_heap(first, last, std::less<T>());
+}
+
+//-------------------- sort_heap ----------------------
+template <size_t Arity, class RandomAccessIterator, class Compare>
+void sort_heap(RandomAccessIterator first, RandomAccessIterator last,
+               Compare comp) {
+	while (last - first > 1) {
+		mSTL::pop_heap<Arity>(first, last, comp);
+		--last;
 	}
-	return first;
 }
 
-template <class Size>
-char* fill_n(char* first, Size n, const char& value) {
-	memset(first, static_cast<unsigned char>(value), n);
-	return first + n;
+template <size_t Arity, class RandomAccessIterator>
+void sort_heap(RandomAccessIterator first, RandomAccessIterator last) {
+	typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+	mSTL::sort_heap<Arity>(first, last, std::less<T>());
 }
-template <class Size>
-wchar_t* fill_n(wchar_t* first, Size n, const wchar_t& value) {
-	memset(first, static_cast<unsigned char>(value), n * sizeof(wchar_t));
-	return first + n;
+
+template <class RandomAccessIterator, class Compare>
+void sort_heap(RandomAccessIterator first, RandomAccessIterator last,
+               Compare comp) {
+	_sort_heap(first, last, comp);
 }
 
-///<- transform series
-///<- generate series
-///<- remove series
-///<- replace series
+template <class RandomAccessIterator>
+void sort_heap(RandomAccessIterator first, RandomAccessIterator last) {
+	typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+	_sort_heap(first, last, std::less<T>());
+}
 
-///<- swap series
-/// swap()  &a <-> &b  O(1)
-/// iter_swap() *a <-> *b  O(1)
-/// swap_ranges() [first1, last1) <-> [first2, first2 + (last1 - first1))  O(N)
-/// swap()(a[], b[])  a[] <-> b[]  O(N)
-//------------------ swap() ---------------------
-template <class T>
-void swap(T& a, T& b) {
-	T temp = std::move(a);
-	a = std::move(b);
-	b = std::move(temp);
+//-------------------- is_heap_until ----------------------
+template <size_t Arity, class RandomAccessIterator, class Compare>
+RandomAccessIterator is_heap_until(RandomAccessIterator first,
+                                   RandomAccessIterator last, Compare comp) {
+	static_assert(Arity >= 2, "heap arity must be at least 2");
+	typedef typename iterator_traits<RandomAccessIterator>::difference_type
+	    Distance;
+
+	const Distance len = last - first;
+	for (Distance child = 1; child < len; ++child)
+		if (comp(*(first + (child - 1) / static_cast<Distance>(Arity)),
+		         *(first + child)))
+			return first + child;
+	return last;
 }
 
-//--------------- iter_swap() -----------------
-template <class ForwardIt1, class ForwardIt2>
-void iter_swap(ForwardIt1 a, ForwardIt2 b) {
-	swap(*a, *b);
+template <size_t Arity, class RandomAccessIterator>
+RandomAccessIterator is_heap_until(RandomAccessIterator first,
+                                   RandomAccessIterator last) {
+	typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+	return mSTL::is_heap_until<Arity>(first, last, std::less<T>());
 }
 
-//--------------- swap_ranges() -----------------
-template <class ForwardIt1, class ForwardIt2>
-ForwardIt2 swap_ranges(ForwardIt1 first1, ForwardIt1 last1, ForwardIt2 first2) {
-	for (; first1 != last1; ++first1, (void)++first2)
-		std::iter_swap(first1, first2);
-	return first2;
+template <class RandomAccessIterator, class Compare>
+RandomAccessIterator is_heap_until(RandomAccessIterator first,
+                                   RandomAccessIterator last, Compare comp) {
+	return mSTL::is_heap_until<2>(first, last, comp);
 }
 
-//------------- swap()(a[], b[])  -----------------
-template <class T, size_t N>
-void swap(T (&a)[N], T (&b)[N]) {
-	swap_ranges(a, (a + N), b);
+template <class RandomAccessIterator>
+RandomAccessIterator is_heap_until(RandomAccessIterator first,
+                                   RandomAccessIterator last) {
+	return mSTL::is_heap_until<2>(first, last);
 }
 
-///<- reverse series
-///<- rotate series
-///<- unique series
+//-------------------- is_heap ----------------------
+template <size_t Arity, class RandomAccessIterator, class Compare>
+bool is_heap(RandomAccessIterator first, RandomAccessIterator last,
+             Compare comp) {
+	return mSTL::is_heap_until<Arity>(first, last, comp) == last;
+}
 
-//<- Partitioning operations
-//<- Sorting operations
-//<- Binary search operations(on sorted ranges)
-//<- Other operations on sorted ranges
-//<- Set operations (on sorted ranges)
-//<- Heap operations
+template <size_t Arity, class RandomAccessIterator>
+bool is_heap(RandomAccessIterator first, RandomAccessIterator last) {
+	return mSTL::is_heap_until<Arity>(first, last) == last;
+}
+
+template <class RandomAccessIterator, class Compare>
+bool is_heap(RandomAccessIterator first, RandomAccessIterator last,
+             Compare comp) {
+	return mSTL::is_heap_until<2>(first, last, comp) == last;
+}
+
+template <class RandomAccessIterator>
+bool is_heap(RandomAccessIterator first, RandomAccessIterator last) {
+	return mSTL::is_heap_until<2>(first, last) == last;
+}
 
 //<- Minimum / maximum operations
+// max() / min() / minmax(): 两个值或初始化列表中的最值，minmax 返回 (首个最小, 最后一个最大)
+// max_element() / min_element(): 首个最大 / 最小元素  O(N)
+// minmax_element(): 首个最小元素与最后一个最大元素，成对比较  3N/2 次比较
+// clamp(v, lo, hi): v 限制在 [lo, hi]; clamp(first, last, lo, hi): 原地限制区间内每个元素  O(N)
+// 连续算术类型且比较器为 std::less 时使用 simd 最值内核:
+//   逐块求向量逐元素最值，记录最值首次 (最后) 出现的块后在块内定位下标
+//   浮点数含 NaN 时与 NaN 的比较结果依赖顺序，回到标量比较以保持与 std 一致
+
+// 比较器为元素类型的 std::less
+template <class Iterator, class Compare>
+struct _is_minmax_scannable {
+	typedef _false_type type;
+};
+
+template <class T, class Compare>
+struct _is_minmax_scannable<T*, Compare> {
+	typedef typename std::remove_const<T>::type U;
+	typedef typename IfThenElse<simd::is_scan_type<U>::value &&
+	                                std::is_same<Compare, std::less<U>>::value,
+	                            _true_type, _false_type>::result type;
+};
+
 // max
 template <class T>
 const T& max(const T& a, const T& b) {
-	return std::max(a, b);
+	return a < b ? b : a;
 }
 
 template <class T, class Compare>
 const T& max(const T& a, const T& b, Compare comp) {
-	return std::max(a, b, comp);
+	return comp(a, b) ? b : a;
 }
 
-template <class T>
-T max(std::initializer_list<T> ilist) {
-	return std::max(ilist);
+// max_element
+template <class ForwardIterator, class Compare>
+ForwardIterator _max_element_aux(ForwardIterator first, ForwardIterator last,
+                                 Compare comp, _false_type) {
+	if (first == last)
+		return last;
+	ForwardIterator largest = first;
+	while (++first != last)
+		if (comp(*largest, *first))
+			largest = first;
+	return largest;
 }
 
 template <class T, class Compare>
-T max(std::initializer_list<T> ilist, Compare comp) {
-	return std::max(ilist, comp);
+T* _max_element_aux(T* first, T* last, Compare comp, _true_type) {
+	size_t index = 0;
+	if (first == last)
+		return last;
+	if (!simd::minmax_index(first, static_cast<size_t>(last - first), nullptr,
+	                        &index, false))
+		return _max_element_aux(first, last, comp, _false_type());
+	return first + index;
 }
 
-// max_element
-template <class ForwardIt>
-ForwardIt max_element(ForwardIt first, ForwardIt last) {
-	return std::max_element(first, last);
+template <class ForwardIterator, class Compare>
+inline ForwardIterator max_element(ForwardIterator first, ForwardIterator last,
+                                   Compare comp) {
+	typedef typename _is_minmax_scannable<ForwardIterator, Compare>::type
+	    isScannable;
+	return _max_element_aux(first, last, comp, isScannable());
 }
 
-template <class ForwardIt, class Compare>
-ForwardIt max_element(ForwardIt first, ForwardIt last, Compare comp) {
-	return std::max_element(first, last, comp);
+template <class ForwardIterator>
+inline ForwardIterator max_element(ForwardIterator first,
+                                   ForwardIterator last) {
+	typedef typename iterator_traits<ForwardIterator>::value_type T;
+	return mSTL::max_element(first, last, std::less<T>());
 }
 
 // min
 template <class T>
 const T& min(const T& a, const T& b) {
-	return std::min(a, b);
+	return b < a ? b : a;
 }
 
 template <class T, class Compare>
 const T& min(const T& a, const T& b, Compare comp) {
-	return std::min(a, b, comp);
+	return comp(b, a) ? b : a;
 }
 
-template <class T>
-T min(std::initializer_list<T> ilist) {
-	return std::min(ilist);
+// min_element
+template <class ForwardIterator, class Compare>
+ForwardIterator _min_element_aux(ForwardIterator first, ForwardIterator last,
+                                 Compare comp, _false_type) {
+	if (first == last)
+		return last;
+	ForwardIterator smallest = first;
+	while (++first != last)
+		if (comp(*first, *smallest))
+			smallest = first;
+	return smallest;
 }
 
 template <class T, class Compare>
-T min(std::initializer_list<T> ilist, Compare comp) {
-	return std::min(ilist, comp);
+T* _min_element_aux(T* first, T* last, Compare comp, _true_type) {
+	size_t index = 0;
+	if (first == last)
+		return last;
+	if (!simd::minmax_index(first, static_cast<size_t>(last - first), &index,
+	                        nullptr, false))
+		return _min_element_aux(first, last, comp, _false_type());
+	return first + index;
 }
 
-// min_element
-template <class ForwardIt>
-ForwardIt min_element(ForwardIt first, ForwardIt last) {
-	return std::min_element(first, last);
+template <class ForwardIterator, class Compare>
+inline ForwardIterator min_element(ForwardIterator first, ForwardIterator last,
+                                   Compare comp) {
+	typedef typename _is_minmax_scannable<ForwardIterator, Compare>::type
+	    isScannable;
+	return _min_element_aux(first, last, comp, isScannable());
 }
 
-template <class ForwardIt, class Compare>
-ForwardIt min_element(ForwardIt first, ForwardIt last, Compare comp) {
-	return std::min_element(first, last, comp);
+template <class ForwardIterator>
+inline ForwardIterator min_element(ForwardIterator first,
+                                   ForwardIterator last) {
+	typedef typename iterator_traits<ForwardIterator>::value_type T;
+	return mSTL::min_element(first, last, std::less<T>());
 }
 
 // minmax
 template <class T>
 std::pair<const T&, const T&> minmax(const T& a, const T& b) {
-	return std::minmax(a, b);
+	return b < a ? std::pair<const T&, const T&>(b, a)
+	             : std::pair<const T&, const T&>(a, b);
 }
 
 template <class T, class Compare>
 std::pair<const T&, const T&> minmax(const T& a, const T& b, Compare comp) {
-	return std::minmax(a, b, comp);
+	return comp(b, a) ? std::pair<const T&, const T&>(b, a)
+	                  : std::pair<const T&, const T&>(a, b);
+}
+
+// minmax_element
+// 每次取两个元素，较小者与当前最小比较、较大者与当前最大比较
+template <class ForwardIterator, class Compare>
+std::pair<ForwardIterator, ForwardIterator>
+_minmax_element_aux(ForwardIterator first, ForwardIterator last, Compare comp,
+                    _false_type) {
+	std::pair<ForwardIterator, ForwardIterator> result(first, first);
+	if (first == last || ++first == last)
+		return result;
+	if (comp(*first, *result.first))
+		result.first = first;
+	else
+		result.second = first;
+	while (++first != last) {
+		ForwardIterator i = first;
+		if (++first == last) {
+			if (comp(*i, *result.first))
+				result.first = i;
+			else if (!comp(*i, *result.second))
+				result.second = i;
+			break;
+		}
+		if (comp(*first, *i)) {
+			if (comp(*first, *result.first))
+				result.first = first;
+			if (!comp(*i, *result.second))
+				result.second = i;
+		} else {
+			if (comp(*i, *result.first))
+				result.first = i;
+			if (!comp(*first, *result.second))
+				result.second = first;
+		}
+	}
+	return result;
+}
+
+template <class T, class Compare>
+std::pair<T*, T*> _minmax_element_aux(T* first, T* last, Compare comp,
+                                      _true_type) {
+	size_t lo = 0, hi = 0;
+	if (first == last)
+		return std::pair<T*, T*>(last, last);
+	if (!simd::minmax_index(first, static_cast<size_t>(last - first), &lo, &hi,
+	                        true))
+		return _minmax_element_aux(first, last, comp, _false_type());
+	return std::pair<T*, T*>(first + lo, first + hi);
+}
+
+template <class ForwardIterator, class Compare>
+inline std::pair<ForwardIterator, ForwardIterator>
+minmax_element(ForwardIterator first, ForwardIterator last, Compare comp) {
+	typedef typename _is_minmax_scannable<ForwardIterator, Compare>::type
+	    isScannable;
+	return _minmax_element_aux(first, last, comp, isScannable());
+}
+
+template <class ForwardIterator>
+inline std::pair<ForwardIterator, ForwardIterator>
+minmax_element(ForwardIterator first, ForwardIterator last) {
+	typedef typename iterator_traits<ForwardIterator>::value_type T;
+	return mSTL::minmax_element(first, last, std::less<T>());
 }
 
+// 初始化列表版本的 max / min / minmax
 template <class T>
-std::pair<T, T> minmax(std::initializer_list<T> ilist) {
-	return std::minmax(ilist);
+T max(std::initializer_list<T> ilist) {
+	return *mSTL::max_element(ilist.begin(), ilist.end());
 }
 
 template <class T, class Compare>
-std::pair<T, T> minmax(std::initializer_list<T> ilist, Compare comp) {
-	return std::minmax(ilist, comp);
+T max(std::initializer_list<T> ilist, Compare comp) {
+	return *mSTL::max_element(ilist.begin(), ilist.end(), comp);
 }
 
-// minmax_element
-template <class ForwardIt>
-std::pair<ForwardIt, ForwardIt> minmax_element(ForwardIt first,
-                                               ForwardIt last) {
-	return std::minmax_element(first, last);
+template <class T>
+T min(std::initializer_list<T> ilist) {
+	return *mSTL::min_element(ilist.begin(), ilist.end());
+}
+
+template <class T, class Compare>
+T min(std::initializer_list<T> ilist, Compare comp) {
+	return *mSTL::min_element(ilist.begin(), ilist.end(), comp);
+}
+
+template <class T>
+std::pair<T, T> minmax(std::initializer_list<T> ilist) {
+	std::pair<const T*, const T*> p =
+	    mSTL::minmax_element(ilist.begin(), ilist.end());
+	return std::pair<T, T>(*p.first, *p.second);
 }
 
-template <class ForwardIt, class Compare>
-std::pair<ForwardIt, ForwardIt> minmax_element(ForwardIt first, ForwardIt last,
-                                               Compare comp) {
-	return std::minmax_element(first, last, comp);
+template <class T, class Compare>
+std::pair<T, T> minmax(std::initializer_list<T> ilist, Compare comp) {
+	std::pair<const T*, const T*> p =
+	    mSTL::minmax_element(ilist.begin(), ilist.end(), comp);
+	return std::pair<T, T>(*p.first, *p.second);
 }
 
 // clamp
 template <class T>
-constexpr const T& clamp(const T& v, const T& lo, const T& hi) {}
+constexpr const T& clamp(const T& v, const T& lo, const T& hi) {
+	return v < lo ? lo : hi < v ? hi : v;
+}
+
+template <class T, class Compare>
+constexpr const T& clamp(const T& v, const T& lo, const T& hi, Compare comp) {
+	return comp(v, lo) ? lo : comp(hi, v) ? hi : v;
+}
+
+template <class ForwardIterator, class T, class Compare>
+void _clamp_aux(ForwardIterator first, ForwardIterator last, const T& lo,
+                const T& hi, Compare comp, _false_type) {
+	for (; first != last; ++first) {
+		if (comp(*first, lo))
+			*first = lo;
+		else if (comp(hi, *first))
+			*first = hi;
+	}
+}
 
 template <class T, class Compare>
-constexpr const T& clamp(const T& v, const T& lo, const T& hi, Compare comp) {}
+inline void _clamp_aux(T* first, T* last, const T& lo, const T& hi, Compare,
+                       _true_type) {
+	simd::clamp(first, static_cast<size_t>(last - first), lo, hi);
+}
+
+// 原地把 [first, last) 中每个元素限制在 [lo, hi]
+template <class ForwardIterator, class T, class Compare>
+inline void clamp(ForwardIterator first, ForwardIterator last, const T& lo,
+                  const T& hi, Compare comp) {
+	typedef typename iterator_traits<ForwardIterator>::value_type V;
+	typedef typename IfThenElse<std::is_same<V, T>::value,
+	                            typename _is_minmax_scannable<
+	                                ForwardIterator, Compare>::type,
+	                            _false_type>::result isScannable;
+	_clamp_aux(first, last, lo, hi, comp, isScannable());
+}
+
+template <class ForwardIterator, class T>
+inline void clamp(ForwardIterator first, ForwardIterator last, const T& lo,
+                  const T& hi) {
+	mSTL::clamp(first, last, lo, hi, std::less<T>());
+}
 
 //<- Comparison operations
 ///<- equal series
@@ -339,10 +4309,135 @@ bool lexicographical_compare(InputIt1 first1, InputIt1 last1, InputIt2 first2,
 	return std::lexicographical_compare(first1, last1, first2, last2, comp);
 }
 
+///<- contiguous compare
+// 连续存储容器 (vector / array 等) 的比较运算实现，按 _comparison_traits 分发
+// _contiguous_equal(): [lhs, lhs + n) == [rhs, rhs + n)
+// _contiguous_less(): [lhs, lhs + lhs_n) 字典序小于 [rhs, rhs + rhs_n)
+
+template <class T>
+bool _contiguous_equal_aux(const T* lhs, const T* rhs, size_t n, _true_type) {
+	return lhs == rhs || memcmp(lhs, rhs, n * sizeof(T)) == 0;
+}
+
+template <class T>
+bool _contiguous_equal_aux(const T* lhs, const T* rhs, size_t n, _false_type) {
+	for (size_t i = 0; i < n; ++i) {
+		if (!(lhs[i] == rhs[i]))
+			return false;
+	}
+	return true;
+}
+
+template <class T>
+bool _contiguous_equal(const T* lhs, const T* rhs, size_t n) {
+	typedef typename _comparison_traits<T>::is_bitwise_equal isBitwiseEqual;
+	return n == 0 || _contiguous_equal_aux(lhs, rhs, n, isBitwiseEqual());
+}
+
+// 单字节无符号类型: memcmp 结果即字典序
+template <class T>
+bool _contiguous_less_aux(const T* lhs, size_t lhs_n, const T* rhs,
+                          size_t rhs_n, _true_type, _true_type) {
+	size_t n = mSTL::min(lhs_n, rhs_n);
+	int    result = n == 0 ? 0 : memcmp(lhs, rhs, n);
+	return result != 0 ? result < 0 : lhs_n < rhs_n;
+}
+
+// 按位相等的宽类型: 以 SIMD 定位首个不同字节，仅比较该位置的元素
+template <class T>
+bool _contiguous_less_aux(const T* lhs, size_t lhs_n, const T* rhs,
+                          size_t rhs_n, _true_type, _false_type) {
+	size_t n = mSTL::min(lhs_n, rhs_n);
+	size_t i = n == 0 ? 0 : simd::mismatch_bytes(lhs, rhs, n * sizeof(T)) /
+	                            sizeof(T);
+	return i != n ? lhs[i] < rhs[i] : lhs_n < rhs_n;
+}
+
+template <class T, class ByteOrdered>
+bool _contiguous_less_aux(const T* lhs, size_t lhs_n, const T* rhs,
+                          size_t rhs_n, _false_type, ByteOrdered) {
+	size_t n = mSTL::min(lhs_n, rhs_n);
+	for (size_t i = 0; i < n; ++i) {
+		if (lhs[i] < rhs[i])
+			return true;
+		if (rhs[i] < lhs[i])
+			return false;
+	}
+	return lhs_n < rhs_n;
+}
+
+template <class T>
+bool _contiguous_less(const T* lhs, size_t lhs_n, const T* rhs, size_t rhs_n) {
+	typedef typename _comparison_traits<T>::is_bitwise_equal isBitwiseEqual;
+	typedef typename _comparison_traits<T>::is_byte_ordered  isByteOrdered;
+	return _contiguous_less_aux(lhs, lhs_n, rhs, rhs_n, isBitwiseEqual(),
+	                            isByteOrdered());
+}
+
 //<- Permutation operations
 
 //<- uninitialized mem operator function
 
+// vector / soa_vector 共用的增长策略
+// 容量为 0 时恰好分配 count 个，否则增加 max(原容量, count)
+inline size_t _grow_capacity(size_t old_capacity, size_t count) noexcept {
+	if (old_capacity == 0)
+		return count;
+	return old_capacity + (count > old_capacity ? count : old_capacity);
+}
+
+// 并行首次访问 (first touch) 构造，默认关闭
+// 开启后超过阈值的 POD 区间 uninitialized copy / fill_n 被切分至线程池执行
+// 新分配的大块内存在首次写入时才分配物理页，由各线程分别写入各自的分块
+// 可使物理页分布在各线程所在的 NUMA 节点上，同时提升多通道内存带宽利用率
+// 分块大小按页对齐，相邻分块至多共享首尾各一页
+// 非 POD 类型的构造可能抛出异常或访问非线程安全的资源 (如 alloc 内存池)，始终串行执行
+struct parallel_construct {
+	static constexpr size_t page_size = 4096;
+
+	// 单个区间字节数达到 bytes 时启用并行，0 表示关闭
+	static void set_threshold(size_t bytes) noexcept {
+		threshold_value().store(bytes, std::memory_order_relaxed);
+	}
+	static size_t threshold() noexcept {
+		return threshold_value().load(std::memory_order_relaxed);
+	}
+
+	// 执行构造的线程池，nullptr (默认) 表示 thread_pool::instance()
+	// 调用者须保证设置的线程池在恢复为 nullptr 之前一直有效
+	static void set_pool(thread_pool* pool) noexcept {
+		pool_value().store(pool, std::memory_order_relaxed);
+	}
+	static thread_pool& pool() {
+		thread_pool* pool = pool_value().load(std::memory_order_relaxed);
+		return pool != nullptr ? *pool : thread_pool::instance();
+	}
+
+	static bool enabled(size_t bytes) {
+		size_t limit = threshold();
+		return limit != 0 && bytes >= limit && pool().concurrency() > 1;
+	}
+
+	// 每个线程负责的元素个数，按页向上取整
+	static size_t grain(size_t count, size_t element_size) {
+		size_t parts = pool().concurrency();
+		size_t bytes = (count * element_size + parts - 1) / parts;
+		bytes = (bytes + page_size - 1) / page_size * page_size;
+		size_t elements = bytes / element_size;
+		return elements == 0 ? 1 : elements;
+	}
+
+private:
+	static std::atomic<size_t>& threshold_value() noexcept {
+		static std::atomic<size_t> value(0);
+		return value;
+	}
+	static std::atomic<thread_pool*>& pool_value() noexcept {
+		static std::atomic<thread_pool*> value(nullptr);
+		return value;
+	}
+};
+
 // Allocator 相关 uninitialized_mem_func
 template <class T, class Allocator>
 class uninitialized_mem_func {
@@ -358,13 +4453,52 @@ public:
 	using allocator_type = Allocator;
 
 private:
+	// 超过阈值的内存拷贝使用非临时存储，避免污染缓存
+	static void _copy_bytes(char* dest, const char* src, size_type bytes,
+	                        bool stream) {
+		if (stream)
+			nontemporal::copy(dest, src, bytes);
+		else
+			memcpy(dest, src, bytes);
+	}
+
+	// 原生指针的填充可使用非临时存储
+	static void _fill_n_pod(pointer first, size_type count,
+	                        const_reference value, bool stream) {
+		if (!stream || !nontemporal::fill_n(first, count, value))
+			mSTL::fill_n(first, count, value);
+	}
+	template <class ForwardIterator>
+	static void _fill_n_pod(ForwardIterator first, size_type count,
+	                        const_reference value, bool) {
+		mSTL::fill_n(first, count, value);
+	}
+
 	// is POD type
 	// 执行内存拷贝操作即可
 	template <class InputIterator, class ForwardIterator>
 	static ForwardIterator _copy_aux(InputIterator first, InputIterator last,
 	                                 ForwardIterator result, _true_type) {
 		size_type count = static_cast<size_type>(last - first);
-		memcpy(&*result, &*first, count * sizeof(*first));
+		if (count == 0)
+			return result;
+
+		size_type   element_size = sizeof(*first);
+		size_type   bytes = count * element_size;
+		char*       dest = reinterpret_cast<char*>(&*result);
+		const char* src = reinterpret_cast<const char*>(&*first);
+		bool        stream = nontemporal::enabled(bytes);
+		if (parallel_construct::enabled(bytes)) {
+			parallel_construct::pool().parallel_for(
+			    0, count, parallel_construct::grain(count, element_size),
+			    [=](size_type begin, size_type end) {
+				    _copy_bytes(dest + begin * element_size,
+				                src + begin * element_size,
+				                (end - begin) * element_size, stream);
+			    });
+		} else {
+			_copy_bytes(dest, src, bytes, stream);
+		}
 		return result + count;
 	}
 
@@ -393,7 +4527,19 @@ private:
 	static ForwardIterator _move_aux(InputIterator first, InputIterator last,
 	                                 ForwardIterator result, _true_type) {
 		size_type count = static_cast<size_type>(last - first);
-		memmove(&*result, &*first, count * sizeof(*first));
+		if (count == 0)
+			return result;
+
+		size_type   bytes = count * sizeof(*first);
+		char*       dest = reinterpret_cast<char*>(&*result);
+		const char* src = reinterpret_cast<const char*>(&*first);
+		uintptr_t   d = reinterpret_cast<uintptr_t>(dest);
+		uintptr_t   s = reinterpret_cast<uintptr_t>(src);
+		// 非临时存储仅用于不重叠的区间 (如扩容时搬移至新内存)
+		if (nontemporal::enabled(bytes) && (d + bytes <= s || s + bytes <= d))
+			nontemporal::copy(dest, src, bytes);
+		else
+			memmove(dest, src, bytes);
 		return result + count;
 	}
 
@@ -446,7 +4592,17 @@ private:
 	template <class ForwardIterator, class Size>
 	static ForwardIterator _fill_n_aux(ForwardIterator first, Size count,
 	                                   const_reference value, _true_type) {
-		mSTL::fill_n(first, count, value);
+		size_type total = static_cast<size_type>(count);
+		bool      stream = nontemporal::enabled(total * sizeof(T));
+		if (parallel_construct::enabled(total * sizeof(T))) {
+			parallel_construct::pool().parallel_for(
+			    0, total, parallel_construct::grain(total, sizeof(T)),
+			    [&](size_type begin, size_type end) {
+				    _fill_n_pod(first + begin, end - begin, value, stream);
+			    });
+		} else {
+			_fill_n_pod(first, total, value, stream);
+		}
 		return (first + count);
 	}
 
@@ -472,11 +4628,16 @@ private:
 public:
 	// uninitialized_copy() 函数调用
 	// 在此萃取出输入迭代器的 value type 特性, 即迭代器所指对象原生类型以实现重载
+	// 仅当输入为指向同类型 POD 对象的原生指针时整块内存拷贝
+	// list / deque 等非连续迭代器或需类型转换时逐个构造
 	template <class InputIterator, class ForwardIterator>
 	static inline ForwardIterator copy(InputIterator first, InputIterator last,
 	                                   ForwardIterator result) {
-		typedef typename _type_traits<
-		    typename iterator_traits<InputIterator>::value_type>::is_POD_type
+		typedef typename iterator_traits<InputIterator>::value_type input_type;
+		typedef typename IfThenElse<
+		    std::is_pointer<InputIterator>::value &&
+		        std::is_same<input_type, value_type>::value,
+		    typename _type_traits<value_type>::is_POD_type, _false_type>::result
 		    isPODType;
 		return _copy_aux(first, last, result, isPODType());
 	}
@@ -23,6 +23,12 @@ public:
 	using size_type = size_t;
 	using difference_type = ptrdiff_t;
 
+	// 获取其他类型的同类分配器，如 vector<bool> 以 word 为单位分配
+	template <class U>
+	struct rebind {
+		using other = allocator<U>;
+	};
+
 public:
 	// 调用 alloc 类函数执行空间分配
 	static pointer allocate();
@@ -115,12 +121,12 @@ void allocator<T>::_destory(pointer first, pointer last, _false_type) noexcept {
 
 template <class T>
 void allocator<T>::destroy(pointer ptr) noexcept {
-	typedef typename _type_traits<pointer>::is_POD_type is_POD_type;
+	typedef typename _type_traits<T>::is_POD_type is_POD_type;
 	allocator<T>::_destory(ptr, is_POD_type());
 }
 template <class T>
 void allocator<T>::destroy(pointer first, pointer last) noexcept {
-	typedef typename _type_traits<pointer>::is_POD_type is_POD_type;
+	typedef typename _type_traits<T>::is_POD_type is_POD_type;
 	allocator<T>::_destory(first, last, is_POD_type());
 }
 
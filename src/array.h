@@ -4,9 +4,12 @@
 #include "basic.h"
 
 #include "algorithm.h"
+#include "hash.h"
 #include "iterator.h"
 #include "uninitialized.h"
 
+#include <type_traits>
+
 MSTL_NAMESPACE_BEGIN
 
 // 数组 T[N]
@@ -33,6 +36,23 @@ struct _array_traits<T, 0> {
 	static constexpr T* static_ptr(const Type&) noexcept { return nullptr; }
 };
 
+// 未初始化数组空间，供 inplace_vector 等定长容器按需构造元素
+template <class T, size_t N>
+struct _uninitialized_array_traits {
+	typedef typename std::aligned_storage<sizeof(T), alignof(T)>::type Type[N];
+
+	static T* static_ptr(const Type& t) noexcept {
+		return reinterpret_cast<T*>(const_cast<Type&>(t));
+	}
+};
+
+template <class T>
+struct _uninitialized_array_traits<T, 0> {
+	struct Type {};
+
+	static T* static_ptr(const Type&) noexcept { return nullptr; }
+};
+
 template <class T, size_t N>
 struct array {
 	using value_type = T;
@@ -116,16 +136,14 @@ struct array {
 	void swap(array& other) noexcept {
 		mSTL::swap_ranges(begin(), end(), other.begin());
 	}
+
+	// 元素哈希值合并，相等的 array 哈希值相等
+	size_t hash() const { return mSTL::hash_range(data(), N); }
 };
 
 template <class T, size_t N>
 inline bool operator==(const array<T, N>& lhs, const array<T, N>& rhs) {
-	for (size_t i = 0; i < N; ++i) {
-		if (lhs[i] != rhs[i])
-			return false;
-	}
-
-	return true;
+	return mSTL::_contiguous_equal(lhs.data(), rhs.data(), N);
 }
 
 template <class T, size_t N>
@@ -135,14 +153,7 @@ inline bool operator!=(const array<T, N>& lhs, const array<T, N>& rhs) {
 
 template <class T, size_t N>
 inline bool operator<(const array<T, N>& lhs, const array<T, N>& rhs) {
-	for (size_t i = 0; i < N; ++i) {
-		if (lhs[i] > rhs[i])
-			return false;
-		else if (lhs[i] < rhs[i])
-			return true;
-	}
-
-	return false;
+	return mSTL::_contiguous_less(lhs.data(), N, rhs.data(), N);
 }
 
 template <class T, size_t N>
@@ -185,4 +196,12 @@ const T&& get(const mSTL::array<T, N>&& arr) noexcept {
 
 MSTL_NAMESPACE_END
 
+// 使 mSTL::array 可作为 std::unordered_map 等容器的键
+namespace std {
+template <class T, size_t N>
+struct hash<mSTL::array<T, N>> {
+	size_t operator()(const mSTL::array<T, N>& arr) const { return arr.hash(); }
+};
+} // namespace std
+
 #endif
\ No newline at end of file
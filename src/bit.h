@@ -0,0 +1,64 @@
+#ifndef BIT_H
+#define BIT_H
+
+#include "basic.h"
+
+#include <climits>
+
+MSTL_NAMESPACE_BEGIN
+
+// 位运算工具函数，接口参照 C++20 <bit>
+// GCC/Clang 下使用内建函数，编译为 popcnt/tzcnt/lzcnt (或 bsf/bsr) 指令
+// 参数统一为 unsigned long long，较窄类型传入时 countl_zero/bit_width 需自行换算
+
+enum { ULL_BITS = sizeof(unsigned long long) * CHAR_BIT };
+
+// 置位个数
+inline int popcount(unsigned long long x) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+	return __builtin_popcountll(x);
+#else
+	int count = 0;
+	for (; x != 0; x &= x - 1)
+		++count;
+	return count;
+#endif
+}
+
+// 低位连续 0 的个数，x == 0 时返回 ULL_BITS
+inline int countr_zero(unsigned long long x) noexcept {
+	if (x == 0)
+		return ULL_BITS;
+#if defined(__GNUC__) || defined(__clang__)
+	return __builtin_ctzll(x);
+#else
+	int count = 0;
+	for (; (x & 1) == 0; x >>= 1)
+		++count;
+	return count;
+#endif
+}
+
+// 高位连续 0 的个数，x == 0 时返回 ULL_BITS
+inline int countl_zero(unsigned long long x) noexcept {
+	if (x == 0)
+		return ULL_BITS;
+#if defined(__GNUC__) || defined(__clang__)
+	return __builtin_clzll(x);
+#else
+	int count = 0;
+	for (unsigned long long mask = 1ull << (ULL_BITS - 1); (x & mask) == 0;
+	     mask >>= 1)
+		++count;
+	return count;
+#endif
+}
+
+// 表示 x 所需的最少位数，即 floor(log2(x)) + 1，x == 0 时返回 0
+inline int bit_width(unsigned long long x) noexcept {
+	return ULL_BITS - countl_zero(x);
+}
+
+MSTL_NAMESPACE_END
+
+#endif
@@ -0,0 +1,506 @@
+#ifndef CONCURRENT_VECTOR_H
+#define CONCURRENT_VECTOR_H
+
+#include "basic.h"
+
+#include "algorithm.h"
+#include "allocator.h"
+#include "iterator.h"
+#include "segmented_vector.h"
+#include "type_traits.h"
+
+#include <atomic>
+#include <cassert>
+#include <initializer_list>
+#include <limits>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+MSTL_NAMESPACE_BEGIN
+
+// concurrent_vector
+// 支持多线程并发 push_back / emplace_back / grow_by 的分段 vector
+//  1. 通过对 size_ 的原子 fetch_add 预留下标，写线程之间互不阻塞
+//  2. 分段表布局同 segmented_vector，扩容时只追加新段，不移动已有元素
+//  3. 每个槽位附带发布标记，构造完成后以 release 语义置位，
+//     读线程通过 is_published() 以 acquire 语义确认后即可安全读取
+// 段分配通过互斥锁串行化，保证每段只分配一次
+// 段内存直接以 ::operator new 分配，不经过 Allocator: alloc 内存池为全局且非线程安全，
+// 较小的段 (如 16 个 int 连同发布标记仅 80 字节) 会落入内存池，与其他线程上的容器产生竞争
+// clear / shrink_to_fit / swap / 赋值等操作不可与其他操作并发执行
+template <class T, class Allocator = allocator<T>, size_t FirstBits = 4>
+class concurrent_vector {
+
+public:
+	using value_type = T;
+	using allocator_type = Allocator;
+	using size_type = size_t;
+	using difference_type = ptrdiff_t;
+	using reference = value_type&;
+	using const_reference = const value_type&;
+	using pointer = value_type*;
+	using const_pointer = const value_type*;
+
+	using traits_type = _segment_table_traits<FirstBits>;
+
+	template <bool IsConst>
+	class index_iterator;
+
+	using iterator = index_iterator<false>;
+	using const_iterator = index_iterator<true>;
+
+	using reverse_iterator = _reverse_iterator<iterator>;
+	using const_reverse_iterator = _reverse_iterator<const_iterator>;
+
+	// 以 (容器, 下标) 表示位置，解引用时经分段表定位
+	template <bool IsConst>
+	class index_iterator {
+	public:
+		using iterator_category = random_access_iterator_tag;
+		using value_type = T;
+		using difference_type = ptrdiff_t;
+		using pointer = typename IfThenElse<IsConst, const T*, T*>::result;
+		using reference = typename IfThenElse<IsConst, const T&, T&>::result;
+
+		using owner_type = typename IfThenElse<IsConst, const concurrent_vector,
+		                                       concurrent_vector>::result;
+		using self = index_iterator;
+
+	private:
+		owner_type* owner_;
+		size_type   index_;
+
+	public:
+		index_iterator() noexcept
+		    : owner_(nullptr)
+		    , index_(0) {}
+		index_iterator(owner_type* owner, size_type index) noexcept
+		    : owner_(owner)
+		    , index_(index) {}
+
+		// iterator -> const_iterator
+		template <bool B, class = typename std::enable_if<IsConst && !B>::type>
+		index_iterator(const index_iterator<B>& other) noexcept
+		    : owner_(other.owner())
+		    , index_(other.index()) {}
+
+		owner_type* owner() const noexcept { return owner_; }
+		size_type   index() const noexcept { return index_; }
+
+		reference operator*() const noexcept { return (*owner_)[index_]; }
+		pointer   operator->() const noexcept { return &(*owner_)[index_]; }
+		reference operator[](difference_type n) const noexcept {
+			return (*owner_)[index_ + n];
+		}
+
+		self& operator++() noexcept {
+			++index_;
+			return *this;
+		}
+		self operator++(int) noexcept {
+			self temp = *this;
+			++index_;
+			return temp;
+		}
+		self& operator--() noexcept {
+			--index_;
+			return *this;
+		}
+		self operator--(int) noexcept {
+			self temp = *this;
+			--index_;
+			return temp;
+		}
+
+		self& operator+=(difference_type n) noexcept {
+			index_ += n;
+			return *this;
+		}
+		self& operator-=(difference_type n) noexcept {
+			index_ -= n;
+			return *this;
+		}
+		self operator+(difference_type n) const noexcept {
+			return self(owner_, index_ + n);
+		}
+		self operator-(difference_type n) const noexcept {
+			return self(owner_, index_ - n);
+		}
+		difference_type operator-(const self& other) const noexcept {
+			return static_cast<difference_type>(index_) -
+			       static_cast<difference_type>(other.index_);
+		}
+
+		bool operator==(const self& other) const noexcept {
+			return index_ == other.index_ && owner_ == other.owner_;
+		}
+		bool operator!=(const self& other) const noexcept {
+			return !(*this == other);
+		}
+		bool operator<(const self& other) const noexcept {
+			return index_ < other.index_;
+		}
+		bool operator>(const self& other) const noexcept {
+			return other < *this;
+		}
+		bool operator<=(const self& other) const noexcept {
+			return !(other < *this);
+		}
+		bool operator>=(const self& other) const noexcept {
+			return !(*this < other);
+		}
+	};
+
+private:
+	using flag_type = std::atomic<unsigned char>;
+
+	// 每段为一块连续内存: [元素 * segment_size][发布标记 * segment_size]
+	std::atomic<pointer>   table_[traits_type::max_segments];
+	std::atomic<size_type> size_; // 已预留槽位数
+	std::mutex             grow_mutex_;
+
+public:
+	// (construct)(destruct)(copy)(operator=) ......
+
+	concurrent_vector() noexcept
+	    : size_(0) {
+		for (auto& segment : table_)
+			segment.store(nullptr, std::memory_order_relaxed);
+	}
+	explicit concurrent_vector(const size_type count,
+	                           const_reference value = value_type())
+	    : concurrent_vector() {
+		grow_by(count, value);
+	}
+	template <class InputIterator,
+	          class = typename std::enable_if<
+	              !std::is_integral<InputIterator>::value>::type>
+	concurrent_vector(InputIterator first, InputIterator last)
+	    : concurrent_vector() {
+		for (; first != last; ++first)
+			emplace_back(*first);
+	}
+
+	concurrent_vector(const concurrent_vector& other)
+	    : concurrent_vector(other.begin(), other.end()) {}
+	concurrent_vector(concurrent_vector&& other) noexcept
+	    : concurrent_vector() {
+		swap(other);
+	}
+	concurrent_vector& operator=(const concurrent_vector& other) {
+		if (this == &other)
+			return *this;
+
+		concurrent_vector temp(other);
+		swap(temp);
+		return *this;
+	}
+	concurrent_vector& operator=(concurrent_vector&& other) noexcept {
+		if (this == &other)
+			return *this;
+
+		concurrent_vector temp(std::move(other));
+		swap(temp);
+		return *this;
+	}
+
+	concurrent_vector(const std::initializer_list<T>& il)
+	    : concurrent_vector(il.begin(), il.end()) {}
+
+	~concurrent_vector() noexcept {
+		clear();
+		release_segments(0);
+	}
+
+	allocator_type get_allocator() { return allocator_type(); }
+
+	// Element access
+	// 仅可访问已发布元素
+
+	reference at(size_type pos) {
+		return is_published(pos) ? (*this)[pos] : throw "out of range";
+	}
+	const_reference at(size_type pos) const {
+		return is_published(pos) ? (*this)[pos] : throw "out of range";
+	}
+
+	reference operator[](size_type i) noexcept { return *slot(i); }
+	const_reference operator[](size_type i) const noexcept { return *slot(i); }
+
+	reference       front() { return (*this)[0]; }
+	const_reference front() const { return (*this)[0]; }
+
+	reference       back() { return (*this)[size() - 1]; }
+	const_reference back() const { return (*this)[size() - 1]; }
+
+	// 下标 i 处元素是否已构造完成，可与写操作并发调用
+	bool is_published(size_type i) const noexcept {
+		if (i >= size())
+			return false;
+
+		size_type segment = traits_type::segment_of(i);
+		pointer   base = table_[segment].load(std::memory_order_acquire);
+		return base != nullptr &&
+		       flags_of(base, segment)[traits_type::offset_of(i, segment)].load(
+		           std::memory_order_acquire) != 0;
+	}
+
+	// Iterators
+
+	iterator       begin() noexcept { return iterator(this, 0); }
+	const_iterator begin() const noexcept { return const_iterator(this, 0); }
+	const_iterator cbegin() const noexcept { return const_iterator(this, 0); }
+
+	iterator       end() noexcept { return iterator(this, size()); }
+	const_iterator end() const noexcept { return const_iterator(this, size()); }
+	const_iterator cend() const noexcept {
+		return const_iterator(this, size());
+	}
+
+	reverse_iterator rbegin() noexcept { return reverse_iterator(end() - 1); }
+	const_reverse_iterator rbegin() const noexcept {
+		return const_reverse_iterator(end() - 1);
+	}
+	const_reverse_iterator crbegin() const noexcept {
+		return const_reverse_iterator(end() - 1);
+	}
+
+	reverse_iterator rend() noexcept { return reverse_iterator(begin() - 1); }
+	const_reverse_iterator rend() const noexcept {
+		return const_reverse_iterator(begin() - 1);
+	}
+	const_reverse_iterator crend() const noexcept {
+		return const_reverse_iterator(begin() - 1);
+	}
+
+	// Capacity
+	// size() 为已预留槽位数，并发写入时其中可能包含尚未发布的元素
+
+	bool      empty() const noexcept { return size() == 0; }
+	size_type size() const noexcept {
+		return size_.load(std::memory_order_acquire);
+	}
+	size_type max_size() const noexcept {
+		return std::numeric_limits<difference_type>::max() /
+		       (sizeof(value_type) + sizeof(flag_type));
+	}
+	size_type capacity() const noexcept {
+		size_type segment = 0;
+		while (segment < traits_type::max_segments &&
+		       table_[segment].load(std::memory_order_acquire) != nullptr)
+			++segment;
+		return traits_type::segment_base(segment);
+	}
+
+	// 可与写操作并发调用
+	void reserve(size_type n) {
+		if (n > max_size())
+			throw "out of range";
+		if (n != 0)
+			ensure_segments(0, n);
+	}
+	// 释放未使用的段
+	void shrink_to_fit() noexcept {
+		size_type n = size();
+		release_segments(n == 0 ? 0 : traits_type::segment_of(n - 1) + 1);
+	}
+
+	// Modifiers
+
+	void clear() noexcept {
+		size_type n = size_.load(std::memory_order_relaxed);
+		for (size_type i = 0; i < n; ++i) {
+			size_type segment = traits_type::segment_of(i);
+			pointer   base = table_[segment].load(std::memory_order_relaxed);
+			flag_type& flag =
+			    flags_of(base, segment)[traits_type::offset_of(i, segment)];
+
+			if (flag.load(std::memory_order_relaxed) != 0) {
+				allocator_type::destroy(slot(i));
+				flag.store(0, std::memory_order_relaxed);
+			}
+		}
+		size_.store(0, std::memory_order_release);
+	}
+
+	iterator push_back(const_reference value) { return emplace_back(value); }
+	iterator push_back(value_type&& value) {
+		return emplace_back(std::move(value));
+	}
+
+	template <class... Args>
+	iterator emplace_back(Args&&... args) {
+		size_type index = size_.fetch_add(1, std::memory_order_acq_rel);
+		ensure_segments(index, index + 1);
+		publish(index, std::forward<Args>(args)...);
+		return iterator(this, index);
+	}
+
+	// 一次预留 n 个连续槽位并以 value 构造，返回首元素位置
+	iterator grow_by(size_type n, const_reference value = value_type()) {
+		size_type first = size_.fetch_add(n, std::memory_order_acq_rel);
+		if (n == 0)
+			return iterator(this, first);
+
+		ensure_segments(first, first + n);
+		for (size_type i = first; i != first + n; ++i)
+			publish(i, value);
+		return iterator(this, first);
+	}
+	template <class InputIterator,
+	          class = typename std::enable_if<
+	              !std::is_integral<InputIterator>::value>::type>
+	iterator grow_by(InputIterator first, InputIterator last) {
+		return range_grow_by(first, last, iterator_category(first));
+	}
+	iterator grow_by(const std::initializer_list<T>& il) {
+		return grow_by(il.begin(), il.end());
+	}
+
+	void swap(concurrent_vector& other) noexcept {
+		if (this == &other)
+			return;
+
+		for (size_type i = 0; i < traits_type::max_segments; ++i) {
+			pointer temp = table_[i].load(std::memory_order_relaxed);
+			table_[i].store(other.table_[i].load(std::memory_order_relaxed),
+			                std::memory_order_relaxed);
+			other.table_[i].store(temp, std::memory_order_relaxed);
+		}
+
+		size_type temp = size_.load(std::memory_order_relaxed);
+		size_.store(other.size_.load(std::memory_order_relaxed),
+		            std::memory_order_relaxed);
+		other.size_.store(temp, std::memory_order_relaxed);
+	}
+
+private:
+	// 单趟迭代器无法预先求出长度，先缓冲后一次预留连续槽位
+	// 缓冲区使用 std::vector，避免并发时经过 alloc 内存池
+	template <class InputIterator>
+	iterator range_grow_by(InputIterator first, InputIterator last,
+	                       input_iterator_tag) {
+		std::vector<value_type> buffer(first, last);
+		return range_grow_by(std::make_move_iterator(buffer.begin()),
+		                     std::make_move_iterator(buffer.end()),
+		                     forward_iterator_tag());
+	}
+	template <class ForwardIterator>
+	iterator range_grow_by(ForwardIterator first, ForwardIterator last,
+	                       forward_iterator_tag) {
+		size_type n = 0;
+		mSTL::distance(first, last, n);
+		size_type start = size_.fetch_add(n, std::memory_order_acq_rel);
+		if (n == 0)
+			return iterator(this, start);
+
+		ensure_segments(start, start + n);
+		for (size_type i = start; first != last; ++first, ++i)
+			publish(i, *first);
+		return iterator(this, start);
+	}
+
+	static size_type segment_bytes(size_type segment) noexcept {
+		return traits_type::segment_size(segment) *
+		       (sizeof(value_type) + sizeof(flag_type));
+	}
+	static flag_type* flags_of(pointer base, size_type segment) noexcept {
+		return reinterpret_cast<flag_type*>(base +
+		                                    traits_type::segment_size(segment));
+	}
+
+	pointer slot(size_type i) const noexcept {
+		size_type segment = traits_type::segment_of(i);
+		return table_[segment].load(std::memory_order_acquire) +
+		       traits_type::offset_of(i, segment);
+	}
+
+	// 构造元素后以 release 语义置位发布标记
+	template <class... Args>
+	void publish(size_type i, Args&&... args) {
+		size_type segment = traits_type::segment_of(i);
+		size_type offset = traits_type::offset_of(i, segment);
+		pointer   base = table_[segment].load(std::memory_order_acquire);
+
+		allocator_type::construct(base + offset, std::forward<Args>(args)...);
+		flags_of(base, segment)[offset].store(1, std::memory_order_release);
+	}
+
+	// 保证 [first, last) 所在各段均已分配
+	// 快速路径只需一次 acquire 读，段缺失时加锁分配
+	void ensure_segments(size_type first, size_type last) {
+		size_type first_segment = traits_type::segment_of(first);
+		size_type last_segment = traits_type::segment_of(last - 1);
+		assert(last_segment < traits_type::max_segments);
+
+		// 各写线程只分配自身所需的段，已分配段之间可能存在空缺，需逐段检查
+		size_type segment = first_segment;
+		while (segment <= last_segment &&
+		       table_[segment].load(std::memory_order_acquire) != nullptr)
+			++segment;
+		if (segment > last_segment)
+			return;
+
+		std::lock_guard<std::mutex> lock(grow_mutex_);
+		for (; segment <= last_segment; ++segment) {
+			if (table_[segment].load(std::memory_order_relaxed) != nullptr)
+				continue;
+
+			size_type count = traits_type::segment_size(segment);
+			pointer   base =
+			    static_cast<pointer>(::operator new(segment_bytes(segment)));
+
+			flag_type* flags = flags_of(base, segment);
+			for (size_type i = 0; i < count; ++i)
+				::new (static_cast<void*>(flags + i)) flag_type(0);
+
+			table_[segment].store(base, std::memory_order_release);
+		}
+	}
+
+	// 释放下标不小于 keep 的段
+	void release_segments(size_type keep) noexcept {
+		for (size_type segment = keep; segment < traits_type::max_segments;
+		     ++segment) {
+			pointer base = table_[segment].load(std::memory_order_relaxed);
+			if (base == nullptr)
+				continue;
+
+			::operator delete(static_cast<void*>(base));
+			table_[segment].store(nullptr, std::memory_order_relaxed);
+		}
+	}
+};
+
+template <class T, class Alloc, size_t B>
+bool operator==(const concurrent_vector<T, Alloc, B>& lhs,
+                const concurrent_vector<T, Alloc, B>& rhs) {
+	if (lhs.size() != rhs.size())
+		return false;
+
+	for (size_t i = 0; i < lhs.size(); ++i) {
+		if (lhs[i] != rhs[i])
+			return false;
+	}
+
+	return true;
+}
+
+template <class T, class Alloc, size_t B>
+bool operator!=(const concurrent_vector<T, Alloc, B>& lhs,
+                const concurrent_vector<T, Alloc, B>& rhs) {
+	return !(lhs == rhs);
+}
+
+template <class T, class Alloc, size_t B>
+void swap(concurrent_vector<T, Alloc, B>& lhs,
+          concurrent_vector<T, Alloc, B>& rhs) noexcept {
+	lhs.swap(rhs);
+}
+
+MSTL_NAMESPACE_END
+
+#endif
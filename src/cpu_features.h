@@ -0,0 +1,76 @@
+#ifndef CPU_FEATURES_H
+#define CPU_FEATURES_H
+
+#include "basic.h"
+
+#include <cstddef>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+// x86 且编译器支持 target 属性时启用 SIMD 内核
+// 内核函数以 MSTL_TARGET("avx2") 等单独标注指令集，无需全局开启 -mavx2
+// 调用前须经 cpu_features 运行时检测，保证旧处理器上不会执行未支持的指令
+#if (defined(__x86_64__) || defined(__i386__)) &&                              \
+    (defined(__GNUC__) || defined(__clang__))
+#define MSTL_X86_SIMD 1
+#define MSTL_TARGET(isa) __attribute__((target(isa)))
+#include <immintrin.h>
+#else
+#define MSTL_X86_SIMD 0
+#define MSTL_TARGET(isa)
+#endif
+
+MSTL_NAMESPACE_BEGIN
+
+// cpu_features
+// 运行时检测的处理器特性与缓存参数，首次调用时检测并缓存结果
+struct cpu_features {
+	bool sse2;
+	bool sse41;
+	bool avx2;
+	bool avx512f;
+	bool avx512bw;
+
+	size_t cache_line_size;
+	size_t last_level_cache_size; // 末级缓存容量，无法检测时为 0
+
+	static const cpu_features& get() noexcept {
+		static const cpu_features features = detect();
+		return features;
+	}
+
+private:
+	static cpu_features detect() noexcept {
+		cpu_features features = {false, false, false, false, false, 64, 0};
+
+#if MSTL_X86_SIMD
+		__builtin_cpu_init();
+		features.sse2 = __builtin_cpu_supports("sse2");
+		features.sse41 = __builtin_cpu_supports("sse4.1");
+		features.avx2 = __builtin_cpu_supports("avx2");
+		features.avx512f = __builtin_cpu_supports("avx512f");
+		features.avx512bw = __builtin_cpu_supports("avx512bw");
+#endif
+
+#if defined(_SC_LEVEL1_DCACHE_LINESIZE)
+		long line = sysconf(_SC_LEVEL1_DCACHE_LINESIZE);
+		if (line > 0)
+			features.cache_line_size = static_cast<size_t>(line);
+#endif
+#if defined(_SC_LEVEL3_CACHE_SIZE) && defined(_SC_LEVEL2_CACHE_SIZE)
+		long cache = sysconf(_SC_LEVEL3_CACHE_SIZE);
+		if (cache <= 0)
+			cache = sysconf(_SC_LEVEL2_CACHE_SIZE);
+		if (cache > 0)
+			features.last_level_cache_size = static_cast<size_t>(cache);
+#endif
+
+		return features;
+	}
+};
+
+MSTL_NAMESPACE_END
+
+#endif
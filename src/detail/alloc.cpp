@@ -53,7 +53,8 @@ void* alloc::refill(size_t size) {
 	}
 
 	// 最后一个内存块
-	current_obj->next = nullptr;
+	// nobjs == 2 时循环不会执行，此时 current_obj 仍为 nullptr
+	next_obj->next = nullptr;
 
 	return result;
 	
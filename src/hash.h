@@ -0,0 +1,84 @@
+#ifndef HASH_H
+#define HASH_H
+
+#include "basic.h"
+
+#include "type_traits.h"
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+
+MSTL_NAMESPACE_BEGIN
+
+// 哈希工具函数
+// hash_combine(): 将 value 合并入 seed，同 boost::hash_combine
+// hash_bytes(): 连续内存的哈希，每次处理 8 字节，混合方式参照 MurmurHash3
+// hash_range(): [first, first + n) 的哈希，供连续存储容器的 hash() 使用
+//               按位相等的类型 (见 _comparison_traits) 直接哈希内存，否则逐元素 std::hash 后合并
+
+inline void hash_combine(size_t& seed, size_t value) noexcept {
+	seed ^= value + static_cast<size_t>(0x9e3779b97f4a7c15ULL) + (seed << 6) +
+	        (seed >> 2);
+}
+
+inline uint64_t _hash_fmix64(uint64_t x) noexcept {
+	x ^= x >> 33;
+	x *= 0xff51afd7ed558ccdULL;
+	x ^= x >> 33;
+	x *= 0xc4ceb9fe1a85ec53ULL;
+	x ^= x >> 33;
+	return x;
+}
+
+inline uint64_t _hash_block(uint64_t h, uint64_t k) noexcept {
+	k *= 0x87c37b91114253d5ULL;
+	k = (k << 31) | (k >> 33);
+	k *= 0x4cf5ad432745937fULL;
+	h ^= k;
+	h = (h << 27) | (h >> 37);
+	return h * 5 + 0x52dce729;
+}
+
+inline size_t hash_bytes(const void* data, size_t bytes,
+                         size_t seed = 0) noexcept {
+	const unsigned char* p = static_cast<const unsigned char*>(data);
+	uint64_t             h = seed;
+
+	size_t i = 0;
+	for (; i + 8 <= bytes; i += 8) {
+		uint64_t k;
+		memcpy(&k, p + i, 8);
+		h = _hash_block(h, k);
+	}
+	if (i != bytes) {
+		uint64_t k = 0;
+		memcpy(&k, p + i, bytes - i);
+		h = _hash_block(h, k);
+	}
+
+	return static_cast<size_t>(_hash_fmix64(h ^ bytes));
+}
+
+template <class T>
+size_t _hash_range_aux(const T* first, size_t n, _true_type) noexcept {
+	return n == 0 ? hash_bytes(nullptr, 0) : hash_bytes(first, n * sizeof(T));
+}
+
+template <class T>
+size_t _hash_range_aux(const T* first, size_t n, _false_type) {
+	size_t seed = n;
+	for (size_t i = 0; i < n; ++i)
+		hash_combine(seed, std::hash<T>()(first[i]));
+	return seed;
+}
+
+template <class T>
+size_t hash_range(const T* first, size_t n) {
+	typedef typename _comparison_traits<T>::is_bitwise_equal isBitwiseEqual;
+	return _hash_range_aux(first, n, isBitwiseEqual());
+}
+
+MSTL_NAMESPACE_END
+
+#endif
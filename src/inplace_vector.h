@@ -0,0 +1,568 @@
+#ifndef INPLACE_VECTOR_H
+#define INPLACE_VECTOR_H
+
+#include "basic.h"
+
+#include "algorithm.h"
+#include "allocator.h"
+#include "array.h"
+#include "iterator.h"
+#include "type_traits.h"
+
+#include <cassert>
+#include <initializer_list>
+#include <type_traits>
+#include <utility>
+
+MSTL_NAMESPACE_BEGIN
+
+// inplace_vector (static_vector)
+// 容量固定为 N 的变长容器，元素存放于对象内部的未初始化数组中，从不进行堆分配
+// 超出容量时 push_back/insert 抛出异常，try_push_back 返回 nullptr
+// unchecked_push_back 不做检查，调用者需保证 size() < N
+
+// 根据 N 选取能容纳元素个数的最小无符号类型
+template <size_t N>
+struct _inplace_size_type {
+	using type = typename IfThenElse<
+	    (N <= 0xffu), unsigned char,
+	    typename IfThenElse<
+	        (N <= 0xffffu), unsigned short,
+	        typename IfThenElse<(N <= 0xffffffffu), unsigned int,
+	                            size_t>::result>::result>::result;
+};
+
+// 存储基类
+// T 可平凡复制时采用默认的复制/移动/析构函数，使 inplace_vector 自身亦可平凡复制
+template <class T, size_t N, bool = std::is_trivially_copyable<T>::value>
+struct _inplace_vector_base {
+	typedef _uninitialized_array_traits<T, N>      AT_Type;
+	typedef typename _inplace_size_type<N>::type size_holder;
+
+	typename AT_Type::Type M_elems;
+	size_holder            M_size;
+
+	_inplace_vector_base() noexcept
+	    : M_size(0) {}
+
+	T* M_data() const noexcept { return AT_Type::static_ptr(M_elems); }
+};
+
+template <class T, size_t N>
+struct _inplace_vector_base<T, N, false> {
+	typedef _uninitialized_array_traits<T, N>      AT_Type;
+	typedef typename _inplace_size_type<N>::type size_holder;
+
+	typename AT_Type::Type M_elems;
+	size_holder            M_size;
+
+	_inplace_vector_base() noexcept
+	    : M_size(0) {}
+
+	_inplace_vector_base(const _inplace_vector_base& other)
+	    : M_size(0) {
+		uninitialized_mem_func<T>::copy(other.M_data(),
+		                                other.M_data() + other.M_size, M_data());
+		M_size = other.M_size;
+	}
+	_inplace_vector_base(_inplace_vector_base&& other)
+	    : M_size(0) {
+		uninitialized_mem_func<T>::move(other.M_data(),
+		                                other.M_data() + other.M_size, M_data());
+		M_size = other.M_size;
+	}
+	_inplace_vector_base& operator=(const _inplace_vector_base& other) {
+		if (this == &other)
+			return *this;
+
+		M_clear();
+		uninitialized_mem_func<T>::copy(other.M_data(),
+		                                other.M_data() + other.M_size, M_data());
+		M_size = other.M_size;
+		return *this;
+	}
+	_inplace_vector_base& operator=(_inplace_vector_base&& other) {
+		if (this == &other)
+			return *this;
+
+		M_clear();
+		uninitialized_mem_func<T>::move(other.M_data(),
+		                                other.M_data() + other.M_size, M_data());
+		M_size = other.M_size;
+		return *this;
+	}
+
+	~_inplace_vector_base() noexcept { M_clear(); }
+
+	T* M_data() const noexcept { return AT_Type::static_ptr(M_elems); }
+
+	void M_clear() noexcept {
+		allocator<T>::destroy(M_data(), M_data() + M_size);
+		M_size = 0;
+	}
+};
+
+template <class T, size_t N>
+class inplace_vector : private _inplace_vector_base<T, N> {
+	typedef _inplace_vector_base<T, N> base_type;
+
+public:
+	using value_type = T;
+	using size_type = size_t;
+	using difference_type = ptrdiff_t;
+	using reference = value_type&;
+	using const_reference = const value_type&;
+	using pointer = value_type*;
+	using const_pointer = const value_type*;
+
+	using iterator = value_type*;
+	using const_iterator = const value_type*;
+
+	using reverse_iterator = _reverse_iterator<iterator>;
+	using const_reverse_iterator = _reverse_iterator<const_iterator>;
+
+	using uninitialized_mem_func_type = uninitialized_mem_func<value_type>;
+
+private:
+	typedef allocator<value_type>                              construct_type;
+	typedef typename _type_traits<value_type>::is_POD_type isPODType;
+
+	using base_type::M_size;
+
+public:
+	// (construct)(destruct)(copy)(operator=)(assign) ......
+	// 复制、移动及析构由存储基类提供
+
+	inplace_vector() = default;
+	inplace_vector(const size_type count, const_reference value = value_type()) {
+		assign(count, value);
+	}
+	template <class InputIterator,
+	          class = typename std::enable_if<
+	              !std::is_integral<InputIterator>::value>::type>
+	inplace_vector(InputIterator first, InputIterator last) {
+		assign(first, last);
+	}
+	inplace_vector(const std::initializer_list<T>& il) {
+		assign(il.begin(), il.end());
+	}
+	inplace_vector& operator=(const std::initializer_list<T>& il) {
+		assign(il.begin(), il.end());
+		return *this;
+	}
+
+	void assign(size_type count, const_reference value) {
+		check_capacity(count);
+
+		value_type copy(value);
+		clear();
+		uninitialized_mem_func_type::fill_n(begin(), count, copy);
+		set_size(count);
+	}
+	template <class InputIterator,
+	          class = typename std::enable_if<
+	              !std::is_integral<InputIterator>::value>::type>
+	void assign(InputIterator first, InputIterator last) {
+		range_assign(first, last, iterator_category(first));
+	}
+	void assign(const std::initializer_list<T>& il) {
+		assign(il.begin(), il.end());
+	}
+
+	// Element access
+
+	reference at(size_type pos) {
+		return pos < size() ? *(begin() + pos) : throw "out of range";
+	}
+	const_reference at(size_type pos) const {
+		return pos < size() ? *(begin() + pos) : throw "out of range";
+	}
+
+	reference operator[](const difference_type i) { return *(begin() + i); }
+	const_reference operator[](const difference_type i) const {
+		return *(cbegin() + i);
+	}
+
+	reference       front() { return *(begin()); }
+	const_reference front() const { return *(begin()); }
+
+	reference       back() { return *(end() - 1); }
+	const_reference back() const { return *(end() - 1); }
+
+	pointer       data() noexcept { return base_type::M_data(); }
+	const_pointer data() const noexcept { return base_type::M_data(); }
+
+	// Iterators
+
+	iterator       begin() noexcept { return data(); }
+	const_iterator begin() const noexcept { return data(); }
+	const_iterator cbegin() const noexcept { return data(); }
+
+	iterator       end() noexcept { return data() + size(); }
+	const_iterator end() const noexcept { return data() + size(); }
+	const_iterator cend() const noexcept { return data() + size(); }
+
+	reverse_iterator rbegin() noexcept { return reverse_iterator(end() - 1); }
+	const_reverse_iterator rbegin() const noexcept {
+		return const_reverse_iterator(end() - 1);
+	}
+	const_reverse_iterator crbegin() const noexcept {
+		return const_reverse_iterator(end() - 1);
+	}
+
+	reverse_iterator rend() noexcept { return reverse_iterator(begin() - 1); }
+	const_reverse_iterator rend() const noexcept {
+		return const_reverse_iterator(begin() - 1);
+	}
+	const_reverse_iterator crend() const noexcept {
+		return const_reverse_iterator(begin() - 1);
+	}
+
+	// Capacity
+
+	bool      empty() const noexcept { return M_size == 0; }
+	size_type size() const noexcept { return static_cast<size_type>(M_size); }
+	static constexpr size_type max_size() noexcept { return N; }
+	static constexpr size_type capacity() noexcept { return N; }
+
+	static void reserve(size_type n) { check_capacity(n); }
+	static void shrink_to_fit() noexcept {}
+
+	// Modifiers
+
+	void clear() noexcept {
+		construct_type::destroy(begin(), end());
+		M_size = 0;
+	}
+	iterator insert(const_iterator pos, const_reference value) {
+		return emplace(pos, value);
+	}
+	iterator insert(const_iterator pos, value_type&& value) {
+		return emplace(pos, std::move(value));
+	}
+	iterator insert(const_iterator pos, size_type count,
+	                const_reference value) {
+		value_type copy(value);
+		pointer    new_pos = make_empty_before_pos(const_cast<pointer>(pos),
+		                                           count);
+
+		uninitialized_mem_func_type::fill_n(new_pos, count, copy);
+		return new_pos;
+	}
+	template <class InputIterator,
+	          class = typename std::enable_if<
+	              !std::is_integral<InputIterator>::value>::type>
+	iterator insert(const_iterator pos, InputIterator first,
+	                InputIterator last) {
+		return range_insert(pos, first, last, iterator_category(first));
+	}
+	iterator insert(const_iterator pos, const std::initializer_list<T>& il) {
+		return insert(pos, il.begin(), il.end());
+	}
+
+	template <class... Args>
+	iterator emplace(const_iterator pos, Args&&... args) {
+		if (pos == cend())
+			return &emplace_back(std::forward<Args>(args)...);
+
+		// 先构造临时对象，避免 args 引用自身元素时在移动后失效
+		value_type value(std::forward<Args>(args)...);
+		pointer    new_pos =
+		    make_empty_before_pos(const_cast<pointer>(pos), 1);
+
+		construct_type::construct(new_pos, std::move(value));
+		return new_pos;
+	}
+
+	iterator erase(const_iterator position) {
+		return erase(position, (position + 1));
+	}
+	iterator erase(const_iterator first, const_iterator last) {
+		pointer   pos = const_cast<pointer>(first);
+		size_type count = static_cast<size_type>(last - first);
+
+		construct_type::destroy(pos, const_cast<pointer>(last));
+		memmove_aux(pos, pos + count, static_cast<size_type>(end() - last),
+		            isPODType(), _common_direction());
+		set_size(size() - count);
+
+		return pos;
+	}
+
+	// 容量不足时抛出异常
+	void push_back(const_reference value) { emplace_back(value); }
+	void push_back(value_type&& value) { emplace_back(std::move(value)); }
+
+	template <class... Args>
+	reference emplace_back(Args&&... args) {
+		check_capacity(size() + 1);
+		return unchecked_emplace_back(std::forward<Args>(args)...);
+	}
+
+	// 容量不足时返回 nullptr，不修改容器
+	pointer try_push_back(const_reference value) {
+		return try_emplace_back(value);
+	}
+	pointer try_push_back(value_type&& value) {
+		return try_emplace_back(std::move(value));
+	}
+
+	template <class... Args>
+	pointer try_emplace_back(Args&&... args) {
+		if (size() == N)
+			return nullptr;
+		return &unchecked_emplace_back(std::forward<Args>(args)...);
+	}
+
+	// 不检查容量，调用者需保证 size() < N
+	void unchecked_push_back(const_reference value) {
+		unchecked_emplace_back(value);
+	}
+	void unchecked_push_back(value_type&& value) {
+		unchecked_emplace_back(std::move(value));
+	}
+
+	template <class... Args>
+	reference unchecked_emplace_back(Args&&... args) {
+		assert(size() < N);
+
+		pointer pos = end();
+		construct_type::construct(pos, std::forward<Args>(args)...);
+		++M_size;
+		return *pos;
+	}
+
+	void pop_back() {
+		--M_size;
+		construct_type::destroy(end());
+	}
+
+	void resize(size_type count, const_reference value = value_type()) {
+		size_type old_size = size();
+
+		if (count < old_size) {
+			construct_type::destroy(begin() + count, end());
+		} else if (count > old_size) {
+			check_capacity(count);
+			uninitialized_mem_func_type::fill_n(end(), count - old_size, value);
+		}
+
+		set_size(count);
+	}
+
+	void swap(inplace_vector& other) {
+		if (this == &other)
+			return;
+
+		inplace_vector temp(std::move(other));
+		other = std::move(*this);
+		*this = std::move(temp);
+	}
+
+private:
+	static void check_capacity(size_type count) {
+		if (count > N)
+			throw "out of capacity";
+	}
+
+	void set_size(size_type count) noexcept {
+		M_size = static_cast<typename base_type::size_holder>(count);
+	}
+
+	inline pointer make_empty_before_pos(pointer pos, size_type count);
+
+	// 按迭代器类别分发: input iterator 逐个追加，forward iterator 先求出元素个数
+	template <class InputIterator>
+	void range_assign(InputIterator first, InputIterator last,
+	                  input_iterator_tag);
+	template <class ForwardIterator>
+	void range_assign(ForwardIterator first, ForwardIterator last,
+	                  forward_iterator_tag);
+
+	template <class InputIterator>
+	iterator range_insert(const_iterator pos, InputIterator first,
+	                      InputIterator last, input_iterator_tag);
+	template <class ForwardIterator>
+	iterator range_insert(const_iterator pos, ForwardIterator first,
+	                      ForwardIterator last, forward_iterator_tag);
+
+	// 非 POD 类型移动后同时析构源对象
+	inline void memmove_aux(pointer dest, pointer src, size_type count,
+	                        _true_type, _direction);
+
+	inline void memmove_aux(pointer dest, pointer src, size_type count,
+	                        _false_type, _common_direction);
+	inline void memmove_aux(pointer dest, pointer src, size_type count,
+	                        _false_type, _reverse_direction);
+};
+
+template <class T, size_t N>
+bool operator==(const inplace_vector<T, N>& lhs,
+                const inplace_vector<T, N>& rhs) {
+	if (lhs.size() != rhs.size())
+		return false;
+
+	for (size_t i = 0; i < lhs.size(); ++i) {
+		if (lhs[i] != rhs[i])
+			return false;
+	}
+
+	return true;
+}
+
+template <class T, size_t N>
+bool operator!=(const inplace_vector<T, N>& lhs,
+                const inplace_vector<T, N>& rhs) {
+	return !(lhs == rhs);
+}
+
+template <class T, size_t N>
+bool operator<(const inplace_vector<T, N>& lhs,
+               const inplace_vector<T, N>& rhs) {
+
+	size_t min_size = mSTL::min(lhs.size(), rhs.size());
+
+	for (size_t i = 0; i < min_size; ++i) {
+		if (lhs[i] > rhs[i])
+			return false;
+		else if (lhs[i] < rhs[i])
+			return true;
+	}
+
+	return lhs.size() < rhs.size();
+}
+
+template <class T, size_t N>
+bool operator<=(const inplace_vector<T, N>& lhs,
+                const inplace_vector<T, N>& rhs) {
+	return !(rhs < lhs);
+}
+
+template <class T, size_t N>
+bool operator>(const inplace_vector<T, N>& lhs,
+               const inplace_vector<T, N>& rhs) {
+	return rhs < lhs;
+}
+
+template <class T, size_t N>
+bool operator>=(const inplace_vector<T, N>& lhs,
+                const inplace_vector<T, N>& rhs) {
+	return !(lhs < rhs);
+}
+
+template <class T, size_t N>
+void swap(inplace_vector<T, N>& lhs, inplace_vector<T, N>& rhs) {
+	lhs.swap(rhs);
+}
+
+// implement
+
+///<- private function
+
+// 在 pos 前空出 count 个未初始化位置，返回空出区间的起始位置
+template <class T, size_t N>
+inline typename inplace_vector<T, N>::pointer
+inplace_vector<T, N>::make_empty_before_pos(pointer pos, size_type count) {
+	size_type new_size = size() + count;
+	check_capacity(new_size);
+
+	memmove_aux((pos + count), pos, static_cast<size_type>(end() - pos),
+	            isPODType(), _reverse_direction());
+	set_size(new_size);
+
+	return pos;
+}
+
+template <class T, size_t N>
+template <class InputIterator>
+void inplace_vector<T, N>::range_assign(InputIterator first,
+                                        InputIterator last,
+                                        input_iterator_tag) {
+	clear();
+	for (; first != last; ++first)
+		emplace_back(*first);
+}
+
+template <class T, size_t N>
+template <class ForwardIterator>
+void inplace_vector<T, N>::range_assign(ForwardIterator first,
+                                        ForwardIterator last,
+                                        forward_iterator_tag) {
+	size_type count = 0;
+	mSTL::distance(first, last, count);
+	check_capacity(count);
+
+	clear();
+	uninitialized_mem_func_type::copy(first, last, begin());
+	set_size(count);
+}
+
+template <class T, size_t N>
+template <class InputIterator>
+typename inplace_vector<T, N>::iterator
+inplace_vector<T, N>::range_insert(const_iterator pos, InputIterator first,
+                                   InputIterator last, input_iterator_tag) {
+	// 无法预知元素个数，先追加至尾部再旋转至插入位置
+	// 超出容量时撤销已追加的元素，原有元素保持不变
+	const size_type index = static_cast<size_type>(pos - cbegin());
+	const size_type old_size = size();
+	try {
+		for (; first != last; ++first)
+			emplace_back(*first);
+	} catch (...) {
+		construct_type::destroy(begin() + old_size, end());
+		set_size(old_size);
+		throw;
+	}
+
+	std::rotate(begin() + index, begin() + old_size, end());
+	return begin() + index;
+}
+
+template <class T, size_t N>
+template <class ForwardIterator>
+typename inplace_vector<T, N>::iterator
+inplace_vector<T, N>::range_insert(const_iterator pos, ForwardIterator first,
+                                   ForwardIterator last, forward_iterator_tag) {
+	size_type count = 0;
+	mSTL::distance(first, last, count);
+
+	pointer new_pos = make_empty_before_pos(const_cast<pointer>(pos), count);
+	uninitialized_mem_func_type::copy(first, last, new_pos);
+	return new_pos;
+}
+
+template <class T, size_t N>
+inline void inplace_vector<T, N>::memmove_aux(pointer dest, pointer src,
+                                              size_type count, _true_type,
+                                              _direction) {
+	if (count != 0)
+		memmove(dest, src, count * sizeof(value_type));
+}
+
+template <class T, size_t N>
+inline void inplace_vector<T, N>::memmove_aux(pointer dest, pointer src,
+                                              size_type count, _false_type,
+                                              _common_direction) {
+	for (size_type i = 0; i < count; ++i, ++src, ++dest) {
+		construct_type::construct(dest, std::move(*src));
+		construct_type::destroy(src);
+	}
+}
+
+template <class T, size_t N>
+inline void inplace_vector<T, N>::memmove_aux(pointer dest, pointer src,
+                                              size_type count, _false_type,
+                                              _reverse_direction) {
+
+	// 反方向即需要移动 [src, src + count) 元素至 [dest, dest + count)
+	pointer src_reverse = src + count - 1, dest_reverse = dest + count - 1;
+	for (size_type i = 0; i < count; ++i, --src_reverse, --dest_reverse) {
+		construct_type::construct(dest_reverse, std::move(*src_reverse));
+		construct_type::destroy(src_reverse);
+	}
+}
+
+MSTL_NAMESPACE_END
+
+#endif
@@ -3,6 +3,8 @@
 
 #include "basic.h"
 
+#include <iterator>
+
 MSTL_NAMESPACE_BEGIN
 
 // STL迭代器定义
@@ -91,13 +93,41 @@ struct _iterator {
 
 #ifdef __STL_CLASS_PARTIAL_SPECIALIZATION
 
+// 标准库迭代器的类别标记映射为对应的 mSTL 标记
+// 使 std::list / std::istream_iterator 等迭代器同样可参与 mSTL 的类别分发
+template <class Category>
+struct _iterator_category_from_std {
+	typedef Category type;
+};
+template <>
+struct _iterator_category_from_std<std::input_iterator_tag> {
+	typedef input_iterator_tag type;
+};
+template <>
+struct _iterator_category_from_std<std::output_iterator_tag> {
+	typedef output_iterator_tag type;
+};
+template <>
+struct _iterator_category_from_std<std::forward_iterator_tag> {
+	typedef forward_iterator_tag type;
+};
+template <>
+struct _iterator_category_from_std<std::bidirectional_iterator_tag> {
+	typedef bidirectional_iterator_tag type;
+};
+template <>
+struct _iterator_category_from_std<std::random_access_iterator_tag> {
+	typedef random_access_iterator_tag type;
+};
+
 // iterator_traits定义
 // 用于萃取出迭代器所指对象的型别
 template <class Iterator>
 struct iterator_traits {
 
 	// 迭代器类型, STL提供五种迭代器
-	typedef typename Iterator::iterator_category iterator_category;
+	typedef typename _iterator_category_from_std<
+	    typename Iterator::iterator_category>::type iterator_category;
 
 	// 迭代器所指对象的型别
 	// 如果想与 STL 算法兼容, 那么在类内需要提供 value_type 定义
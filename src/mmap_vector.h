@@ -0,0 +1,437 @@
+#ifndef MMAP_VECTOR_H
+#define MMAP_VECTOR_H
+
+#include "basic.h"
+
+#include "algorithm.h"
+#include "iterator.h"
+#include "span.h"
+
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <limits>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MSTL_NAMESPACE_BEGIN
+
+// 映射方式
+enum class mmap_mode {
+	read_only,  // PROT_READ，修改操作抛出异常
+	read_write, // PROT_READ | PROT_WRITE，文件不存在时创建
+};
+
+// 刷新策略，决定 close / 析构时如何将脏页写回文件
+enum class mmap_flush {
+	manual,         // 仅在显式调用 flush() 时写回
+	async_on_close, // 关闭时 msync(MS_ASYNC)
+	sync_on_close,  // 关闭时 msync(MS_SYNC)
+};
+
+// 访问模式提示，对应 madvise
+enum class mmap_advice {
+	normal,
+	sequential,
+	random,
+	willneed,
+	dontneed,
+};
+
+// mmap_vector
+// 以文件映射作为存储的 vector，仅支持 trivially copyable 类型
+// 文件内容即为元素的原始字节，打开时无需逐个读取，数据量可超过物理内存
+// 扩容时 ftruncate 扩展文件并 mremap 重新映射 (不支持 mremap 的平台退化为
+// munmap + mmap)，因此同 vector 一样扩容后迭代器与指针失效
+// 文件长度按容量分配，关闭时截断为 size() 个元素
+template <class T>
+class mmap_vector {
+	static_assert(std::is_trivially_copyable<T>::value,
+	              "mmap_vector requires trivially copyable T");
+
+public:
+	using value_type = T;
+	using size_type = size_t;
+	using difference_type = ptrdiff_t;
+	using reference = value_type&;
+	using const_reference = const value_type&;
+	using pointer = value_type*;
+	using const_pointer = const value_type*;
+
+	using iterator = value_type*;
+	using const_iterator = const value_type*;
+
+	using reverse_iterator = _reverse_iterator<iterator>;
+	using const_reverse_iterator = _reverse_iterator<const_iterator>;
+
+private:
+	int        fd_;
+	pointer    start_;
+	size_type  size_;
+	size_type  capacity_;
+	mmap_mode  mode_;
+	mmap_flush flush_;
+
+public:
+	// (construct)(destruct)(move)(operator=) ......
+	// 映射不可复制
+
+	mmap_vector() noexcept
+	    : fd_(-1)
+	    , start_(nullptr)
+	    , size_(0)
+	    , capacity_(0)
+	    , mode_(mmap_mode::read_only)
+	    , flush_(mmap_flush::manual) {}
+	explicit mmap_vector(const std::string& path,
+	                     mmap_mode  mode = mmap_mode::read_only,
+	                     mmap_flush flush = mmap_flush::async_on_close)
+	    : mmap_vector() {
+		open(path, mode, flush);
+	}
+
+	mmap_vector(const mmap_vector&) = delete;
+	mmap_vector& operator=(const mmap_vector&) = delete;
+
+	mmap_vector(mmap_vector&& other) noexcept
+	    : mmap_vector() {
+		swap(other);
+	}
+	mmap_vector& operator=(mmap_vector&& other) noexcept {
+		if (this == &other)
+			return *this;
+
+		close();
+		swap(other);
+		return *this;
+	}
+
+	~mmap_vector() noexcept { close(); }
+
+	// 打开并映射文件，文件长度需为 sizeof(T) 的整数倍
+	void open(const std::string& path, mmap_mode mode = mmap_mode::read_only,
+	          mmap_flush flush = mmap_flush::async_on_close) {
+		close();
+
+		int flags = mode == mmap_mode::read_write ? (O_RDWR | O_CREAT) : O_RDONLY;
+		int fd = ::open(path.c_str(), flags, 0644);
+		if (fd < 0)
+			throw "mmap_vector: open failed";
+
+		struct stat st;
+		if (::fstat(fd, &st) != 0 ||
+		    static_cast<size_type>(st.st_size) % sizeof(value_type) != 0) {
+			::close(fd);
+			throw "mmap_vector: invalid file size";
+		}
+
+		fd_ = fd;
+		mode_ = mode;
+		flush_ = flush;
+		size_ = capacity_ =
+		    static_cast<size_type>(st.st_size) / sizeof(value_type);
+
+		if (capacity_ != 0) {
+			start_ = static_cast<pointer>(map(capacity_));
+			if (start_ == nullptr) {
+				reset();
+				throw "mmap_vector: mmap failed";
+			}
+		}
+	}
+
+	// 按刷新策略写回后解除映射，可写映射将文件截断为 size() 个元素
+	void close() noexcept {
+		if (fd_ < 0)
+			return;
+
+		if (flush_ != mmap_flush::manual)
+			flush(flush_ == mmap_flush::async_on_close);
+		if (start_ != nullptr)
+			::munmap(start_, bytes(capacity_));
+		if (mode_ == mmap_mode::read_write &&
+		    ::ftruncate(fd_, static_cast<off_t>(bytes(size_))) != 0) {
+			// 截断失败时文件保留容量长度，无法在 noexcept 中报告
+		}
+
+		reset();
+	}
+
+	bool       is_open() const noexcept { return fd_ >= 0; }
+	mmap_mode  mode() const noexcept { return mode_; }
+	mmap_flush flush_policy() const noexcept { return flush_; }
+	void       set_flush_policy(mmap_flush flush) noexcept { flush_ = flush; }
+
+	// 将 [0, size()) 对应的脏页写回文件
+	void flush(bool async = false) noexcept {
+		if (start_ != nullptr && mode_ == mmap_mode::read_write && size_ != 0)
+			(void)::msync(start_, bytes(size_), async ? MS_ASYNC : MS_SYNC);
+	}
+
+	// 访问模式提示，不影响正确性
+	void advise(mmap_advice advice) noexcept {
+		if (start_ != nullptr)
+			(void)::madvise(start_, bytes(capacity_), to_madvise(advice));
+	}
+	void advise(mmap_advice advice, size_type first, size_type count) noexcept {
+		if (start_ == nullptr || count == 0)
+			return;
+
+		// madvise 要求起始地址按页对齐
+		size_type page = static_cast<size_type>(::sysconf(_SC_PAGESIZE));
+		uintptr_t begin = reinterpret_cast<uintptr_t>(start_ + first);
+		uintptr_t aligned = begin & ~static_cast<uintptr_t>(page - 1);
+		(void)::madvise(reinterpret_cast<void*>(aligned),
+		                bytes(count) + (begin - aligned), to_madvise(advice));
+	}
+
+	// Element access
+
+	reference at(size_type pos) {
+		return pos < size_ ? start_[pos] : throw "out of range";
+	}
+	const_reference at(size_type pos) const {
+		return pos < size_ ? start_[pos] : throw "out of range";
+	}
+
+	reference       operator[](size_type i) { return start_[i]; }
+	const_reference operator[](size_type i) const { return start_[i]; }
+
+	reference       front() { return start_[0]; }
+	const_reference front() const { return start_[0]; }
+
+	reference       back() { return start_[size_ - 1]; }
+	const_reference back() const { return start_[size_ - 1]; }
+
+	pointer       data() noexcept { return start_; }
+	const_pointer data() const noexcept { return start_; }
+
+	span<value_type>       as_span() noexcept { return {start_, size_}; }
+	span<const value_type> as_span() const noexcept { return {start_, size_}; }
+
+	// Iterators
+
+	iterator       begin() noexcept { return start_; }
+	const_iterator begin() const noexcept { return start_; }
+	const_iterator cbegin() const noexcept { return start_; }
+
+	iterator       end() noexcept { return start_ + size_; }
+	const_iterator end() const noexcept { return start_ + size_; }
+	const_iterator cend() const noexcept { return start_ + size_; }
+
+	reverse_iterator rbegin() noexcept { return reverse_iterator(end() - 1); }
+	const_reverse_iterator rbegin() const noexcept {
+		return const_reverse_iterator(end() - 1);
+	}
+	const_reverse_iterator crbegin() const noexcept {
+		return const_reverse_iterator(end() - 1);
+	}
+
+	reverse_iterator rend() noexcept { return reverse_iterator(begin() - 1); }
+	const_reverse_iterator rend() const noexcept {
+		return const_reverse_iterator(begin() - 1);
+	}
+	const_reverse_iterator crend() const noexcept {
+		return const_reverse_iterator(begin() - 1);
+	}
+
+	// Capacity
+
+	bool      empty() const noexcept { return size_ == 0; }
+	size_type size() const noexcept { return size_; }
+	size_type max_size() const noexcept {
+		return std::numeric_limits<off_t>::max() / sizeof(value_type);
+	}
+	size_type capacity() const noexcept { return capacity_; }
+
+	void reserve(size_type n) {
+		if (n > capacity_)
+			remap(n);
+	}
+	void shrink_to_fit() {
+		if (capacity_ != size_)
+			remap(size_);
+	}
+
+	// Modifiers
+
+	void clear() noexcept { size_ = 0; }
+
+	void push_back(const_reference value) {
+		if (size_ == capacity_) {
+			// value 可能引用自身元素，需在重新映射前复制
+			value_type copy(value);
+			remap(get_new_capacity(1));
+			start_[size_++] = copy;
+			return;
+		}
+		start_[size_++] = value;
+	}
+
+	template <class... Args>
+	reference emplace_back(Args&&... args) {
+		value_type value(std::forward<Args>(args)...);
+		push_back(value);
+		return back();
+	}
+
+	void pop_back() { --size_; }
+
+	void resize(size_type count, const_reference value = value_type()) {
+		if (count > size_) {
+			value_type copy(value);
+			reserve(count);
+			mSTL::fill_n(start_ + size_, count - size_, copy);
+		}
+		size_ = count;
+	}
+
+	void assign(size_type count, const_reference value) {
+		value_type copy(value);
+		clear();
+		resize(count, copy);
+	}
+	template <class InputIterator,
+	          class = typename std::enable_if<
+	              !std::is_integral<InputIterator>::value>::type>
+	void assign(InputIterator first, InputIterator last) {
+		clear();
+		for (; first != last; ++first)
+			push_back(*first);
+	}
+	void assign(const std::initializer_list<T>& il) {
+		clear();
+		if (il.size() == 0)
+			return;
+
+		reserve(il.size());
+		std::memcpy(start_, il.begin(), bytes(il.size()));
+		size_ = il.size();
+	}
+
+	void swap(mmap_vector& other) noexcept {
+		if (this == &other)
+			return;
+
+		mSTL::swap(fd_, other.fd_);
+		mSTL::swap(start_, other.start_);
+		mSTL::swap(size_, other.size_);
+		mSTL::swap(capacity_, other.capacity_);
+		mSTL::swap(mode_, other.mode_);
+		mSTL::swap(flush_, other.flush_);
+	}
+
+public:
+	size_type get_new_capacity(size_type count) const {
+		// 至少一页，按 2 倍增长
+		size_type page = static_cast<size_type>(::sysconf(_SC_PAGESIZE));
+		size_type min_capacity =
+		    mSTL::max(page / sizeof(value_type), size_type(1));
+		return mSTL::max(mSTL::max(capacity_ * 2, size_ + count), min_capacity);
+	}
+
+private:
+	static size_type bytes(size_type count) noexcept {
+		return count * sizeof(value_type);
+	}
+
+	static int to_madvise(mmap_advice advice) noexcept {
+		switch (advice) {
+		case mmap_advice::sequential: return MADV_SEQUENTIAL;
+		case mmap_advice::random: return MADV_RANDOM;
+		case mmap_advice::willneed: return MADV_WILLNEED;
+		case mmap_advice::dontneed: return MADV_DONTNEED;
+		default: return MADV_NORMAL;
+		}
+	}
+
+	void reset() noexcept {
+		if (fd_ >= 0)
+			::close(fd_);
+
+		fd_ = -1;
+		start_ = nullptr;
+		size_ = capacity_ = 0;
+	}
+
+	void* map(size_type count) noexcept {
+		int   prot = mode_ == mmap_mode::read_write ? (PROT_READ | PROT_WRITE)
+		                                            : PROT_READ;
+		void* ptr = ::mmap(nullptr, bytes(count), prot, MAP_SHARED, fd_, 0);
+		return ptr == MAP_FAILED ? nullptr : ptr;
+	}
+
+	// 调整文件长度并重新映射为 count 个元素
+	void remap(size_type count) {
+		if (mode_ != mmap_mode::read_write)
+			throw "mmap_vector: read only mapping";
+		if (count > max_size())
+			throw "out of range";
+
+		if (count > capacity_ &&
+		    ::ftruncate(fd_, static_cast<off_t>(bytes(count))) != 0)
+			throw "mmap_vector: ftruncate failed";
+
+		void* ptr = nullptr;
+		if (count == 0) {
+			::munmap(start_, bytes(capacity_));
+		} else if (start_ == nullptr) {
+			ptr = map(count);
+		} else {
+#ifdef MREMAP_MAYMOVE
+			ptr = ::mremap(start_, bytes(capacity_), bytes(count), MREMAP_MAYMOVE);
+			if (ptr == MAP_FAILED)
+				ptr = nullptr;
+#else
+			ptr = map(count);
+			if (ptr != nullptr)
+				::munmap(start_, bytes(capacity_));
+#endif
+		}
+
+		if (count != 0 && ptr == nullptr)
+			throw "mmap_vector: remap failed";
+
+		// 缩容时先解除映射再截断文件
+		if (count < capacity_ &&
+		    ::ftruncate(fd_, static_cast<off_t>(bytes(count))) != 0)
+			throw "mmap_vector: ftruncate failed";
+
+		start_ = static_cast<pointer>(ptr);
+		capacity_ = count;
+	}
+};
+
+template <class T>
+bool operator==(const mmap_vector<T>& lhs, const mmap_vector<T>& rhs) {
+	if (lhs.size() != rhs.size())
+		return false;
+
+	for (size_t i = 0; i < lhs.size(); ++i) {
+		if (!(lhs[i] == rhs[i]))
+			return false;
+	}
+
+	return true;
+}
+
+template <class T>
+bool operator!=(const mmap_vector<T>& lhs, const mmap_vector<T>& rhs) {
+	return !(lhs == rhs);
+}
+
+template <class T>
+void swap(mmap_vector<T>& lhs, mmap_vector<T>& rhs) noexcept {
+	lhs.swap(rhs);
+}
+
+MSTL_NAMESPACE_END
+
+#endif
@@ -0,0 +1,195 @@
+#ifndef NONTEMPORAL_H
+#define NONTEMPORAL_H
+
+#include "basic.h"
+
+#include "cpu_features.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+MSTL_NAMESPACE_BEGIN
+
+// nontemporal
+// 使用非临时 (streaming) 存储指令的大块内存拷贝 / 填充内核
+// 写入数据经写合并缓冲直接进入内存，不占用缓存，避免大块拷贝驱逐其他线程的工作集
+// 源数据以 prefetchnta 预取，读取侧同样尽量不污染末级缓存
+// 数据量达到阈值时使用，阈值默认为 0 (关闭)，须由使用者以 set_threshold 显式开启
+// 非临时存储的拷贝本身并不更快，收益仅在于保留其他数据的缓存，是否值得取决于负载
+// recommended_threshold() 为末级缓存容量的一半 (至少 1 MiB)，可作为开启时的阈值
+// 运行时选择 AVX2 / SSE2 内核，均不支持时退化为普通 memcpy / fill
+//
+// 非临时存储不遵循 x86 的强存储顺序，内核返回前执行 sfence
+// 使后续普通存储 (如发布 finish_ 或解锁) 对其他线程可见时，流式写入的数据一定已可见
+class nontemporal {
+private:
+	using copy_kernel = void (*)(char*, const char*, size_t);
+	using fill_kernel = void (*)(char*, size_t, const unsigned char*);
+
+	enum { PATTERN_SIZE = 32, PREFETCH_DISTANCE = 512 };
+
+public:
+	static void set_threshold(size_t bytes) noexcept {
+		threshold_value().store(bytes, std::memory_order_relaxed);
+	}
+	static size_t threshold() noexcept {
+		return threshold_value().load(std::memory_order_relaxed);
+	}
+
+	static size_t recommended_threshold() noexcept {
+		size_t cache = cpu_features::get().last_level_cache_size;
+		size_t limit = cache / 2;
+		return limit < (1u << 20) ? (1u << 20) : limit;
+	}
+
+	static bool enabled(size_t bytes) noexcept {
+		size_t limit = threshold();
+		return limit != 0 && bytes >= limit && kernels().copy != nullptr;
+	}
+
+	// [src, src + bytes) -> [dest, dest + bytes)，两区间不得重叠
+	static void copy(void* dest, const void* src, size_t bytes) noexcept {
+		copy_kernel kernel = kernels().copy;
+		if (kernel == nullptr) {
+			memcpy(dest, src, bytes);
+			return;
+		}
+		char*       d = static_cast<char*>(dest);
+		const char* s = static_cast<const char*>(src);
+
+		// 头部按 PATTERN_SIZE 对齐后交由内核处理，尾部由内核自行处理
+		size_t head = (PATTERN_SIZE - reinterpret_cast<uintptr_t>(d) % PATTERN_SIZE) %
+		              PATTERN_SIZE;
+		if (head > bytes)
+			head = bytes;
+		memcpy(d, s, head);
+		kernel(d + head, s + head, bytes - head);
+	}
+
+	// value -> [first, first + count)
+	// sizeof(T) 须整除 32 且 first 按 sizeof(T) 对齐，否则返回 false 由调用者自行填充
+	template <class T>
+	static bool fill_n(T* first, size_t count, const T& value) noexcept {
+		fill_kernel kernel = kernels().fill;
+		if (kernel == nullptr || PATTERN_SIZE % sizeof(T) != 0 ||
+		    reinterpret_cast<uintptr_t>(first) % sizeof(T) != 0)
+			return false;
+
+		while (count != 0 &&
+		       reinterpret_cast<uintptr_t>(first) % PATTERN_SIZE != 0) {
+			*first++ = value;
+			--count;
+		}
+
+		alignas(PATTERN_SIZE) unsigned char pattern[PATTERN_SIZE];
+		for (size_t i = 0; i < PATTERN_SIZE; i += sizeof(T))
+			memcpy(pattern + i, &value, sizeof(T));
+
+		size_t blocks = count * sizeof(T) / PATTERN_SIZE;
+		kernel(reinterpret_cast<char*>(first), blocks, pattern);
+
+		first += blocks * (PATTERN_SIZE / sizeof(T));
+		count -= blocks * (PATTERN_SIZE / sizeof(T));
+		while (count-- != 0)
+			*first++ = value;
+		return true;
+	}
+
+private:
+	struct kernel_table {
+		copy_kernel copy;
+		fill_kernel fill;
+	};
+
+	static std::atomic<size_t>& threshold_value() noexcept {
+		static std::atomic<size_t> value(0);
+		return value;
+	}
+
+	static const kernel_table& kernels() noexcept {
+		static const kernel_table table = select_kernels();
+		return table;
+	}
+
+	static kernel_table select_kernels() noexcept {
+		kernel_table table = {nullptr, nullptr};
+#if MSTL_X86_SIMD
+		const cpu_features& features = cpu_features::get();
+		if (features.avx2) {
+			table.copy = &copy_avx2;
+			table.fill = &fill_avx2;
+		} else if (features.sse2) {
+			table.copy = &copy_sse2;
+			table.fill = &fill_sse2;
+		}
+#endif
+		return table;
+	}
+
+#if MSTL_X86_SIMD
+	// dest 已按 32 字节对齐，源地址任意
+	MSTL_TARGET("sse2")
+	static void copy_sse2(char* dest, const char* src, size_t bytes) noexcept {
+		for (; bytes >= 64; bytes -= 64, dest += 64, src += 64) {
+			_mm_prefetch(src + PREFETCH_DISTANCE, _MM_HINT_NTA);
+			__m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+			__m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 16));
+			__m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 32));
+			__m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 48));
+			_mm_stream_si128(reinterpret_cast<__m128i*>(dest), a);
+			_mm_stream_si128(reinterpret_cast<__m128i*>(dest + 16), b);
+			_mm_stream_si128(reinterpret_cast<__m128i*>(dest + 32), c);
+			_mm_stream_si128(reinterpret_cast<__m128i*>(dest + 48), d);
+		}
+		_mm_sfence();
+		memcpy(dest, src, bytes);
+	}
+
+	MSTL_TARGET("avx2")
+	static void copy_avx2(char* dest, const char* src, size_t bytes) noexcept {
+		for (; bytes >= 128; bytes -= 128, dest += 128, src += 128) {
+			_mm_prefetch(src + PREFETCH_DISTANCE, _MM_HINT_NTA);
+			_mm_prefetch(src + PREFETCH_DISTANCE + 64, _MM_HINT_NTA);
+			__m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+			__m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 32));
+			__m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 64));
+			__m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 96));
+			_mm256_stream_si256(reinterpret_cast<__m256i*>(dest), a);
+			_mm256_stream_si256(reinterpret_cast<__m256i*>(dest + 32), b);
+			_mm256_stream_si256(reinterpret_cast<__m256i*>(dest + 64), c);
+			_mm256_stream_si256(reinterpret_cast<__m256i*>(dest + 96), d);
+		}
+		_mm_sfence();
+		memcpy(dest, src, bytes);
+	}
+
+	// 写入 blocks 个 32 字节块，dest 已按 32 字节对齐
+	MSTL_TARGET("sse2")
+	static void fill_sse2(char* dest, size_t blocks,
+	                      const unsigned char* pattern) noexcept {
+		__m128i low = _mm_load_si128(reinterpret_cast<const __m128i*>(pattern));
+		__m128i high =
+		    _mm_load_si128(reinterpret_cast<const __m128i*>(pattern + 16));
+		for (; blocks != 0; --blocks, dest += 32) {
+			_mm_stream_si128(reinterpret_cast<__m128i*>(dest), low);
+			_mm_stream_si128(reinterpret_cast<__m128i*>(dest + 16), high);
+		}
+		_mm_sfence();
+	}
+
+	MSTL_TARGET("avx2")
+	static void fill_avx2(char* dest, size_t blocks,
+	                      const unsigned char* pattern) noexcept {
+		__m256i value =
+		    _mm256_load_si256(reinterpret_cast<const __m256i*>(pattern));
+		for (; blocks != 0; --blocks, dest += 32)
+			_mm256_stream_si256(reinterpret_cast<__m256i*>(dest), value);
+		_mm_sfence();
+	}
+#endif
+};
+
+MSTL_NAMESPACE_END
+
+#endif
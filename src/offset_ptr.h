@@ -0,0 +1,111 @@
+#ifndef OFFSET_PTR_H
+#define OFFSET_PTR_H
+
+#include "basic.h"
+
+#include "iterator.h"
+
+#include <cstdint>
+#include <type_traits>
+
+MSTL_NAMESPACE_BEGIN
+
+// offset_ptr
+// 保存目标地址相对自身地址的偏移而非绝对地址
+// 只要指针与目标位于同一映射区域内，区域被映射到任意地址均保持有效
+// 可用作分配器的 pointer 类型，使容器能够存放于共享内存中
+//
+// 偏移 1 表示空指针: this + 1 位于 offset_ptr 自身内部，不可能是合法目标
+// 可隐式转换为原生指针，算术与比较运算均经由原生指针完成
+// 复制时需按新位置重新计算偏移，因此不提供逐位复制的移动语义
+template <class T>
+class offset_ptr {
+public:
+	using element_type = T;
+	using value_type = typename std::remove_cv<T>::type;
+	using difference_type = ptrdiff_t;
+	using pointer = T*;
+	using reference = typename std::add_lvalue_reference<T>::type;
+	using iterator_category = random_access_iterator_tag;
+
+private:
+	difference_type offset_;
+
+public:
+	offset_ptr() noexcept
+	    : offset_(1) {}
+	offset_ptr(std::nullptr_t) noexcept
+	    : offset_(1) {}
+	offset_ptr(pointer ptr) noexcept
+	    : offset_(to_offset(ptr)) {}
+	offset_ptr(const offset_ptr& other) noexcept
+	    : offset_(to_offset(other.get())) {}
+
+	// offset_ptr<U> -> offset_ptr<T>，如 T* -> const T*
+	template <class U, class = typename std::enable_if<
+	                       std::is_convertible<U*, T*>::value>::type>
+	offset_ptr(const offset_ptr<U>& other) noexcept
+	    : offset_(to_offset(other.get())) {}
+
+	offset_ptr& operator=(const offset_ptr& other) noexcept {
+		offset_ = to_offset(other.get());
+		return *this;
+	}
+	offset_ptr& operator=(pointer ptr) noexcept {
+		offset_ = to_offset(ptr);
+		return *this;
+	}
+	offset_ptr& operator=(std::nullptr_t) noexcept {
+		offset_ = 1;
+		return *this;
+	}
+
+	pointer get() const noexcept {
+		return offset_ == 1
+		           ? nullptr
+		           : reinterpret_cast<pointer>(
+		                 reinterpret_cast<uintptr_t>(this) + offset_);
+	}
+	operator pointer() const noexcept { return get(); }
+
+	reference operator*() const noexcept { return *get(); }
+	pointer   operator->() const noexcept { return get(); }
+
+	// 自增自减直接作用于偏移，二元算术经隐式转换由原生指针完成
+	offset_ptr& operator++() noexcept { return *this += 1; }
+	offset_ptr  operator++(int) noexcept {
+		offset_ptr temp = *this;
+		++*this;
+		return temp;
+	}
+	offset_ptr& operator--() noexcept { return *this -= 1; }
+	offset_ptr  operator--(int) noexcept {
+		offset_ptr temp = *this;
+		--*this;
+		return temp;
+	}
+	offset_ptr& operator+=(difference_type n) noexcept {
+		offset_ += n * static_cast<difference_type>(sizeof(T));
+		return *this;
+	}
+	offset_ptr& operator-=(difference_type n) noexcept {
+		offset_ -= n * static_cast<difference_type>(sizeof(T));
+		return *this;
+	}
+
+	// 偏移值本身，用于调试
+	difference_type offset() const noexcept { return offset_; }
+
+private:
+	difference_type to_offset(const volatile void* ptr) const noexcept {
+		return ptr == nullptr
+		           ? 1
+		           : static_cast<difference_type>(
+		                 reinterpret_cast<uintptr_t>(ptr) -
+		                 reinterpret_cast<uintptr_t>(this));
+	}
+};
+
+MSTL_NAMESPACE_END
+
+#endif
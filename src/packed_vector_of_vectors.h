@@ -0,0 +1,354 @@
+#ifndef PACKED_VECTOR_OF_VECTORS_H
+#define PACKED_VECTOR_OF_VECTORS_H
+
+#include "basic.h"
+
+#include "algorithm.h"
+#include "allocator.h"
+#include "iterator.h"
+#include "span.h"
+#include "type_traits.h"
+#include "vector.h"
+
+#include <cassert>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+MSTL_NAMESPACE_BEGIN
+
+// packed_vector_of_vectors
+// 以 CSR (Compressed Sparse Row) 布局存放不等长的多行数据
+//   values_  : 所有行元素依次紧密存放
+//   offsets_ : 长度为行数 + 1，第 r 行为 values_[offsets_[r], offsets_[r + 1])
+// 相比 vector<vector<T>> 只需两次分配、无每行头部开销，遍历全部元素为一次线性扫描
+// 仅支持在尾部追加 / 删除行，行内容以 span 形式访问
+template <class T, class Allocator = allocator<T>>
+class packed_vector_of_vectors {
+
+public:
+	using value_type = T;
+	using allocator_type = Allocator;
+	using size_type = size_t;
+	using difference_type = ptrdiff_t;
+	using reference = value_type&;
+	using const_reference = const value_type&;
+	using pointer = value_type*;
+	using const_pointer = const value_type*;
+
+	using row_type = span<value_type>;
+	using const_row_type = span<const value_type>;
+
+	using values_type = vector<value_type, allocator_type>;
+	using offsets_type =
+	    vector<size_type,
+	           typename Allocator::template rebind<size_type>::other>;
+
+	template <bool IsConst>
+	class row_iterator;
+
+	using iterator = row_iterator<false>;
+	using const_iterator = row_iterator<true>;
+
+	// 按行遍历，解引用得到该行的 span
+	template <bool IsConst>
+	class row_iterator {
+	public:
+		using iterator_category = random_access_iterator_tag;
+		using value_type = typename IfThenElse<IsConst, const_row_type,
+		                                       row_type>::result;
+		using difference_type = ptrdiff_t;
+		using pointer = void;
+		using reference = value_type;
+
+		using owner_type =
+		    typename IfThenElse<IsConst, const packed_vector_of_vectors,
+		                        packed_vector_of_vectors>::result;
+		using self = row_iterator;
+
+	private:
+		owner_type* owner_;
+		size_type   row_;
+
+	public:
+		row_iterator() noexcept
+		    : owner_(nullptr)
+		    , row_(0) {}
+		row_iterator(owner_type* owner, size_type row) noexcept
+		    : owner_(owner)
+		    , row_(row) {}
+
+		// iterator -> const_iterator
+		template <bool B, class = typename std::enable_if<IsConst && !B>::type>
+		row_iterator(const row_iterator<B>& other) noexcept
+		    : owner_(other.owner())
+		    , row_(other.row()) {}
+
+		owner_type* owner() const noexcept { return owner_; }
+		size_type   row() const noexcept { return row_; }
+
+		reference operator*() const { return (*owner_)[row_]; }
+		reference operator[](difference_type n) const {
+			return (*owner_)[row_ + n];
+		}
+
+		self& operator++() noexcept {
+			++row_;
+			return *this;
+		}
+		self operator++(int) noexcept {
+			self temp = *this;
+			++row_;
+			return temp;
+		}
+		self& operator--() noexcept {
+			--row_;
+			return *this;
+		}
+		self operator--(int) noexcept {
+			self temp = *this;
+			--row_;
+			return temp;
+		}
+
+		self& operator+=(difference_type n) noexcept {
+			row_ += n;
+			return *this;
+		}
+		self& operator-=(difference_type n) noexcept {
+			row_ -= n;
+			return *this;
+		}
+		self operator+(difference_type n) const noexcept {
+			return self(owner_, row_ + n);
+		}
+		self operator-(difference_type n) const noexcept {
+			return self(owner_, row_ - n);
+		}
+		difference_type operator-(const self& other) const noexcept {
+			return static_cast<difference_type>(row_) -
+			       static_cast<difference_type>(other.row_);
+		}
+
+		bool operator==(const self& other) const noexcept {
+			return row_ == other.row_ && owner_ == other.owner_;
+		}
+		bool operator!=(const self& other) const noexcept {
+			return !(*this == other);
+		}
+		bool operator<(const self& other) const noexcept {
+			return row_ < other.row_;
+		}
+		bool operator>(const self& other) const noexcept {
+			return other < *this;
+		}
+		bool operator<=(const self& other) const noexcept {
+			return !(other < *this);
+		}
+		bool operator>=(const self& other) const noexcept {
+			return !(*this < other);
+		}
+	};
+
+private:
+	values_type  values_;
+	offsets_type offsets_; // 恒有 offsets_.front() == 0
+
+public:
+	// (construct)(destruct)(copy)(operator=) ......
+
+	packed_vector_of_vectors()
+	    : values_()
+	    , offsets_{0} {}
+
+	packed_vector_of_vectors(
+	    const std::initializer_list<std::initializer_list<T>>& il)
+	    : packed_vector_of_vectors() {
+		offsets_.reserve(il.size() + 1);
+		for (const auto& row : il)
+			push_row(row);
+	}
+
+	packed_vector_of_vectors(const packed_vector_of_vectors&) = default;
+	packed_vector_of_vectors(packed_vector_of_vectors&& other)
+	    : packed_vector_of_vectors() {
+		swap(other);
+	}
+	packed_vector_of_vectors& operator=(const packed_vector_of_vectors&) =
+	    default;
+	packed_vector_of_vectors& operator=(packed_vector_of_vectors&& other) {
+		if (this == &other)
+			return *this;
+
+		packed_vector_of_vectors temp(std::move(other));
+		swap(temp);
+		return *this;
+	}
+
+	~packed_vector_of_vectors() = default;
+
+	allocator_type get_allocator() { return allocator_type(); }
+
+	// 由 (行号, 值) 对批量构建，同一行内保持输入顺序
+	// 先计数各行长度并求前缀和得到 offsets_，再一次分散写入 values_
+	// 要求 value_type 可默认构造；rows 可指定最少行数以保留末尾空行
+	template <class ForwardIterator>
+	void assign_pairs(ForwardIterator first, ForwardIterator last,
+	                  size_type rows = 0) {
+		clear();
+
+		for (ForwardIterator it = first; it != last; ++it)
+			rows = mSTL::max(rows, static_cast<size_type>(it->first) + 1);
+
+		// 计数写入 offsets_[r + 2]，前缀和后 offsets_[r + 1] 即为第 r 行起点
+		// 分散写入时以其为游标，结束后恰好变为第 r 行终点
+		offsets_.resize(rows + 2, 0);
+		for (ForwardIterator it = first; it != last; ++it)
+			++offsets_[static_cast<size_type>(it->first) + 2];
+		for (size_type r = 2; r < rows + 2; ++r)
+			offsets_[r] += offsets_[r - 1];
+
+		values_.resize(offsets_[rows + 1]);
+		for (ForwardIterator it = first; it != last; ++it)
+			values_[offsets_[static_cast<size_type>(it->first) + 1]++] =
+			    it->second;
+
+		offsets_.pop_back();
+	}
+
+	// Element access
+
+	row_type at(size_type row) {
+		return row < rows() ? (*this)[row] : throw "out of range";
+	}
+	const_row_type at(size_type row) const {
+		return row < rows() ? (*this)[row] : throw "out of range";
+	}
+
+	row_type operator[](size_type row) {
+		return row_type(values_.data() + offsets_[row], row_size(row));
+	}
+	const_row_type operator[](size_type row) const {
+		return const_row_type(values_.data() + offsets_[row], row_size(row));
+	}
+
+	row_type       front() { return (*this)[0]; }
+	const_row_type front() const { return (*this)[0]; }
+
+	row_type       back() { return (*this)[rows() - 1]; }
+	const_row_type back() const { return (*this)[rows() - 1]; }
+
+	size_type row_size(size_type row) const {
+		return offsets_[row + 1] - offsets_[row];
+	}
+
+	// 所有元素组成的连续区间，按行序排列
+	row_type       values() { return row_type(values_.data(), values_.size()); }
+	const_row_type values() const {
+		return const_row_type(values_.data(), values_.size());
+	}
+	span<const size_type> offsets() const {
+		return span<const size_type>(offsets_.data(), offsets_.size());
+	}
+
+	// Iterators
+
+	iterator       begin() noexcept { return iterator(this, 0); }
+	const_iterator begin() const noexcept { return const_iterator(this, 0); }
+	const_iterator cbegin() const noexcept { return const_iterator(this, 0); }
+
+	iterator       end() noexcept { return iterator(this, rows()); }
+	const_iterator end() const noexcept {
+		return const_iterator(this, rows());
+	}
+	const_iterator cend() const noexcept {
+		return const_iterator(this, rows());
+	}
+
+	// Capacity
+
+	bool      empty() const noexcept { return rows() == 0; }
+	size_type rows() const noexcept { return offsets_.size() - 1; }
+	size_type size() const noexcept { return rows(); }
+	size_type values_size() const noexcept { return values_.size(); }
+
+	void reserve(size_type rows, size_type values) {
+		offsets_.reserve(rows + 1);
+		values_.reserve(values);
+	}
+	void shrink_to_fit() {
+		offsets_.shrink_to_fit();
+		values_.shrink_to_fit();
+	}
+
+	// Modifiers
+
+	void clear() noexcept {
+		values_.clear();
+		offsets_.erase(offsets_.begin() + 1, offsets_.end());
+	}
+
+	// 追加一行
+	void push_row() { offsets_.push_back(values_.size()); }
+	template <class InputIterator,
+	          class = typename std::enable_if<
+	              !std::is_integral<InputIterator>::value>::type>
+	void push_row(InputIterator first, InputIterator last) {
+		for (; first != last; ++first)
+			values_.push_back(*first);
+		offsets_.push_back(values_.size());
+	}
+	template <class Range>
+	auto push_row(const Range& range)
+	    -> decltype(std::begin(range), std::end(range), void()) {
+		push_row(std::begin(range), std::end(range));
+	}
+	void push_row(const std::initializer_list<T>& il) {
+		push_row(il.begin(), il.end());
+	}
+
+	// 向最后一行追加元素
+	void push_to_last_row(const_reference value) {
+		assert(!empty());
+		values_.push_back(value);
+		++offsets_.back();
+	}
+	template <class... Args>
+	reference emplace_to_last_row(Args&&... args) {
+		assert(!empty());
+		reference result = values_.emplace_back(std::forward<Args>(args)...);
+		++offsets_.back();
+		return result;
+	}
+
+	void pop_row() {
+		assert(!empty());
+		offsets_.pop_back();
+		values_.erase(values_.begin() + offsets_.back(), values_.end());
+	}
+
+	void swap(packed_vector_of_vectors& other) {
+		values_.swap(other.values_);
+		offsets_.swap(other.offsets_);
+	}
+
+	friend bool operator==(const packed_vector_of_vectors& lhs,
+	                       const packed_vector_of_vectors& rhs) {
+		return lhs.offsets_ == rhs.offsets_ && lhs.values_ == rhs.values_;
+	}
+	friend bool operator!=(const packed_vector_of_vectors& lhs,
+	                       const packed_vector_of_vectors& rhs) {
+		return !(lhs == rhs);
+	}
+};
+
+template <class T, class Alloc>
+void swap(packed_vector_of_vectors<T, Alloc>& lhs,
+          packed_vector_of_vectors<T, Alloc>& rhs) {
+	lhs.swap(rhs);
+}
+
+MSTL_NAMESPACE_END
+
+#endif
@@ -0,0 +1,815 @@
+#ifndef PERSISTENT_VECTOR_H
+#define PERSISTENT_VECTOR_H
+
+#include "basic.h"
+
+#include "algorithm.h"
+#include "allocator.h"
+#include "iterator.h"
+#include "type_traits.h"
+
+#include <atomic>
+#include <cassert>
+#include <initializer_list>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+MSTL_NAMESPACE_BEGIN
+
+template <class T, class Allocator>
+class persistent_vector;
+
+template <class T, class Allocator>
+class transient_vector;
+
+// 持久化 vector 的公共实现
+// 32 叉基数平衡 trie (radix balanced trie) + 尾部缓冲 (tail)
+//   1. 下标 i 在第 level 层的分支为 (i >> level) & 31，查找与修改均为 O(log32 n)
+//   2. 最后不足 32 个元素存放于 tail 中，push_back / pop_back 多数情况下只需
+//      操作 tail，满 32 个后整体作为叶子插入 trie
+//   3. 修改时只复制根到目标叶子的路径，其余节点在新旧版本间共享，以引用计数管理
+//   4. 所有修改操作带有 owner 标记，节点 owner 与标记相同时原地修改，否则复制
+//      持久化操作使用标记 0 (总是复制)，transient 使用独占的非零标记
+// 引用计数为原子变量，共享节点的快照可在不同线程中复制与析构；
+// 与其他容器一样，同一对象的并发修改仍需外部同步
+// 节点直接以 ::operator new 分配，不经过 Allocator: alloc 内存池为全局且非线程安全，
+// sizeof(T) 不超过 3 时叶子节点不超过 128 字节，会落入内存池；Allocator 仅用于构造与析构元素
+template <class T, class Allocator>
+class _persistent_vector_impl {
+public:
+	using value_type = T;
+	using allocator_type = Allocator;
+	using size_type = size_t;
+	using difference_type = ptrdiff_t;
+	using reference = value_type&;
+	using const_reference = const value_type&;
+	using pointer = value_type*;
+	using const_pointer = const value_type*;
+
+	enum : size_type {
+		BITS = 5,
+		BRANCH = size_type(1) << BITS,
+		MASK = BRANCH - 1,
+	};
+
+protected:
+	struct node_base {
+		std::atomic<size_type> refcount;
+		size_type              owner;
+	};
+	struct inner_node : node_base {
+		node_base* children[BRANCH];
+	};
+	struct leaf_node : node_base {
+		size_type size; // 已构造元素个数
+		typename std::aligned_storage<sizeof(T), alignof(T)>::type data[BRANCH];
+
+		pointer elements() noexcept { return reinterpret_cast<pointer>(data); }
+	};
+
+protected:
+	size_type  size_;
+	size_type  shift_; // 根节点所在层的位移，叶子层为 0
+	inner_node* root_; // 元素不超过 32 个时为空
+	leaf_node*  tail_;
+
+protected:
+	_persistent_vector_impl() noexcept
+	    : size_(0)
+	    , shift_(BITS)
+	    , root_(nullptr)
+	    , tail_(nullptr) {}
+	_persistent_vector_impl(const _persistent_vector_impl& other) noexcept
+	    : size_(other.size_)
+	    , shift_(other.shift_)
+	    , root_(other.root_)
+	    , tail_(other.tail_) {
+		retain(root_);
+		retain(tail_);
+	}
+	~_persistent_vector_impl() noexcept { reset(); }
+
+	_persistent_vector_impl& operator=(const _persistent_vector_impl&) = delete;
+
+	void reset() noexcept {
+		release(root_, shift_);
+		release(tail_, 0);
+		size_ = 0;
+		shift_ = BITS;
+		root_ = nullptr;
+		tail_ = nullptr;
+	}
+
+	void swap_impl(_persistent_vector_impl& other) noexcept {
+		mSTL::swap(size_, other.size_);
+		mSTL::swap(shift_, other.shift_);
+		mSTL::swap(root_, other.root_);
+		mSTL::swap(tail_, other.tail_);
+	}
+
+	// trie 中元素个数，恒为 32 的倍数
+	size_type tail_offset() const noexcept {
+		return size_ < BRANCH ? 0 : ((size_ - 1) >> BITS) << BITS;
+	}
+
+	// 下标 i 所在叶子的元素数组
+	pointer array_for(size_type i) const noexcept {
+		if (i >= tail_offset())
+			return tail_->elements();
+
+		node_base* node = root_;
+		for (size_type level = shift_; level > 0; level -= BITS)
+			node = static_cast<inner_node*>(node)->children[(i >> level) & MASK];
+		return static_cast<leaf_node*>(node)->elements();
+	}
+
+	static size_type next_owner() noexcept {
+		static std::atomic<size_type> owner(0);
+		return ++owner;
+	}
+
+	// modifiers
+
+	template <class... Args>
+	void push_back_impl(size_type owner, Args&&... args) {
+		size_type tail_count = size_ - tail_offset();
+
+		if (tail_count < BRANCH) {
+			leaf_node* tail = tail_ == nullptr
+			                      ? new_leaf(owner)
+			                      : editable_leaf(tail_, tail_count, owner);
+			try {
+				allocator_type::construct(tail->elements() + tail_count,
+				                          std::forward<Args>(args)...);
+			} catch (...) {
+				if (tail != tail_)
+					release(tail, 0);
+				throw;
+			}
+			++tail->size;
+
+			if (tail != tail_) {
+				release(tail_, 0);
+				tail_ = tail;
+			}
+			++size_;
+			return;
+		}
+
+		// tail 已满，先构造新 tail 再将旧 tail 插入 trie
+		leaf_node* tail = new_leaf(owner);
+		try {
+			allocator_type::construct(tail->elements(),
+			                          std::forward<Args>(args)...);
+		} catch (...) {
+			release(tail, 0);
+			throw;
+		}
+		tail->size = 1;
+
+		if (root_ == nullptr) {
+			root_ = new_inner(owner);
+			root_->children[0] = tail_;
+			shift_ = BITS;
+		} else if ((size_ >> BITS) > (size_type(1) << shift_)) {
+			// 根节点已满，树高加一
+			inner_node* root = new_inner(owner);
+			root->children[0] = root_;
+			root->children[1] = new_path(shift_, tail_, owner);
+			root_ = root;
+			shift_ += BITS;
+		} else {
+			inner_node* root = push_tail(shift_, root_, tail_, owner);
+			replace(root_, root, shift_);
+		}
+
+		tail_ = tail;
+		++size_;
+	}
+
+	void set_impl(size_type owner, size_type i, const_reference value) {
+		value_type copy(value);
+
+		if (i >= tail_offset()) {
+			leaf_node* tail = editable_leaf(tail_, size_ - tail_offset(), owner);
+			tail->elements()[i & MASK] = std::move(copy);
+			replace(tail_, tail, 0);
+			return;
+		}
+
+		node_base* root = do_set(shift_, root_, i, copy, owner);
+		replace(root_, static_cast<inner_node*>(root), shift_);
+	}
+
+	void pop_back_impl(size_type owner) {
+		assert(size_ != 0);
+
+		if (size_ == 1) {
+			reset();
+			return;
+		}
+
+		size_type tail_count = size_ - tail_offset();
+		if (tail_count > 1) {
+			leaf_node* tail = editable_leaf(tail_, tail_count - 1, owner);
+			if (tail == tail_) {
+				allocator_type::destroy(tail->elements() + tail_count - 1);
+				--tail->size;
+			} else {
+				replace(tail_, tail, 0);
+			}
+			--size_;
+			return;
+		}
+
+		// tail 仅剩一个元素，trie 中最后一个叶子成为新 tail
+		leaf_node* tail = leaf_for(size_ - 2);
+		retain(tail);
+
+		inner_node* root = pop_tail(shift_, root_, owner);
+		if (root == nullptr) {
+			release(root_, shift_);
+			root_ = nullptr;
+			shift_ = BITS;
+		} else {
+			replace(root_, root, shift_);
+			if (shift_ > BITS && root_->children[1] == nullptr) {
+				inner_node* child = static_cast<inner_node*>(root_->children[0]);
+				retain(child);
+				release(root_, shift_);
+				root_ = child;
+				shift_ -= BITS;
+			}
+		}
+
+		release(tail_, 0);
+		tail_ = tail;
+		--size_;
+	}
+
+private:
+	static void retain(node_base* node) noexcept {
+		if (node != nullptr)
+			node->refcount.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	static void release(node_base* node, size_type level) noexcept {
+		// acq_rel: 释放最后一个引用的线程可见其他线程在此之前对节点的全部写入
+		if (node == nullptr ||
+		    node->refcount.fetch_sub(1, std::memory_order_acq_rel) != 1)
+			return;
+
+		if (level == 0) {
+			leaf_node* leaf = static_cast<leaf_node*>(node);
+			allocator_type::destroy(leaf->elements(),
+			                        leaf->elements() + leaf->size);
+			::operator delete(static_cast<void*>(leaf));
+		} else {
+			inner_node* inner = static_cast<inner_node*>(node);
+			for (node_base* child : inner->children)
+				release(child, level - BITS);
+			::operator delete(static_cast<void*>(inner));
+		}
+	}
+
+	// 以 node 替换 slot 中的节点并释放旧节点的引用
+	template <class Node>
+	static void replace(Node*& slot, Node* node, size_type level) noexcept {
+		if (slot == node)
+			return;
+
+		release(slot, level);
+		slot = node;
+	}
+
+	static inner_node* new_inner(size_type owner) {
+		inner_node* node =
+		    static_cast<inner_node*>(::operator new(sizeof(inner_node)));
+		node->refcount.store(1, std::memory_order_relaxed);
+		node->owner = owner;
+		for (node_base*& child : node->children)
+			child = nullptr;
+		return node;
+	}
+
+	static leaf_node* new_leaf(size_type owner) {
+		leaf_node* node =
+		    static_cast<leaf_node*>(::operator new(sizeof(leaf_node)));
+		node->refcount.store(1, std::memory_order_relaxed);
+		node->owner = owner;
+		node->size = 0;
+		return node;
+	}
+
+	// owner 相同则原地修改，否则复制节点 (共享全部子节点)
+	static inner_node* editable_inner(inner_node* node, size_type owner) {
+		if (owner != 0 && node->owner == owner)
+			return node;
+
+		inner_node* copy = new_inner(owner);
+		for (size_type i = 0; i < BRANCH; ++i) {
+			copy->children[i] = node->children[i];
+			retain(copy->children[i]);
+		}
+		return copy;
+	}
+
+	// 复制时只保留前 count 个元素
+	static leaf_node* editable_leaf(leaf_node* node, size_type count,
+	                                size_type owner) {
+		if (owner != 0 && node->owner == owner)
+			return node;
+
+		leaf_node* copy = new_leaf(owner);
+		try {
+			for (; copy->size < count; ++copy->size)
+				allocator_type::construct(copy->elements() + copy->size,
+				                          node->elements()[copy->size]);
+		} catch (...) {
+			release(copy, 0);
+			throw;
+		}
+		return copy;
+	}
+
+	leaf_node* leaf_for(size_type i) const noexcept {
+		node_base* node = root_;
+		for (size_type level = shift_; level > 0; level -= BITS)
+			node = static_cast<inner_node*>(node)->children[(i >> level) & MASK];
+		return static_cast<leaf_node*>(node);
+	}
+
+	static node_base* new_path(size_type level, leaf_node* leaf,
+	                           size_type owner) {
+		if (level == 0)
+			return leaf;
+
+		inner_node* node = new_inner(owner);
+		node->children[0] = new_path(level - BITS, leaf, owner);
+		return node;
+	}
+
+	inner_node* push_tail(size_type level, inner_node* parent, leaf_node* tail,
+	                      size_type owner) {
+		inner_node* node = editable_inner(parent, owner);
+		size_type   sub = ((size_ - 1) >> level) & MASK;
+
+		if (level == BITS) {
+			node->children[sub] = tail;
+			return node;
+		}
+
+		node_base* child = node->children[sub];
+		node_base* inserted =
+		    child == nullptr
+		        ? new_path(level - BITS, tail, owner)
+		        : push_tail(level - BITS, static_cast<inner_node*>(child), tail,
+		                    owner);
+		replace(node->children[sub], inserted, level - BITS);
+		return node;
+	}
+
+	node_base* do_set(size_type level, node_base* node, size_type i,
+	                  value_type& value, size_type owner) {
+		if (level == 0) {
+			leaf_node* leaf =
+			    editable_leaf(static_cast<leaf_node*>(node), BRANCH, owner);
+			leaf->elements()[i & MASK] = std::move(value);
+			return leaf;
+		}
+
+		inner_node* inner = editable_inner(static_cast<inner_node*>(node), owner);
+		size_type   sub = (i >> level) & MASK;
+		node_base*  child =
+		    do_set(level - BITS, inner->children[sub], i, value, owner);
+		replace(inner->children[sub], child, level - BITS);
+		return inner;
+	}
+
+	// 移除 trie 中最后一个叶子，节点变空时返回 nullptr
+	inner_node* pop_tail(size_type level, inner_node* node, size_type owner) {
+		size_type sub = ((size_ - 2) >> level) & MASK;
+
+		if (level > BITS) {
+			inner_node* child = static_cast<inner_node*>(node->children[sub]);
+			inner_node* popped = pop_tail(level - BITS, child, owner);
+			if (popped == nullptr && sub == 0)
+				return nullptr;
+
+			inner_node* inner = editable_inner(node, owner);
+			node_base*  popped_base = popped;
+			replace(inner->children[sub], popped_base, level - BITS);
+			return inner;
+		}
+
+		if (sub == 0)
+			return nullptr;
+
+		inner_node* inner = editable_inner(node, owner);
+		node_base*  empty = nullptr;
+		replace(inner->children[sub], empty, 0);
+		return inner;
+	}
+};
+
+// persistent_vector
+// 不可变 vector，push_back / pop_back / set 均返回新版本，原版本保持不变
+// 新旧版本共享未修改的节点，单次修改只复制 O(log32 n) 个节点
+// 大量连续修改时可通过 transient() 获取可原地修改的 transient_vector
+template <class T, class Allocator = allocator<T>>
+class persistent_vector : private _persistent_vector_impl<T, Allocator> {
+
+	using base = _persistent_vector_impl<T, Allocator>;
+
+	friend class transient_vector<T, Allocator>;
+
+public:
+	using typename base::value_type;
+	using typename base::allocator_type;
+	using typename base::size_type;
+	using typename base::difference_type;
+	using typename base::reference;
+	using typename base::const_reference;
+	using typename base::pointer;
+	using typename base::const_pointer;
+
+	using transient_type = transient_vector<T, Allocator>;
+
+	class const_iterator;
+
+	using iterator = const_iterator;
+	using reverse_iterator = _reverse_iterator<const_iterator>;
+	using const_reverse_iterator = _reverse_iterator<const_iterator>;
+
+	// 缓存当前叶子，顺序遍历时每 32 个元素才查找一次
+	class const_iterator {
+	public:
+		using iterator_category = random_access_iterator_tag;
+		using value_type = T;
+		using difference_type = ptrdiff_t;
+		using pointer = const T*;
+		using reference = const T&;
+
+		using self = const_iterator;
+
+	private:
+		const persistent_vector* owner_;
+		size_type                index_;
+		pointer                  leaf_;
+
+	public:
+		const_iterator() noexcept
+		    : owner_(nullptr)
+		    , index_(0)
+		    , leaf_(nullptr) {}
+		const_iterator(const persistent_vector* owner, size_type index) noexcept
+		    : owner_(owner)
+		    , index_(index) {
+			locate();
+		}
+
+		size_type index() const noexcept { return index_; }
+
+		reference operator*() const noexcept { return leaf_[index_ & base::MASK]; }
+		pointer   operator->() const noexcept { return &**this; }
+		reference operator[](difference_type n) const noexcept {
+			return (*owner_)[index_ + n];
+		}
+
+		self& operator++() noexcept {
+			if ((++index_ & base::MASK) == 0)
+				locate();
+			return *this;
+		}
+		self operator++(int) noexcept {
+			self temp = *this;
+			++*this;
+			return temp;
+		}
+		self& operator--() noexcept {
+			if ((index_-- & base::MASK) == 0)
+				locate();
+			return *this;
+		}
+		self operator--(int) noexcept {
+			self temp = *this;
+			--*this;
+			return temp;
+		}
+
+		self& operator+=(difference_type n) noexcept {
+			index_ += n;
+			locate();
+			return *this;
+		}
+		self& operator-=(difference_type n) noexcept {
+			index_ -= n;
+			locate();
+			return *this;
+		}
+		self operator+(difference_type n) const noexcept {
+			return self(owner_, index_ + n);
+		}
+		self operator-(difference_type n) const noexcept {
+			return self(owner_, index_ - n);
+		}
+		difference_type operator-(const self& other) const noexcept {
+			return static_cast<difference_type>(index_) -
+			       static_cast<difference_type>(other.index_);
+		}
+
+		bool operator==(const self& other) const noexcept {
+			return index_ == other.index_ && owner_ == other.owner_;
+		}
+		bool operator!=(const self& other) const noexcept {
+			return !(*this == other);
+		}
+		bool operator<(const self& other) const noexcept {
+			return index_ < other.index_;
+		}
+		bool operator>(const self& other) const noexcept {
+			return other < *this;
+		}
+		bool operator<=(const self& other) const noexcept {
+			return !(other < *this);
+		}
+		bool operator>=(const self& other) const noexcept {
+			return !(*this < other);
+		}
+
+	private:
+		void locate() noexcept {
+			leaf_ = owner_ != nullptr && index_ < owner_->size_
+			            ? owner_->array_for(index_)
+			            : nullptr;
+		}
+	};
+
+public:
+	// (construct)(destruct)(copy)(operator=) ......
+
+	persistent_vector() noexcept = default;
+	persistent_vector(const size_type count, const_reference value = value_type())
+	    : persistent_vector() {
+		transient_type builder;
+		for (size_type i = 0; i < count; ++i)
+			builder.push_back(value);
+		persistent_vector built = builder.get_persistent();
+		swap(built);
+	}
+	template <class InputIterator,
+	          class = typename std::enable_if<
+	              !std::is_integral<InputIterator>::value>::type>
+	persistent_vector(InputIterator first, InputIterator last)
+	    : persistent_vector() {
+		transient_type builder;
+		for (; first != last; ++first)
+			builder.push_back(*first);
+		persistent_vector built = builder.get_persistent();
+		swap(built);
+	}
+	persistent_vector(const std::initializer_list<T>& il)
+	    : persistent_vector(il.begin(), il.end()) {}
+
+	// 复制仅增加根节点与 tail 的引用计数，O(1)
+	persistent_vector(const persistent_vector& other) noexcept = default;
+	persistent_vector(persistent_vector&& other) noexcept
+	    : persistent_vector() {
+		swap(other);
+	}
+	persistent_vector& operator=(const persistent_vector& other) noexcept {
+		if (this == &other)
+			return *this;
+
+		persistent_vector temp(other);
+		swap(temp);
+		return *this;
+	}
+	persistent_vector& operator=(persistent_vector&& other) noexcept {
+		if (this == &other)
+			return *this;
+
+		persistent_vector temp(std::move(other));
+		swap(temp);
+		return *this;
+	}
+
+	~persistent_vector() noexcept = default;
+
+	allocator_type get_allocator() { return allocator_type(); }
+
+	// Element access
+
+	const_reference at(size_type pos) const {
+		return pos < this->size_ ? (*this)[pos] : throw "out of range";
+	}
+	const_reference operator[](size_type i) const noexcept {
+		return this->array_for(i)[i & base::MASK];
+	}
+
+	const_reference front() const { return (*this)[0]; }
+	const_reference back() const { return (*this)[this->size_ - 1]; }
+
+	// Iterators
+
+	const_iterator begin() const noexcept { return const_iterator(this, 0); }
+	const_iterator cbegin() const noexcept { return const_iterator(this, 0); }
+
+	const_iterator end() const noexcept {
+		return const_iterator(this, this->size_);
+	}
+	const_iterator cend() const noexcept {
+		return const_iterator(this, this->size_);
+	}
+
+	const_reverse_iterator rbegin() const noexcept {
+		return const_reverse_iterator(end() - 1);
+	}
+	const_reverse_iterator crbegin() const noexcept {
+		return const_reverse_iterator(end() - 1);
+	}
+	const_reverse_iterator rend() const noexcept {
+		return const_reverse_iterator(begin() - 1);
+	}
+	const_reverse_iterator crend() const noexcept {
+		return const_reverse_iterator(begin() - 1);
+	}
+
+	// Capacity
+
+	bool      empty() const noexcept { return this->size_ == 0; }
+	size_type size() const noexcept { return this->size_; }
+	size_type max_size() const noexcept {
+		return std::numeric_limits<difference_type>::max();
+	}
+
+	// Modifiers
+	// 均返回修改后的新版本，*this 保持不变
+
+	persistent_vector push_back(const_reference value) const {
+		persistent_vector result(*this);
+		result.push_back_impl(0, value);
+		return result;
+	}
+	persistent_vector push_back(value_type&& value) const {
+		persistent_vector result(*this);
+		result.push_back_impl(0, std::move(value));
+		return result;
+	}
+	template <class... Args>
+	persistent_vector emplace_back(Args&&... args) const {
+		persistent_vector result(*this);
+		result.push_back_impl(0, std::forward<Args>(args)...);
+		return result;
+	}
+
+	persistent_vector set(size_type pos, const_reference value) const {
+		if (pos >= this->size_)
+			throw "out of range";
+
+		persistent_vector result(*this);
+		result.set_impl(0, pos, value);
+		return result;
+	}
+
+	persistent_vector pop_back() const {
+		persistent_vector result(*this);
+		result.pop_back_impl(0);
+		return result;
+	}
+
+	// 获取以当前版本为起点的 transient，不影响 *this
+	transient_type transient() const { return transient_type(*this); }
+
+	void swap(persistent_vector& other) noexcept { this->swap_impl(other); }
+};
+
+// transient_vector
+// persistent_vector 的可变构建器，持有独占的 owner 标记
+// 自身创建的节点直接原地修改，与原版本共享的节点在首次修改时复制
+// get_persistent() 之后不再持有任何节点，结果与后续修改互不影响
+template <class T, class Allocator = allocator<T>>
+class transient_vector : private _persistent_vector_impl<T, Allocator> {
+
+	using base = _persistent_vector_impl<T, Allocator>;
+
+	friend class persistent_vector<T, Allocator>;
+
+public:
+	using typename base::value_type;
+	using typename base::allocator_type;
+	using typename base::size_type;
+	using typename base::difference_type;
+	using typename base::reference;
+	using typename base::const_reference;
+
+	using persistent_type = persistent_vector<T, Allocator>;
+
+private:
+	size_type owner_;
+
+public:
+	transient_vector() noexcept
+	    : owner_(base::next_owner()) {}
+	explicit transient_vector(const persistent_type& other) noexcept
+	    : base(other)
+	    , owner_(base::next_owner()) {}
+
+	transient_vector(const transient_vector&) = delete;
+	transient_vector& operator=(const transient_vector&) = delete;
+
+	transient_vector(transient_vector&& other) noexcept
+	    : owner_(other.owner_) {
+		this->swap_impl(other);
+		other.owner_ = base::next_owner();
+	}
+	transient_vector& operator=(transient_vector&& other) noexcept {
+		if (this == &other)
+			return *this;
+
+		this->reset();
+		this->swap_impl(other);
+		owner_ = other.owner_;
+		other.owner_ = base::next_owner();
+		return *this;
+	}
+
+	~transient_vector() noexcept = default;
+
+	// Element access
+
+	const_reference at(size_type pos) const {
+		return pos < this->size_ ? (*this)[pos] : throw "out of range";
+	}
+	const_reference operator[](size_type i) const noexcept {
+		return this->array_for(i)[i & base::MASK];
+	}
+
+	const_reference front() const { return (*this)[0]; }
+	const_reference back() const { return (*this)[this->size_ - 1]; }
+
+	bool      empty() const noexcept { return this->size_ == 0; }
+	size_type size() const noexcept { return this->size_; }
+
+	// Modifiers
+
+	void push_back(const_reference value) { this->push_back_impl(owner_, value); }
+	void push_back(value_type&& value) {
+		this->push_back_impl(owner_, std::move(value));
+	}
+	template <class... Args>
+	void emplace_back(Args&&... args) {
+		this->push_back_impl(owner_, std::forward<Args>(args)...);
+	}
+
+	void set(size_type pos, const_reference value) {
+		if (pos >= this->size_)
+			throw "out of range";
+
+		this->set_impl(owner_, pos, value);
+	}
+
+	void pop_back() { this->pop_back_impl(owner_); }
+
+	// 生成持久化版本，transient 随即清空并更换 owner 标记
+	// 已生成版本中的节点从此不会再被原地修改
+	persistent_type get_persistent() noexcept {
+		persistent_type result;
+		result.swap_impl(*this);
+		owner_ = base::next_owner();
+		return result;
+	}
+};
+
+template <class T, class Alloc>
+bool operator==(const persistent_vector<T, Alloc>& lhs,
+                const persistent_vector<T, Alloc>& rhs) {
+	if (lhs.size() != rhs.size())
+		return false;
+
+	auto r = rhs.begin();
+	for (auto l = lhs.begin(); l != lhs.end(); ++l, ++r) {
+		if (*l != *r)
+			return false;
+	}
+
+	return true;
+}
+
+template <class T, class Alloc>
+bool operator!=(const persistent_vector<T, Alloc>& lhs,
+                const persistent_vector<T, Alloc>& rhs) {
+	return !(lhs == rhs);
+}
+
+template <class T, class Alloc>
+void swap(persistent_vector<T, Alloc>& lhs,
+          persistent_vector<T, Alloc>& rhs) noexcept {
+	lhs.swap(rhs);
+}
+
+MSTL_NAMESPACE_END
+
+#endif
@@ -0,0 +1,540 @@
+#ifndef SEGMENTED_VECTOR_H
+#define SEGMENTED_VECTOR_H
+
+#include "basic.h"
+
+#include "algorithm.h"
+#include "allocator.h"
+#include "bit.h"
+#include "iterator.h"
+#include "type_traits.h"
+
+#include <cassert>
+#include <climits>
+#include <initializer_list>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+MSTL_NAMESPACE_BEGIN
+
+// 分段表下标计算
+// 第 k 段容纳 F * 2^k 个元素 (F = 2^FirstBits)，前 k 段共 F * (2^(k+1) - 1) 个
+// 对下标 i 令 j = i + F，则 j 的最高位确定所在段，去掉最高位即为段内偏移
+//   segment = bit_width(j) - 1 - FirstBits
+//   offset  = j - (F << segment)
+// 整个过程只需一次 clz 指令，无需循环或分支
+template <size_t FirstBits>
+struct _segment_table_traits {
+	using size_type = size_t;
+
+	static constexpr size_type first_size = size_type(1) << FirstBits;
+	static constexpr size_type max_segments =
+	    sizeof(size_type) * CHAR_BIT - FirstBits;
+
+	static size_type segment_of(size_type i) noexcept {
+		return static_cast<size_type>(mSTL::bit_width(i + first_size)) - 1 -
+		       FirstBits;
+	}
+	static size_type offset_of(size_type i, size_type segment) noexcept {
+		return i + first_size - (first_size << segment);
+	}
+
+	// 第 k 段起始下标及大小
+	static size_type segment_base(size_type segment) noexcept {
+		return (first_size << segment) - first_size;
+	}
+	static size_type segment_size(size_type segment) noexcept {
+		return first_size << segment;
+	}
+};
+
+template <size_t FirstBits>
+constexpr typename _segment_table_traits<FirstBits>::size_type
+    _segment_table_traits<FirstBits>::first_size;
+template <size_t FirstBits>
+constexpr typename _segment_table_traits<FirstBits>::size_type
+    _segment_table_traits<FirstBits>::max_segments;
+
+// segmented_vector
+// 由按 2 的幂次增长的若干段组成，扩容时只分配新段，从不移动已有元素
+// 因此元素地址在 push_back 后保持不变，追加操作也不存在整体拷贝带来的延迟尖峰
+// 段表为定长数组，段本身通过 Allocator 分配
+template <class T, class Allocator = allocator<T>, size_t FirstBits = 4>
+class segmented_vector {
+
+public:
+	using value_type = T;
+	using allocator_type = Allocator;
+	using size_type = size_t;
+	using difference_type = ptrdiff_t;
+	using reference = value_type&;
+	using const_reference = const value_type&;
+	using pointer = value_type*;
+	using const_pointer = const value_type*;
+
+	using traits_type = _segment_table_traits<FirstBits>;
+
+	template <bool IsConst>
+	class segment_iterator;
+
+	using iterator = segment_iterator<false>;
+	using const_iterator = segment_iterator<true>;
+
+	using reverse_iterator = _reverse_iterator<iterator>;
+	using const_reverse_iterator = _reverse_iterator<const_iterator>;
+
+	// 缓存当前元素指针及所在段末尾，顺序遍历时仅在跨段时重新计算
+	template <bool IsConst>
+	class segment_iterator {
+	public:
+		using iterator_category = random_access_iterator_tag;
+		using value_type = T;
+		using difference_type = ptrdiff_t;
+		using pointer = typename IfThenElse<IsConst, const T*, T*>::result;
+		using reference = typename IfThenElse<IsConst, const T&, T&>::result;
+
+		using owner_type = typename IfThenElse<IsConst, const segmented_vector,
+		                                       segmented_vector>::result;
+		using self = segment_iterator;
+
+	private:
+		owner_type* owner_;
+		size_type   index_;
+		pointer     current_;
+		pointer     segment_end_;
+
+	public:
+		segment_iterator() noexcept
+		    : owner_(nullptr)
+		    , index_(0)
+		    , current_(nullptr)
+		    , segment_end_(nullptr) {}
+		segment_iterator(owner_type* owner, size_type index) noexcept
+		    : owner_(owner)
+		    , index_(index) {
+			locate();
+		}
+
+		// iterator -> const_iterator
+		template <bool B, class = typename std::enable_if<IsConst && !B>::type>
+		segment_iterator(const segment_iterator<B>& other) noexcept
+		    : owner_(other.owner())
+		    , index_(other.index()) {
+			locate();
+		}
+
+		owner_type* owner() const noexcept { return owner_; }
+		size_type   index() const noexcept { return index_; }
+
+		reference operator*() const noexcept { return *current_; }
+		pointer   operator->() const noexcept { return current_; }
+		reference operator[](difference_type n) const noexcept {
+			return (*owner_)[index_ + n];
+		}
+
+		self& operator++() noexcept {
+			++index_;
+			if (++current_ == segment_end_)
+				locate();
+			return *this;
+		}
+		self operator++(int) noexcept {
+			self temp = *this;
+			++*this;
+			return temp;
+		}
+		self& operator--() noexcept {
+			--index_;
+			locate();
+			return *this;
+		}
+		self operator--(int) noexcept {
+			self temp = *this;
+			--*this;
+			return temp;
+		}
+
+		self& operator+=(difference_type n) noexcept {
+			index_ += n;
+			locate();
+			return *this;
+		}
+		self& operator-=(difference_type n) noexcept {
+			index_ -= n;
+			locate();
+			return *this;
+		}
+		self operator+(difference_type n) const noexcept {
+			return self(owner_, index_ + n);
+		}
+		self operator-(difference_type n) const noexcept {
+			return self(owner_, index_ - n);
+		}
+		difference_type operator-(const self& other) const noexcept {
+			return static_cast<difference_type>(index_) -
+			       static_cast<difference_type>(other.index_);
+		}
+
+		bool operator==(const self& other) const noexcept {
+			return index_ == other.index_ && owner_ == other.owner_;
+		}
+		bool operator!=(const self& other) const noexcept {
+			return !(*this == other);
+		}
+		bool operator<(const self& other) const noexcept {
+			return index_ < other.index_;
+		}
+		bool operator>(const self& other) const noexcept {
+			return other < *this;
+		}
+		bool operator<=(const self& other) const noexcept {
+			return !(other < *this);
+		}
+		bool operator>=(const self& other) const noexcept {
+			return !(*this < other);
+		}
+
+	private:
+		// 下标越界 (如 end()) 时所在段可能尚未分配，此时指针置空
+		void locate() noexcept {
+			size_type segment = traits_type::segment_of(index_);
+			pointer   base = (owner_ != nullptr && segment < owner_->segments_)
+			                     ? owner_->table_[segment]
+			                     : nullptr;
+			if (base == nullptr) {
+				current_ = segment_end_ = nullptr;
+				return;
+			}
+			current_ = base + traits_type::offset_of(index_, segment);
+			segment_end_ = base + traits_type::segment_size(segment);
+		}
+	};
+
+private:
+	pointer   table_[traits_type::max_segments];
+	size_type size_;
+	size_type segments_; // 已分配段数
+
+public:
+	// (construct)(destruct)(copy)(operator=)(assign) ......
+
+	segmented_vector() noexcept
+	    : table_()
+	    , size_(0)
+	    , segments_(0) {}
+	segmented_vector(const size_type count,
+	                 const_reference value = value_type())
+	    : segmented_vector() {
+		assign(count, value);
+	}
+	template <class InputIterator,
+	          class = typename std::enable_if<
+	              !std::is_integral<InputIterator>::value>::type>
+	segmented_vector(InputIterator first, InputIterator last)
+	    : segmented_vector() {
+		assign(first, last);
+	}
+
+	segmented_vector(const segmented_vector& other)
+	    : segmented_vector() {
+		assign(other.begin(), other.end());
+	}
+	segmented_vector(segmented_vector&& other) noexcept
+	    : segmented_vector() {
+		swap(other);
+	}
+	segmented_vector& operator=(const segmented_vector& other) {
+		if (this == &other)
+			return *this;
+
+		assign(other.begin(), other.end());
+		return *this;
+	}
+	segmented_vector& operator=(segmented_vector&& other) noexcept {
+		if (this == &other)
+			return *this;
+
+		segmented_vector temp(std::move(other));
+		swap(temp);
+		return *this;
+	}
+
+	segmented_vector(const std::initializer_list<T>& il)
+	    : segmented_vector() {
+		assign(il.begin(), il.end());
+	}
+	segmented_vector& operator=(const std::initializer_list<T>& il) {
+		assign(il.begin(), il.end());
+		return *this;
+	}
+
+	void assign(size_type count, const_reference value) {
+		value_type copy(value);
+		clear();
+		reserve(count);
+		fill_rows(0, count, copy);
+	}
+	template <class InputIterator,
+	          class = typename std::enable_if<
+	              !std::is_integral<InputIterator>::value>::type>
+	void assign(InputIterator first, InputIterator last) {
+		clear();
+		for (; first != last; ++first)
+			emplace_back(*first);
+	}
+	void assign(const std::initializer_list<T>& il) {
+		assign(il.begin(), il.end());
+	}
+
+	~segmented_vector() noexcept {
+		clear();
+		release_segments(0);
+	}
+
+	allocator_type get_allocator() { return allocator_type(); }
+
+	// Element access
+
+	reference at(size_type pos) {
+		return pos < size_ ? (*this)[pos] : throw "out of range";
+	}
+	const_reference at(size_type pos) const {
+		return pos < size_ ? (*this)[pos] : throw "out of range";
+	}
+
+	reference operator[](size_type i) noexcept {
+		size_type segment = traits_type::segment_of(i);
+		return table_[segment][traits_type::offset_of(i, segment)];
+	}
+	const_reference operator[](size_type i) const noexcept {
+		size_type segment = traits_type::segment_of(i);
+		return table_[segment][traits_type::offset_of(i, segment)];
+	}
+
+	reference       front() { return (*this)[0]; }
+	const_reference front() const { return (*this)[0]; }
+
+	reference       back() { return (*this)[size_ - 1]; }
+	const_reference back() const { return (*this)[size_ - 1]; }
+
+	// 按段访问，便于对连续内存进行批量处理
+	size_type segment_count() const noexcept {
+		return size_ == 0 ? 0 : traits_type::segment_of(size_ - 1) + 1;
+	}
+	pointer segment_data(size_type segment) noexcept {
+		return table_[segment];
+	}
+	const_pointer segment_data(size_type segment) const noexcept {
+		return table_[segment];
+	}
+	// 第 segment 段中有效元素个数
+	size_type segment_size(size_type segment) const noexcept {
+		size_type base = traits_type::segment_base(segment);
+		size_type count = size_ > base ? size_ - base : 0;
+		return mSTL::min(count, traits_type::segment_size(segment));
+	}
+
+	// Iterators
+
+	iterator       begin() noexcept { return iterator(this, 0); }
+	const_iterator begin() const noexcept { return const_iterator(this, 0); }
+	const_iterator cbegin() const noexcept { return const_iterator(this, 0); }
+
+	iterator       end() noexcept { return iterator(this, size_); }
+	const_iterator end() const noexcept { return const_iterator(this, size_); }
+	const_iterator cend() const noexcept { return const_iterator(this, size_); }
+
+	reverse_iterator rbegin() noexcept { return reverse_iterator(end() - 1); }
+	const_reverse_iterator rbegin() const noexcept {
+		return const_reverse_iterator(end() - 1);
+	}
+	const_reverse_iterator crbegin() const noexcept {
+		return const_reverse_iterator(end() - 1);
+	}
+
+	reverse_iterator rend() noexcept { return reverse_iterator(begin() - 1); }
+	const_reverse_iterator rend() const noexcept {
+		return const_reverse_iterator(begin() - 1);
+	}
+	const_reverse_iterator crend() const noexcept {
+		return const_reverse_iterator(begin() - 1);
+	}
+
+	// Capacity
+
+	bool      empty() const noexcept { return size_ == 0; }
+	size_type size() const noexcept { return size_; }
+	size_type max_size() const noexcept {
+		return std::numeric_limits<difference_type>::max();
+	}
+	size_type capacity() const noexcept {
+		return traits_type::segment_base(segments_);
+	}
+
+	// 只会追加新段，不影响已有元素地址
+	void reserve(size_type n) {
+		while (capacity() < n)
+			allocate_segment();
+	}
+	// 释放未使用的段
+	void shrink_to_fit() noexcept { release_segments(segment_count()); }
+
+	// Modifiers
+
+	void clear() noexcept {
+		destroy_rows(0, size_);
+		size_ = 0;
+	}
+
+	void push_back(const_reference value) { emplace_back(value); }
+	void push_back(value_type&& value) { emplace_back(std::move(value)); }
+
+	template <class... Args>
+	reference emplace_back(Args&&... args) {
+		if (size_ == capacity())
+			allocate_segment();
+
+		pointer pos = &(*this)[size_];
+		allocator_type::construct(pos, std::forward<Args>(args)...);
+		++size_;
+		return *pos;
+	}
+
+	void pop_back() {
+		--size_;
+		allocator_type::destroy(&(*this)[size_]);
+	}
+
+	void resize(size_type count, const_reference value = value_type()) {
+		if (count < size_) {
+			destroy_rows(count, size_);
+			size_ = count;
+		} else if (count > size_) {
+			value_type copy(value);
+			reserve(count);
+			fill_rows(size_, count, copy);
+		}
+	}
+
+	void swap(segmented_vector& other) noexcept {
+		if (this == &other)
+			return;
+
+		// 仅交换双方已分配的段
+		size_type used = mSTL::max(segments_, other.segments_);
+		mSTL::swap_ranges(table_, table_ + used, other.table_);
+		mSTL::swap(size_, other.size_);
+		mSTL::swap(segments_, other.segments_);
+	}
+
+private:
+	void allocate_segment() {
+		assert(segments_ < traits_type::max_segments);
+		table_[segments_] =
+		    allocator_type::allocate(traits_type::segment_size(segments_));
+		++segments_;
+	}
+
+	// 释放下标不小于 keep 的段
+	void release_segments(size_type keep) noexcept {
+		while (segments_ > keep) {
+			--segments_;
+			allocator_type::deallocate(table_[segments_],
+			                           traits_type::segment_size(segments_));
+		}
+	}
+
+	// 逐段处理 [first, last)，每段内为连续内存
+	template <class Func>
+	void for_each_segment(size_type first, size_type last, Func func) {
+		while (first < last) {
+			size_type segment = traits_type::segment_of(first);
+			size_type offset = traits_type::offset_of(first, segment);
+			size_type count =
+			    mSTL::min(last - first, traits_type::segment_size(segment) - offset);
+
+			func(table_[segment] + offset, count);
+			first += count;
+		}
+	}
+
+	void destroy_rows(size_type first, size_type last) noexcept {
+		for_each_segment(first, last, [](pointer p, size_type count) {
+			allocator_type::destroy(p, p + count);
+		});
+	}
+
+	// 要求容量已足够，size_ 随构造进度更新
+	void fill_rows(size_type first, size_type last, const_reference value) {
+		for_each_segment(first, last, [this, &value](pointer p, size_type count) {
+			uninitialized_mem_func<value_type, allocator_type>::fill_n(p, count,
+			                                                           value);
+			size_ += count;
+		});
+	}
+};
+
+template <class T, class Alloc, size_t B>
+bool operator==(const segmented_vector<T, Alloc, B>& lhs,
+                const segmented_vector<T, Alloc, B>& rhs) {
+	if (lhs.size() != rhs.size())
+		return false;
+
+	for (size_t i = 0; i < lhs.size(); ++i) {
+		if (lhs[i] != rhs[i])
+			return false;
+	}
+
+	return true;
+}
+
+template <class T, class Alloc, size_t B>
+bool operator!=(const segmented_vector<T, Alloc, B>& lhs,
+                const segmented_vector<T, Alloc, B>& rhs) {
+	return !(lhs == rhs);
+}
+
+template <class T, class Alloc, size_t B>
+bool operator<(const segmented_vector<T, Alloc, B>& lhs,
+               const segmented_vector<T, Alloc, B>& rhs) {
+
+	size_t min_size = mSTL::min(lhs.size(), rhs.size());
+
+	for (size_t i = 0; i < min_size; ++i) {
+		if (lhs[i] > rhs[i])
+			return false;
+		else if (lhs[i] < rhs[i])
+			return true;
+	}
+
+	return lhs.size() < rhs.size();
+}
+
+template <class T, class Alloc, size_t B>
+bool operator<=(const segmented_vector<T, Alloc, B>& lhs,
+                const segmented_vector<T, Alloc, B>& rhs) {
+	return !(rhs < lhs);
+}
+
+template <class T, class Alloc, size_t B>
+bool operator>(const segmented_vector<T, Alloc, B>& lhs,
+               const segmented_vector<T, Alloc, B>& rhs) {
+	return rhs < lhs;
+}
+
+template <class T, class Alloc, size_t B>
+bool operator>=(const segmented_vector<T, Alloc, B>& lhs,
+                const segmented_vector<T, Alloc, B>& rhs) {
+	return !(lhs < rhs);
+}
+
+template <class T, class Alloc, size_t B>
+void swap(segmented_vector<T, Alloc, B>& lhs,
+          segmented_vector<T, Alloc, B>& rhs) noexcept {
+	lhs.swap(rhs);
+}
+
+MSTL_NAMESPACE_END
+
+#endif
@@ -0,0 +1,456 @@
+#ifndef SHM_ALLOCATOR_H
+#define SHM_ALLOCATOR_H
+
+#include "basic.h"
+
+#include "algorithm.h"
+#include "allocator.h"
+#include "offset_ptr.h"
+
+#include <atomic>
+#include <cassert>
+#include <cerrno>
+#include <new>
+#include <string>
+#include <utility>
+
+#include <fcntl.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MSTL_NAMESPACE_BEGIN
+
+// 共享内存段的底层存储
+enum class shm_backing {
+	shared_memory, // shm_open
+	file,          // shm_open 不可用时退化为 /tmp 下的普通文件
+};
+
+// 段头部，位于映射区域起始处，内部全部以相对段首的偏移记录位置
+struct _shm_header {
+	unsigned long long     magic;
+	std::atomic<unsigned>  lock;
+	std::atomic<size_t>    root;      // 根对象偏移，0 表示不存在
+	size_t                 size;      // 段总长度
+	size_t                 top;       // 未分配区域起点
+	size_t                 free_head; // 空闲块链表，0 表示空
+};
+
+// 块头部，紧邻用户数据之前
+struct _shm_block {
+	size_t size; // 含块头部的总长度
+	size_t next; // 空闲时为下一空闲块偏移
+};
+
+static_assert(ATOMIC_INT_LOCK_FREE == 2 && ATOMIC_LONG_LOCK_FREE == 2,
+              "shm_segment requires address-free atomics");
+
+// shm_segment
+// 可被多个进程同时映射的内存段，各进程映射地址可以不同
+// 段内分配采用 首次适配空闲链表 + 顶部指针 的简单策略，以自旋锁保证跨进程互斥
+// 释放紧邻顶部的块时直接回退顶部指针，其余空闲块不做合并
+// 段内对象之间须以 offset_ptr 互相引用，通常通过根对象定位共享的数据结构
+class shm_segment {
+public:
+	using size_type = size_t;
+
+	static constexpr unsigned long long magic_number = 0x6d53544c73686d31ULL;
+	static constexpr size_type          alignment = 16;
+
+private:
+	std::string  name_;
+	int          fd_;
+	char*        base_;
+	size_type    size_;
+	shm_backing  backing_;
+
+public:
+	// (construct)(destruct)(move) ......
+	// 段映射不可复制
+
+	shm_segment() noexcept
+	    : fd_(-1)
+	    , base_(nullptr)
+	    , size_(0)
+	    , backing_(shm_backing::shared_memory) {}
+	// 打开已存在的段，不存在时按 size 创建
+	shm_segment(const std::string& name, size_type size)
+	    : shm_segment() {
+		open_or_create(name, size);
+	}
+	// 打开已存在的段
+	explicit shm_segment(const std::string& name)
+	    : shm_segment() {
+		open(name);
+	}
+
+	shm_segment(const shm_segment&) = delete;
+	shm_segment& operator=(const shm_segment&) = delete;
+
+	shm_segment(shm_segment&& other) noexcept
+	    : shm_segment() {
+		swap(other);
+	}
+	shm_segment& operator=(shm_segment&& other) noexcept {
+		if (this == &other)
+			return *this;
+
+		close();
+		swap(other);
+		return *this;
+	}
+
+	~shm_segment() noexcept { close(); }
+
+	void open_or_create(const std::string& name, size_type size) {
+		close();
+
+		size = round_up(mSTL::max(size, header_size() + alignment));
+		shm_backing backing = shm_backing::shared_memory;
+
+		int fd = open_fd(name, O_RDWR | O_CREAT | O_EXCL, backing);
+		if (fd < 0 && errno == EEXIST) {
+			open(name);
+			return;
+		}
+		if (fd < 0)
+			throw "shm_segment: create failed";
+
+		if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+			::close(fd);
+			unlink(name, backing);
+			throw "shm_segment: ftruncate failed";
+		}
+
+		attach(name, fd, size, backing);
+
+		_shm_header* header = ::new (static_cast<void*>(base_)) _shm_header;
+		header->lock.store(0, std::memory_order_relaxed);
+		header->root.store(0, std::memory_order_relaxed);
+		header->size = size;
+		header->top = header_size();
+		header->free_head = 0;
+		std::atomic_thread_fence(std::memory_order_release);
+		header->magic = magic_number;
+	}
+
+	void open(const std::string& name) {
+		close();
+
+		shm_backing backing = shm_backing::shared_memory;
+		int         fd = open_fd(name, O_RDWR, backing);
+		if (fd < 0)
+			throw "shm_segment: open failed";
+
+		struct stat st;
+		if (::fstat(fd, &st) != 0 ||
+		    static_cast<size_type>(st.st_size) < header_size()) {
+			::close(fd);
+			throw "shm_segment: invalid segment";
+		}
+
+		attach(name, fd, static_cast<size_type>(st.st_size), backing);
+		if (header()->magic != magic_number) {
+			close();
+			throw "shm_segment: invalid segment";
+		}
+	}
+
+	// 解除映射，段本身保留至 remove()
+	void close() noexcept {
+		if (current() == this)
+			current() = nullptr;
+		if (base_ != nullptr)
+			::munmap(base_, size_);
+		if (fd_ >= 0)
+			::close(fd_);
+
+		name_.clear();
+		fd_ = -1;
+		base_ = nullptr;
+		size_ = 0;
+	}
+
+	// 删除命名段，已建立的映射仍然有效
+	static bool remove(const std::string& name) noexcept {
+		bool removed = unlink(name, shm_backing::shared_memory);
+		return unlink(name, shm_backing::file) || removed;
+	}
+
+	bool        is_open() const noexcept { return base_ != nullptr; }
+	void*       base() const noexcept { return base_; }
+	size_type   size() const noexcept { return size_; }
+	shm_backing backing() const noexcept { return backing_; }
+	const std::string& name() const noexcept { return name_; }
+
+	bool contains(const void* ptr) const noexcept {
+		const char* p = static_cast<const char*>(ptr);
+		return base_ != nullptr && p >= base_ && p < base_ + size_;
+	}
+
+	// 剩余未分配区域大小 (不含空闲链表)
+	size_type free_size() const noexcept {
+		return base_ == nullptr ? 0 : header()->size - header()->top;
+	}
+
+	// 段内分配，按 alignment 对齐，空间不足时抛出异常
+	void* allocate(size_type bytes) {
+		size_type need = round_up(mSTL::max(bytes, size_type(1))) + block_size();
+
+		lock_guard lock(header());
+		_shm_header* h = header();
+
+		// 首次适配
+		size_type* prev = &h->free_head;
+		while (*prev != 0) {
+			_shm_block* block = block_at(*prev);
+			if (block->size >= need) {
+				size_type offset = *prev;
+				if (block->size - need >= 4 * block_size()) {
+					_shm_block* rest = block_at(offset + need);
+					rest->size = block->size - need;
+					rest->next = block->next;
+					*prev = offset + need;
+					block->size = need;
+				} else {
+					*prev = block->next;
+				}
+				return data_of(offset);
+			}
+			prev = &block->next;
+		}
+
+		if (need > h->size - h->top)
+			throw "shm_segment: out of memory";
+
+		size_type   offset = h->top;
+		_shm_block* block = block_at(offset);
+		block->size = need;
+		block->next = 0;
+		h->top += need;
+		return data_of(offset);
+	}
+
+	void deallocate(void* ptr) noexcept {
+		if (ptr == nullptr)
+			return;
+
+		lock_guard   lock(header());
+		_shm_header* h = header();
+		size_type    offset =
+		    static_cast<size_type>(static_cast<char*>(ptr) - base_) - block_size();
+		_shm_block* block = block_at(offset);
+
+		if (offset + block->size == h->top) {
+			h->top = offset;
+		} else {
+			block->next = h->free_head;
+			h->free_head = offset;
+		}
+	}
+
+	// 根对象，供各进程定位共享数据结构
+	template <class U>
+	U* root() const noexcept {
+		size_type offset = header()->root.load(std::memory_order_acquire);
+		return offset == 0 ? nullptr : reinterpret_cast<U*>(base_ + offset);
+	}
+	// 根对象不存在时在段内构造，多个进程同时构造时只保留其一
+	template <class U, class... Args>
+	U* find_or_construct_root(Args&&... args) {
+		if (U* existing = root<U>())
+			return existing;
+
+		void* storage = allocate(sizeof(U));
+		U*    object = nullptr;
+		try {
+			object = ::new (storage) U(std::forward<Args>(args)...);
+		} catch (...) {
+			deallocate(storage);
+			throw;
+		}
+
+		size_type expected = 0;
+		size_type offset = static_cast<size_type>(
+		    reinterpret_cast<char*>(object) - base_);
+		if (!header()->root.compare_exchange_strong(expected, offset,
+		                                            std::memory_order_acq_rel)) {
+			object->~U();
+			deallocate(storage);
+			return root<U>();
+		}
+		return object;
+	}
+
+	// shm_allocator 使用的当前段
+	static shm_segment*& current() noexcept {
+		static shm_segment* segment = nullptr;
+		return segment;
+	}
+	void make_current() noexcept { current() = this; }
+
+	void swap(shm_segment& other) noexcept {
+		if (this == &other)
+			return;
+
+		if (current() == this)
+			current() = &other;
+		else if (current() == &other)
+			current() = this;
+
+		name_.swap(other.name_);
+		mSTL::swap(fd_, other.fd_);
+		mSTL::swap(base_, other.base_);
+		mSTL::swap(size_, other.size_);
+		mSTL::swap(backing_, other.backing_);
+	}
+
+private:
+	// 跨进程自旋锁
+	class lock_guard {
+	private:
+		_shm_header* header_;
+
+	public:
+		explicit lock_guard(_shm_header* header) noexcept
+		    : header_(header) {
+			unsigned expected = 0;
+			while (!header_->lock.compare_exchange_weak(
+			    expected, 1, std::memory_order_acquire)) {
+				expected = 0;
+				::sched_yield();
+			}
+		}
+		~lock_guard() noexcept {
+			header_->lock.store(0, std::memory_order_release);
+		}
+
+		lock_guard(const lock_guard&) = delete;
+		lock_guard& operator=(const lock_guard&) = delete;
+	};
+
+	static size_type round_up(size_type n) noexcept {
+		return (n + alignment - 1) & ~(alignment - 1);
+	}
+	static size_type header_size() noexcept {
+		return round_up(sizeof(_shm_header));
+	}
+	static size_type block_size() noexcept {
+		return round_up(sizeof(_shm_block));
+	}
+
+	_shm_header* header() const noexcept {
+		return reinterpret_cast<_shm_header*>(base_);
+	}
+	_shm_block* block_at(size_type offset) const noexcept {
+		return reinterpret_cast<_shm_block*>(base_ + offset);
+	}
+	void* data_of(size_type offset) const noexcept {
+		return base_ + offset + block_size();
+	}
+
+	static std::string file_path(const std::string& name) {
+		return std::string("/tmp/") +
+		       (name.empty() || name[0] != '/' ? name : name.substr(1));
+	}
+	static std::string shm_name(const std::string& name) {
+		return name.empty() || name[0] != '/' ? "/" + name : name;
+	}
+
+	// 优先使用 shm_open，失败 (非 EEXIST) 时退化为普通文件
+	static int open_fd(const std::string& name, int flags,
+	                   shm_backing& backing) {
+		int fd = ::shm_open(shm_name(name).c_str(), flags, 0600);
+		if (fd >= 0 || errno == EEXIST) {
+			backing = shm_backing::shared_memory;
+			return fd;
+		}
+
+		backing = shm_backing::file;
+		return ::open(file_path(name).c_str(), flags, 0600);
+	}
+
+	static bool unlink(const std::string& name, shm_backing backing) noexcept {
+		return backing == shm_backing::shared_memory
+		           ? ::shm_unlink(shm_name(name).c_str()) == 0
+		           : ::unlink(file_path(name).c_str()) == 0;
+	}
+
+	void attach(const std::string& name, int fd, size_type size,
+	            shm_backing backing) {
+		void* ptr =
+		    ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		if (ptr == MAP_FAILED) {
+			::close(fd);
+			throw "shm_segment: mmap failed";
+		}
+
+		name_ = name;
+		fd_ = fd;
+		base_ = static_cast<char*>(ptr);
+		size_ = size;
+		backing_ = backing;
+	}
+};
+
+// shm_allocator
+// 从 shm_segment::current() 指定的共享内存段中分配，pointer 类型为 offset_ptr
+// 接口与 allocator 一致，可直接作为 vector 等容器的 Allocator 参数
+template <class T>
+class shm_allocator {
+public:
+	using value_type = T;
+	using pointer = offset_ptr<T>;
+	using const_pointer = offset_ptr<const T>;
+	using reference = T&;
+	using const_reference = const T&;
+	using size_type = size_t;
+	using difference_type = ptrdiff_t;
+
+	template <class U>
+	struct rebind {
+		using other = shm_allocator<U>;
+	};
+
+	using construct_type = allocator<T>;
+
+public:
+	static pointer allocate() { return allocate(1); }
+	static pointer allocate(size_type n) {
+		if (n == 0)
+			return nullptr;
+
+		shm_segment* segment = shm_segment::current();
+		if (segment == nullptr)
+			throw "shm_allocator: no current segment";
+		return static_cast<T*>(segment->allocate(sizeof(T) * n));
+	}
+
+	static void deallocate(pointer ptr) { deallocate(ptr, 1); }
+	static void deallocate(pointer ptr, size_type n) {
+		if (ptr == nullptr || n == 0)
+			return;
+
+		shm_segment* segment = shm_segment::current();
+		assert(segment != nullptr && segment->contains(ptr.get()));
+		segment->deallocate(ptr.get());
+	}
+
+	// 对象构造与析构与 allocator 相同
+	static void construct(T* ptr) { construct_type::construct(ptr); }
+	template <class... Args>
+	static void construct(T* ptr, Args&&... args) {
+		construct_type::construct(ptr, std::forward<Args>(args)...);
+	}
+
+	static void destroy(T* ptr) noexcept { construct_type::destroy(ptr); }
+	static void destroy(T* first, T* last) noexcept {
+		construct_type::destroy(first, last);
+	}
+};
+
+MSTL_NAMESPACE_END
+
+#endif
@@ -0,0 +1,1342 @@
+#ifndef SIMD_H
+#define SIMD_H
+
+#include "basic.h"
+
+#include "bit.h"
+#include "cpu_features.h"
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+MSTL_NAMESPACE_BEGIN
+
+// simd
+// 供容器与算法使用的连续内存 SIMD 内核
+// 首次调用时按 cpu_features 选择 AVX-512 / AVX2 / SSE2 实现，均不支持时使用标量实现
+class simd {
+private:
+	using mismatch_kernel = size_t (*)(const unsigned char*,
+	                                   const unsigned char*, size_t);
+
+	using intersect_kernel = size_t (*)(const uint32_t*, size_t,
+	                                    const uint32_t*, size_t, uint32_t*);
+
+public:
+	// 逐元素比较 x OP y，结果与标量运算符一致 (与 NaN 比较时仅 op_ne 成立)
+	enum compare_op { op_eq, op_ne, op_lt, op_le, op_gt, op_ge };
+
+	// 指令集级别，scan_kernels_for() 以此限定内核所用指令集的上限
+	enum isa_level { isa_scalar, isa_sse2, isa_avx2, isa_avx512 };
+
+	// 支持向量扫描的元素类型: 1 / 2 / 4 / 8 字节的整数 (bool 除外) 与 float / double
+	template <class T>
+	struct is_scan_type
+	    : std::integral_constant<
+	          bool, (std::is_integral<T>::value &&
+	                 !std::is_same<T, bool>::value &&
+	                 (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 ||
+	                  sizeof(T) == 8)) ||
+	                    std::is_same<T, float>::value ||
+	                    std::is_same<T, double>::value> {};
+
+	// 同一元素类型与比较运算的一组扫描内核
+	template <class T, int Op>
+	struct scan_kernel_table {
+		// 首个 (data[i] OP value) != negate 的下标，不存在时返回 n
+		size_t (*find)(const T*, size_t, T, bool);
+		// 满足 data[i] OP value 的元素个数
+		size_t (*count)(const T*, size_t, T);
+		// 首个 (a[i] OP b[i]) != negate 的下标，不存在时返回 n
+		size_t (*find_pair)(const T*, const T*, size_t, bool);
+	};
+
+	// 首个不同字节相对起始位置的偏移，完全相同时返回 bytes
+	static size_t mismatch_bytes(const void* lhs, const void* rhs,
+	                             size_t bytes) noexcept {
+		return kernels().mismatch(static_cast<const unsigned char*>(lhs),
+		                          static_cast<const unsigned char*>(rhs),
+		                          bytes);
+	}
+
+	// 两个严格递增数组的交集写入 out，返回交集元素个数
+	// out 容量不小于 min(na, nb)，可与 a 或 b 相同
+	static size_t intersect_sorted(const uint32_t* a, size_t na,
+	                               const uint32_t* b, size_t nb,
+	                               uint32_t* out) noexcept {
+		return kernels().intersect(a, na, b, nb, out);
+	}
+
+	// 首个 (data[i] OP value) != negate 的元素下标，不存在时返回 n
+	template <int Op, class T>
+	static size_t find_value(const T* data, size_t n, T value,
+	                         bool negate = false) noexcept {
+		return scan_kernels<T, Op>().find(data, n, value, negate);
+	}
+
+	// 满足 data[i] OP value 的元素个数
+	template <int Op, class T>
+	static size_t count_value(const T* data, size_t n, T value) noexcept {
+		return scan_kernels<T, Op>().count(data, n, value);
+	}
+
+	// 首个 (a[i] OP b[i]) != negate 的下标，不存在时返回 n
+	// a 与 b 可以重叠，如 (data + 1, data) 逐对比较相邻元素
+	template <int Op, class T>
+	static size_t find_pair(const T* a, const T* b, size_t n,
+	                        bool negate = false) noexcept {
+		return scan_kernels<T, Op>().find_pair(a, b, n, negate);
+	}
+
+	// 同一元素类型的一组最值内核
+	template <class T>
+	struct minmax_kernel_table {
+		// [data, data + n) 的最小值与最大值，n 须大于 0; 含 NaN 时返回 false
+		bool (*minmax)(const T*, size_t, T*, T*);
+		// 原地把每个元素限制在 [lo, hi]
+		void (*clamp)(T*, size_t, T, T);
+	};
+
+	// 首个最小元素与首个最大元素的下标，last_max 为 true 时取最后一个最大元素 (同 minmax_element)
+	// 逐块求最值，记录最值首次 (最后) 出现的块，最后在该块内定位; 不需要的下标传入 nullptr
+	// n 须大于 0; 浮点数含 NaN 时比较结果依赖顺序，返回 false 由调用方按标量语义处理
+	template <class T>
+	static bool minmax_index(const T* data, size_t n, size_t* min_index,
+	                         size_t* max_index, bool last_max) noexcept {
+		const minmax_kernel_table<T>& table = minmax_kernels<T>();
+		const size_t block = minmax_block_bytes / sizeof(T);
+		T            lo = data[0], hi = data[0];
+		size_t       lo_block = 0, hi_block = 0;
+		for (size_t start = 0; start < n; start += block) {
+			T block_lo, block_hi;
+			if (!table.minmax(data + start, block_size(start, n, block),
+			                  &block_lo, &block_hi))
+				return false;
+			if (block_lo < lo) {
+				lo = block_lo;
+				lo_block = start;
+			}
+			if (last_max ? !(block_hi < hi) : hi < block_hi) {
+				hi = block_hi;
+				hi_block = start;
+			}
+		}
+		if (min_index != nullptr) {
+			const size_t len = block_size(lo_block, n, block);
+			*min_index = lo_block + find_value<op_eq>(data + lo_block, len, lo);
+		}
+		if (max_index != nullptr) {
+			const size_t len = block_size(hi_block, n, block);
+			size_t       i = hi_block + len;
+			if (!last_max)
+				i = hi_block + find_value<op_eq>(data + hi_block, len, hi);
+			else
+				while (!(data[--i] == hi))
+					;
+			*max_index = i;
+		}
+		return true;
+	}
+
+	// 原地把每个元素限制在 [lo, hi]，结果同逐个调用 clamp(x, lo, hi)
+	template <class T>
+	static void clamp(T* data, size_t n, T lo, T hi) noexcept {
+		minmax_kernels<T>().clamp(data, n, lo, hi);
+	}
+
+	// 当前处理器上元素类型 T 可用的最高指令集，8 / 16 位元素的 AVX-512 内核需要 AVX-512BW
+	template <class T>
+	static isa_level max_scan_isa() noexcept {
+#if MSTL_X86_SIMD
+		const cpu_features& features = cpu_features::get();
+		if (features.avx512f && (sizeof(T) >= 4 || features.avx512bw))
+			return isa_avx512;
+		if (features.avx2)
+			return isa_avx2;
+		if (features.sse2)
+			return isa_sse2;
+#endif
+		return isa_scalar;
+	}
+
+	// 指令集不超过 level 的最值内核
+	template <class T>
+	static minmax_kernel_table<T> minmax_kernels_for(isa_level level) noexcept {
+		static_assert(is_scan_type<T>::value,
+		              "simd minmax supports integers of 1, 2, 4 or 8 bytes, "
+		              "float and double");
+		minmax_kernel_table<T> table = {&minmax_scalar<T>, &clamp_scalar<T>};
+#if MSTL_X86_SIMD
+		const isa_level best = max_scan_isa<T>();
+		if (level > best)
+			level = best;
+		if (level == isa_avx512)
+			table = ops_minmax_kernels<avx512_ops<T>>();
+		else if (level == isa_avx2)
+			table = ops_minmax_kernels<avx2_ops<T>>();
+		else if (level == isa_sse2)
+			table = ops_minmax_kernels<sse2_ops<T>>();
+#endif
+		return table;
+	}
+
+	// 指令集不超过 level 的扫描内核，供测试与基准逐一对比各指令集
+	template <class T, int Op>
+	static scan_kernel_table<T, Op> scan_kernels_for(isa_level level) noexcept {
+		static_assert(is_scan_type<T>::value,
+		              "simd scan supports integers of 1, 2, 4 or 8 bytes, "
+		              "float and double");
+		scan_kernel_table<T, Op> table = {&find_scalar<T, Op>,
+		                                  &count_scalar<T, Op>,
+		                                  &find_pair_scalar<T, Op>};
+#if MSTL_X86_SIMD
+		const isa_level best = max_scan_isa<T>();
+		if (level > best)
+			level = best;
+		if (level == isa_avx512)
+			table = ops_kernels<avx512_ops<T>, Op>();
+		else if (level == isa_avx2)
+			table = ops_kernels<avx2_ops<T>, Op>();
+		else if (level == isa_sse2)
+			table = ops_kernels<sse2_ops<T>, Op>();
+#endif
+		return table;
+	}
+
+private:
+	struct kernel_table {
+		mismatch_kernel  mismatch;
+		intersect_kernel intersect;
+	};
+
+	static const kernel_table& kernels() noexcept {
+		static const kernel_table table = select_kernels();
+		return table;
+	}
+
+	static kernel_table select_kernels() noexcept {
+		kernel_table table = {&mismatch_scalar, &intersect_scalar};
+#if MSTL_X86_SIMD
+		const cpu_features& features = cpu_features::get();
+		if (features.avx2) {
+			table.mismatch = &mismatch_avx2;
+			table.intersect = &intersect_avx2;
+		} else if (features.sse2) {
+			table.mismatch = &mismatch_sse2;
+			table.intersect = &intersect_sse2;
+		}
+#endif
+		return table;
+	}
+
+	template <class T, int Op>
+	static const scan_kernel_table<T, Op>& scan_kernels() noexcept {
+		static const scan_kernel_table<T, Op> table =
+		    scan_kernels_for<T, Op>(isa_avx512);
+		return table;
+	}
+
+	// 最值按块计算，块内数据留在 L1 中供定位时再次读取
+	enum { minmax_block_bytes = 16384 };
+
+	static size_t block_size(size_t start, size_t n, size_t block) noexcept {
+		return n - start < block ? n - start : block;
+	}
+
+	template <class T>
+	static const minmax_kernel_table<T>& minmax_kernels() noexcept {
+		static const minmax_kernel_table<T> table =
+		    minmax_kernels_for<T>(isa_avx512);
+		return table;
+	}
+
+	template <class T>
+	static bool minmax_scalar(const T* data, size_t n, T* lo, T* hi) noexcept {
+		T a = data[0], b = data[0];
+		for (size_t i = 0; i < n; ++i) {
+			if (std::is_floating_point<T>::value && !(data[i] == data[i]))
+				return false;
+			if (data[i] < a)
+				a = data[i];
+			if (b < data[i])
+				b = data[i];
+		}
+		*lo = a;
+		*hi = b;
+		return true;
+	}
+
+	template <class T>
+	static void clamp_scalar(T* data, size_t n, T lo, T hi) noexcept {
+		for (size_t i = 0; i < n; ++i)
+			data[i] = data[i] < lo ? lo : hi < data[i] ? hi : data[i];
+	}
+
+	template <int Op, class T>
+	static bool compare(T x, T y) noexcept {
+		return Op == op_eq   ? x == y
+		       : Op == op_ne ? x != y
+		       : Op == op_lt ? x < y
+		       : Op == op_le ? x <= y
+		       : Op == op_gt ? x > y
+		                     : x >= y;
+	}
+
+	template <class T, int Op>
+	static size_t find_scalar(const T* data, size_t n, T value,
+	                          bool negate) noexcept {
+		for (size_t i = 0; i < n; ++i)
+			if (compare<Op>(data[i], value) != negate)
+				return i;
+		return n;
+	}
+
+	template <class T, int Op>
+	static size_t count_scalar(const T* data, size_t n, T value) noexcept {
+		size_t count = 0;
+		for (size_t i = 0; i < n; ++i)
+			count += compare<Op>(data[i], value) ? 1 : 0;
+		return count;
+	}
+
+	template <class T, int Op>
+	static size_t find_pair_scalar(const T* a, const T* b, size_t n,
+	                               bool negate) noexcept {
+		for (size_t i = 0; i < n; ++i)
+			if (compare<Op>(a[i], b[i]) != negate)
+				return i;
+		return n;
+	}
+
+	// 按 8 字节比较，异或结果的最低非零字节即首个不同字节 (小端)
+	static size_t mismatch_scalar(const unsigned char* lhs,
+	                              const unsigned char* rhs,
+	                              size_t               bytes) noexcept {
+		size_t i = 0;
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+		for (; i + 8 <= bytes; i += 8) {
+			uint64_t a, b;
+			memcpy(&a, lhs + i, 8);
+			memcpy(&b, rhs + i, 8);
+			if (a != b)
+				return i + static_cast<size_t>(mSTL::countr_zero(a ^ b) / 8);
+		}
+#endif
+		for (; i < bytes; ++i)
+			if (lhs[i] != rhs[i])
+				return i;
+		return bytes;
+	}
+
+	static size_t intersect_scalar(const uint32_t* a, size_t na,
+	                               const uint32_t* b, size_t nb,
+	                               uint32_t* out) noexcept {
+		size_t i = 0, j = 0, count = 0;
+		while (i < na && j < nb) {
+			if (a[i] < b[j]) {
+				++i;
+			} else if (b[j] < a[i]) {
+				++j;
+			} else {
+				out[count++] = a[i];
+				++i;
+				++j;
+			}
+		}
+		return count;
+	}
+
+#if MSTL_X86_SIMD
+	MSTL_TARGET("sse2")
+	static size_t mismatch_sse2(const unsigned char* lhs,
+	                            const unsigned char* rhs,
+	                            size_t               bytes) noexcept {
+		size_t i = 0;
+		for (; i + 16 <= bytes; i += 16) {
+			__m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lhs + i));
+			__m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rhs + i));
+			unsigned mask =
+			    static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)));
+			if (mask != 0xffffu)
+				return i + static_cast<size_t>(mSTL::countr_zero(~mask & 0xffffu));
+		}
+		return i + mismatch_scalar(lhs + i, rhs + i, bytes - i);
+	}
+
+	MSTL_TARGET("avx2")
+	static size_t mismatch_avx2(const unsigned char* lhs,
+	                            const unsigned char* rhs,
+	                            size_t               bytes) noexcept {
+		size_t i = 0;
+		for (; i + 32 <= bytes; i += 32) {
+			__m256i a =
+			    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhs + i));
+			__m256i b =
+			    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rhs + i));
+			unsigned mask = static_cast<unsigned>(
+			    _mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)));
+			if (mask != 0xffffffffu)
+				return i + static_cast<size_t>(mSTL::countr_zero(~mask));
+		}
+		return i + mismatch_scalar(lhs + i, rhs + i, bytes - i);
+	}
+
+	// 块内全比较: a 的一块与 b 的一块各轮换位置比较相等，掩码给出 a 中出现在 b 块内的元素
+	// 之后末元素较小的一侧前进一块 (相等时同时前进)，剩余部分逐个比较
+	MSTL_TARGET("sse2")
+	static size_t intersect_sse2(const uint32_t* a, size_t na,
+	                             const uint32_t* b, size_t nb,
+	                             uint32_t* out) noexcept {
+		size_t i = 0, j = 0, count = 0;
+		while (i + 4 <= na && j + 4 <= nb) {
+			const uint32_t a_max = a[i + 3];
+			const uint32_t b_max = b[j + 3];
+			__m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+			__m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + j));
+			__m128i eq = _mm_or_si128(
+			    _mm_or_si128(_mm_cmpeq_epi32(va, vb),
+			                 _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, 0x39))),
+			    _mm_or_si128(_mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, 0x4e)),
+			                 _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, 0x93))));
+			unsigned mask =
+			    static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(eq)));
+			for (; mask != 0; mask &= mask - 1)
+				out[count++] = a[i + static_cast<size_t>(mSTL::countr_zero(mask))];
+			i += a_max <= b_max ? 4 : 0;
+			j += b_max <= a_max ? 4 : 0;
+		}
+		return count + intersect_scalar(a + i, na - i, b + j, nb - j, out + count);
+	}
+
+	MSTL_TARGET("avx2")
+	static size_t intersect_avx2(const uint32_t* a, size_t na,
+	                             const uint32_t* b, size_t nb,
+	                             uint32_t* out) noexcept {
+		size_t i = 0, j = 0, count = 0;
+		while (i + 8 <= na && j + 8 <= nb) {
+			const uint32_t a_max = a[i + 7];
+			const uint32_t b_max = b[j + 7];
+			__m256i va =
+			    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+			__m256i vb =
+			    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + j));
+			// 128 位通道内轮换 4 次，再交换两个通道轮换 4 次，覆盖全部 8 x 8 组合
+			__m256i vs = _mm256_permute2x128_si256(vb, vb, 0x01);
+			__m256i eq = _mm256_or_si256(
+			    _mm256_or_si256(
+			        _mm256_or_si256(
+			            _mm256_cmpeq_epi32(va, vb),
+			            _mm256_cmpeq_epi32(va, _mm256_shuffle_epi32(vb, 0x39))),
+			        _mm256_or_si256(
+			            _mm256_cmpeq_epi32(va, _mm256_shuffle_epi32(vb, 0x4e)),
+			            _mm256_cmpeq_epi32(va, _mm256_shuffle_epi32(vb, 0x93)))),
+			    _mm256_or_si256(
+			        _mm256_or_si256(
+			            _mm256_cmpeq_epi32(va, vs),
+			            _mm256_cmpeq_epi32(va, _mm256_shuffle_epi32(vs, 0x39))),
+			        _mm256_or_si256(
+			            _mm256_cmpeq_epi32(va, _mm256_shuffle_epi32(vs, 0x4e)),
+			            _mm256_cmpeq_epi32(va, _mm256_shuffle_epi32(vs, 0x93)))));
+			unsigned mask = static_cast<unsigned>(
+			    _mm256_movemask_ps(_mm256_castsi256_ps(eq)));
+			for (; mask != 0; mask &= mask - 1)
+				out[count++] = a[i + static_cast<size_t>(mSTL::countr_zero(mask))];
+			i += a_max <= b_max ? 8 : 0;
+			j += b_max <= a_max ? 8 : 0;
+		}
+		return count + intersect_scalar(a + i, na - i, b + j, nb - j, out + count);
+	}
+
+	// 各指令集按元素宽度的加载、比较与最值，内核由 MSTL_SIMD_SCAN_KERNELS / MSTL_SIMD_MINMAX_KERNELS 在其中生成
+	// eq(a, b) / lt(a, b) 返回逐元素掩码，每个元素占 lane_bits 位; min / max 同 _mm_min_ps 的选择方向
+	template <class T, size_t Size = sizeof(T),
+	          bool Float = std::is_floating_point<T>::value>
+	struct sse2_ops;
+	template <class T, size_t Size = sizeof(T),
+	          bool Float = std::is_floating_point<T>::value>
+	struct avx2_ops;
+	template <class T, size_t Size = sizeof(T),
+	          bool Float = std::is_floating_point<T>::value>
+	struct avx512_ops;
+
+	// SSE2 处理器不一定支持 popcnt 指令，16 位掩码以移位相加计数，避免逐向量调用库函数
+	static uint32_t popcount_sse2(uint32_t x) noexcept {
+		x = x - ((x >> 1) & 0x5555u);
+		x = (x & 0x3333u) + ((x >> 2) & 0x3333u);
+		x = (x + (x >> 4)) & 0x0f0fu;
+		return (x + (x >> 8)) & 0x1fu;
+	}
+
+	template <class Ops>
+	static minmax_kernel_table<typename Ops::value_type>
+	ops_minmax_kernels() noexcept {
+		minmax_kernel_table<typename Ops::value_type> table = {&Ops::minmax,
+		                                                       &Ops::clamp};
+		return table;
+	}
+
+	template <class Ops, int Op>
+	static scan_kernel_table<typename Ops::value_type, Op> ops_kernels() noexcept {
+		scan_kernel_table<typename Ops::value_type, Op> table = {
+		    &Ops::template find<Op>, &Ops::template count<Op>,
+		    &Ops::template find_pair<Op>};
+		return table;
+	}
+#endif
+};
+
+#if MSTL_X86_SIMD
+// find / find_pair 每次检查 4 个向量，命中后再定位具体元素
+// count 以 bit_count 累加掩码置位数，最后按每元素位数折算
+#define MSTL_SIMD_SCAN_KERNELS(isa, bit_count)                                 \
+	static constexpr mask_type full_mask() noexcept {                          \
+		return static_cast<mask_type>(~mask_type(0) >>                         \
+		                              (sizeof(mask_type) * 8 -                 \
+		                               lanes * lane_bits));                    \
+	}                                                                          \
+	template <int Op>                                                          \
+	MSTL_TARGET(isa)                                                           \
+	static mask_type compare(vector a, vector b) noexcept {                    \
+		return Op == op_eq   ? eq(a, b)                                        \
+		       : Op == op_ne ? static_cast<mask_type>(full_mask() ^ eq(a, b))  \
+		       : Op == op_lt ? lt(a, b)                                        \
+		       : Op == op_le ? static_cast<mask_type>(lt(a, b) | eq(a, b))     \
+		       : Op == op_gt ? lt(b, a)                                        \
+		                     : static_cast<mask_type>(lt(b, a) | eq(a, b));    \
+	}                                                                          \
+	template <int Op>                                                          \
+	MSTL_TARGET(isa)                                                           \
+	static size_t find(const value_type* data, size_t n, value_type value,     \
+	                   bool negate) noexcept {                                 \
+		const vector    y = set1(value);                                       \
+		const mask_type flip = negate ? full_mask() : 0;                       \
+		size_t          i = 0;                                                 \
+		for (; i + 4 * lanes <= n; i += 4 * lanes) {                           \
+			mask_type mask[4];                                                 \
+			for (size_t j = 0; j < 4; ++j)                                     \
+				mask[j] = compare<Op>(load(data + i + j * lanes), y) ^ flip;   \
+			if ((mask[0] | mask[1] | mask[2] | mask[3]) == 0)                  \
+				continue;                                                      \
+			for (size_t j = 0;; ++j)                                           \
+				if (mask[j] != 0)                                              \
+					return i + j * lanes +                                     \
+					       static_cast<size_t>(mSTL::countr_zero(mask[j])) /   \
+					           lane_bits;                                      \
+		}                                                                      \
+		return i + find_scalar<value_type, Op>(data + i, n - i, value, negate);  \
+	}                                                                          \
+	template <int Op>                                                          \
+	MSTL_TARGET(isa)                                                           \
+	static size_t count(const value_type* data, size_t n,                      \
+	                    value_type value) noexcept {                           \
+		const vector y = set1(value);                                          \
+		size_t       bits = 0;                                                 \
+		size_t       i = 0;                                                    \
+		for (; i + lanes <= n; i += lanes)                                     \
+			bits += static_cast<size_t>(                                       \
+			    bit_count(compare<Op>(load(data + i), y)));                    \
+		return bits / lane_bits +                                              \
+		       count_scalar<value_type, Op>(data + i, n - i, value);           \
+	}                                                                          \
+	template <int Op>                                                          \
+	MSTL_TARGET(isa)                                                           \
+	static size_t find_pair(const value_type* a, const value_type* b,          \
+	                        size_t n, bool negate) noexcept {                  \
+		const mask_type flip = negate ? full_mask() : 0;                       \
+		size_t          i = 0;                                                 \
+		for (; i + 4 * lanes <= n; i += 4 * lanes) {                           \
+			mask_type mask[4];                                                 \
+			for (size_t j = 0; j < 4; ++j)                                     \
+				mask[j] = compare<Op>(load(a + i + j * lanes),                 \
+				                      load(b + i + j * lanes)) ^                \
+				          flip;                                                \
+			if ((mask[0] | mask[1] | mask[2] | mask[3]) == 0)                  \
+				continue;                                                      \
+			for (size_t j = 0;; ++j)                                           \
+				if (mask[j] != 0)                                              \
+					return i + j * lanes +                                     \
+					       static_cast<size_t>(mSTL::countr_zero(mask[j])) /   \
+					           lane_bits;                                      \
+		}                                                                      \
+		return i +                                                             \
+		       find_pair_scalar<value_type, Op>(a + i, b + i, n - i, negate);  \
+	}
+
+// minmax 以 4 组累加器逐元素求最值 (浮点 min / max 延迟较长)，末尾不足一个向量时与前一向量重叠读取
+// 浮点数同时检查是否出现 NaN
+// clamp 逐向量计算 min(hi, max(lo, x))，选择方向与标量 clamp 一致，NaN 保持不变
+// 末尾同样重叠处理，已限制的元素再次限制结果不变
+#define MSTL_SIMD_MINMAX_KERNELS(isa)                                          \
+	MSTL_TARGET(isa)                                                           \
+	static mask_type unordered(vector x) noexcept {                            \
+		return std::is_floating_point<value_type>::value                       \
+		           ? static_cast<mask_type>(full_mask() ^ eq(x, x))            \
+		           : 0;                                                        \
+	}                                                                          \
+	MSTL_TARGET(isa)                                                           \
+	static bool minmax(const value_type* data, size_t n, value_type* lo,       \
+	                   value_type* hi) noexcept {                              \
+		if (n < 4 * lanes)                                                     \
+			return minmax_scalar(data, n, lo, hi);                             \
+		vector    low[4], high[4];                                             \
+		mask_type nan = 0;                                                     \
+		for (size_t j = 0; j < 4; ++j) {                                       \
+			low[j] = high[j] = load(data + j * lanes);                         \
+			nan |= unordered(low[j]);                                          \
+		}                                                                      \
+		size_t i = 4 * lanes;                                                  \
+		for (; i + 4 * lanes <= n; i += 4 * lanes) {                           \
+			for (size_t j = 0; j < 4; ++j) {                                   \
+				vector x = load(data + i + j * lanes);                         \
+				low[j] = min(low[j], x);                                       \
+				high[j] = max(high[j], x);                                     \
+				nan |= unordered(x);                                           \
+			}                                                                  \
+		}                                                                      \
+		for (; i < n; i += lanes) {                                            \
+			vector x = load(data + (i + lanes <= n ? i : n - lanes));          \
+			low[0] = min(low[0], x);                                           \
+			high[0] = max(high[0], x);                                         \
+			nan |= unordered(x);                                               \
+		}                                                                      \
+		if (nan != 0)                                                          \
+			return false;                                                      \
+		value_type lows[lanes], highs[lanes], unused;                          \
+		store(lows, min(min(low[0], low[1]), min(low[2], low[3])));            \
+		store(highs, max(max(high[0], high[1]), max(high[2], high[3])));       \
+		minmax_scalar(lows, lanes, lo, &unused);                               \
+		minmax_scalar(highs, lanes, &unused, hi);                              \
+		return true;                                                           \
+	}                                                                          \
+	MSTL_TARGET(isa)                                                           \
+	static void clamp(value_type* data, size_t n, value_type lo,               \
+	                  value_type hi) noexcept {                                \
+		if (n < lanes) {                                                       \
+			clamp_scalar(data, n, lo, hi);                                     \
+			return;                                                            \
+		}                                                                      \
+		const vector low = set1(lo);                                           \
+		const vector high = set1(hi);                                          \
+		for (size_t i = 0; i < n; i += lanes) {                                \
+			value_type* p = data + (i + lanes <= n ? i : n - lanes);           \
+			store(p, min(high, max(low, load(p))));                            \
+		}                                                                      \
+	}
+
+// SSE2 / AVX2 以 movemask_epi8 取掩码，每个元素占 sizeof(T) 位
+// 无符号整数翻转符号位后按有符号比较
+template <class T>
+struct simd::sse2_ops<T, 1, false> {
+	typedef T        value_type;
+	typedef __m128i  vector;
+	typedef uint32_t mask_type;
+	enum : size_t { lanes = 16, lane_bits = 1 };
+
+	MSTL_TARGET("sse2") static vector set1(value_type v) noexcept {
+		return _mm_set1_epi8(static_cast<char>(v));
+	}
+	MSTL_TARGET("sse2") static vector load(const value_type* p) noexcept {
+		return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+	}
+	MSTL_TARGET("sse2") static vector bias(vector v) noexcept {
+		return std::is_signed<T>::value
+		           ? v
+		           : _mm_xor_si128(v, _mm_set1_epi8(static_cast<char>(0x80)));
+	}
+	MSTL_TARGET("sse2") static mask_type eq(vector a, vector b) noexcept {
+		return static_cast<mask_type>(_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)));
+	}
+	MSTL_TARGET("sse2") static mask_type lt(vector a, vector b) noexcept {
+		return static_cast<mask_type>(
+		    _mm_movemask_epi8(_mm_cmplt_epi8(bias(a), bias(b))));
+	}
+	MSTL_TARGET("sse2") static void store(value_type* p, vector v) noexcept {
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(p), v);
+	}
+	// SSE2 只有无符号 8 位最值，有符号时翻转符号位后计算
+	MSTL_TARGET("sse2") static vector min(vector a, vector b) noexcept {
+		const __m128i sign = _mm_set1_epi8(static_cast<char>(0x80));
+		return std::is_signed<T>::value
+		           ? _mm_xor_si128(_mm_min_epu8(_mm_xor_si128(a, sign),
+		                                        _mm_xor_si128(b, sign)),
+		                           sign)
+		           : _mm_min_epu8(a, b);
+	}
+	MSTL_TARGET("sse2") static vector max(vector a, vector b) noexcept {
+		const __m128i sign = _mm_set1_epi8(static_cast<char>(0x80));
+		return std::is_signed<T>::value
+		           ? _mm_xor_si128(_mm_max_epu8(_mm_xor_si128(a, sign),
+		                                        _mm_xor_si128(b, sign)),
+		                           sign)
+		           : _mm_max_epu8(a, b);
+	}
+	MSTL_SIMD_SCAN_KERNELS("sse2", simd::popcount_sse2)
+	MSTL_SIMD_MINMAX_KERNELS("sse2")
+};
+
+template <class T>
+struct simd::sse2_ops<T, 2, false> {
+	typedef T        value_type;
+	typedef __m128i  vector;
+	typedef uint32_t mask_type;
+	enum : size_t { lanes = 8, lane_bits = 2 };
+
+	MSTL_TARGET("sse2") static vector set1(value_type v) noexcept {
+		return _mm_set1_epi16(static_cast<short>(v));
+	}
+	MSTL_TARGET("sse2") static vector load(const value_type* p) noexcept {
+		return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+	}
+	MSTL_TARGET("sse2") static vector bias(vector v) noexcept {
+		return std::is_signed<T>::value
+		           ? v
+		           : _mm_xor_si128(v, _mm_set1_epi16(INT16_MIN));
+	}
+	MSTL_TARGET("sse2") static mask_type eq(vector a, vector b) noexcept {
+		return static_cast<mask_type>(_mm_movemask_epi8(_mm_cmpeq_epi16(a, b)));
+	}
+	MSTL_TARGET("sse2") static mask_type lt(vector a, vector b) noexcept {
+		return static_cast<mask_type>(
+		    _mm_movemask_epi8(_mm_cmplt_epi16(bias(a), bias(b))));
+	}
+	MSTL_TARGET("sse2") static void store(value_type* p, vector v) noexcept {
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(p), v);
+	}
+	MSTL_TARGET("sse2") static vector min(vector a, vector b) noexcept {
+		return bias(_mm_min_epi16(bias(a), bias(b)));
+	}
+	MSTL_TARGET("sse2") static vector max(vector a, vector b) noexcept {
+		return bias(_mm_max_epi16(bias(a), bias(b)));
+	}
+	MSTL_SIMD_SCAN_KERNELS("sse2", simd::popcount_sse2)
+	MSTL_SIMD_MINMAX_KERNELS("sse2")
+};
+
+template <class T>
+struct simd::sse2_ops<T, 4, false> {
+	typedef T        value_type;
+	typedef __m128i  vector;
+	typedef uint32_t mask_type;
+	enum : size_t { lanes = 4, lane_bits = 4 };
+
+	MSTL_TARGET("sse2") static vector set1(value_type v) noexcept {
+		return _mm_set1_epi32(static_cast<int>(v));
+	}
+	MSTL_TARGET("sse2") static vector load(const value_type* p) noexcept {
+		return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+	}
+	MSTL_TARGET("sse2") static vector bias(vector v) noexcept {
+		return std::is_signed<T>::value
+		           ? v
+		           : _mm_xor_si128(v, _mm_set1_epi32(INT32_MIN));
+	}
+	MSTL_TARGET("sse2") static mask_type eq(vector a, vector b) noexcept {
+		return static_cast<mask_type>(_mm_movemask_epi8(_mm_cmpeq_epi32(a, b)));
+	}
+	MSTL_TARGET("sse2") static mask_type lt(vector a, vector b) noexcept {
+		return static_cast<mask_type>(
+		    _mm_movemask_epi8(_mm_cmplt_epi32(bias(a), bias(b))));
+	}
+	MSTL_TARGET("sse2") static void store(value_type* p, vector v) noexcept {
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(p), v);
+	}
+	// SSE2 没有 32 位最值指令，按比较结果选择
+	MSTL_TARGET("sse2") static vector min(vector a, vector b) noexcept {
+		__m128i m = _mm_cmplt_epi32(bias(a), bias(b));
+		return _mm_or_si128(_mm_and_si128(m, a), _mm_andnot_si128(m, b));
+	}
+	MSTL_TARGET("sse2") static vector max(vector a, vector b) noexcept {
+		__m128i m = _mm_cmpgt_epi32(bias(a), bias(b));
+		return _mm_or_si128(_mm_and_si128(m, a), _mm_andnot_si128(m, b));
+	}
+	MSTL_SIMD_SCAN_KERNELS("sse2", simd::popcount_sse2)
+	MSTL_SIMD_MINMAX_KERNELS("sse2")
+};
+
+// SSE2 没有 64 位整数比较，由 32 位比较组合: 高半部分相等时再比较低半部分 (无符号)
+template <class T>
+struct simd::sse2_ops<T, 8, false> {
+	typedef T        value_type;
+	typedef __m128i  vector;
+	typedef uint32_t mask_type;
+	enum : size_t { lanes = 2, lane_bits = 8 };
+
+	MSTL_TARGET("sse2") static vector set1(value_type v) noexcept {
+		return _mm_set1_epi64x(static_cast<long long>(v));
+	}
+	MSTL_TARGET("sse2") static vector load(const value_type* p) noexcept {
+		return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+	}
+	MSTL_TARGET("sse2") static vector bias(vector v) noexcept {
+		return std::is_signed<T>::value
+		           ? v
+		           : _mm_xor_si128(v, _mm_set1_epi64x(INT64_MIN));
+	}
+	MSTL_TARGET("sse2") static mask_type eq(vector a, vector b) noexcept {
+		__m128i e = _mm_cmpeq_epi32(a, b);
+		e = _mm_and_si128(e, _mm_shuffle_epi32(e, 0xb1));
+		return static_cast<mask_type>(_mm_movemask_epi8(e));
+	}
+	MSTL_TARGET("sse2") static vector less(vector a, vector b) noexcept {
+		const __m128i low_bias = _mm_set1_epi64x(0x80000000LL);
+		a = bias(a);
+		b = bias(b);
+		__m128i high_lt = _mm_cmplt_epi32(a, b);
+		__m128i high_eq = _mm_cmpeq_epi32(a, b);
+		__m128i low_lt = _mm_cmplt_epi32(_mm_xor_si128(a, low_bias),
+		                                 _mm_xor_si128(b, low_bias));
+		// 低半部分结果移到高半部分位置，再把高半部分结果复制到整个 64 位
+		__m128i r = _mm_or_si128(
+		    high_lt, _mm_and_si128(high_eq, _mm_shuffle_epi32(low_lt, 0xa0)));
+		return _mm_shuffle_epi32(r, 0xf5);
+	}
+	MSTL_TARGET("sse2") static mask_type lt(vector a, vector b) noexcept {
+		return static_cast<mask_type>(_mm_movemask_epi8(less(a, b)));
+	}
+	MSTL_TARGET("sse2") static void store(value_type* p, vector v) noexcept {
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(p), v);
+	}
+	MSTL_TARGET("sse2") static vector min(vector a, vector b) noexcept {
+		__m128i m = less(a, b);
+		return _mm_or_si128(_mm_and_si128(m, a), _mm_andnot_si128(m, b));
+	}
+	MSTL_TARGET("sse2") static vector max(vector a, vector b) noexcept {
+		__m128i m = less(b, a);
+		return _mm_or_si128(_mm_and_si128(m, a), _mm_andnot_si128(m, b));
+	}
+	MSTL_SIMD_SCAN_KERNELS("sse2", simd::popcount_sse2)
+	MSTL_SIMD_MINMAX_KERNELS("sse2")
+};
+
+template <>
+struct simd::sse2_ops<float, 4, true> {
+	typedef float    value_type;
+	typedef __m128   vector;
+	typedef uint32_t mask_type;
+	enum : size_t { lanes = 4, lane_bits = 4 };
+
+	MSTL_TARGET("sse2") static vector set1(value_type v) noexcept {
+		return _mm_set1_ps(v);
+	}
+	MSTL_TARGET("sse2") static vector load(const value_type* p) noexcept {
+		return _mm_loadu_ps(p);
+	}
+	MSTL_TARGET("sse2") static mask_type eq(vector a, vector b) noexcept {
+		return static_cast<mask_type>(
+		    _mm_movemask_epi8(_mm_castps_si128(_mm_cmpeq_ps(a, b))));
+	}
+	MSTL_TARGET("sse2") static mask_type lt(vector a, vector b) noexcept {
+		return static_cast<mask_type>(
+		    _mm_movemask_epi8(_mm_castps_si128(_mm_cmplt_ps(a, b))));
+	}
+	MSTL_TARGET("sse2") static void store(value_type* p, vector v) noexcept {
+		_mm_storeu_ps(p, v);
+	}
+	MSTL_TARGET("sse2") static vector min(vector a, vector b) noexcept {
+		return _mm_min_ps(a, b);
+	}
+	MSTL_TARGET("sse2") static vector max(vector a, vector b) noexcept {
+		return _mm_max_ps(a, b);
+	}
+	MSTL_SIMD_SCAN_KERNELS("sse2", simd::popcount_sse2)
+	MSTL_SIMD_MINMAX_KERNELS("sse2")
+};
+
+template <>
+struct simd::sse2_ops<double, 8, true> {
+	typedef double   value_type;
+	typedef __m128d  vector;
+	typedef uint32_t mask_type;
+	enum : size_t { lanes = 2, lane_bits = 8 };
+
+	MSTL_TARGET("sse2") static vector set1(value_type v) noexcept {
+		return _mm_set1_pd(v);
+	}
+	MSTL_TARGET("sse2") static vector load(const value_type* p) noexcept {
+		return _mm_loadu_pd(p);
+	}
+	MSTL_TARGET("sse2") static mask_type eq(vector a, vector b) noexcept {
+		return static_cast<mask_type>(
+		    _mm_movemask_epi8(_mm_castpd_si128(_mm_cmpeq_pd(a, b))));
+	}
+	MSTL_TARGET("sse2") static mask_type lt(vector a, vector b) noexcept {
+		return static_cast<mask_type>(
+		    _mm_movemask_epi8(_mm_castpd_si128(_mm_cmplt_pd(a, b))));
+	}
+	MSTL_TARGET("sse2") static void store(value_type* p, vector v) noexcept {
+		_mm_storeu_pd(p, v);
+	}
+	MSTL_TARGET("sse2") static vector min(vector a, vector b) noexcept {
+		return _mm_min_pd(a, b);
+	}
+	MSTL_TARGET("sse2") static vector max(vector a, vector b) noexcept {
+		return _mm_max_pd(a, b);
+	}
+	MSTL_SIMD_SCAN_KERNELS("sse2", simd::popcount_sse2)
+	MSTL_SIMD_MINMAX_KERNELS("sse2")
+};
+
+template <class T>
+struct simd::avx2_ops<T, 1, false> {
+	typedef T        value_type;
+	typedef __m256i  vector;
+	typedef uint32_t mask_type;
+	enum : size_t { lanes = 32, lane_bits = 1 };
+
+	MSTL_TARGET("avx2") static vector set1(value_type v) noexcept {
+		return _mm256_set1_epi8(static_cast<char>(v));
+	}
+	MSTL_TARGET("avx2") static vector load(const value_type* p) noexcept {
+		return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+	}
+	MSTL_TARGET("avx2") static vector bias(vector v) noexcept {
+		return std::is_signed<T>::value
+		           ? v
+		           : _mm256_xor_si256(v,
+		                              _mm256_set1_epi8(static_cast<char>(0x80)));
+	}
+	MSTL_TARGET("avx2") static mask_type eq(vector a, vector b) noexcept {
+		return static_cast<mask_type>(
+		    _mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)));
+	}
+	MSTL_TARGET("avx2") static mask_type lt(vector a, vector b) noexcept {
+		return static_cast<mask_type>(
+		    _mm256_movemask_epi8(_mm256_cmpgt_epi8(bias(b), bias(a))));
+	}
+	MSTL_TARGET("avx2") static void store(value_type* p, vector v) noexcept {
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+	}
+	MSTL_TARGET("avx2") static vector min(vector a, vector b) noexcept {
+		return std::is_signed<T>::value ? _mm256_min_epi8(a, b)
+		                                : _mm256_min_epu8(a, b);
+	}
+	MSTL_TARGET("avx2") static vector max(vector a, vector b) noexcept {
+		return std::is_signed<T>::value ? _mm256_max_epi8(a, b)
+		                                : _mm256_max_epu8(a, b);
+	}
+	MSTL_SIMD_SCAN_KERNELS("avx2", mSTL::popcount)
+	MSTL_SIMD_MINMAX_KERNELS("avx2")
+};
+
+template <class T>
+struct simd::avx2_ops<T, 2, false> {
+	typedef T        value_type;
+	typedef __m256i  vector;
+	typedef uint32_t mask_type;
+	enum : size_t { lanes = 16, lane_bits = 2 };
+
+	MSTL_TARGET("avx2") static vector set1(value_type v) noexcept {
+		return _mm256_set1_epi16(static_cast<short>(v));
+	}
+	MSTL_TARGET("avx2") static vector load(const value_type* p) noexcept {
+		return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+	}
+	MSTL_TARGET("avx2") static vector bias(vector v) noexcept {
+		return std::is_signed<T>::value
+		           ? v
+		           : _mm256_xor_si256(v, _mm256_set1_epi16(INT16_MIN));
+	}
+	MSTL_TARGET("avx2") static mask_type eq(vector a, vector b) noexcept {
+		return static_cast<mask_type>(
+		    _mm256_movemask_epi8(_mm256_cmpeq_epi16(a, b)));
+	}
+	MSTL_TARGET("avx2") static mask_type lt(vector a, vector b) noexcept {
+		return static_cast<mask_type>(
+		    _mm256_movemask_epi8(_mm256_cmpgt_epi16(bias(b), bias(a))));
+	}
+	MSTL_TARGET("avx2") static void store(value_type* p, vector v) noexcept {
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+	}
+	MSTL_TARGET("avx2") static vector min(vector a, vector b) noexcept {
+		return std::is_signed<T>::value ? _mm256_min_epi16(a, b)
+		                                : _mm256_min_epu16(a, b);
+	}
+	MSTL_TARGET("avx2") static vector max(vector a, vector b) noexcept {
+		return std::is_signed<T>::value ? _mm256_max_epi16(a, b)
+		                                : _mm256_max_epu16(a, b);
+	}
+	MSTL_SIMD_SCAN_KERNELS("avx2", mSTL::popcount)
+	MSTL_SIMD_MINMAX_KERNELS("avx2")
+};
+
+template <class T>
+struct simd::avx2_ops<T, 4, false> {
+	typedef T        value_type;
+	typedef __m256i  vector;
+	typedef uint32_t mask_type;
+	enum : size_t { lanes = 8, lane_bits = 4 };
+
+	MSTL_TARGET("avx2") static vector set1(value_type v) noexcept {
+		return _mm256_set1_epi32(static_cast<int>(v));
+	}
+	MSTL_TARGET("avx2") static vector load(const value_type* p) noexcept {
+		return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+	}
+	MSTL_TARGET("avx2") static vector bias(vector v) noexcept {
+		return std::is_signed<T>::value
+		           ? v
+		           : _mm256_xor_si256(v, _mm256_set1_epi32(INT32_MIN));
+	}
+	MSTL_TARGET("avx2") static mask_type eq(vector a, vector b) noexcept {
+		return static_cast<mask_type>(
+		    _mm256_movemask_epi8(_mm256_cmpeq_epi32(a, b)));
+	}
+	MSTL_TARGET("avx2") static mask_type lt(vector a, vector b) noexcept {
+		return static_cast<mask_type>(
+		    _mm256_movemask_epi8(_mm256_cmpgt_epi32(bias(b), bias(a))));
+	}
+	MSTL_TARGET("avx2") static void store(value_type* p, vector v) noexcept {
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+	}
+	MSTL_TARGET("avx2") static vector min(vector a, vector b) noexcept {
+		return std::is_signed<T>::value ? _mm256_min_epi32(a, b)
+		                                : _mm256_min_epu32(a, b);
+	}
+	MSTL_TARGET("avx2") static vector max(vector a, vector b) noexcept {
+		return std::is_signed<T>::value ? _mm256_max_epi32(a, b)
+		                                : _mm256_max_epu32(a, b);
+	}
+	MSTL_SIMD_SCAN_KERNELS("avx2", mSTL::popcount)
+	MSTL_SIMD_MINMAX_KERNELS("avx2")
+};
+
+template <class T>
+struct simd::avx2_ops<T, 8, false> {
+	typedef T        value_type;
+	typedef __m256i  vector;
+	typedef uint32_t mask_type;
+	enum : size_t { lanes = 4, lane_bits = 8 };
+
+	MSTL_TARGET("avx2") static vector set1(value_type v) noexcept {
+		return _mm256_set1_epi64x(static_cast<long long>(v));
+	}
+	MSTL_TARGET("avx2") static vector load(const value_type* p) noexcept {
+		return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+	}
+	MSTL_TARGET("avx2") static vector bias(vector v) noexcept {
+		return std::is_signed<T>::value
+		           ? v
+		           : _mm256_xor_si256(v, _mm256_set1_epi64x(INT64_MIN));
+	}
+	MSTL_TARGET("avx2") static mask_type eq(vector a, vector b) noexcept {
+		return static_cast<mask_type>(
+		    _mm256_movemask_epi8(_mm256_cmpeq_epi64(a, b)));
+	}
+	MSTL_TARGET("avx2") static mask_type lt(vector a, vector b) noexcept {
+		return static_cast<mask_type>(
+		    _mm256_movemask_epi8(_mm256_cmpgt_epi64(bias(b), bias(a))));
+	}
+	MSTL_TARGET("avx2") static void store(value_type* p, vector v) noexcept {
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+	}
+	MSTL_TARGET("avx2") static vector min(vector a, vector b) noexcept {
+		return _mm256_blendv_epi8(b, a, _mm256_cmpgt_epi64(bias(b), bias(a)));
+	}
+	MSTL_TARGET("avx2") static vector max(vector a, vector b) noexcept {
+		return _mm256_blendv_epi8(b, a, _mm256_cmpgt_epi64(bias(a), bias(b)));
+	}
+	MSTL_SIMD_SCAN_KERNELS("avx2", mSTL::popcount)
+	MSTL_SIMD_MINMAX_KERNELS("avx2")
+};
+
+template <>
+struct simd::avx2_ops<float, 4, true> {
+	typedef float    value_type;
+	typedef __m256   vector;
+	typedef uint32_t mask_type;
+	enum : size_t { lanes = 8, lane_bits = 4 };
+
+	MSTL_TARGET("avx2") static vector set1(value_type v) noexcept {
+		return _mm256_set1_ps(v);
+	}
+	MSTL_TARGET("avx2") static vector load(const value_type* p) noexcept {
+		return _mm256_loadu_ps(p);
+	}
+	MSTL_TARGET("avx2") static mask_type eq(vector a, vector b) noexcept {
+		return static_cast<mask_type>(_mm256_movemask_epi8(
+		    _mm256_castps_si256(_mm256_cmp_ps(a, b, _CMP_EQ_OQ))));
+	}
+	MSTL_TARGET("avx2") static mask_type lt(vector a, vector b) noexcept {
+		return static_cast<mask_type>(_mm256_movemask_epi8(
+		    _mm256_castps_si256(_mm256_cmp_ps(a, b, _CMP_LT_OQ))));
+	}
+	MSTL_TARGET("avx2") static void store(value_type* p, vector v) noexcept {
+		_mm256_storeu_ps(p, v);
+	}
+	MSTL_TARGET("avx2") static vector min(vector a, vector b) noexcept {
+		return _mm256_min_ps(a, b);
+	}
+	MSTL_TARGET("avx2") static vector max(vector a, vector b) noexcept {
+		return _mm256_max_ps(a, b);
+	}
+	MSTL_SIMD_SCAN_KERNELS("avx2", mSTL::popcount)
+	MSTL_SIMD_MINMAX_KERNELS("avx2")
+};
+
+template <>
+struct simd::avx2_ops<double, 8, true> {
+	typedef double   value_type;
+	typedef __m256d  vector;
+	typedef uint32_t mask_type;
+	enum : size_t { lanes = 4, lane_bits = 8 };
+
+	MSTL_TARGET("avx2") static vector set1(value_type v) noexcept {
+		return _mm256_set1_pd(v);
+	}
+	MSTL_TARGET("avx2") static vector load(const value_type* p) noexcept {
+		return _mm256_loadu_pd(p);
+	}
+	MSTL_TARGET("avx2") static mask_type eq(vector a, vector b) noexcept {
+		return static_cast<mask_type>(_mm256_movemask_epi8(
+		    _mm256_castpd_si256(_mm256_cmp_pd(a, b, _CMP_EQ_OQ))));
+	}
+	MSTL_TARGET("avx2") static mask_type lt(vector a, vector b) noexcept {
+		return static_cast<mask_type>(_mm256_movemask_epi8(
+		    _mm256_castpd_si256(_mm256_cmp_pd(a, b, _CMP_LT_OQ))));
+	}
+	MSTL_TARGET("avx2") static void store(value_type* p, vector v) noexcept {
+		_mm256_storeu_pd(p, v);
+	}
+	MSTL_TARGET("avx2") static vector min(vector a, vector b) noexcept {
+		return _mm256_min_pd(a, b);
+	}
+	MSTL_TARGET("avx2") static vector max(vector a, vector b) noexcept {
+		return _mm256_max_pd(a, b);
+	}
+	MSTL_SIMD_SCAN_KERNELS("avx2", mSTL::popcount)
+	MSTL_SIMD_MINMAX_KERNELS("avx2")
+};
+
+// AVX-512 比较直接得到每元素 1 位的掩码寄存器，并有无符号比较指令
+// 8 / 16 位元素需要 AVX-512BW
+// 32 / 64 位最值用全掩码形式: GCC 12 的无掩码形式以未定义向量为源，-Wall 下误报未初始化
+template <class T>
+struct simd::avx512_ops<T, 1, false> {
+	typedef T        value_type;
+	typedef __m512i  vector;
+	typedef uint64_t mask_type;
+	enum : size_t { lanes = 64, lane_bits = 1 };
+
+	MSTL_TARGET("avx512f,avx512bw")
+	static vector set1(value_type v) noexcept {
+		return _mm512_set1_epi8(static_cast<char>(v));
+	}
+	MSTL_TARGET("avx512f,avx512bw")
+	static vector load(const value_type* p) noexcept {
+		return _mm512_loadu_si512(p);
+	}
+	MSTL_TARGET("avx512f,avx512bw")
+	static mask_type eq(vector a, vector b) noexcept {
+		return _mm512_cmpeq_epi8_mask(a, b);
+	}
+	MSTL_TARGET("avx512f,avx512bw")
+	static mask_type lt(vector a, vector b) noexcept {
+		return std::is_signed<T>::value ? _mm512_cmplt_epi8_mask(a, b)
+		                                : _mm512_cmplt_epu8_mask(a, b);
+	}
+	MSTL_TARGET("avx512f,avx512bw")
+	static void store(value_type* p, vector v) noexcept {
+		_mm512_storeu_si512(p, v);
+	}
+	MSTL_TARGET("avx512f,avx512bw")
+	static vector min(vector a, vector b) noexcept {
+		return std::is_signed<T>::value ? _mm512_min_epi8(a, b)
+		                                : _mm512_min_epu8(a, b);
+	}
+	MSTL_TARGET("avx512f,avx512bw")
+	static vector max(vector a, vector b) noexcept {
+		return std::is_signed<T>::value ? _mm512_max_epi8(a, b)
+		                                : _mm512_max_epu8(a, b);
+	}
+	MSTL_SIMD_SCAN_KERNELS("avx512f,avx512bw", mSTL::popcount)
+	MSTL_SIMD_MINMAX_KERNELS("avx512f,avx512bw")
+};
+
+template <class T>
+struct simd::avx512_ops<T, 2, false> {
+	typedef T        value_type;
+	typedef __m512i  vector;
+	typedef uint64_t mask_type;
+	enum : size_t { lanes = 32, lane_bits = 1 };
+
+	MSTL_TARGET("avx512f,avx512bw")
+	static vector set1(value_type v) noexcept {
+		return _mm512_set1_epi16(static_cast<short>(v));
+	}
+	MSTL_TARGET("avx512f,avx512bw")
+	static vector load(const value_type* p) noexcept {
+		return _mm512_loadu_si512(p);
+	}
+	MSTL_TARGET("avx512f,avx512bw")
+	static mask_type eq(vector a, vector b) noexcept {
+		return _mm512_cmpeq_epi16_mask(a, b);
+	}
+	MSTL_TARGET("avx512f,avx512bw")
+	static mask_type lt(vector a, vector b) noexcept {
+		return std::is_signed<T>::value ? _mm512_cmplt_epi16_mask(a, b)
+		                                : _mm512_cmplt_epu16_mask(a, b);
+	}
+	MSTL_TARGET("avx512f,avx512bw")
+	static void store(value_type* p, vector v) noexcept {
+		_mm512_storeu_si512(p, v);
+	}
+	MSTL_TARGET("avx512f,avx512bw")
+	static vector min(vector a, vector b) noexcept {
+		return std::is_signed<T>::value ? _mm512_min_epi16(a, b)
+		                                : _mm512_min_epu16(a, b);
+	}
+	MSTL_TARGET("avx512f,avx512bw")
+	static vector max(vector a, vector b) noexcept {
+		return std::is_signed<T>::value ? _mm512_max_epi16(a, b)
+		                                : _mm512_max_epu16(a, b);
+	}
+	MSTL_SIMD_SCAN_KERNELS("avx512f,avx512bw", mSTL::popcount)
+	MSTL_SIMD_MINMAX_KERNELS("avx512f,avx512bw")
+};
+
+template <class T>
+struct simd::avx512_ops<T, 4, false> {
+	typedef T        value_type;
+	typedef __m512i  vector;
+	typedef uint64_t mask_type;
+	enum : size_t { lanes = 16, lane_bits = 1 };
+
+	MSTL_TARGET("avx512f") static vector set1(value_type v) noexcept {
+		return _mm512_set1_epi32(static_cast<int>(v));
+	}
+	MSTL_TARGET("avx512f") static vector load(const value_type* p) noexcept {
+		return _mm512_loadu_si512(p);
+	}
+	MSTL_TARGET("avx512f") static mask_type eq(vector a, vector b) noexcept {
+		return _mm512_cmpeq_epi32_mask(a, b);
+	}
+	MSTL_TARGET("avx512f") static mask_type lt(vector a, vector b) noexcept {
+		return std::is_signed<T>::value ? _mm512_cmplt_epi32_mask(a, b)
+		                                : _mm512_cmplt_epu32_mask(a, b);
+	}
+	MSTL_TARGET("avx512f") static void store(value_type* p, vector v) noexcept {
+		_mm512_storeu_si512(p, v);
+	}
+	MSTL_TARGET("avx512f") static vector min(vector a, vector b) noexcept {
+		return std::is_signed<T>::value
+		           ? _mm512_mask_min_epi32(a, 0xffff, a, b)
+		           : _mm512_mask_min_epu32(a, 0xffff, a, b);
+	}
+	MSTL_TARGET("avx512f") static vector max(vector a, vector b) noexcept {
+		return std::is_signed<T>::value
+		           ? _mm512_mask_max_epi32(a, 0xffff, a, b)
+		           : _mm512_mask_max_epu32(a, 0xffff, a, b);
+	}
+	MSTL_SIMD_SCAN_KERNELS("avx512f", mSTL::popcount)
+	MSTL_SIMD_MINMAX_KERNELS("avx512f")
+};
+
+template <class T>
+struct simd::avx512_ops<T, 8, false> {
+	typedef T        value_type;
+	typedef __m512i  vector;
+	typedef uint64_t mask_type;
+	enum : size_t { lanes = 8, lane_bits = 1 };
+
+	MSTL_TARGET("avx512f") static vector set1(value_type v) noexcept {
+		return _mm512_set1_epi64(static_cast<long long>(v));
+	}
+	MSTL_TARGET("avx512f") static vector load(const value_type* p) noexcept {
+		return _mm512_loadu_si512(p);
+	}
+	MSTL_TARGET("avx512f") static mask_type eq(vector a, vector b) noexcept {
+		return _mm512_cmpeq_epi64_mask(a, b);
+	}
+	MSTL_TARGET("avx512f") static mask_type lt(vector a, vector b) noexcept {
+		return std::is_signed<T>::value ? _mm512_cmplt_epi64_mask(a, b)
+		                                : _mm512_cmplt_epu64_mask(a, b);
+	}
+	MSTL_TARGET("avx512f") static void store(value_type* p, vector v) noexcept {
+		_mm512_storeu_si512(p, v);
+	}
+	MSTL_TARGET("avx512f") static vector min(vector a, vector b) noexcept {
+		return std::is_signed<T>::value
+		           ? _mm512_mask_min_epi64(a, 0xff, a, b)
+		           : _mm512_mask_min_epu64(a, 0xff, a, b);
+	}
+	MSTL_TARGET("avx512f") static vector max(vector a, vector b) noexcept {
+		return std::is_signed<T>::value
+		           ? _mm512_mask_max_epi64(a, 0xff, a, b)
+		           : _mm512_mask_max_epu64(a, 0xff, a, b);
+	}
+	MSTL_SIMD_SCAN_KERNELS("avx512f", mSTL::popcount)
+	MSTL_SIMD_MINMAX_KERNELS("avx512f")
+};
+
+template <>
+struct simd::avx512_ops<float, 4, true> {
+	typedef float    value_type;
+	typedef __m512   vector;
+	typedef uint64_t mask_type;
+	enum : size_t { lanes = 16, lane_bits = 1 };
+
+	MSTL_TARGET("avx512f") static vector set1(value_type v) noexcept {
+		return _mm512_set1_ps(v);
+	}
+	MSTL_TARGET("avx512f") static vector load(const value_type* p) noexcept {
+		return _mm512_loadu_ps(p);
+	}
+	MSTL_TARGET("avx512f") static mask_type eq(vector a, vector b) noexcept {
+		return _mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ);
+	}
+	MSTL_TARGET("avx512f") static mask_type lt(vector a, vector b) noexcept {
+		return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ);
+	}
+	MSTL_TARGET("avx512f") static void store(value_type* p, vector v) noexcept {
+		_mm512_storeu_ps(p, v);
+	}
+	MSTL_TARGET("avx512f") static vector min(vector a, vector b) noexcept {
+		return _mm512_mask_min_ps(a, 0xffff, a, b);
+	}
+	MSTL_TARGET("avx512f") static vector max(vector a, vector b) noexcept {
+		return _mm512_mask_max_ps(a, 0xffff, a, b);
+	}
+	MSTL_SIMD_SCAN_KERNELS("avx512f", mSTL::popcount)
+	MSTL_SIMD_MINMAX_KERNELS("avx512f")
+};
+
+template <>
+struct simd::avx512_ops<double, 8, true> {
+	typedef double   value_type;
+	typedef __m512d  vector;
+	typedef uint64_t mask_type;
+	enum : size_t { lanes = 8, lane_bits = 1 };
+
+	MSTL_TARGET("avx512f") static vector set1(value_type v) noexcept {
+		return _mm512_set1_pd(v);
+	}
+	MSTL_TARGET("avx512f") static vector load(const value_type* p) noexcept {
+		return _mm512_loadu_pd(p);
+	}
+	MSTL_TARGET("avx512f") static mask_type eq(vector a, vector b) noexcept {
+		return _mm512_cmp_pd_mask(a, b, _CMP_EQ_OQ);
+	}
+	MSTL_TARGET("avx512f") static mask_type lt(vector a, vector b) noexcept {
+		return _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ);
+	}
+	MSTL_TARGET("avx512f") static void store(value_type* p, vector v) noexcept {
+		_mm512_storeu_pd(p, v);
+	}
+	MSTL_TARGET("avx512f") static vector min(vector a, vector b) noexcept {
+		return _mm512_mask_min_pd(a, 0xff, a, b);
+	}
+	MSTL_TARGET("avx512f") static vector max(vector a, vector b) noexcept {
+		return _mm512_mask_max_pd(a, 0xff, a, b);
+	}
+	MSTL_SIMD_SCAN_KERNELS("avx512f", mSTL::popcount)
+	MSTL_SIMD_MINMAX_KERNELS("avx512f")
+};
+
+#undef MSTL_SIMD_SCAN_KERNELS
+#undef MSTL_SIMD_MINMAX_KERNELS
+#endif
+
+MSTL_NAMESPACE_END
+
+#endif
@@ -0,0 +1,623 @@
+#ifndef SMALL_VECTOR_H
+#define SMALL_VECTOR_H
+
+#include "basic.h"
+
+#include "algorithm.h"
+#include "allocator.h"
+#include "iterator.h"
+#include "type_traits.h"
+
+#include <cassert>
+#include <initializer_list>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+MSTL_NAMESPACE_BEGIN
+
+// small_vector
+// 元素个数不超过 N 时直接存放于对象内部缓冲区，超出后才通过 Allocator 转移至堆上
+// size_ 最高位标记数据是否位于堆上，其余位记录元素个数
+// 堆指针及容量与内部缓冲区共用一段 union 空间，inline 情况下对象更紧凑
+template <class T, size_t N, class Allocator = allocator<T>>
+class small_vector {
+	static_assert(N > 0, "small_vector requires N > 0");
+
+public:
+	using value_type = T;
+	using allocator_type = Allocator;
+	using size_type = size_t;
+	using difference_type = ptrdiff_t;
+	using reference = value_type&;
+	using const_reference = const value_type&;
+	using pointer = value_type*;
+	using const_pointer = const value_type*;
+
+	using iterator = value_type*;
+	using const_iterator = const value_type*;
+
+	using reverse_iterator = _reverse_iterator<iterator>;
+	using const_reverse_iterator = _reverse_iterator<const_iterator>;
+
+	using uninitialized_mem_func_type =
+	    uninitialized_mem_func<value_type, Allocator>;
+
+private:
+	typedef typename _type_traits<value_type>::is_POD_type isPODType;
+
+	struct heap_storage {
+		pointer   data_;
+		size_type capacity_;
+	};
+
+	union storage {
+		heap_storage heap_;
+		typename std::aligned_storage<sizeof(T) * N, alignof(T)>::type inline_;
+	};
+
+	size_type size_;
+	storage   storage_;
+
+public:
+	// (construct)(destruct)(copy)(operator=)(assign) ......
+	// 与 vector 一致，不支持构造函数中自定义 alloc 进行分配
+
+	small_vector() noexcept
+	    : size_(0) {}
+	small_vector(const size_type count, const_reference value = value_type())
+	    : size_(0) {
+		assign(count, value);
+	}
+	template <class InputIterator,
+	          class = typename std::enable_if<
+	              !std::is_integral<InputIterator>::value>::type>
+	small_vector(InputIterator first, InputIterator last)
+	    : size_(0) {
+		assign(first, last);
+	}
+
+	small_vector(const small_vector& other)
+	    : size_(0) {
+		assign(other.begin(), other.end());
+	}
+	small_vector(small_vector&& other) noexcept
+	    : size_(0) {
+		move_from(other);
+	}
+	small_vector& operator=(const small_vector& other) {
+		if (this == &other)
+			return *this;
+
+		assign(other.begin(), other.end());
+		return *this;
+	}
+	small_vector& operator=(small_vector&& other) noexcept {
+		if (this == &other)
+			return *this;
+
+		clear();
+		release_heap();
+		size_ = 0;
+		move_from(other);
+
+		return *this;
+	}
+
+	small_vector(const std::initializer_list<T>& il)
+	    : size_(0) {
+		assign(il.begin(), il.end());
+	}
+	small_vector& operator=(const std::initializer_list<T>& il) {
+		assign(il.begin(), il.end());
+		return *this;
+	}
+
+	void assign(size_type count, const_reference value) {
+		value_type copy(value);
+		clear();
+		reserve(count);
+		uninitialized_mem_func_type::fill_n(begin(), count, copy);
+		set_size(count);
+	}
+	template <class InputIterator,
+	          class = typename std::enable_if<
+	              !std::is_integral<InputIterator>::value>::type>
+	void assign(InputIterator first, InputIterator last) {
+		size_type count = static_cast<size_type>(last - first);
+
+		clear();
+		reserve(count);
+		uninitialized_mem_func_type::copy(first, last, begin());
+		set_size(count);
+	}
+	void assign(const std::initializer_list<T>& il) {
+		assign(il.begin(), il.end());
+	}
+
+	~small_vector() noexcept {
+		clear();
+		release_heap();
+	}
+
+	allocator_type get_allocator() { return allocator_type(); }
+
+	// Element access
+
+	reference       at(size_type pos) { return *(begin() + pos); }
+	const_reference at(size_type pos) const { return *(begin() + pos); }
+
+	reference operator[](const difference_type i) { return *(begin() + i); }
+	const_reference operator[](const difference_type i) const {
+		return *(cbegin() + i);
+	}
+
+	reference       front() { return *(begin()); }
+	const_reference front() const { return *(begin()); }
+
+	reference       back() { return *(end() - 1); }
+	const_reference back() const { return *(end() - 1); }
+
+	pointer data() noexcept {
+		return is_heap() ? storage_.heap_.data_ : inline_data();
+	}
+	const_pointer data() const noexcept {
+		return is_heap() ? storage_.heap_.data_ : inline_data();
+	}
+
+	// Iterators
+
+	iterator       begin() noexcept { return data(); }
+	const_iterator begin() const noexcept { return data(); }
+	const_iterator cbegin() const noexcept { return data(); }
+
+	iterator       end() noexcept { return data() + size(); }
+	const_iterator end() const noexcept { return data() + size(); }
+	const_iterator cend() const noexcept { return data() + size(); }
+
+	reverse_iterator rbegin() noexcept { return reverse_iterator(end() - 1); }
+	const_reverse_iterator rbegin() const noexcept {
+		return const_reverse_iterator(end() - 1);
+	}
+	const_reverse_iterator crbegin() const noexcept {
+		return const_reverse_iterator(end() - 1);
+	}
+
+	reverse_iterator rend() noexcept { return reverse_iterator(begin() - 1); }
+	const_reverse_iterator rend() const noexcept {
+		return const_reverse_iterator(begin() - 1);
+	}
+	const_reverse_iterator crend() const noexcept {
+		return const_reverse_iterator(begin() - 1);
+	}
+
+	// Capacity
+
+	bool empty() const noexcept { return size() == 0; }
+
+	size_type size() const noexcept { return size_ & ~heap_mask(); }
+	size_type max_size() const noexcept {
+		return std::numeric_limits<difference_type>::max();
+	}
+	size_type capacity() const noexcept {
+		return is_heap() ? storage_.heap_.capacity_ : N;
+	}
+
+	// 数据是否仍位于对象内部缓冲区
+	bool is_inline() const noexcept { return !is_heap(); }
+	static constexpr size_type inline_capacity() noexcept { return N; }
+
+	void reserve(size_type n) {
+		if (n <= capacity())
+			return;
+
+		realloc_and_move(n);
+	}
+	void shrink_to_fit();
+
+	// Modifiers
+
+	void clear() noexcept {
+		allocator_type::destroy(begin(), end());
+		set_size(0);
+	}
+	iterator insert(const_iterator pos, const_reference value) {
+		return emplace(pos, value);
+	}
+	iterator insert(const_iterator pos, value_type&& value) {
+		return emplace(pos, std::move(value));
+	}
+	iterator insert(const_iterator pos, size_type count,
+	                const_reference value) {
+		value_type copy(value);
+		pointer    new_pos = make_empty_before_pos(const_cast<pointer>(pos),
+		                                           count);
+
+		uninitialized_mem_func_type::fill_n(new_pos, count, copy);
+		return new_pos;
+	}
+	template <class InputIterator,
+	          class = typename std::enable_if<
+	              !std::is_integral<InputIterator>::value>::type>
+	iterator insert(const_iterator pos, InputIterator first,
+	                InputIterator last) {
+		pointer new_pos =
+		    make_empty_before_pos(const_cast<pointer>(pos),
+		                          static_cast<size_type>(last - first));
+
+		uninitialized_mem_func_type::copy(first, last, new_pos);
+		return new_pos;
+	}
+	iterator insert(const_iterator pos, const std::initializer_list<T>& il) {
+		return insert(pos, il.begin(), il.end());
+	}
+
+	template <class... Args>
+	iterator emplace(const_iterator pos, Args&&... args) {
+		if (pos == cend())
+			return &emplace_back(std::forward<Args>(args)...);
+
+		// 先构造临时对象，避免 args 引用自身元素时在移动后失效
+		value_type value(std::forward<Args>(args)...);
+		pointer    new_pos =
+		    make_empty_before_pos(const_cast<pointer>(pos), 1);
+
+		allocator_type::construct(new_pos, std::move(value));
+		return new_pos;
+	}
+
+	iterator erase(const_iterator position) {
+		return erase(position, (position + 1));
+	}
+	iterator erase(const_iterator first, const_iterator last) {
+		allocator_type::destroy(const_cast<pointer>(first),
+		                        const_cast<pointer>(last));
+		return erase_empty_in_pos(const_cast<pointer>(first),
+		                          static_cast<size_type>(last - first));
+	}
+
+	void push_back(const_reference value) { emplace_back(value); }
+	void push_back(value_type&& value) { emplace_back(std::move(value)); }
+
+	template <class... Args>
+	reference emplace_back(Args&&... args);
+
+	void pop_back() {
+		allocator_type::destroy(end() - 1);
+		set_size(size() - 1);
+	}
+
+	void resize(size_type count, const_reference value = value_type());
+
+	void swap(small_vector& other);
+
+public:
+	inline size_type get_new_capacity(size_type count) const;
+
+private:
+	static constexpr size_type heap_mask() noexcept {
+		return ~(~static_cast<size_type>(0) >> 1);
+	}
+
+	bool is_heap() const noexcept { return (size_ & heap_mask()) != 0; }
+	void set_size(size_type count) noexcept {
+		size_ = (size_ & heap_mask()) | count;
+	}
+
+	pointer inline_data() noexcept {
+		return reinterpret_cast<pointer>(&storage_.inline_);
+	}
+	const_pointer inline_data() const noexcept {
+		return reinterpret_cast<const_pointer>(&storage_.inline_);
+	}
+
+	inline void release_heap() noexcept;
+	inline void move_from(small_vector& other) noexcept;
+	inline void realloc_and_move(size_type count);
+
+	inline pointer make_empty_before_pos(pointer pos, size_type count);
+	inline pointer erase_empty_in_pos(pointer pos, size_type count);
+
+	// 与 vector::memmove_aux 不同，非 POD 类型移动后同时析构源对象
+	inline void memmove_aux(pointer dest, pointer src, size_type count,
+	                        _true_type, _direction);
+
+	inline void memmove_aux(pointer dest, pointer src, size_type count,
+	                        _false_type, _common_direction);
+	inline void memmove_aux(pointer dest, pointer src, size_type count,
+	                        _false_type, _reverse_direction);
+};
+
+template <class T, size_t N, class Alloc>
+bool operator==(const small_vector<T, N, Alloc>& lhs,
+                const small_vector<T, N, Alloc>& rhs) {
+	if (lhs.size() != rhs.size())
+		return false;
+
+	for (size_t i = 0; i < lhs.size(); ++i) {
+		if (lhs[i] != rhs[i])
+			return false;
+	}
+
+	return true;
+}
+
+template <class T, size_t N, class Alloc>
+bool operator!=(const small_vector<T, N, Alloc>& lhs,
+                const small_vector<T, N, Alloc>& rhs) {
+	return !(lhs == rhs);
+}
+
+template <class T, size_t N, class Alloc>
+bool operator<(const small_vector<T, N, Alloc>& lhs,
+               const small_vector<T, N, Alloc>& rhs) {
+
+	size_t min_size = mSTL::min(lhs.size(), rhs.size());
+
+	for (size_t i = 0; i < min_size; ++i) {
+		if (lhs[i] > rhs[i])
+			return false;
+		else if (lhs[i] < rhs[i])
+			return true;
+	}
+
+	return lhs.size() < rhs.size();
+}
+
+template <class T, size_t N, class Alloc>
+bool operator<=(const small_vector<T, N, Alloc>& lhs,
+                const small_vector<T, N, Alloc>& rhs) {
+	return !(rhs < lhs);
+}
+
+template <class T, size_t N, class Alloc>
+bool operator>(const small_vector<T, N, Alloc>& lhs,
+               const small_vector<T, N, Alloc>& rhs) {
+	return rhs < lhs;
+}
+
+template <class T, size_t N, class Alloc>
+bool operator>=(const small_vector<T, N, Alloc>& lhs,
+                const small_vector<T, N, Alloc>& rhs) {
+	return !(lhs < rhs);
+}
+
+template <class T, size_t N, class Alloc>
+void swap(small_vector<T, N, Alloc>& lhs, small_vector<T, N, Alloc>& rhs) {
+	lhs.swap(rhs);
+}
+
+// implement
+
+///<- Capacity
+
+template <class T, size_t N, class Alloc>
+void small_vector<T, N, Alloc>::shrink_to_fit() {
+	if (!is_heap())
+		return;
+
+	size_type old_size = size();
+	if (old_size > N) {
+		if (old_size < capacity())
+			realloc_and_move(old_size);
+		return;
+	}
+
+	// 元素可以放回内部缓冲区
+	// union 空间复用，需先取出堆指针再写入缓冲区
+	pointer   old_start = storage_.heap_.data_;
+	size_type old_capacity = storage_.heap_.capacity_;
+
+	size_ = old_size;
+	memmove_aux(inline_data(), old_start, old_size, isPODType(),
+	            _common_direction());
+	allocator_type::deallocate(old_start, old_capacity);
+}
+
+///<- Modifiers
+
+template <class T, size_t N, class Alloc>
+template <class... Args>
+typename small_vector<T, N, Alloc>::reference
+small_vector<T, N, Alloc>::emplace_back(Args&&... args) {
+	size_type old_size = size();
+
+	if (old_size < capacity()) {
+		pointer pos = begin() + old_size;
+		allocator_type::construct(pos, std::forward<Args>(args)...);
+		set_size(old_size + 1);
+		return *pos;
+	}
+
+	// 先在新内存块中构造新元素，再迁移旧元素
+	// 保证 args 引用自身元素时依然有效
+	size_type new_capacity = get_new_capacity(1);
+	pointer   new_start = allocator_type::allocate(new_capacity);
+
+	allocator_type::construct(new_start + old_size,
+	                          std::forward<Args>(args)...);
+	memmove_aux(new_start, begin(), old_size, isPODType(),
+	            _common_direction());
+	release_heap();
+
+	storage_.heap_.data_ = new_start;
+	storage_.heap_.capacity_ = new_capacity;
+	size_ = (old_size + 1) | heap_mask();
+
+	return new_start[old_size];
+}
+
+template <class T, size_t N, class Alloc>
+void small_vector<T, N, Alloc>::resize(size_type count,
+                                       const_reference value) {
+	size_type old_size = size();
+
+	if (count < old_size) {
+		allocator_type::destroy(begin() + count, end());
+	} else if (count > old_size) {
+		value_type copy(value);
+		if (count > capacity())
+			realloc_and_move(
+			    mSTL::max(count, get_new_capacity(count - old_size)));
+		uninitialized_mem_func_type::fill_n(end(), count - old_size, copy);
+	}
+
+	set_size(count);
+}
+
+template <class T, size_t N, class Alloc>
+void small_vector<T, N, Alloc>::swap(small_vector& other) {
+	if (this == &other)
+		return;
+
+	// 双方均位于堆上时直接交换指针即可
+	if (is_heap() && other.is_heap()) {
+		mSTL::swap(size_, other.size_);
+		mSTL::swap(storage_.heap_.data_, other.storage_.heap_.data_);
+		mSTL::swap(storage_.heap_.capacity_, other.storage_.heap_.capacity_);
+		return;
+	}
+
+	small_vector temp(std::move(other));
+	other = std::move(*this);
+	*this = std::move(temp);
+}
+
+///<- private function
+
+// 与 vector 采用相同的增长策略
+template <class T, size_t N, class Alloc>
+inline typename small_vector<T, N, Alloc>::size_type
+small_vector<T, N, Alloc>::get_new_capacity(size_type count) const {
+
+	size_type new_capacity = _grow_capacity(capacity(), count);
+	assert(new_capacity < max_size());
+
+	return new_capacity;
+}
+
+template <class T, size_t N, class Alloc>
+inline void small_vector<T, N, Alloc>::release_heap() noexcept {
+	if (is_heap()) {
+		allocator_type::deallocate(storage_.heap_.data_,
+		                           storage_.heap_.capacity_);
+		size_ &= ~heap_mask();
+	}
+}
+
+// 此处要求 *this 为空且位于内部缓冲区
+template <class T, size_t N, class Alloc>
+inline void small_vector<T, N, Alloc>::move_from(small_vector& other) noexcept {
+	if (other.is_heap()) {
+		storage_.heap_ = other.storage_.heap_;
+	} else {
+		memmove_aux(inline_data(), other.inline_data(), other.size(),
+		            isPODType(), _common_direction());
+	}
+
+	size_ = other.size_;
+	other.size_ = 0;
+}
+
+template <class T, size_t N, class Alloc>
+inline void small_vector<T, N, Alloc>::realloc_and_move(size_type count) {
+
+	size_type old_size = size();
+
+	// 此处 count 默认会大于等于 old_size 即元素个数
+	assert(count >= old_size);
+
+	pointer new_start = allocator_type::allocate(count);
+	memmove_aux(new_start, begin(), old_size, isPODType(),
+	            _common_direction());
+	release_heap();
+
+	storage_.heap_.data_ = new_start;
+	storage_.heap_.capacity_ = count;
+	size_ = old_size | heap_mask();
+}
+
+// 在 pos 前空出 count 个未初始化位置，返回空出区间的起始位置
+template <class T, size_t N, class Alloc>
+inline typename small_vector<T, N, Alloc>::pointer
+small_vector<T, N, Alloc>::make_empty_before_pos(pointer   pos,
+                                                 size_type count) {
+	size_type old_size = size();
+	size_type new_size = old_size + count;
+
+	size_type size_before_pos = static_cast<size_type>(pos - begin());
+	size_type size_after_pos = old_size - size_before_pos;
+
+	if (new_size <= capacity()) {
+		memmove_aux((pos + count), pos, size_after_pos, isPODType(),
+		            _reverse_direction());
+		set_size(new_size);
+		return pos;
+	}
+
+	size_type new_capacity = get_new_capacity(count);
+	pointer   new_start = allocator_type::allocate(new_capacity);
+
+	memmove_aux(new_start, begin(), size_before_pos, isPODType(),
+	            _common_direction());
+	memmove_aux((new_start + size_before_pos + count), pos, size_after_pos,
+	            isPODType(), _common_direction());
+	release_heap();
+
+	storage_.heap_.data_ = new_start;
+	storage_.heap_.capacity_ = new_capacity;
+	size_ = new_size | heap_mask();
+
+	return new_start + size_before_pos;
+}
+
+// [pos, pos + count) 已析构，将其后元素前移填补
+template <class T, size_t N, class Alloc>
+inline typename small_vector<T, N, Alloc>::pointer
+small_vector<T, N, Alloc>::erase_empty_in_pos(pointer pos, size_type count) {
+
+	pointer   src = pos + count;
+	size_type size_move = static_cast<size_type>(end() - src);
+
+	memmove_aux(pos, src, size_move, isPODType(), _common_direction());
+	set_size(size() - count);
+
+	return pos;
+}
+
+template <class T, size_t N, class Alloc>
+inline void small_vector<T, N, Alloc>::memmove_aux(pointer dest, pointer src,
+                                                   size_type count, _true_type,
+                                                   _direction) {
+	if (count != 0)
+		memmove(dest, src, count * sizeof(value_type));
+}
+
+template <class T, size_t N, class Alloc>
+inline void small_vector<T, N, Alloc>::memmove_aux(pointer dest, pointer src,
+                                                   size_type count,
+                                                   _false_type,
+                                                   _common_direction) {
+	for (size_type i = 0; i < count; ++i, ++src, ++dest) {
+		allocator_type::construct(dest, std::move(*src));
+		allocator_type::destroy(src);
+	}
+}
+
+template <class T, size_t N, class Alloc>
+inline void small_vector<T, N, Alloc>::memmove_aux(pointer dest, pointer src,
+                                                   size_type count,
+                                                   _false_type,
+                                                   _reverse_direction) {
+
+	// 反方向即需要移动 [src, src + count) 元素至 [dest, dest + count)
+	pointer src_reverse = src + count - 1, dest_reverse = dest + count - 1;
+	for (size_type i = 0; i < count; ++i, --src_reverse, --dest_reverse) {
+		allocator_type::construct(dest_reverse, std::move(*src_reverse));
+		allocator_type::destroy(src_reverse);
+	}
+}
+
+MSTL_NAMESPACE_END
+
+#endif
@@ -0,0 +1,566 @@
+#ifndef SOA_VECTOR_H
+#define SOA_VECTOR_H
+
+#include "basic.h"
+
+#include "algorithm.h"
+#include "allocator.h"
+#include "iterator.h"
+#include "span.h"
+#include "type_traits.h"
+
+#include <cassert>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+MSTL_NAMESPACE_BEGIN
+
+// soa_vector (struct of arrays)
+// 每个字段独立存放于一段连续内存中，所有列共用一次内存分配及同一组 size/capacity
+// 只访问部分字段的循环只需加载对应列，可以充分利用缓存行并便于向量化
+// 列的复制与移动复用 uninitialized_mem_func，POD 类型走 memcpy/memmove 路径
+
+// C++11 下的 index_sequence
+template <size_t... Is>
+struct _index_sequence {};
+
+template <size_t N, size_t... Is>
+struct _make_index_sequence : _make_index_sequence<N - 1, N - 1, Is...> {};
+
+template <size_t... Is>
+struct _make_index_sequence<0, Is...> {
+	using type = _index_sequence<Is...>;
+};
+
+// 各列类型中最大的对齐要求
+template <class... Ts>
+struct _max_alignof;
+
+template <class T>
+struct _max_alignof<T> {
+	static constexpr size_t value = alignof(T);
+};
+
+template <class T, class... Ts>
+struct _max_alignof<T, Ts...> {
+	static constexpr size_t value = alignof(T) > _max_alignof<Ts...>::value
+	                                    ? alignof(T)
+	                                    : _max_alignof<Ts...>::value;
+};
+
+template <class... Ts>
+class soa_vector {
+	static_assert(sizeof...(Ts) > 0, "soa_vector requires at least one column");
+
+public:
+	using value_type = std::tuple<Ts...>;
+	using size_type = size_t;
+	using difference_type = ptrdiff_t;
+
+	// 行引用，由各列元素引用组成
+	using reference = std::tuple<Ts&...>;
+	using const_reference = std::tuple<const Ts&...>;
+
+	template <size_t I>
+	using column_type =
+	    typename std::tuple_element<I, std::tuple<Ts...>>::type;
+
+	template <bool IsConst>
+	class row_iterator;
+
+	using iterator = row_iterator<false>;
+	using const_iterator = row_iterator<true>;
+
+	// 按行遍历的迭代器，解引用得到行引用
+	template <bool IsConst>
+	class row_iterator {
+	public:
+		using iterator_category = random_access_iterator_tag;
+		using value_type = typename soa_vector::value_type;
+		using difference_type = ptrdiff_t;
+		using pointer = void;
+		using reference =
+		    typename IfThenElse<IsConst, typename soa_vector::const_reference,
+		                        typename soa_vector::reference>::result;
+
+		using owner_type =
+		    typename IfThenElse<IsConst, const soa_vector, soa_vector>::result;
+		using self = row_iterator;
+
+	private:
+		owner_type* owner_;
+		size_type   index_;
+
+	public:
+		row_iterator(owner_type* owner = nullptr, size_type index = 0) noexcept
+		    : owner_(owner)
+		    , index_(index) {}
+
+		// iterator -> const_iterator
+		template <bool B, class = typename std::enable_if<IsConst && !B>::type>
+		row_iterator(const row_iterator<B>& other) noexcept
+		    : owner_(other.owner())
+		    , index_(other.index()) {}
+
+		owner_type* owner() const noexcept { return owner_; }
+		size_type   index() const noexcept { return index_; }
+
+		reference operator*() const { return (*owner_)[index_]; }
+		reference operator[](difference_type n) const {
+			return (*owner_)[index_ + n];
+		}
+
+		self& operator++() noexcept {
+			++index_;
+			return *this;
+		}
+		self operator++(int) noexcept {
+			self temp = *this;
+			++index_;
+			return temp;
+		}
+		self& operator--() noexcept {
+			--index_;
+			return *this;
+		}
+		self operator--(int) noexcept {
+			self temp = *this;
+			--index_;
+			return temp;
+		}
+
+		self& operator+=(difference_type n) noexcept {
+			index_ += n;
+			return *this;
+		}
+		self& operator-=(difference_type n) noexcept {
+			index_ -= n;
+			return *this;
+		}
+		self operator+(difference_type n) const noexcept {
+			return self(owner_, index_ + n);
+		}
+		self operator-(difference_type n) const noexcept {
+			return self(owner_, index_ - n);
+		}
+		difference_type operator-(const self& other) const noexcept {
+			return static_cast<difference_type>(index_) -
+			       static_cast<difference_type>(other.index_);
+		}
+
+		bool operator==(const self& other) const noexcept {
+			return index_ == other.index_ && owner_ == other.owner_;
+		}
+		bool operator!=(const self& other) const noexcept {
+			return !(*this == other);
+		}
+		bool operator<(const self& other) const noexcept {
+			return index_ < other.index_;
+		}
+		bool operator>(const self& other) const noexcept {
+			return other < *this;
+		}
+		bool operator<=(const self& other) const noexcept {
+			return !(other < *this);
+		}
+		bool operator>=(const self& other) const noexcept {
+			return !(*this < other);
+		}
+	};
+
+private:
+	using columns_type = std::tuple<Ts*...>;
+	using indices_type = typename _make_index_sequence<sizeof...(Ts)>::type;
+	using byte_allocator = allocator<char>;
+
+	enum { MAX_ALIGN = _max_alignof<Ts...>::value };
+
+	char*        buffer_;
+	size_type    size_;
+	size_type    capacity_;
+	columns_type columns_;
+
+public:
+	// (construct)(destruct)(copy)(operator=) ......
+
+	soa_vector() noexcept
+	    : buffer_(nullptr)
+	    , size_(0)
+	    , capacity_(0)
+	    , columns_() {}
+	explicit soa_vector(size_type count)
+	    : soa_vector() {
+		resize(count);
+	}
+
+	soa_vector(const soa_vector& other)
+	    : soa_vector() {
+		realloc_and_move(other.size_);
+		copy_columns(other, indices_type());
+		size_ = other.size_;
+	}
+	soa_vector(soa_vector&& other) noexcept
+	    : buffer_(other.buffer_)
+	    , size_(other.size_)
+	    , capacity_(other.capacity_)
+	    , columns_(other.columns_) {
+		other.buffer_ = nullptr;
+		other.size_ = other.capacity_ = 0;
+		other.columns_ = columns_type();
+	}
+	soa_vector& operator=(const soa_vector& other) {
+		if (this == &other)
+			return *this;
+
+		clear();
+		reserve(other.size_);
+		copy_columns(other, indices_type());
+		size_ = other.size_;
+
+		return *this;
+	}
+	soa_vector& operator=(soa_vector&& other) noexcept {
+		if (this == &other)
+			return *this;
+
+		soa_vector temp(std::move(other));
+		swap(temp);
+
+		return *this;
+	}
+
+	~soa_vector() noexcept {
+		clear();
+		deallocate_buffer();
+	}
+
+	// Element access
+
+	reference operator[](size_type i) { return row(i, indices_type()); }
+	const_reference operator[](size_type i) const {
+		return row(i, indices_type());
+	}
+
+	reference       front() { return (*this)[0]; }
+	const_reference front() const { return (*this)[0]; }
+	reference       back() { return (*this)[size_ - 1]; }
+	const_reference back() const { return (*this)[size_ - 1]; }
+
+	// 第 I 列第 i 行元素
+	template <size_t I>
+	column_type<I>& get(size_type i) {
+		return std::get<I>(columns_)[i];
+	}
+	template <size_t I>
+	const column_type<I>& get(size_type i) const {
+		return std::get<I>(columns_)[i];
+	}
+
+	// 第 I 列的连续存储
+	template <size_t I>
+	column_type<I>* data() noexcept {
+		return std::get<I>(columns_);
+	}
+	template <size_t I>
+	const column_type<I>* data() const noexcept {
+		return std::get<I>(columns_);
+	}
+
+	template <size_t I>
+	span<column_type<I>> column() noexcept {
+		return span<column_type<I>>(std::get<I>(columns_), size_);
+	}
+	template <size_t I>
+	span<const column_type<I>> column() const noexcept {
+		return span<const column_type<I>>(std::get<I>(columns_), size_);
+	}
+
+	// Iterators
+
+	iterator       begin() noexcept { return iterator(this, 0); }
+	const_iterator begin() const noexcept { return const_iterator(this, 0); }
+	const_iterator cbegin() const noexcept { return const_iterator(this, 0); }
+
+	iterator       end() noexcept { return iterator(this, size_); }
+	const_iterator end() const noexcept { return const_iterator(this, size_); }
+	const_iterator cend() const noexcept { return const_iterator(this, size_); }
+
+	// Capacity
+
+	bool      empty() const noexcept { return size_ == 0; }
+	size_type size() const noexcept { return size_; }
+	size_type max_size() const noexcept {
+		return std::numeric_limits<difference_type>::max() /
+		       bytes_for(1);
+	}
+	size_type capacity() const noexcept { return capacity_; }
+
+	void reserve(size_type n) {
+		if (n <= capacity_)
+			return;
+
+		realloc_and_move(n);
+	}
+	void shrink_to_fit() {
+		if (size_ < capacity_)
+			realloc_and_move(size_);
+	}
+
+	// Modifiers
+
+	void clear() noexcept {
+		destroy_rows(0, size_, indices_type());
+		size_ = 0;
+	}
+
+	// 每列对应一个参数
+	void push_back(const Ts&... values) { emplace_back(values...); }
+
+	template <class... Args>
+	reference emplace_back(Args&&... args);
+
+	void pop_back() {
+		destroy_rows(size_ - 1, size_, indices_type());
+		--size_;
+	}
+
+	void resize(size_type count);
+
+	void swap(soa_vector& other) noexcept {
+		mSTL::swap(buffer_, other.buffer_);
+		mSTL::swap(size_, other.size_);
+		mSTL::swap(capacity_, other.capacity_);
+		std::swap(columns_, other.columns_);
+	}
+
+private:
+	inline size_type get_new_capacity(size_type count) const;
+
+	template <size_t... Is>
+	reference row(size_type i, _index_sequence<Is...>) {
+		return reference(std::get<Is>(columns_)[i]...);
+	}
+	template <size_t... Is>
+	const_reference row(size_type i, _index_sequence<Is...>) const {
+		return const_reference(std::get<Is>(columns_)[i]...);
+	}
+
+	// 计算 capacity 为 count 时各列的偏移，base 非空时同时写入列指针
+	// 返回所需字节数
+	static size_type layout(size_type count, char* base,
+	                        columns_type& columns) {
+		return layout(count, base, columns, indices_type());
+	}
+	template <size_t... Is>
+	static size_type layout(size_type count, char* base, columns_type& columns,
+	                        _index_sequence<Is...>) {
+		size_type offset = 0;
+		int       arr[] = {
+            (place_column<Is>(count, base, columns, offset), 0)...};
+		(void)arr;
+		return offset;
+	}
+	template <size_t I>
+	static void place_column(size_type count, char* base,
+	                         columns_type& columns, size_type& offset) {
+		const size_type align = alignof(column_type<I>);
+		offset = (offset + align - 1) / align * align;
+		if (base != nullptr)
+			std::get<I>(columns) = reinterpret_cast<column_type<I>*>(base + offset);
+		offset += count * sizeof(column_type<I>);
+	}
+
+	// 分配时额外预留 MAX_ALIGN - 1 字节用于对齐起始地址
+	static size_type bytes_for(size_type count) {
+		columns_type columns;
+		return layout(count, nullptr, columns) + MAX_ALIGN - 1;
+	}
+
+	void deallocate_buffer() noexcept {
+		if (buffer_ != nullptr)
+			byte_allocator::deallocate(buffer_, bytes_for(capacity_));
+		buffer_ = nullptr;
+	}
+
+	inline void allocate_columns(size_type count, char*& buffer,
+	                             columns_type& columns);
+	inline void realloc_and_move(size_type count);
+
+	template <size_t... Is>
+	void move_columns(columns_type& dest, _index_sequence<Is...>) {
+		if (size_ == 0)
+			return;
+
+		int arr[] = {(uninitialized_mem_func<Ts>::move(
+		                  std::get<Is>(columns_), std::get<Is>(columns_) + size_,
+		                  std::get<Is>(dest)),
+		              allocator<Ts>::destroy(std::get<Is>(columns_),
+		                                     std::get<Is>(columns_) + size_),
+		              0)...};
+		(void)arr;
+	}
+
+	template <size_t... Is>
+	void copy_columns(const soa_vector& other, _index_sequence<Is...>) {
+		int arr[] = {(uninitialized_mem_func<Ts>::copy(
+		                  std::get<Is>(other.columns_),
+		                  std::get<Is>(other.columns_) + other.size_,
+		                  std::get<Is>(columns_)),
+		              0)...};
+		(void)arr;
+	}
+
+	template <size_t... Is>
+	void destroy_rows(size_type first, size_type last,
+	                  _index_sequence<Is...>) noexcept {
+		int arr[] = {(allocator<Ts>::destroy(std::get<Is>(columns_) + first,
+		                                     std::get<Is>(columns_) + last),
+		              0)...};
+		(void)arr;
+	}
+
+	template <size_t... Is>
+	static void destroy_row(columns_type& columns, size_type i,
+	                        _index_sequence<Is...>) noexcept {
+		int arr[] = {(allocator<Ts>::destroy(std::get<Is>(columns) + i), 0)...};
+		(void)arr;
+	}
+
+	template <size_t... Is>
+	void fill_rows(size_type first, size_type count, _index_sequence<Is...>) {
+		int arr[] = {(uninitialized_mem_func<Ts>::fill_n(
+		                  std::get<Is>(columns_) + first, count, Ts()),
+		              0)...};
+		(void)arr;
+	}
+
+	template <size_t... Is, class... Args>
+	static void construct_row(columns_type& columns, size_type i,
+	                          _index_sequence<Is...>, Args&&... args) {
+		int arr[] = {(allocator<Ts>::construct(std::get<Is>(columns) + i,
+		                                       std::forward<Args>(args)),
+		              0)...};
+		(void)arr;
+	}
+};
+
+template <class... Ts>
+void swap(soa_vector<Ts...>& lhs, soa_vector<Ts...>& rhs) noexcept {
+	lhs.swap(rhs);
+}
+
+// implement
+
+///<- Modifiers
+
+template <class... Ts>
+template <class... Args>
+typename soa_vector<Ts...>::reference
+soa_vector<Ts...>::emplace_back(Args&&... args) {
+	static_assert(sizeof...(Args) == sizeof...(Ts),
+	              "emplace_back requires one argument per column");
+
+	if (size_ < capacity_) {
+		construct_row(columns_, size_, indices_type(),
+		              std::forward<Args>(args)...);
+		return (*this)[size_++];
+	}
+
+	// 先在新内存块中构造新行，再迁移旧数据
+	// 保证 args 引用自身元素时依然有效
+	size_type    new_capacity = get_new_capacity(1);
+	char*        new_buffer = nullptr;
+	columns_type new_columns;
+
+	allocate_columns(new_capacity, new_buffer, new_columns);
+	try {
+		construct_row(new_columns, size_, indices_type(),
+		              std::forward<Args>(args)...);
+	} catch (...) {
+		if (new_buffer != nullptr)
+			byte_allocator::deallocate(new_buffer, bytes_for(new_capacity));
+		throw;
+	}
+	try {
+		move_columns(new_columns, indices_type());
+	} catch (...) {
+		destroy_row(new_columns, size_, indices_type());
+		if (new_buffer != nullptr)
+			byte_allocator::deallocate(new_buffer, bytes_for(new_capacity));
+		throw;
+	}
+	deallocate_buffer();
+
+	buffer_ = new_buffer;
+	capacity_ = new_capacity;
+	columns_ = new_columns;
+
+	return (*this)[size_++];
+}
+
+template <class... Ts>
+void soa_vector<Ts...>::resize(size_type count) {
+	if (count < size_) {
+		destroy_rows(count, size_, indices_type());
+	} else if (count > size_) {
+		if (count > capacity_)
+			realloc_and_move(mSTL::max(count, get_new_capacity(count - size_)));
+		fill_rows(size_, count - size_, indices_type());
+	}
+
+	size_ = count;
+}
+
+///<- private function
+
+// 与 vector 共用 _grow_capacity 增长策略
+template <class... Ts>
+inline typename soa_vector<Ts...>::size_type
+soa_vector<Ts...>::get_new_capacity(size_type count) const {
+
+	size_type new_capacity = _grow_capacity(capacity(), count);
+	assert(new_capacity < max_size());
+
+	return new_capacity;
+}
+
+template <class... Ts>
+inline void soa_vector<Ts...>::allocate_columns(size_type     count,
+                                                char*&        buffer,
+                                                columns_type& columns) {
+	if (count == 0) {
+		buffer = nullptr;
+		columns = columns_type();
+		return;
+	}
+
+	buffer = byte_allocator::allocate(bytes_for(count));
+
+	size_t address = reinterpret_cast<size_t>(buffer);
+	char*  base = buffer + ((MAX_ALIGN - address % MAX_ALIGN) % MAX_ALIGN);
+	layout(count, base, columns);
+}
+
+template <class... Ts>
+inline void soa_vector<Ts...>::realloc_and_move(size_type count) {
+
+	// 此处 count 默认会大于等于 size_ 即元素个数
+	assert(count >= size_);
+
+	char*        new_buffer = nullptr;
+	columns_type new_columns;
+
+	allocate_columns(count, new_buffer, new_columns);
+	move_columns(new_columns, indices_type());
+	deallocate_buffer();
+
+	buffer_ = new_buffer;
+	capacity_ = count;
+	columns_ = new_columns;
+}
+
+MSTL_NAMESPACE_END
+
+#endif
@@ -0,0 +1,107 @@
+#ifndef SPAN_H
+#define SPAN_H
+
+#include "basic.h"
+
+#include "iterator.h"
+
+#include <cassert>
+#include <type_traits>
+
+MSTL_NAMESPACE_BEGIN
+
+// span
+// 连续内存区间的非拥有视图，接口参照 C++20 std::span (仅支持动态长度)
+// 用于 soa_vector 的列访问等需要暴露底层连续存储的场合
+template <class T>
+class span {
+public:
+	using element_type = T;
+	using value_type = typename std::remove_cv<T>::type;
+	using size_type = size_t;
+	using difference_type = ptrdiff_t;
+	using reference = T&;
+	using const_reference = const T&;
+	using pointer = T*;
+	using const_pointer = const T*;
+
+	using iterator = T*;
+	using reverse_iterator = _reverse_iterator<iterator>;
+
+	static constexpr size_type npos = static_cast<size_type>(-1);
+
+private:
+	pointer   data_;
+	size_type size_;
+
+public:
+	constexpr span() noexcept
+	    : data_(nullptr)
+	    , size_(0) {}
+	constexpr span(pointer data, size_type count) noexcept
+	    : data_(data)
+	    , size_(count) {}
+	constexpr span(pointer first, pointer last) noexcept
+	    : data_(first)
+	    , size_(static_cast<size_type>(last - first)) {}
+	template <size_t N>
+	constexpr span(element_type (&arr)[N]) noexcept
+	    : data_(arr)
+	    , size_(N) {}
+
+	// span<T> -> span<const T>
+	template <class U, class = typename std::enable_if<std::is_convertible<
+	                       U (*)[], T (*)[]>::value>::type>
+	constexpr span(const span<U>& other) noexcept
+	    : data_(other.data())
+	    , size_(other.size()) {}
+
+	// Element access
+
+	constexpr reference operator[](size_type i) const { return data_[i]; }
+	constexpr reference front() const { return data_[0]; }
+	constexpr reference back() const { return data_[size_ - 1]; }
+	constexpr pointer   data() const noexcept { return data_; }
+
+	// Iterators
+
+	constexpr iterator begin() const noexcept { return data_; }
+	constexpr iterator end() const noexcept { return data_ + size_; }
+
+	reverse_iterator rbegin() const noexcept {
+		return reverse_iterator(end() - 1);
+	}
+	reverse_iterator rend() const noexcept {
+		return reverse_iterator(begin() - 1);
+	}
+
+	// Observers
+
+	constexpr size_type size() const noexcept { return size_; }
+	constexpr size_type size_bytes() const noexcept {
+		return size_ * sizeof(element_type);
+	}
+	constexpr bool empty() const noexcept { return size_ == 0; }
+
+	// Subviews
+
+	span first(size_type count) const {
+		assert(count <= size_);
+		return span(data_, count);
+	}
+	span last(size_type count) const {
+		assert(count <= size_);
+		return span(data_ + (size_ - count), count);
+	}
+	span subspan(size_type offset, size_type count = npos) const {
+		assert(offset <= size_);
+		return span(data_ + offset, count == npos ? size_ - offset : count);
+	}
+};
+
+template <class T>
+constexpr typename span<T>::size_type span<T>::npos;
+
+MSTL_NAMESPACE_END
+
+#endif
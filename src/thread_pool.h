@@ -0,0 +1,195 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include "basic.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+MSTL_NAMESPACE_BEGIN
+
+// thread_pool
+// 固定数量工作线程，以 parallel_for 的形式执行分块任务
+// 调用线程同样参与执行，parallel_for 返回时所有分块均已完成
+// 同一时刻只执行一个 parallel_for，在分块内部 (无论工作线程还是调用线程) 嵌套调用时直接串行执行
+// 任一分块抛出的异常在全部分块结束后于调用线程重新抛出
+class thread_pool {
+public:
+	using size_type = size_t;
+
+private:
+	struct job {
+		void (*invoke)(void*, size_type, size_type);
+		void*     context;
+		size_type first;
+		size_type last;
+		size_type grain;
+		size_type chunks;
+
+		std::atomic<size_type> next;
+		std::exception_ptr     error;
+		std::mutex             error_mutex;
+	};
+
+	std::vector<std::thread> workers_;
+
+	std::mutex              submit_mutex_; // 串行化 parallel_for
+	std::mutex              mutex_;
+	std::condition_variable work_cv_;
+	std::condition_variable done_cv_;
+	job*                    job_;
+	size_type               generation_;
+	size_type               busy_; // 正在执行当前任务的工作线程数
+	bool                    stop_;
+
+public:
+	// threads 为工作线程数，不含调用线程
+	explicit thread_pool(size_type threads = default_threads())
+	    : job_(nullptr)
+	    , generation_(0)
+	    , busy_(0)
+	    , stop_(false) {
+		workers_.reserve(threads);
+		for (size_type i = 0; i < threads; ++i)
+			workers_.emplace_back(&thread_pool::worker_loop, this);
+	}
+
+	thread_pool(const thread_pool&) = delete;
+	thread_pool& operator=(const thread_pool&) = delete;
+
+	~thread_pool() noexcept {
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			stop_ = true;
+		}
+		work_cv_.notify_all();
+		for (auto& worker : workers_)
+			worker.join();
+	}
+
+	// 全局共享线程池，首次使用时创建
+	static thread_pool& instance() {
+		static thread_pool pool;
+		return pool;
+	}
+
+	static size_type default_threads() noexcept {
+		size_type hardware = std::thread::hardware_concurrency();
+		return hardware > 1 ? hardware - 1 : 0;
+	}
+
+	// 参与执行的线程总数 (含调用线程)
+	size_type concurrency() const noexcept { return workers_.size() + 1; }
+
+	// 将 [first, last) 按 grain 切分，以 func(begin, end) 并行处理各分块
+	template <class Func>
+	void parallel_for(size_type first, size_type last, size_type grain,
+	                  Func&& func) {
+		if (first >= last)
+			return;
+		if (grain == 0)
+			grain = 1;
+
+		size_type chunks = (last - first + grain - 1) / grain;
+		if (chunks == 1 || workers_.empty() || in_task()) {
+			for (size_type begin = first; begin < last; begin += grain)
+				func(begin, begin + grain < last ? begin + grain : last);
+			return;
+		}
+
+		using func_type = typename std::remove_reference<Func>::type;
+
+		std::lock_guard<std::mutex> submit(submit_mutex_);
+
+		job task;
+		task.invoke = [](void* context, size_type begin, size_type end) {
+			(*static_cast<func_type*>(context))(begin, end);
+		};
+		task.context = static_cast<void*>(&func);
+		task.first = first;
+		task.last = last;
+		task.grain = grain;
+		task.chunks = chunks;
+		task.next.store(0, std::memory_order_relaxed);
+
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			job_ = &task;
+			++generation_;
+		}
+		work_cv_.notify_all();
+
+		// 调用线程执行分块期间同样标记为任务内，嵌套调用不会再次获取 submit_mutex_
+		in_task() = true;
+		run(task);
+		in_task() = false;
+
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			job_ = nullptr;
+			done_cv_.wait(lock, [this]() { return busy_ == 0; });
+		}
+
+		if (task.error)
+			std::rethrow_exception(task.error);
+	}
+
+private:
+	// 当前线程是否正在执行某个线程池的分块 (工作线程始终为 true)
+	static bool& in_task() noexcept {
+		static thread_local bool flag = false;
+		return flag;
+	}
+
+	static void run(job& task) noexcept {
+		size_type chunk;
+		while ((chunk = task.next.fetch_add(1, std::memory_order_relaxed)) <
+		       task.chunks) {
+			size_type begin = task.first + chunk * task.grain;
+			size_type end = task.last - begin > task.grain ? begin + task.grain
+			                                               : task.last;
+			try {
+				task.invoke(task.context, begin, end);
+			} catch (...) {
+				std::lock_guard<std::mutex> lock(task.error_mutex);
+				if (!task.error)
+					task.error = std::current_exception();
+			}
+		}
+	}
+
+	void worker_loop() {
+		in_task() = true;
+
+		std::unique_lock<std::mutex> lock(mutex_);
+		size_type                    seen = generation_;
+		while (true) {
+			work_cv_.wait(lock,
+			              [&]() { return stop_ || generation_ != seen; });
+			if (stop_)
+				return;
+
+			seen = generation_;
+			job* task = job_;
+			if (task == nullptr)
+				continue;
+
+			++busy_;
+			lock.unlock();
+			run(*task);
+			lock.lock();
+			if (--busy_ == 0)
+				done_cv_.notify_all();
+		}
+	}
+};
+
+MSTL_NAMESPACE_END
+
+#endif
@@ -3,6 +3,8 @@
 
 #include "basic.h"
 
+#include <type_traits>
+
 MSTL_NAMESPACE_BEGIN
 
 namespace {
@@ -233,6 +235,23 @@ struct _type_traits<const signed char*> {
 	typedef _true_type is_POD_type;
 };
 
+// 萃取传入的 T 类型的比较特性，供连续存储容器选择比较方式
+// is_bitwise_equal: 按位相等即值相等 (整型、枚举、指针)，可用 memcmp 判断相等
+//                   浮点数存在 NaN 与 +0.0 / -0.0，不满足
+// is_byte_ordered:  逐字节无符号比较与值的字典序一致 (单字节无符号整型及 bool)
+//                   可直接以 memcmp 结果判断大小
+template <class T>
+struct _comparison_traits {
+	typedef typename IfThenElse<std::is_integral<T>::value ||
+	                                std::is_enum<T>::value ||
+	                                std::is_pointer<T>::value,
+	                            _true_type, _false_type>::result is_bitwise_equal;
+	typedef typename IfThenElse<std::is_integral<T>::value &&
+	                                std::is_unsigned<T>::value &&
+	                                sizeof(T) == 1,
+	                            _true_type, _false_type>::result is_byte_ordered;
+};
+
 MSTL_NAMESPACE_END
 
 #endif
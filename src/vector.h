@@ -5,11 +5,17 @@
 
 #include "algorithm.h"
 #include "allocator.h"
+#include "bit.h"
+#include "hash.h"
 #include "iterator.h"
 #include "type_traits.h"
 
+#include <climits>
+#include <cstring>
 #include <initializer_list>
+#include <iterator>
 #include <limits>
+#include <type_traits>
 #include <utility>
 
 MSTL_NAMESPACE_BEGIN
@@ -36,10 +42,14 @@ public:
 	using uninitialized_mem_func_type =
 	    uninitialized_mem_func<value_type, Allocator>;
 
+	// 成员指针类型取自分配器，如 shm_allocator 下为 offset_ptr
+	// 使 vector 本身可存放于共享内存中，对外接口仍使用原生指针
+	using storage_pointer = typename allocator_type::pointer;
+
 private:
-	pointer start_;
-	pointer finish_;
-	pointer end_of_storage_;
+	storage_pointer start_;
+	storage_pointer finish_;
+	storage_pointer end_of_storage_;
 
 public:
 	// (construct)(destruct)(copy)(operator=)(assign) ......
@@ -56,9 +66,14 @@ public:
 		finish_ = start_ + count;
 		end_of_storage_ = finish_;
 	}
-	template <class InputIterator>
-	vector(InputIterator first, InputIterator last) {
-		alloc_n_and_copy(&*first, &*last, static_cast<size_type>(last - first));
+	template <class InputIterator,
+	          class = typename std::enable_if<
+	              !std::is_integral<InputIterator>::value>::type>
+	vector(InputIterator first, InputIterator last)
+	    : start_(nullptr)
+	    , finish_(nullptr)
+	    , end_of_storage_(nullptr) {
+		range_init(first, last, iterator_category(first));
 	}
 
 	vector(const vector& other) {
@@ -121,12 +136,11 @@ public:
 		uninitialized_mem_func_type::fill_n(start_, count, value);
 		finish_ = start_ + count;
 	}
-	template <class InputIterator>
+	template <class InputIterator,
+	          class = typename std::enable_if<
+	              !std::is_integral<InputIterator>::value>::type>
 	void assign(InputIterator first, InputIterator last) {
-		clear();
-		reserve(static_cast<size_type>(last - first));
-		uninitialized_mem_func_type::copy(&*first, &*last, start_);
-		finish_ = start_ + static_cast<size_type>(last - first);
+		range_assign(first, last, iterator_category(first));
 	}
 
 	void assign(const std::initializer_list<T>& il) {
@@ -247,17 +261,12 @@ public:
 		uninitialized_mem_func_type::fill_n(new_pos, count, value);
 		return new_pos;
 	}
-	template <class InputIterator>
+	template <class InputIterator,
+	          class = typename std::enable_if<
+	              !std::is_integral<InputIterator>::value>::type>
 	iterator insert(const_iterator pos, InputIterator first,
 	                InputIterator last) {
-
-		const size_type index = pos - begin();
-		make_empty_before_pos(const_cast<pointer>(pos),
-		                      static_cast<size_type>(last - first));
-
-		pointer new_pos = begin() + index;
-		uninitialized_mem_func_type::copy(first, last, new_pos);
-		return new_pos;
+		return range_insert(pos, first, last, iterator_category(first));
 	}
 	iterator insert(const_iterator pos, const std::initializer_list<T>& il) {
 		return insert(pos, il.begin(), il.end());
@@ -333,12 +342,39 @@ public:
 		mSTL::swap(end_of_storage_, other.end_of_storage_);
 	}
 
+	// 元素哈希值合并，相等的 vector 哈希值相等
+	size_t hash() const { return mSTL::hash_range(data(), size()); }
+
 public:
 	inline size_type get_new_capacity(size_type count) const;
 
 private:
 	inline void alloc_n_and_copy(const_iterator first, const_iterator last,
 	                             size_type count);
+
+	// 区间构造 / 赋值 / 插入按迭代器类别分发
+	// input iterator 只能单趟遍历，逐个追加并按 get_new_capacity 摊还扩容
+	// forward iterator 先以 distance 计数，一次分配后直接构造
+	template <class InputIterator>
+	void range_init(InputIterator first, InputIterator last,
+	                input_iterator_tag);
+	template <class ForwardIterator>
+	void range_init(ForwardIterator first, ForwardIterator last,
+	                forward_iterator_tag);
+
+	template <class InputIterator>
+	void range_assign(InputIterator first, InputIterator last,
+	                  input_iterator_tag);
+	template <class ForwardIterator>
+	void range_assign(ForwardIterator first, ForwardIterator last,
+	                  forward_iterator_tag);
+
+	template <class InputIterator>
+	iterator range_insert(const_iterator pos, InputIterator first,
+	                      InputIterator last, input_iterator_tag);
+	template <class ForwardIterator>
+	iterator range_insert(const_iterator pos, ForwardIterator first,
+	                      ForwardIterator last, forward_iterator_tag);
 	inline void realloc_and_move(size_type count);
 
 	inline void make_empty_before_pos(pointer pos, size_type count);
@@ -355,15 +391,8 @@ private:
 
 template <class T, class Alloc>
 bool operator==(const vector<T, Alloc>& lhs, const vector<T, Alloc>& rhs) {
-	if (lhs.size() != rhs.size())
-		return false;
-
-	for (size_t i = 0; i < lhs.size(); ++i) {
-		if (lhs[i] != rhs[i])
-			return false;
-	}
-
-	return true;
+	return lhs.size() == rhs.size() &&
+	       mSTL::_contiguous_equal(lhs.data(), rhs.data(), lhs.size());
 }
 
 template <class T, class Alloc>
@@ -373,17 +402,8 @@ bool operator!=(const vector<T, Alloc>& lhs, const vector<T, Alloc>& rhs) {
 
 template <class T, class Alloc>
 bool operator<(const vector<T, Alloc>& lhs, const vector<T, Alloc>& rhs) {
-
-	size_t min_size = mSTL::min(lhs.size(), rhs.size());
-
-	for (size_t i = 0; i < min_size; ++i) {
-		if (lhs[i] > rhs[i])
-			return false;
-		else if (lhs[i] < rhs[i])
-			return true;
-	}
-
-	return lhs.size() < rhs.size() ? true : false;
+	return mSTL::_contiguous_less(lhs.data(), lhs.size(), rhs.data(),
+	                              rhs.size());
 }
 
 template <class T, class Alloc>
@@ -406,33 +426,49 @@ void swap(vector<T, Alloc>& lhs, vector<T, Alloc>& rhs) {
 	lhs.swap(rhs);
 }
 
+// erase() / erase_if(): 单趟稳定压缩后一次性销毁尾部，返回移除个数  O(N)
+// POD 类型经 remove_if 的无分支压缩实现
 template <class T, class Alloc, class U>
 size_t erase(vector<T, Alloc>& c, const U& value) {
-	size_t count = 0;
-	for (auto item = c.begin(); item != c.end(); ++item) {
-		if (*item == value) {
-			c.erase(item);
-			++count;
-		}
-	}
+	auto new_end = mSTL::remove(c.begin(), c.end(), value);
+	size_t count = static_cast<size_t>(c.end() - new_end);
+	c.erase(new_end, c.end());
 
 	return count;
 }
 
-/*
 template <class T, class Alloc, class Pred>
 size_t erase_if(vector<T, Alloc>& c, Pred pred) {
-	size_t count = 0;
-	for (auto item = c.begin(); item != c.end(); ++item) {
-		if (pred(*item)) {
-			c.erase(item);
-			++count;
-		}
-	}
+	auto new_end = mSTL::remove_if(c.begin(), c.end(), pred);
+	size_t count = static_cast<size_t>(c.end() - new_end);
+	c.erase(new_end, c.end());
 
 	return count;
 }
-*/
+
+// erase_indices(): 按升序下标批量移除元素，返回移除个数  O(N + K)
+// 允许重复下标，超出 size() 的下标被忽略
+template <class T, class Alloc, class InputIterator>
+size_t erase_indices(vector<T, Alloc>& c, InputIterator first,
+                     InputIterator last) {
+	auto new_end = mSTL::remove_indices(c.begin(), c.end(), first, last);
+	size_t count = static_cast<size_t>(c.end() - new_end);
+	c.erase(new_end, c.end());
+
+	return count;
+}
+
+template <class T, class Alloc, class Indices>
+size_t erase_indices(vector<T, Alloc>& c, const Indices& sorted_indices) {
+	return erase_indices(c, std::begin(sorted_indices),
+	                     std::end(sorted_indices));
+}
+
+template <class T, class Alloc>
+size_t erase_indices(vector<T, Alloc>& c,
+                     std::initializer_list<size_t> sorted_indices) {
+	return erase_indices(c, sorted_indices.begin(), sorted_indices.end());
+}
 
 // implement
 
@@ -455,12 +491,10 @@ template <class T, class Alloc>
 inline typename vector<T, Alloc>::size_type
 vector<T, Alloc>::get_new_capacity(size_type count) const {
 
-	size_type old_capacity = capacity();
-
-	size_type new_capacity = old_capacity + mSTL::max(old_capacity, count);
+	size_type new_capacity = _grow_capacity(capacity(), count);
 	assert(new_capacity < max_size());
 
-	return (old_capacity == 0 ? count : new_capacity);
+	return new_capacity;
 
 	// gcc
 	// return (capacity() == 0 ? len : capacity() * 2);
@@ -480,10 +514,127 @@ inline void vector<T, Alloc>::alloc_n_and_copy(const_iterator first,
 	end_of_storage_ = start_ + count;
 }
 
+template <class T, class Alloc>
+template <class InputIterator>
+void vector<T, Alloc>::range_init(InputIterator first, InputIterator last,
+                                  input_iterator_tag) {
+	try {
+		for (; first != last; ++first)
+			emplace_back(*first);
+	} catch (...) {
+		clear();
+		if (start_ != nullptr)
+			allocator_type::deallocate(start_, capacity());
+		throw;
+	}
+}
+
+template <class T, class Alloc>
+template <class ForwardIterator>
+void vector<T, Alloc>::range_init(ForwardIterator first, ForwardIterator last,
+                                  forward_iterator_tag) {
+	size_type count = 0;
+	mSTL::distance(first, last, count);
+
+	start_ = allocator_type::allocate(count);
+	try {
+		finish_ = uninitialized_mem_func_type::copy(first, last, start_);
+	} catch (...) {
+		allocator_type::deallocate(start_, count);
+		throw;
+	}
+	end_of_storage_ = start_ + count;
+}
+
+template <class T, class Alloc>
+template <class InputIterator>
+void vector<T, Alloc>::range_assign(InputIterator first, InputIterator last,
+                                    input_iterator_tag) {
+	// 先覆盖已有元素，剩余部分追加或销毁
+	pointer current = begin();
+	for (; first != last && current != end(); ++first, ++current)
+		*current = *first;
+
+	if (first == last) {
+		allocator_type::destroy(current, end());
+		finish_ = current;
+	} else {
+		for (; first != last; ++first)
+			emplace_back(*first);
+	}
+}
+
+template <class T, class Alloc>
+template <class ForwardIterator>
+void vector<T, Alloc>::range_assign(ForwardIterator first, ForwardIterator last,
+                                    forward_iterator_tag) {
+	size_type count = 0;
+	mSTL::distance(first, last, count);
+
+	if (count > capacity()) {
+		// 先构造新内存块，源区间可来自自身
+		pointer new_start = allocator_type::allocate(count);
+		try {
+			uninitialized_mem_func_type::copy(first, last, new_start);
+		} catch (...) {
+			allocator_type::deallocate(new_start, count);
+			throw;
+		}
+		if (start_ != nullptr) {
+			allocator_type::destroy(begin(), end());
+			allocator_type::deallocate(start_, capacity());
+		}
+
+		start_ = new_start;
+		finish_ = start_ + count;
+		end_of_storage_ = finish_;
+	} else if (count <= size()) {
+		pointer new_finish = mSTL::copy(first, last, begin());
+		allocator_type::destroy(new_finish, end());
+		finish_ = new_finish;
+	} else {
+		ForwardIterator mid = first;
+		mSTL::advance(mid, size());
+		mSTL::copy(first, mid, begin());
+		finish_ = uninitialized_mem_func_type::copy(mid, last, end());
+	}
+}
+
+template <class T, class Alloc>
+template <class InputIterator>
+typename vector<T, Alloc>::iterator
+vector<T, Alloc>::range_insert(const_iterator pos, InputIterator first,
+                               InputIterator last, input_iterator_tag) {
+	// 无法预知元素个数，先追加至尾部再旋转至插入位置
+	const size_type index = static_cast<size_type>(pos - begin());
+	const size_type old_size = size();
+	for (; first != last; ++first)
+		emplace_back(*first);
+
+	std::rotate(begin() + index, begin() + old_size, end());
+	return begin() + index;
+}
+
+template <class T, class Alloc>
+template <class ForwardIterator>
+typename vector<T, Alloc>::iterator
+vector<T, Alloc>::range_insert(const_iterator pos, ForwardIterator first,
+                               ForwardIterator last, forward_iterator_tag) {
+	size_type count = 0;
+	mSTL::distance(first, last, count);
+
+	const size_type index = static_cast<size_type>(pos - begin());
+	make_empty_before_pos(const_cast<pointer>(pos), count);
+
+	pointer new_pos = begin() + index;
+	uninitialized_mem_func_type::copy(first, last, new_pos);
+	return new_pos;
+}
+
 template <class T, class Alloc>
 inline void vector<T, Alloc>::realloc_and_move(size_type count) {
 
-	pointer new_start_ = allocator_type::allocate(count);
+	pointer new_start = allocator_type::allocate(count);
 
 	size_type old_size = size();
 
@@ -493,11 +644,11 @@ inline void vector<T, Alloc>::realloc_and_move(size_type count) {
 
 	if (start_ != nullptr) {
 		// 数据移动
-		uninitialized_mem_func_type::move(start_, finish_, new_start_);
+		uninitialized_mem_func_type::move(start_, finish_, new_start);
 		allocator_type::deallocate(start_, capacity());
 	}
 
-	start_ = new_start_;
+	start_ = new_start;
 	finish_ = start_ + old_size;
 	end_of_storage_ = start_ + count;
 }
@@ -520,20 +671,20 @@ inline void vector<T, Alloc>::make_empty_before_pos(pointer   pos,
 
 		size_type new_capacity = get_new_capacity(count);
 		// 构建新的内存块
-		pointer new_start_ = allocator_type::allocate(new_capacity);
+		pointer new_start = allocator_type::allocate(new_capacity);
 
 		if (start_ != nullptr) {
 
-			memmove_aux(new_start_, start_, size_before_pos, isPODType(),
+			memmove_aux(new_start, start_, size_before_pos, isPODType(),
 			            _common_direction());
-			memmove_aux((new_start_ + size_before_pos + count), pos,
+			memmove_aux((new_start + size_before_pos + count), pos,
 			            size_after_pos, isPODType(), _reverse_direction());
 
 			// 释放此前的内存块
 			allocator_type::deallocate(start_, capacity());
 		}
 
-		start_ = new_start_;
+		start_ = new_start;
 		finish_ = start_ + new_size;
 		end_of_storage_ = start_ + new_capacity;
 	}
@@ -578,6 +729,790 @@ inline void vector<T, Alloc>::memmove_aux(pointer dest, pointer src,
 		    dest_reverse, std::move(static_cast<value_type>(*src_reverse)));
 }
 
+///<- vector<bool>
+
+// 按位压缩存储，每个 word 保存 word_bits 个元素，相比逐字节存储节省 8 倍空间
+// 约定所有已分配 word 中位置不小于 size() 的位始终为 0
+// 由此 count/find/比较 等操作可以直接按 word 进行
+
+template <class Allocator>
+class vector<bool, Allocator> {
+
+public:
+	using value_type = bool;
+	using allocator_type = Allocator;
+	using size_type = size_t;
+	using difference_type = ptrdiff_t;
+
+	using word_type = unsigned long long;
+	using word_allocator_type =
+	    typename Allocator::template rebind<word_type>::other;
+
+	static constexpr size_type word_bits = sizeof(word_type) * CHAR_BIT;
+	static constexpr size_type npos = static_cast<size_type>(-1);
+
+	class reference;
+	class iterator;
+	class const_iterator;
+
+	using const_reference = bool;
+
+	using reverse_iterator = _reverse_iterator<iterator>;
+	using const_reverse_iterator = _reverse_iterator<const_iterator>;
+
+	// 位引用代理
+	class reference {
+	private:
+		word_type* word_;
+		word_type  mask_;
+
+	public:
+		reference(word_type* word, word_type mask) noexcept
+		    : word_(word)
+		    , mask_(mask) {}
+		reference(const reference&) noexcept = default;
+
+		operator bool() const noexcept { return (*word_ & mask_) != 0; }
+
+		reference& operator=(bool x) noexcept {
+			if (x)
+				*word_ |= mask_;
+			else
+				*word_ &= ~mask_;
+			return *this;
+		}
+		reference& operator=(const reference& x) noexcept {
+			return *this = static_cast<bool>(x);
+		}
+
+		bool operator~() const noexcept { return !static_cast<bool>(*this); }
+		void flip() noexcept { *word_ ^= mask_; }
+	};
+
+	// 位迭代器公共部分，p_ 指向所在 word，offset_ 为 word 内位偏移
+	class bit_iterator_base {
+	public:
+		using iterator_category = random_access_iterator_tag;
+		using value_type = bool;
+		using difference_type = ptrdiff_t;
+		using pointer = void;
+
+		word_type* p_;
+		size_type  offset_;
+
+		bit_iterator_base(word_type* p = nullptr, size_type offset = 0) noexcept
+		    : p_(p)
+		    , offset_(offset) {}
+
+	protected:
+		void bump_up() noexcept {
+			if (offset_++ == word_bits - 1) {
+				offset_ = 0;
+				++p_;
+			}
+		}
+		void bump_down() noexcept {
+			if (offset_-- == 0) {
+				offset_ = word_bits - 1;
+				--p_;
+			}
+		}
+		void incr(difference_type i) noexcept {
+			difference_type n =
+			    i + static_cast<difference_type>(offset_);
+			difference_type words =
+			    n / static_cast<difference_type>(word_bits);
+			n %= static_cast<difference_type>(word_bits);
+			if (n < 0) {
+				n += static_cast<difference_type>(word_bits);
+				--words;
+			}
+			p_ += words;
+			offset_ = static_cast<size_type>(n);
+		}
+
+	public:
+		friend difference_type operator-(const bit_iterator_base& x,
+		                                 const bit_iterator_base& y) noexcept {
+			return static_cast<difference_type>(word_bits) * (x.p_ - y.p_) +
+			       static_cast<difference_type>(x.offset_) -
+			       static_cast<difference_type>(y.offset_);
+		}
+
+		bool operator==(const bit_iterator_base& x) const noexcept {
+			return p_ == x.p_ && offset_ == x.offset_;
+		}
+		bool operator!=(const bit_iterator_base& x) const noexcept {
+			return !(*this == x);
+		}
+		bool operator<(const bit_iterator_base& x) const noexcept {
+			return p_ < x.p_ || (p_ == x.p_ && offset_ < x.offset_);
+		}
+		bool operator>(const bit_iterator_base& x) const noexcept {
+			return x < *this;
+		}
+		bool operator<=(const bit_iterator_base& x) const noexcept {
+			return !(x < *this);
+		}
+		bool operator>=(const bit_iterator_base& x) const noexcept {
+			return !(*this < x);
+		}
+	};
+
+	class iterator : public bit_iterator_base {
+	public:
+		using reference = typename vector::reference;
+		using self = iterator;
+
+		iterator(word_type* p = nullptr, size_type offset = 0) noexcept
+		    : bit_iterator_base(p, offset) {}
+
+		reference operator*() const noexcept {
+			return reference(this->p_, word_type(1) << this->offset_);
+		}
+		reference operator[](difference_type i) const noexcept {
+			return *(*this + i);
+		}
+
+		self& operator++() noexcept {
+			this->bump_up();
+			return *this;
+		}
+		self operator++(int) noexcept {
+			self temp = *this;
+			this->bump_up();
+			return temp;
+		}
+		self& operator--() noexcept {
+			this->bump_down();
+			return *this;
+		}
+		self operator--(int) noexcept {
+			self temp = *this;
+			this->bump_down();
+			return temp;
+		}
+
+		self& operator+=(difference_type i) noexcept {
+			this->incr(i);
+			return *this;
+		}
+		self& operator-=(difference_type i) noexcept {
+			this->incr(-i);
+			return *this;
+		}
+		self operator+(difference_type i) const noexcept {
+			self temp = *this;
+			return temp += i;
+		}
+		self operator-(difference_type i) const noexcept {
+			self temp = *this;
+			return temp -= i;
+		}
+	};
+
+	class const_iterator : public bit_iterator_base {
+	public:
+		using reference = bool;
+		using self = const_iterator;
+
+		const_iterator(const word_type* p = nullptr, size_type offset = 0) noexcept
+		    : bit_iterator_base(const_cast<word_type*>(p), offset) {}
+		const_iterator(const iterator& x) noexcept
+		    : bit_iterator_base(x.p_, x.offset_) {}
+
+		reference operator*() const noexcept {
+			return (*this->p_ & (word_type(1) << this->offset_)) != 0;
+		}
+		reference operator[](difference_type i) const noexcept {
+			return *(*this + i);
+		}
+
+		self& operator++() noexcept {
+			this->bump_up();
+			return *this;
+		}
+		self operator++(int) noexcept {
+			self temp = *this;
+			this->bump_up();
+			return temp;
+		}
+		self& operator--() noexcept {
+			this->bump_down();
+			return *this;
+		}
+		self operator--(int) noexcept {
+			self temp = *this;
+			this->bump_down();
+			return temp;
+		}
+
+		self& operator+=(difference_type i) noexcept {
+			this->incr(i);
+			return *this;
+		}
+		self& operator-=(difference_type i) noexcept {
+			this->incr(-i);
+			return *this;
+		}
+		self operator+(difference_type i) const noexcept {
+			self temp = *this;
+			return temp += i;
+		}
+		self operator-(difference_type i) const noexcept {
+			self temp = *this;
+			return temp -= i;
+		}
+	};
+
+private:
+	word_type* start_;
+	size_type  size_;
+	size_type  words_; // 已分配 word 个数
+
+public:
+	// (construct)(destruct)(copy)(operator=)(assign) ......
+
+	vector() noexcept
+	    : start_(nullptr)
+	    , size_(0)
+	    , words_(0) {}
+	vector(const size_type count, const bool value = false)
+	    : start_(nullptr)
+	    , size_(0)
+	    , words_(0) {
+		assign(count, value);
+	}
+	template <class InputIterator,
+	          class = typename std::enable_if<
+	              !std::is_integral<InputIterator>::value>::type>
+	vector(InputIterator first, InputIterator last)
+	    : start_(nullptr)
+	    , size_(0)
+	    , words_(0) {
+		assign(first, last);
+	}
+
+	vector(const vector& other)
+	    : start_(nullptr)
+	    , size_(0)
+	    , words_(0) {
+		realloc_and_move(other.size_);
+		copy_words(other.start_, word_count(other.size_), start_);
+		size_ = other.size_;
+	}
+	vector(vector&& other) noexcept
+	    : start_(other.start_)
+	    , size_(other.size_)
+	    , words_(other.words_) {
+		other.start_ = nullptr;
+		other.size_ = 0;
+		other.words_ = 0;
+	}
+	vector& operator=(const vector& other) {
+		if (this == &other)
+			return *this;
+
+		clear();
+		reserve(other.size_);
+		copy_words(other.start_, word_count(other.size_), start_);
+		size_ = other.size_;
+
+		return *this;
+	}
+	vector& operator=(vector&& other) noexcept {
+		if (this == &other)
+			return *this;
+
+		word_allocator_type::deallocate(start_, words_);
+
+		start_ = other.start_;
+		size_ = other.size_;
+		words_ = other.words_;
+
+		other.start_ = nullptr;
+		other.size_ = 0;
+		other.words_ = 0;
+
+		return *this;
+	}
+
+	vector(const std::initializer_list<bool>& il)
+	    : start_(nullptr)
+	    , size_(0)
+	    , words_(0) {
+		assign(il.begin(), il.end());
+	}
+	vector& operator=(const std::initializer_list<bool>& il) {
+		assign(il.begin(), il.end());
+		return *this;
+	}
+
+	void assign(size_type count, const bool value) {
+		clear();
+		reserve(count);
+		size_ = count;
+		fill_bits(0, count, value);
+	}
+	template <class InputIterator,
+	          class = typename std::enable_if<
+	              !std::is_integral<InputIterator>::value>::type>
+	void assign(InputIterator first, InputIterator last) {
+		clear();
+		range_reserve(first, last, iterator_category(first));
+		for (; first != last; ++first)
+			push_back(static_cast<bool>(*first));
+	}
+	void assign(const std::initializer_list<bool>& il) {
+		assign(il.begin(), il.end());
+	}
+
+	~vector() noexcept {
+		word_allocator_type::deallocate(start_, words_);
+		start_ = nullptr;
+		size_ = words_ = 0;
+	}
+
+	allocator_type get_allocator() { return allocator_type(); }
+
+	// Element access
+
+	reference       at(size_type pos) { return *(begin() + pos); }
+	const_reference at(size_type pos) const { return *(begin() + pos); }
+
+	reference operator[](const difference_type i) {
+		return reference(start_ + i / word_bits,
+		                 word_type(1) << (i % word_bits));
+	}
+	const_reference operator[](const difference_type i) const {
+		return (start_[i / word_bits] >> (i % word_bits)) & 1;
+	}
+
+	reference       front() { return (*this)[0]; }
+	const_reference front() const { return (*this)[0]; }
+
+	reference       back() { return (*this)[size_ - 1]; }
+	const_reference back() const { return (*this)[size_ - 1]; }
+
+	// 底层 word 数组，有效 word 个数为 num_words()
+	word_type*       words() noexcept { return start_; }
+	const word_type* words() const noexcept { return start_; }
+	size_type num_words() const noexcept { return word_count(size_); }
+
+	// Iterators
+
+	iterator       begin() noexcept { return iterator(start_, 0); }
+	const_iterator begin() const noexcept { return const_iterator(start_, 0); }
+	const_iterator cbegin() const noexcept {
+		return const_iterator(start_, 0);
+	}
+
+	iterator end() noexcept {
+		return iterator(start_ + size_ / word_bits, size_ % word_bits);
+	}
+	const_iterator end() const noexcept {
+		return const_iterator(start_ + size_ / word_bits, size_ % word_bits);
+	}
+	const_iterator cend() const noexcept { return end(); }
+
+	reverse_iterator rbegin() noexcept { return reverse_iterator(end() - 1); }
+	const_reverse_iterator rbegin() const noexcept {
+		return const_reverse_iterator(end() - 1);
+	}
+	const_reverse_iterator crbegin() const noexcept {
+		return const_reverse_iterator(end() - 1);
+	}
+
+	reverse_iterator rend() noexcept { return reverse_iterator(begin() - 1); }
+	const_reverse_iterator rend() const noexcept {
+		return const_reverse_iterator(begin() - 1);
+	}
+	const_reverse_iterator crend() const noexcept {
+		return const_reverse_iterator(begin() - 1);
+	}
+
+	// Capacity
+
+	bool empty() const noexcept { return size_ == 0; }
+
+	size_type size() const noexcept { return size_; }
+	size_type max_size() const noexcept {
+		return std::numeric_limits<difference_type>::max();
+	}
+	size_type capacity() const noexcept { return words_ * word_bits; }
+
+	void reserve(size_type n) {
+		if (n <= capacity())
+			return;
+
+		realloc_and_move(n);
+	}
+	void shrink_to_fit() {
+		if (word_count(size_) < words_)
+			realloc_and_move(size_);
+	}
+
+	// Modifiers
+
+	void clear() noexcept {
+		zero_words(start_, word_count(size_));
+		size_ = 0;
+	}
+
+	iterator insert(const_iterator pos, const bool value) {
+		return insert(pos, static_cast<size_type>(1), value);
+	}
+	iterator insert(const_iterator pos, size_type count, const bool value) {
+		const size_type index = static_cast<size_type>(pos - cbegin());
+		make_empty_before_pos(index, count);
+		fill_bits(index, index + count, value);
+		return begin() + index;
+	}
+	template <class InputIterator,
+	          class = typename std::enable_if<
+	              !std::is_integral<InputIterator>::value>::type>
+	iterator insert(const_iterator pos, InputIterator first,
+	                InputIterator last) {
+		return range_insert(static_cast<size_type>(pos - cbegin()), first, last,
+		                    iterator_category(first));
+	}
+	iterator insert(const_iterator pos, const std::initializer_list<bool>& il) {
+		return insert(pos, il.begin(), il.end());
+	}
+
+	iterator erase(const_iterator position) {
+		return erase(position, (position + 1));
+	}
+	iterator erase(const_iterator first, const_iterator last) {
+		const size_type index = static_cast<size_type>(first - cbegin());
+		const size_type count = static_cast<size_type>(last - first);
+
+		iterator dest = begin() + index;
+		mSTL::copy(begin() + (index + count), end(), dest);
+		fill_bits(size_ - count, size_, false);
+		size_ -= count;
+
+		return begin() + index;
+	}
+
+	void push_back(const bool value) {
+		if (size_ == capacity())
+			realloc_and_move(get_new_capacity(1));
+		unchecked_push_back(value);
+	}
+
+	template <class... Args>
+	reference emplace_back(Args&&... args) {
+		push_back(bool(std::forward<Args>(args)...));
+		return back();
+	}
+
+	void pop_back() {
+		--size_;
+		(*this)[size_] = false;
+	}
+
+	void resize(size_type count, const bool value = false) {
+		if (count < size_) {
+			fill_bits(count, size_, false);
+		} else if (count > size_) {
+			if (count > capacity())
+				realloc_and_move(
+				    mSTL::max(count, get_new_capacity(count - size_)));
+			fill_bits(size_, count, value);
+		}
+
+		size_ = count;
+	}
+
+	void swap(vector& other) noexcept {
+		if (this == &other)
+			return;
+
+		mSTL::swap(start_, other.start_);
+		mSTL::swap(size_, other.size_);
+		mSTL::swap(words_, other.words_);
+	}
+
+	// 末尾多余位均为 0，直接哈希有效 word
+	size_t hash() const noexcept {
+		return mSTL::hash_bytes(start_, num_words() * sizeof(word_type), size_);
+	}
+
+	static void swap(reference x, reference y) noexcept {
+		bool temp = x;
+		x = y;
+		y = temp;
+	}
+
+	// Bit operations
+	// 以下操作均按 word 进行
+
+	// 全部元素取反
+	void flip() noexcept {
+		size_type n = word_count(size_);
+		for (size_type i = 0; i < n; ++i)
+			start_[i] = ~start_[i];
+		clear_unused_bits();
+	}
+
+	// 全部元素置为 value
+	void fill(const bool value) noexcept { fill_bits(0, size_, value); }
+
+	// 值为 true 的元素个数
+	size_type count() const noexcept {
+		size_type result = 0;
+		size_type n = word_count(size_);
+		for (size_type i = 0; i < n; ++i)
+			result += static_cast<size_type>(mSTL::popcount(start_[i]));
+		return result;
+	}
+
+	// 第一个值为 true 的元素下标，不存在时返回 npos
+	size_type find_first() const noexcept { return find_from(0); }
+
+	// pos 之后第一个值为 true 的元素下标，不存在时返回 npos
+	size_type find_next(size_type pos) const noexcept {
+		return pos + 1 >= size_ ? npos : find_from(pos + 1);
+	}
+
+	// 按位与/或/异或，要求两者元素个数相同
+	vector& operator&=(const vector& other) noexcept {
+		assert(size_ == other.size_);
+		size_type n = word_count(size_);
+		for (size_type i = 0; i < n; ++i)
+			start_[i] &= other.start_[i];
+		return *this;
+	}
+	vector& operator|=(const vector& other) noexcept {
+		assert(size_ == other.size_);
+		size_type n = word_count(size_);
+		for (size_type i = 0; i < n; ++i)
+			start_[i] |= other.start_[i];
+		return *this;
+	}
+	vector& operator^=(const vector& other) noexcept {
+		assert(size_ == other.size_);
+		size_type n = word_count(size_);
+		for (size_type i = 0; i < n; ++i)
+			start_[i] ^= other.start_[i];
+		return *this;
+	}
+
+public:
+	inline size_type get_new_capacity(size_type count) const;
+
+private:
+	static size_type word_count(size_type bits) noexcept {
+		return (bits + word_bits - 1) / word_bits;
+	}
+
+	static void copy_words(const word_type* src, size_type n, word_type* dest) {
+		if (n != 0)
+			memcpy(dest, src, n * sizeof(word_type));
+	}
+	static void zero_words(word_type* dest, size_type n) {
+		if (n != 0)
+			memset(dest, 0, n * sizeof(word_type));
+	}
+
+	void unchecked_push_back(const bool value) noexcept {
+		if (value)
+			start_[size_ / word_bits] |= word_type(1) << (size_ % word_bits);
+		++size_;
+	}
+
+	// 区间赋值 / 插入按迭代器类别分发，forward iterator 预先计数
+	template <class InputIterator>
+	void range_reserve(InputIterator, InputIterator, input_iterator_tag) {}
+	template <class ForwardIterator>
+	void range_reserve(ForwardIterator first, ForwardIterator last,
+	                   forward_iterator_tag) {
+		size_type count = 0;
+		mSTL::distance(first, last, count);
+		reserve(size_ + count);
+	}
+
+	// input iterator 只能单趟遍历，先读入临时对象再整体插入
+	template <class InputIterator>
+	iterator range_insert(size_type index, InputIterator first,
+	                      InputIterator last, input_iterator_tag) {
+		vector temp(first, last);
+		return range_insert(index, temp.cbegin(), temp.cend(),
+		                    random_access_iterator_tag());
+	}
+	template <class ForwardIterator>
+	iterator range_insert(size_type index, ForwardIterator first,
+	                      ForwardIterator last, forward_iterator_tag) {
+		size_type count = 0;
+		mSTL::distance(first, last, count);
+		make_empty_before_pos(index, count);
+
+		iterator current = begin() + index;
+		for (; first != last; ++first, ++current)
+			*current = static_cast<bool>(*first);
+		return begin() + index;
+	}
+
+	inline void realloc_and_move(size_type bits);
+	inline void make_empty_before_pos(size_type index, size_type count);
+	inline void fill_bits(size_type first, size_type last, bool value) noexcept;
+	inline void clear_unused_bits() noexcept;
+	inline size_type find_from(size_type pos) const noexcept;
+};
+
+template <class Allocator>
+constexpr typename vector<bool, Allocator>::size_type
+    vector<bool, Allocator>::word_bits;
+
+template <class Allocator>
+constexpr typename vector<bool, Allocator>::size_type
+    vector<bool, Allocator>::npos;
+
+// 末尾多余位均为 0，可直接逐 word 比较
+template <class Alloc>
+bool operator==(const vector<bool, Alloc>& lhs,
+                const vector<bool, Alloc>& rhs) {
+	if (lhs.size() != rhs.size())
+		return false;
+
+	size_t n = lhs.num_words();
+	return n == 0 ||
+	       memcmp(lhs.words(), rhs.words(),
+	              n * sizeof(typename vector<bool, Alloc>::word_type)) == 0;
+}
+
+// 字典序比较，以异或结果的最低置位定位首个不同元素
+template <class Alloc>
+bool operator<(const vector<bool, Alloc>& lhs,
+               const vector<bool, Alloc>& rhs) {
+	typedef typename vector<bool, Alloc>::word_type word_type;
+
+	size_t min_size = mSTL::min(lhs.size(), rhs.size());
+	size_t n = (min_size + vector<bool, Alloc>::word_bits - 1) /
+	           vector<bool, Alloc>::word_bits;
+
+	for (size_t i = 0; i < n; ++i) {
+		word_type diff = lhs.words()[i] ^ rhs.words()[i];
+		if (diff == 0)
+			continue;
+
+		int    offset = mSTL::countr_zero(diff);
+		size_t pos = i * vector<bool, Alloc>::word_bits + offset;
+		if (pos >= min_size)
+			break;
+		return ((rhs.words()[i] >> offset) & 1) != 0;
+	}
+
+	return lhs.size() < rhs.size();
+}
+
+template <class Alloc>
+inline typename vector<bool, Alloc>::size_type
+vector<bool, Alloc>::get_new_capacity(size_type count) const {
+
+	// 首次分配至少占满一个 word
+	size_type new_capacity = _grow_capacity(
+	    capacity(), capacity() == 0 ? mSTL::max(count, word_bits) : count);
+	assert(new_capacity < max_size());
+
+	return new_capacity;
+}
+
+// 新分配的 word 全部置 0 以维持末尾多余位为 0 的约定
+template <class Alloc>
+inline void vector<bool, Alloc>::realloc_and_move(size_type bits) {
+	size_type new_words = word_count(bits);
+	word_type* new_start = word_allocator_type::allocate(new_words);
+
+	size_type used = word_count(size_);
+	copy_words(start_, used, new_start);
+	zero_words(new_start + used, new_words - used);
+
+	word_allocator_type::deallocate(start_, words_);
+
+	start_ = new_start;
+	words_ = new_words;
+}
+
+// 将 [index, size()) 后移 count 位，空出的位置值未定
+template <class Alloc>
+inline void vector<bool, Alloc>::make_empty_before_pos(size_type index,
+                                                      size_type count) {
+	size_type new_size = size_ + count;
+	if (new_size > capacity())
+		realloc_and_move(mSTL::max(new_size, get_new_capacity(count)));
+
+	iterator old_end = end();
+	size_ = new_size;
+	mSTL::copy_backward(begin() + index, old_end, end());
+}
+
+// 将 [first, last) 位置为 value，首尾不完整的 word 使用掩码处理
+template <class Alloc>
+inline void vector<bool, Alloc>::fill_bits(size_type first, size_type last,
+                                          bool value) noexcept {
+	if (first >= last)
+		return;
+
+	size_type first_word = first / word_bits;
+	size_type last_word = (last - 1) / word_bits;
+
+	word_type head = ~word_type(0) << (first % word_bits);
+	word_type tail = ~word_type(0) >> (word_bits - 1 - (last - 1) % word_bits);
+
+	if (first_word == last_word) {
+		word_type mask = head & tail;
+		start_[first_word] =
+		    value ? (start_[first_word] | mask) : (start_[first_word] & ~mask);
+		return;
+	}
+
+	start_[first_word] =
+	    value ? (start_[first_word] | head) : (start_[first_word] & ~head);
+	if (last_word > first_word + 1)
+		memset(start_ + first_word + 1, value ? 0xff : 0,
+		       (last_word - first_word - 1) * sizeof(word_type));
+	start_[last_word] =
+	    value ? (start_[last_word] | tail) : (start_[last_word] & ~tail);
+}
+
+template <class Alloc>
+inline void vector<bool, Alloc>::clear_unused_bits() noexcept {
+	size_type offset = size_ % word_bits;
+	if (offset != 0)
+		start_[size_ / word_bits] &= ~(~word_type(0) << offset);
+}
+
+template <class Alloc>
+inline typename vector<bool, Alloc>::size_type
+vector<bool, Alloc>::find_from(size_type pos) const noexcept {
+	if (pos >= size_)
+		return npos;
+
+	size_type i = pos / word_bits;
+	size_type n = word_count(size_);
+
+	word_type w = start_[i] & (~word_type(0) << (pos % word_bits));
+	while (w == 0) {
+		if (++i == n)
+			return npos;
+		w = start_[i];
+	}
+
+	return i * word_bits + static_cast<size_type>(mSTL::countr_zero(w));
+}
+
 MSTL_NAMESPACE_END
 
+// 使 mSTL::vector 可作为 std::unordered_map 等容器的键
+namespace std {
+template <class T, class Alloc>
+struct hash<mSTL::vector<T, Alloc>> {
+	size_t operator()(const mSTL::vector<T, Alloc>& vec) const {
+		return vec.hash();
+	}
+};
+} // namespace std
+
 #endif
\ No newline at end of file
@@ -0,0 +1,89 @@
+// 有序数组查找对比，数组大小从 L1 到远超末级缓存
+// std::lower_bound、无分支 mSTL::lower_bound、批量 lower_bound_many、
+// eytzinger_index 单次与批量查找，输出每次查找的平均耗时 (ns)
+// 参数: [查找次数] [最大数组元素个数]
+
+#include "../../src/algorithm.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+double elapsed_ns(clock_type::time_point start) {
+	return std::chrono::duration<double, std::nano>(clock_type::now() - start)
+	    .count();
+}
+
+// 结果求和防止查找被优化掉
+template <class Lookup>
+double run(const std::vector<int>& keys, Lookup lookup) {
+	auto   start = clock_type::now();
+	size_t checksum = lookup();
+	double ns = elapsed_ns(start) / static_cast<double>(keys.size());
+	if (checksum == 1)
+		std::printf(" ");
+	return ns;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+	size_t lookups = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+	size_t max_n = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1 << 24;
+
+	std::mt19937 rng(48);
+	std::printf("lookups = %zu (ns / lookup)\n", lookups);
+	std::printf("%10s %10s %10s %10s %10s %10s\n", "n", "std", "mSTL", "many",
+	            "eytzinger", "eyt many");
+
+	for (size_t n = 1 << 10; n <= max_n; n <<= 3) {
+		std::vector<int> data(n);
+		for (size_t i = 0; i < n; ++i)
+			data[i] = static_cast<int>(i * 3);
+		std::vector<int> keys(lookups);
+		for (int& key : keys)
+			key = static_cast<int>(rng() % (n * 3));
+		mSTL::eytzinger_index<int> index(data.begin(), data.end());
+		std::vector<const int*>    found(keys.size());
+
+		double std_ns = run(keys, [&]() {
+			size_t sum = 0;
+			for (int key : keys)
+				sum += std::lower_bound(data.begin(), data.end(), key) - data.begin();
+			return sum;
+		});
+		double mstl_ns = run(keys, [&]() {
+			size_t sum = 0;
+			for (int key : keys)
+				sum += mSTL::lower_bound(data.data(), data.data() + n, key) -
+				       data.data();
+			return sum;
+		});
+		double many_ns = run(keys, [&]() {
+			mSTL::lower_bound_many(data.data(), data.data() + n, keys.begin(),
+			                       keys.end(), found.begin());
+			return static_cast<size_t>(found.back() - data.data());
+		});
+		double eyt_ns = run(keys, [&]() {
+			size_t sum = 0;
+			for (int key : keys)
+				sum += static_cast<size_t>(index.lower_bound(key) - index.begin());
+			return sum;
+		});
+		double eyt_many_ns = run(keys, [&]() {
+			index.lower_bound_many(keys.begin(), keys.end(), found.begin());
+			return static_cast<size_t>(found.back() - index.begin());
+		});
+		std::printf("%10zu %10.1f %10.1f %10.1f %10.1f %10.1f\n", n, std_ns,
+		            mstl_ns, many_ns, eyt_ns, eyt_many_ns);
+	}
+	return 0;
+}
@@ -0,0 +1,89 @@
+// concurrent_vector 多线程追加性能对比
+// 对比对象: std::mutex + mSTL::vector
+// 线程数从 1 递增至 hardware_concurrency，每个线程追加相同数量元素
+
+#include "../../src/concurrent_vector.h"
+#include "../../src/vector.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+template <class Func>
+double run_threads(unsigned threads, Func func) {
+	std::vector<std::thread> workers;
+	auto                     start = clock_type::now();
+
+	for (unsigned t = 0; t < threads; ++t)
+		workers.emplace_back(func, t);
+	for (auto& worker : workers)
+		worker.join();
+
+	return std::chrono::duration<double, std::milli>(clock_type::now() - start)
+	    .count();
+}
+
+double bench_locked_vector(unsigned threads, size_t per_thread) {
+	mSTL::vector<size_t> vec;
+	std::mutex           mutex;
+
+	return run_threads(threads, [&](unsigned t) {
+		for (size_t i = 0; i < per_thread; ++i) {
+			std::lock_guard<std::mutex> lock(mutex);
+			vec.push_back(t * per_thread + i);
+		}
+	});
+}
+
+double bench_concurrent_vector(unsigned threads, size_t per_thread) {
+	mSTL::concurrent_vector<size_t> vec;
+
+	return run_threads(threads, [&](unsigned t) {
+		for (size_t i = 0; i < per_thread; ++i)
+			vec.push_back(t * per_thread + i);
+	});
+}
+
+double bench_concurrent_grow_by(unsigned threads, size_t per_thread) {
+	mSTL::concurrent_vector<size_t> vec;
+
+	return run_threads(threads, [&](unsigned t) {
+		const size_t batch = 64;
+		for (size_t i = 0; i < per_thread; i += batch)
+			vec.grow_by(batch, t);
+	});
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+	size_t   per_thread = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+	unsigned max_threads = std::thread::hardware_concurrency();
+	if (max_threads == 0)
+		max_threads = 4;
+
+	std::printf("push_back %zu elements per thread (ms)\n", per_thread);
+	std::printf("%8s %16s %18s %18s\n", "threads", "mutex+vector",
+	            "concurrent_vector", "grow_by(64)");
+
+	// 2 的幂次线程数，最后补上 max_threads 本身
+	std::vector<unsigned> thread_counts;
+	for (unsigned threads = 1; threads < max_threads; threads *= 2)
+		thread_counts.push_back(threads);
+	thread_counts.push_back(max_threads);
+
+	for (unsigned threads : thread_counts)
+		std::printf("%8u %16.2f %18.2f %18.2f\n", threads,
+		            bench_locked_vector(threads, per_thread),
+		            bench_concurrent_vector(threads, per_thread),
+		            bench_concurrent_grow_by(threads, per_thread));
+
+	return 0;
+}
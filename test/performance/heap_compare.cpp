@@ -0,0 +1,112 @@
+// 二叉堆与 4 叉、8 叉堆对比 (std 堆函数作为基准)
+// 场景: make_heap、逐个 push_heap、逐个 pop_heap、定长优先队列 (弹出堆顶后压入新元素)
+// 元素为随机 uint64_t，默认堆大小超过末级缓存
+// 参数: [元素个数] [重复次数]
+
+#include "../../src/algorithm.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+double elapsed_ms(clock_type::time_point start) {
+	return std::chrono::duration<double, std::milli>(clock_type::now() - start)
+	    .count();
+}
+
+typedef std::vector<uint64_t>::iterator iterator;
+
+// 以函数对象统一 std 与各叉数的 mSTL 堆函数
+struct std_heap {
+	static void make(iterator first, iterator last) { std::make_heap(first, last); }
+	static void push(iterator first, iterator last) { std::push_heap(first, last); }
+	static void pop(iterator first, iterator last) { std::pop_heap(first, last); }
+	static bool check(iterator first, iterator last) {
+		return std::is_heap(first, last);
+	}
+};
+
+template <size_t Arity>
+struct mstl_heap {
+	static void make(iterator first, iterator last) {
+		mSTL::make_heap<Arity>(first, last);
+	}
+	static void push(iterator first, iterator last) {
+		mSTL::push_heap<Arity>(first, last);
+	}
+	static void pop(iterator first, iterator last) {
+		mSTL::pop_heap<Arity>(first, last);
+	}
+	static bool check(iterator first, iterator last) {
+		return mSTL::is_heap<Arity>(first, last);
+	}
+};
+
+template <class Heap>
+void compare(const char* name, const std::vector<uint64_t>& input, int rounds) {
+	double make_ms = 0, push_ms = 0, pop_ms = 0, queue_ms = 0;
+	for (int r = 0; r < rounds; ++r) {
+		std::vector<uint64_t> data(input);
+		auto                  start = clock_type::now();
+		Heap::make(data.begin(), data.end());
+		make_ms += elapsed_ms(start);
+
+		data.clear();
+		start = clock_type::now();
+		for (uint64_t value : input) {
+			data.push_back(value);
+			Heap::push(data.begin(), data.end());
+		}
+		push_ms += elapsed_ms(start);
+
+		// 定长优先队列: 弹出堆顶并压入比它大的新键 (类似事件调度)
+		std::mt19937_64 rng(static_cast<uint64_t>(r));
+		start = clock_type::now();
+		for (size_t i = 0; i < input.size(); ++i) {
+			Heap::pop(data.begin(), data.end());
+			data.back() += rng() % 1024;
+			Heap::push(data.begin(), data.end());
+		}
+		queue_ms += elapsed_ms(start);
+		if (!Heap::check(data.begin(), data.end()))
+			std::printf("not a heap\n");
+
+		start = clock_type::now();
+		for (iterator last = data.end(); last - data.begin() > 1; --last)
+			Heap::pop(data.begin(), last);
+		pop_ms += elapsed_ms(start);
+		if (!std::is_sorted(data.begin(), data.end()))
+			std::printf("not sorted\n");
+	}
+	std::printf("%12s %12.2f %12.2f %12.2f %12.2f\n", name, make_ms / rounds,
+	            push_ms / rounds, queue_ms / rounds, pop_ms / rounds);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+	size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1 << 22;
+	int    rounds = argc > 2 ? std::atoi(argv[2]) : 3;
+
+	std::vector<uint64_t> input(n);
+	std::mt19937_64       rng(46);
+	for (size_t i = 0; i < n; ++i)
+		input[i] = rng();
+
+	std::printf("n = %zu, rounds = %d (ms)\n", n, rounds);
+	std::printf("%12s %12s %12s %12s %12s\n", "heap", "make", "push", "queue",
+	            "pop");
+	compare<std_heap>("std", input, rounds);
+	compare<mstl_heap<2>>("mSTL 2-ary", input, rounds);
+	compare<mstl_heap<4>>("mSTL 4-ary", input, rounds);
+	compare<mstl_heap<8>>("mSTL 8-ary", input, rounds);
+	return 0;
+}
@@ -0,0 +1,132 @@
+// 最值与 clamp 的 SIMD 内核与 std 对比，逐指令集测量
+// 算法: min_element、max_element、minmax_element (各列为 simd 内核求最值的吞吐)、
+//       clamp (原地限制到 [lo, hi]，std 为逐元素 std::min(std::max(x, lo), hi))
+// 另给出 mSTL::max_element / minmax_element 的整体吞吐 (含块内定位下标)
+// 元素类型: uint8_t、int16_t、int32_t、int64_t、float、double
+// 各列为吞吐量 (GB/s)，处理器不支持的指令集显示 -
+// 参数: [元素个数] [重复次数]
+
+#include "../../src/algorithm.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+using mSTL::simd;
+
+volatile size_t sink;
+
+double elapsed_ms(clock_type::time_point start) {
+	return std::chrono::duration<double, std::milli>(clock_type::now() - start)
+	    .count();
+}
+
+// 每次调用处理 bytes 字节，返回 GB/s
+template <class Function>
+double run(size_t bytes, int rounds, Function f) {
+	auto start = clock_type::now();
+	for (int i = 0; i < rounds; ++i)
+		sink = sink + f();
+	return static_cast<double>(bytes) * rounds / (elapsed_ms(start) * 1e6);
+}
+
+template <class T, class Std, class Kernel>
+void row(const char* name, size_t bytes, int rounds, Std std_call,
+         Kernel kernel) {
+	std::printf("%16s %10.2f", name, run(bytes, rounds, std_call));
+	for (int level = simd::isa_scalar; level <= simd::isa_avx512; ++level) {
+		if (level > simd::max_scan_isa<T>()) {
+			std::printf(" %10s", "-");
+			continue;
+		}
+		simd::minmax_kernel_table<T> table =
+		    simd::minmax_kernels_for<T>(static_cast<simd::isa_level>(level));
+		std::printf(" %10.2f",
+		            run(bytes, rounds, [&]() { return kernel(table); }));
+	}
+	std::printf("\n");
+}
+
+template <class T>
+void compare(const char* type, size_t n, int rounds) {
+	typedef simd::minmax_kernel_table<T> kernels;
+
+	std::vector<T>  data(n);
+	std::mt19937_64 rng(50);
+	for (size_t i = 0; i < n; ++i)
+		data[i] = static_cast<T>(rng() % 100);
+	std::vector<T> work(data);
+	const T*       a = data.data();
+	T*             w = work.data();
+	const size_t   bytes = n * sizeof(T);
+	const T        lo = T(20), hi = T(80);
+
+	auto minmax = [&](const kernels& k) {
+		T low = T(), high = T();
+		k.minmax(a, n, &low, &high);
+		return static_cast<size_t>(low) + static_cast<size_t>(high);
+	};
+
+	std::printf("%s\n", type);
+	row<T>(
+	    "min_element", bytes, rounds,
+	    [&]() { return static_cast<size_t>(std::min_element(a, a + n) - a); },
+	    minmax);
+	row<T>(
+	    "max_element", bytes, rounds,
+	    [&]() { return static_cast<size_t>(std::max_element(a, a + n) - a); },
+	    minmax);
+	row<T>(
+	    "minmax_element", bytes, rounds,
+	    [&]() {
+		    return static_cast<size_t>(std::minmax_element(a, a + n).second - a);
+	    },
+	    minmax);
+	row<T>(
+	    "clamp", 2 * bytes, rounds,
+	    [&]() {
+		    for (size_t i = 0; i < n; ++i)
+			    w[i] = std::min(std::max(w[i], lo), hi);
+		    return static_cast<size_t>(w[0]);
+	    },
+	    [&](const kernels& k) {
+		    k.clamp(w, n, lo, hi);
+		    return static_cast<size_t>(w[0]);
+	    });
+	std::printf("%16s %10.2f\n", "mSTL::max",
+	            run(bytes, rounds, [&]() {
+		            return static_cast<size_t>(mSTL::max_element(a, a + n) - a);
+	            }));
+	std::printf("%16s %10.2f\n", "mSTL::minmax",
+	            run(bytes, rounds, [&]() {
+		            return static_cast<size_t>(
+		                mSTL::minmax_element(a, a + n).second - a);
+	            }));
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+	size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1 << 16;
+	int    rounds = argc > 2 ? std::atoi(argv[2]) : 1000;
+	if (n < 1)
+		n = 1;
+
+	std::printf("n = %zu, rounds = %d, GB/s\n", n, rounds);
+	std::printf("%16s %10s %10s %10s %10s %10s\n", "algorithm", "std",
+	            "scalar", "sse2", "avx2", "avx512");
+	compare<uint8_t>("uint8_t", n, rounds);
+	compare<int16_t>("int16_t", n, rounds);
+	compare<int32_t>("int32_t", n, rounds);
+	compare<int64_t>("int64_t", n, rounds);
+	compare<float>("float", n, rounds);
+	compare<double>("double", n, rounds);
+	return 0;
+}
@@ -0,0 +1,129 @@
+// 非临时存储拷贝对缓存污染的影响
+// 一个线程在常驻缓存的工作集上做随机指针追逐，另一线程反复拷贝大 vector
+// 对比关闭 / 开启 nontemporal 时: 拷贝耗时、拷贝期间工作集访问吞吐、拷贝后首次遍历工作集耗时
+// 参数: [拷贝数据 MB] [工作集 KB] [拷贝次数]
+
+#include "../../src/nontemporal.h"
+#include "../../src/vector.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+// 防止追逐结果被优化掉
+volatile uint32_t sink = 0;
+
+double elapsed_ms(clock_type::time_point start) {
+	return std::chrono::duration<double, std::milli>(clock_type::now() - start)
+	    .count();
+}
+
+// 单环随机排列，保证追逐遍历整个工作集
+std::vector<uint32_t> make_chain(size_t count) {
+	std::vector<uint32_t> order(count);
+	for (size_t i = 0; i < count; ++i)
+		order[i] = static_cast<uint32_t>(i);
+	std::mt19937 rng(12345);
+	for (size_t i = count - 1; i > 0; --i)
+		std::swap(order[i], order[rng() % (i + 1)]);
+
+	std::vector<uint32_t> next(count);
+	for (size_t i = 0; i < count; ++i)
+		next[order[i]] = order[(i + 1) % count];
+	return next;
+}
+
+uint32_t chase(const std::vector<uint32_t>& chain, uint32_t pos, size_t steps) {
+	for (size_t i = 0; i < steps; ++i)
+		pos = chain[pos];
+	return pos;
+}
+
+struct result {
+	double copy_ms;
+	double reader_steps_per_us;
+	double rescan_ms;
+};
+
+result run(size_t copy_bytes, const std::vector<uint32_t>& chain, int rounds) {
+	mSTL::vector<uint64_t> source(copy_bytes / sizeof(uint64_t), 1);
+
+	std::atomic<bool>   stop(false);
+	std::atomic<size_t> steps(0);
+	std::thread         reader([&]() {
+		uint32_t pos = 0;
+		while (!stop.load(std::memory_order_relaxed)) {
+			pos = chase(chain, pos, 4096);
+			steps.fetch_add(4096, std::memory_order_relaxed);
+		}
+		sink += pos;
+	});
+
+	// 预热工作集
+	sink += chase(chain, 0, chain.size() * 2);
+
+	double copy_ms = 0;
+	auto   start = clock_type::now();
+	for (int i = 0; i < rounds; ++i) {
+		auto                   copy_start = clock_type::now();
+		mSTL::vector<uint64_t> dest(source);
+		copy_ms += elapsed_ms(copy_start);
+		if (dest[dest.size() / 2] != 1)
+			std::printf("copy mismatch\n");
+	}
+	double total_us = elapsed_ms(start) * 1000;
+	stop.store(true);
+	reader.join();
+
+	// 单线程: 拷贝后首次遍历工作集的耗时
+	double rescan_ms = 0;
+	for (int i = 0; i < rounds; ++i) {
+		sink += chase(chain, 0, chain.size());
+		mSTL::vector<uint64_t> dest(source);
+		auto                   rescan_start = clock_type::now();
+		sink += chase(chain, static_cast<uint32_t>(dest[0]), chain.size());
+		rescan_ms += elapsed_ms(rescan_start);
+	}
+
+	result r = {copy_ms / rounds, steps.load() / total_us, rescan_ms / rounds};
+	return r;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+	size_t copy_mb = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 256;
+	size_t hot_kb = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 4096;
+	int    rounds = argc > 3 ? std::atoi(argv[3]) : 8;
+
+	std::vector<uint32_t> chain = make_chain(hot_kb * 1024 / sizeof(uint32_t));
+	size_t                old_threshold = mSTL::nontemporal::threshold();
+
+	std::printf("copy %zu MB x %d, hot set %zu KB, recommended threshold %zu KB\n",
+	            copy_mb, rounds, hot_kb,
+	            mSTL::nontemporal::recommended_threshold() / 1024);
+	std::printf("%14s %12s %22s %14s\n", "mode", "copy(ms)",
+	            "reader(steps/us)", "rescan(ms)");
+
+	mSTL::nontemporal::set_threshold(0);
+	result plain = run(copy_mb << 20, chain, rounds);
+	std::printf("%14s %12.2f %22.2f %14.3f\n", "memcpy", plain.copy_ms,
+	            plain.reader_steps_per_us, plain.rescan_ms);
+
+	mSTL::nontemporal::set_threshold(1 << 20);
+	result stream = run(copy_mb << 20, chain, rounds);
+	std::printf("%14s %12.2f %22.2f %14.3f\n", "nontemporal", stream.copy_ms,
+	            stream.reader_steps_per_us, stream.rescan_ms);
+
+	mSTL::nontemporal::set_threshold(old_threshold);
+	return 0;
+}
@@ -0,0 +1,76 @@
+// 并行排序 sort(par) / stable_sort(par) 与串行 mSTL::sort、std::sort、std::stable_sort 对比
+// 元素为随机 uint64_t 存于 mSTL::vector，线程数由 thread_pool::instance() 决定
+// 参数: [元素个数] [重复次数]
+
+#include "../../src/algorithm.h"
+#include "../../src/vector.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+double elapsed_ms(clock_type::time_point start) {
+	return std::chrono::duration<double, std::milli>(clock_type::now() - start)
+	    .count();
+}
+
+template <class Sort>
+double run(const mSTL::vector<uint64_t>& input, int rounds, Sort sort) {
+	double total = 0;
+	for (int i = 0; i < rounds; ++i) {
+		mSTL::vector<uint64_t> data(input);
+		auto                   start = clock_type::now();
+		sort(data.begin(), data.end());
+		total += elapsed_ms(start);
+		if (!std::is_sorted(data.begin(), data.end()))
+			std::printf("not sorted\n");
+	}
+	return total / rounds;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+	size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+	int    rounds = argc > 2 ? std::atoi(argv[2]) : 3;
+
+	typedef mSTL::vector<uint64_t>::iterator iterator;
+
+	mSTL::vector<uint64_t> input(n);
+	std::mt19937_64        rng(7);
+	for (size_t i = 0; i < n; ++i)
+		input[i] = rng();
+
+	std::printf("n = %zu, rounds = %d, threads = %zu\n", n, rounds,
+	            mSTL::thread_pool::instance().concurrency());
+	std::printf("%20s %12s\n", "algorithm", "time(ms)");
+
+	double serial = run(input, rounds, [](iterator first, iterator last) {
+		std::sort(first, last);
+	});
+	std::printf("%20s %12.2f\n", "std::sort", serial);
+	std::printf("%20s %12.2f\n", "mSTL::sort",
+	            run(input, rounds, [](iterator first, iterator last) {
+		            mSTL::sort(first, last);
+	            }));
+	std::printf("%20s %12.2f\n", "mSTL::sort(par)",
+	            run(input, rounds, [](iterator first, iterator last) {
+		            mSTL::sort(mSTL::par, first, last);
+	            }));
+	std::printf("%20s %12.2f\n", "std::stable_sort",
+	            run(input, rounds, [](iterator first, iterator last) {
+		            std::stable_sort(first, last);
+	            }));
+	std::printf("%20s %12.2f\n", "mSTL::stable_sort(par)",
+	            run(input, rounds, [](iterator first, iterator last) {
+		            mSTL::stable_sort(mSTL::par, first, last);
+	            }));
+	return 0;
+}
@@ -0,0 +1,104 @@
+// mSTL::radix_sort 与 mSTL::sort、std::sort 对比
+// 键类型: uint32_t、int64_t、double、按 double 键排序的结构体
+// 参数: [元素个数] [重复次数]
+
+#include "../../src/algorithm.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+struct record {
+	double   key;
+	uint64_t payload;
+};
+
+double elapsed_ms(clock_type::time_point start) {
+	return std::chrono::duration<double, std::milli>(clock_type::now() - start)
+	    .count();
+}
+
+template <class T, class Sort>
+double run(const std::vector<T>& input, int rounds, Sort sort) {
+	double total = 0;
+	for (int i = 0; i < rounds; ++i) {
+		std::vector<T> data(input);
+		auto           start = clock_type::now();
+		sort(data);
+		total += elapsed_ms(start);
+	}
+	return total / rounds;
+}
+
+template <class T>
+void compare(const char* name, const std::vector<T>& input, int rounds) {
+	double std_ms = run(input, rounds, [](std::vector<T>& data) {
+		std::sort(data.begin(), data.end());
+	});
+	double pdq_ms = run(input, rounds, [](std::vector<T>& data) {
+		mSTL::sort(data.begin(), data.end());
+	});
+	double radix_ms = run(input, rounds, [](std::vector<T>& data) {
+		mSTL::radix_sort(data.begin(), data.end());
+	});
+	double par_ms = run(input, rounds, [](std::vector<T>& data) {
+		mSTL::radix_sort(mSTL::par, data.begin(), data.end());
+	});
+	std::printf("%12s %12.2f %12.2f %12.2f %12.2f\n", name, std_ms, pdq_ms,
+	            radix_ms, par_ms);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+	size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+	int    rounds = argc > 2 ? std::atoi(argv[2]) : 3;
+
+	std::mt19937_64 rng(42);
+
+	std::vector<uint32_t> u32(n);
+	std::vector<int64_t>  i64(n);
+	std::vector<double>   f64(n);
+	std::vector<record>   records(n);
+	for (size_t i = 0; i < n; ++i) {
+		u32[i] = static_cast<uint32_t>(rng());
+		i64[i] = static_cast<int64_t>(rng());
+		f64[i] = static_cast<double>(static_cast<int64_t>(rng())) / 1e9;
+		records[i].key = f64[i];
+		records[i].payload = i;
+	}
+
+	std::printf("n = %zu, rounds = %d, threads = %zu\n", n, rounds,
+	            mSTL::thread_pool::instance().concurrency());
+	std::printf("%12s %12s %12s %12s %12s\n", "key", "std::sort", "mSTL::sort",
+	            "radix", "radix(par)");
+	compare("uint32_t", u32, rounds);
+	compare("int64_t", i64, rounds);
+	compare("double", f64, rounds);
+
+	auto   by_key = [](const record& a, const record& b) { return a.key < b.key; };
+	auto   key_of = [](const record& r) { return r.key; };
+	double std_ms = run(records, rounds, [&](std::vector<record>& data) {
+		std::sort(data.begin(), data.end(), by_key);
+	});
+	double pdq_ms = run(records, rounds, [&](std::vector<record>& data) {
+		mSTL::sort(data.begin(), data.end(), by_key);
+	});
+	double radix_ms = run(records, rounds, [&](std::vector<record>& data) {
+		mSTL::radix_sort(data.begin(), data.end(), key_of);
+	});
+	double par_ms = run(records, rounds, [&](std::vector<record>& data) {
+		mSTL::radix_sort(mSTL::par, data.begin(), data.end(), key_of);
+	});
+	std::printf("%12s %12.2f %12.2f %12.2f %12.2f\n", "record", std_ms, pdq_ms,
+	            radix_ms, par_ms);
+	return 0;
+}
@@ -0,0 +1,122 @@
+// 非修改序列算法的 SIMD 扫描内核与 std 对比，逐指令集测量
+// 算法: find (不命中，扫描整个区间)、count、mismatch (两区间相同)、
+//       adjacent_find (无相邻相等)、is_sorted (有序)、all_of (x < 2，全部满足)
+// 元素类型: uint8_t、int16_t、int32_t、int64_t、float、double
+// 各列为吞吐量 (GB/s)，处理器不支持的指令集显示 -
+// 参数: [元素个数] [重复次数]
+
+#include "../../src/algorithm.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+using mSTL::simd;
+
+volatile size_t sink;
+
+double elapsed_ms(clock_type::time_point start) {
+	return std::chrono::duration<double, std::milli>(clock_type::now() - start)
+	    .count();
+}
+
+// 每次调用读取 bytes 字节，返回 GB/s
+template <class Function>
+double run(size_t bytes, int rounds, Function f) {
+	auto start = clock_type::now();
+	for (int i = 0; i < rounds; ++i)
+		sink = sink + f();
+	return static_cast<double>(bytes) * rounds / (elapsed_ms(start) * 1e6);
+}
+
+template <class T, int Op, class Std, class Kernel>
+void row(const char* name, size_t bytes, int rounds, Std std_call,
+         Kernel kernel) {
+	std::printf("%16s %10.2f", name, run(bytes, rounds, std_call));
+	for (int level = simd::isa_scalar; level <= simd::isa_avx512; ++level) {
+		if (level > simd::max_scan_isa<T>()) {
+			std::printf(" %10s", "-");
+			continue;
+		}
+		simd::scan_kernel_table<T, Op> table =
+		    simd::scan_kernels_for<T, Op>(static_cast<simd::isa_level>(level));
+		std::printf(" %10.2f",
+		            run(bytes, rounds, [&]() { return kernel(table); }));
+	}
+	std::printf("\n");
+}
+
+template <class T>
+void compare(const char* type, size_t n, int rounds) {
+	typedef simd::scan_kernel_table<T, simd::op_eq> eq_kernels;
+	typedef simd::scan_kernel_table<T, simd::op_lt> lt_kernels;
+
+	std::vector<T> alternating(n);
+	std::vector<T> sorted(n);
+	for (size_t i = 0; i < n; ++i) {
+		alternating[i] = static_cast<T>(i % 2);
+		sorted[i] = static_cast<T>(i * 100 / n);
+	}
+	std::vector<T> copy(alternating);
+	const T*       a = alternating.data();
+	const T*       b = copy.data();
+	const T*       s = sorted.data();
+	const size_t   bytes = n * sizeof(T);
+
+	std::printf("%s\n", type);
+	row<T, simd::op_eq>(
+	    "find", bytes, rounds,
+	    [&]() { return static_cast<size_t>(std::find(a, a + n, T(3)) - a); },
+	    [&](const eq_kernels& k) { return k.find(a, n, T(3), false); });
+	row<T, simd::op_eq>(
+	    "count", bytes, rounds,
+	    [&]() { return static_cast<size_t>(std::count(a, a + n, T(1))); },
+	    [&](const eq_kernels& k) { return k.count(a, n, T(1)); });
+	row<T, simd::op_eq>(
+	    "mismatch", 2 * bytes, rounds,
+	    [&]() {
+		    return static_cast<size_t>(std::mismatch(a, a + n, b).first - a);
+	    },
+	    [&](const eq_kernels& k) { return k.find_pair(a, b, n, true); });
+	row<T, simd::op_eq>(
+	    "adjacent_find", bytes, rounds,
+	    [&]() { return static_cast<size_t>(std::adjacent_find(a, a + n) - a); },
+	    [&](const eq_kernels& k) { return k.find_pair(a, a + 1, n - 1, false); });
+	row<T, simd::op_lt>(
+	    "is_sorted", bytes, rounds,
+	    [&]() { return static_cast<size_t>(std::is_sorted(s, s + n)); },
+	    [&](const lt_kernels& k) { return k.find_pair(s + 1, s, n - 1, false); });
+	row<T, simd::op_lt>(
+	    "all_of", bytes, rounds,
+	    [&]() {
+		    return static_cast<size_t>(
+		        std::all_of(a, a + n, [](T x) { return x < T(2); }));
+	    },
+	    [&](const lt_kernels& k) { return k.find(a, n, T(2), true); });
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+	size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1 << 16;
+	int    rounds = argc > 2 ? std::atoi(argv[2]) : 1000;
+	if (n < 2)
+		n = 2;
+
+	std::printf("n = %zu, rounds = %d, GB/s\n", n, rounds);
+	std::printf("%16s %10s %10s %10s %10s %10s\n", "algorithm", "std",
+	            "scalar", "sse2", "avx2", "avx512");
+	compare<uint8_t>("uint8_t", n, rounds);
+	compare<int16_t>("int16_t", n, rounds);
+	compare<int32_t>("int32_t", n, rounds);
+	compare<int64_t>("int64_t", n, rounds);
+	compare<float>("float", n, rounds);
+	compare<double>("double", n, rounds);
+	return 0;
+}
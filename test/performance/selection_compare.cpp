@@ -0,0 +1,85 @@
+// 选择算法与 std 实现及全排序对比
+// nth_element (中位数)、partial_sort (k = 100 / N/2)、top_k (k = 100) 与 std::partial_sort、std::sort
+// 元素为随机 int32_t / double，以指针调用使 top_k 走 SIMD 过滤
+// 参数: [元素个数] [重复次数]
+
+#include "../../src/algorithm.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <vector>
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+double elapsed_ms(clock_type::time_point start) {
+	return std::chrono::duration<double, std::milli>(clock_type::now() - start)
+	    .count();
+}
+
+template <class T, class Select>
+double run(const std::vector<T>& input, int rounds, Select select) {
+	double total = 0;
+	for (int i = 0; i < rounds; ++i) {
+		std::vector<T> data(input);
+		auto           start = clock_type::now();
+		select(data.data(), data.data() + data.size());
+		total += elapsed_ms(start);
+	}
+	return total / rounds;
+}
+
+template <class T>
+void compare(const char* name, const std::vector<T>& input, int rounds) {
+	const size_t n = input.size();
+	const size_t k = n < 100 ? n : 100;
+
+	std::printf("%s\n", name);
+	std::printf("%24s %12.2f\n", "std::sort", run(input, rounds, [](T* f, T* l) {
+		            std::sort(f, l);
+	            }));
+	std::printf("%24s %12.2f\n", "std::nth_element",
+	            run(input, rounds,
+	                [n](T* f, T* l) { std::nth_element(f, f + n / 2, l); }));
+	std::printf("%24s %12.2f\n", "mSTL::nth_element",
+	            run(input, rounds,
+	                [n](T* f, T* l) { mSTL::nth_element(f, f + n / 2, l); }));
+	std::printf("%24s %12.2f\n", "std::partial_sort(N/2)",
+	            run(input, rounds,
+	                [n](T* f, T* l) { std::partial_sort(f, f + n / 2, l); }));
+	std::printf("%24s %12.2f\n", "mSTL::partial_sort(N/2)",
+	            run(input, rounds,
+	                [n](T* f, T* l) { mSTL::partial_sort(f, f + n / 2, l); }));
+	std::printf("%24s %12.2f\n", "std::partial_sort(100)",
+	            run(input, rounds, [k](T* f, T* l) {
+		            std::partial_sort(f, f + k, l, std::greater<T>());
+	            }));
+	std::printf("%24s %12.2f\n", "mSTL::top_k(100)",
+	            run(input, rounds, [k](T* f, T* l) { mSTL::top_k(f, l, k); }));
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+	size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+	int    rounds = argc > 2 ? std::atoi(argv[2]) : 3;
+
+	std::mt19937_64      rng(45);
+	std::vector<int32_t> ints(n);
+	std::vector<double>  doubles(n);
+	for (size_t i = 0; i < n; ++i) {
+		ints[i] = static_cast<int32_t>(rng());
+		doubles[i] = static_cast<double>(static_cast<int64_t>(rng())) / 1e9;
+	}
+
+	std::printf("n = %zu, rounds = %d (ms)\n", n, rounds);
+	compare("int32_t", ints, rounds);
+	compare("double", doubles, rounds);
+	return 0;
+}
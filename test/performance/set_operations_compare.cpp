@@ -0,0 +1,130 @@
+// 有序区间集合操作对比
+// 倒排表求交: 两个严格递增的 uint32_t 数组，长度比 1 ~ 1000，
+//   std::set_intersection、mSTL::set_intersection (倍增查找) 与 simd::intersect_sorted
+// k 路合并: mSTL::multiway_merge (败者树) 与基于 std::priority_queue 的合并
+// 参数: [较长数组元素个数] [重复次数]
+
+#include "../../src/algorithm.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <queue>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+double elapsed_ms(clock_type::time_point start) {
+	return std::chrono::duration<double, std::milli>(clock_type::now() - start)
+	    .count();
+}
+
+// n 个互不相同的有序文档号，取自 [0, universe)
+std::vector<uint32_t> posting_list(size_t n, uint32_t universe,
+                                   std::mt19937& rng) {
+	std::vector<uint32_t> list(n);
+	for (size_t i = 0; i < n; ++i)
+		list[i] = static_cast<uint32_t>(rng() % universe);
+	std::sort(list.begin(), list.end());
+	list.erase(std::unique(list.begin(), list.end()), list.end());
+	return list;
+}
+
+template <class Intersect>
+double run(int rounds, Intersect intersect) {
+	double total = 0;
+	for (int i = 0; i < rounds; ++i) {
+		auto start = clock_type::now();
+		intersect();
+		total += elapsed_ms(start);
+	}
+	return total / rounds;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+	size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4000000;
+	int    rounds = argc > 2 ? std::atoi(argv[2]) : 5;
+
+	std::mt19937   rng(47);
+	const uint32_t universe = static_cast<uint32_t>(n * 4);
+	std::printf("n = %zu, rounds = %d (ms)\n", n, rounds);
+	std::printf("%8s %12s %12s %12s %10s\n", "ratio", "std", "mSTL", "simd",
+	            "matches");
+
+	const size_t ratios[] = {1, 4, 16, 100, 1000};
+	for (size_t ratio : ratios) {
+		std::vector<uint32_t> large = posting_list(n, universe, rng);
+		std::vector<uint32_t> small = posting_list(n / ratio, universe, rng);
+		std::vector<uint32_t> out(small.size());
+		size_t                matches = 0;
+
+		double std_ms = run(rounds, [&]() {
+			matches = std::set_intersection(small.begin(), small.end(),
+			                                large.begin(), large.end(),
+			                                out.begin()) -
+			          out.begin();
+		});
+		double mstl_ms = run(rounds, [&]() {
+			mSTL::set_intersection(small.data(), small.data() + small.size(),
+			                       large.data(), large.data() + large.size(),
+			                       out.data());
+		});
+		double simd_ms = run(rounds, [&]() {
+			mSTL::simd::intersect_sorted(small.data(), small.size(), large.data(),
+			                             large.size(), out.data());
+		});
+		std::printf("%8zu %12.3f %12.3f %12.3f %10zu\n", ratio, std_ms, mstl_ms,
+		            simd_ms, matches);
+	}
+
+	std::printf("\n%8s %12s %12s\n", "k", "heap", "loser tree");
+	const size_t ks[] = {4, 16, 64, 256};
+	for (size_t k : ks) {
+		std::vector<std::vector<uint32_t>> lists(k);
+		size_t                             total = 0;
+		for (size_t i = 0; i < k; ++i) {
+			lists[i] = posting_list(n / k, universe, rng);
+			total += lists[i].size();
+		}
+		typedef std::vector<uint32_t>::const_iterator iterator;
+		std::vector<uint32_t>                         out(n);
+
+		double heap_ms = run(rounds, [&]() {
+			typedef std::pair<uint32_t, size_t> head; // (值, 列表序号)
+			std::priority_queue<head, std::vector<head>, std::greater<head>> heads;
+			std::vector<iterator> cursors(k);
+			for (size_t i = 0; i < k; ++i) {
+				cursors[i] = lists[i].begin();
+				if (cursors[i] != lists[i].end())
+					heads.push(head(*cursors[i], i));
+			}
+			uint32_t* result = out.data();
+			while (!heads.empty()) {
+				size_t i = heads.top().second;
+				heads.pop();
+				*result++ = *cursors[i];
+				if (++cursors[i] != lists[i].end())
+					heads.push(head(*cursors[i], i));
+			}
+		});
+		double tree_ms = run(rounds, [&]() {
+			std::vector<std::pair<iterator, iterator>> ranges(k);
+			for (size_t i = 0; i < k; ++i)
+				ranges[i] = std::make_pair(lists[i].cbegin(), lists[i].cend());
+			mSTL::multiway_merge(ranges.begin(), ranges.end(), out.data());
+		});
+		if (!std::is_sorted(out.begin(), out.begin() + total))
+			std::printf("not sorted\n");
+		std::printf("%8zu %12.3f %12.3f\n", k, heap_ms, tree_ms);
+	}
+	return 0;
+}
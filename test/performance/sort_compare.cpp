@@ -0,0 +1,94 @@
+// mSTL::sort (pdqsort) 与 std::sort 对比
+// 输入分布: 有序、逆序、锯齿、随机、少量不同值，元素为 int / std::string
+// 参数: [元素个数] [重复次数]
+
+#include "../../src/algorithm.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+double elapsed_ms(clock_type::time_point start) {
+	return std::chrono::duration<double, std::milli>(clock_type::now() - start)
+	    .count();
+}
+
+std::vector<int> make_input(const char* pattern, size_t n) {
+	std::vector<int> data(n);
+	std::mt19937     rng(2024);
+	std::string      name(pattern);
+	for (size_t i = 0; i < n; ++i) {
+		if (name == "sorted")
+			data[i] = static_cast<int>(i);
+		else if (name == "reverse")
+			data[i] = static_cast<int>(n - i);
+		else if (name == "sawtooth")
+			data[i] = static_cast<int>(i % 1024);
+		else if (name == "few_unique")
+			data[i] = static_cast<int>(rng() % 16);
+		else
+			data[i] = static_cast<int>(rng());
+	}
+	return data;
+}
+
+template <class T, class Sort>
+double run(const std::vector<T>& input, int rounds, Sort sort) {
+	double total = 0;
+	for (int i = 0; i < rounds; ++i) {
+		std::vector<T> data(input);
+		auto           start = clock_type::now();
+		sort(data.begin(), data.end());
+		total += elapsed_ms(start);
+		if (!std::is_sorted(data.begin(), data.end()))
+			std::printf("not sorted\n");
+	}
+	return total / rounds;
+}
+
+template <class T>
+void compare(const char* name, const std::vector<T>& input, int rounds) {
+	typedef typename std::vector<T>::iterator iterator;
+	double std_ms = run(input, rounds, [](iterator first, iterator last) {
+		std::sort(first, last);
+	});
+	double mstl_ms = run(input, rounds, [](iterator first, iterator last) {
+		mSTL::sort(first, last);
+	});
+	std::printf("%18s %12.3f %12.3f %10.2fx\n", name, std_ms, mstl_ms,
+	            std_ms / mstl_ms);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+	size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+	int    rounds = argc > 2 ? std::atoi(argv[2]) : 5;
+
+	const char* patterns[] = {"sorted", "reverse", "sawtooth", "random",
+	                          "few_unique"};
+
+	std::printf("n = %zu, rounds = %d\n", n, rounds);
+	std::printf("%18s %12s %12s %11s\n", "input", "std(ms)", "mSTL(ms)",
+	            "speedup");
+	for (const char* pattern : patterns)
+		compare((std::string("int ") + pattern).c_str(), make_input(pattern, n),
+		        rounds);
+
+	for (const char* pattern : patterns) {
+		std::vector<int>         keys = make_input(pattern, n / 10);
+		std::vector<std::string> words(keys.size());
+		for (size_t i = 0; i < keys.size(); ++i)
+			words[i] = "key_" + std::to_string(keys[i]);
+		compare((std::string("string ") + pattern).c_str(), words, rounds);
+	}
+	return 0;
+}
@@ -0,0 +1,109 @@
+// mSTL::stable_sort (TimSort) 与 std::stable_sort 对比
+// 输入分布: 随机、有序、逆序、几乎有序 (时间序日志，局部乱序)、若干有序段拼接、升降段交替
+// 元素为 (时间戳, 序号) 记录，按时间戳比较
+// 参数: [元素个数] [重复次数]
+
+#include "../../src/algorithm.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+struct entry {
+	int64_t  timestamp;
+	uint32_t sequence;
+};
+
+struct by_timestamp {
+	bool operator()(const entry& a, const entry& b) const {
+		return a.timestamp < b.timestamp;
+	}
+};
+
+double elapsed_ms(clock_type::time_point start) {
+	return std::chrono::duration<double, std::milli>(clock_type::now() - start)
+	    .count();
+}
+
+std::vector<entry> make_input(const std::string& pattern, size_t n) {
+	std::vector<entry> data(n);
+	std::mt19937_64    rng(99);
+	int64_t            value = 0;
+	int64_t            step = 1;
+	for (size_t i = 0; i < n; ++i) {
+		if (pattern == "random")
+			value = static_cast<int64_t>(rng() % (n * 4));
+		else if (pattern == "sorted")
+			value = static_cast<int64_t>(i);
+		else if (pattern == "reverse")
+			value = static_cast<int64_t>(n - i);
+		else if (pattern == "nearly_sorted")
+			// 时间序日志: 时间戳递增，每个元素偏离有序位置不超过 64
+			value = static_cast<int64_t>(i * 16 + rng() % 1024);
+		else if (pattern == "runs") {
+			// 每 10000 个元素一段有序数据，段起点随机
+			if (i % 10000 == 0)
+				value = static_cast<int64_t>(rng() % (n * 4));
+			value += static_cast<int64_t>(rng() % 8);
+		} else {
+			// 升降交替的段
+			if (i % 5000 == 0)
+				step = -step;
+			value += step * static_cast<int64_t>(rng() % 8);
+		}
+		data[i].timestamp = value;
+		data[i].sequence = static_cast<uint32_t>(i);
+	}
+	return data;
+}
+
+template <class Sort>
+double run(const std::vector<entry>& input, int rounds, Sort sort) {
+	double total = 0;
+	for (int i = 0; i < rounds; ++i) {
+		std::vector<entry> data(input);
+		auto               start = clock_type::now();
+		sort(data.begin(), data.end());
+		total += elapsed_ms(start);
+		if (!std::is_sorted(data.begin(), data.end(), by_timestamp()))
+			std::printf("not sorted\n");
+	}
+	return total / rounds;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+	size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+	int    rounds = argc > 2 ? std::atoi(argv[2]) : 5;
+
+	typedef std::vector<entry>::iterator iterator;
+
+	const char* patterns[] = {"random",        "sorted", "reverse",
+	                          "nearly_sorted", "runs",   "zigzag"};
+
+	std::printf("n = %zu, rounds = %d\n", n, rounds);
+	std::printf("%16s %18s %18s %10s\n", "input", "std::stable_sort(ms)",
+	            "mSTL(ms)", "speedup");
+	for (const char* pattern : patterns) {
+		std::vector<entry> input = make_input(pattern, n);
+		double std_ms = run(input, rounds, [](iterator first, iterator last) {
+			std::stable_sort(first, last, by_timestamp());
+		});
+		double mstl_ms = run(input, rounds, [](iterator first, iterator last) {
+			mSTL::stable_sort(first, last, by_timestamp());
+		});
+		std::printf("%16s %18.3f %18.3f %9.2fx\n", pattern, std_ms, mstl_ms,
+		            std_ms / mstl_ms);
+	}
+	return 0;
+}
@@ -0,0 +1,1437 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "test_basic.h"
+
+#include "../include/doctest.h"
+#include "../src/algorithm.h"
+#include "../src/array.h"
+#include "../src/vector.h"
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <functional>
+#include <list>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+MSTL_TEST_NAMESPACE_BEGIN
+
+// 小值域随机数据使查找能够命中，前缀有序使 is_sorted_until 落在中间
+template <class T>
+std::vector<T> scan_input(size_t n, int range, std::mt19937& rng) {
+	std::vector<T> data(n);
+	for (size_t i = 0; i < n; ++i)
+		data[i] = static_cast<T>(static_cast<int>(rng() % range) - range / 4);
+	std::sort(data.begin(), data.begin() + rng() % (n + 1));
+	return data;
+}
+
+template <class T>
+void check_scan(std::mt19937& rng) {
+	const size_t sizes[] = {0, 1, 2, 15, 16, 17, 63, 64, 65, 130, 1000};
+	for (size_t n : sizes) {
+		for (int range : {3, 40, 1000}) {
+			std::vector<T> data = scan_input<T>(n, range, rng);
+			std::deque<T>  deq(data.begin(), data.end());
+			const T*       first = data.data();
+			const T*       last = first + n;
+			const T        value = n == 0 ? T(1) : data[rng() % n];
+			const T        limit = static_cast<T>(range / 2);
+
+			CHECK(mSTL::find(first, last, value) == std::find(first, last, value));
+			CHECK(mSTL::count(first, last, value) == std::count(first, last, value));
+			CHECK(mSTL::count(deq.begin(), deq.end(), value) ==
+			      std::count(first, last, value));
+
+			auto less = mSTL::compare_with(std::less<T>(), limit);
+			auto not_equal = mSTL::compare_with(std::not_equal_to<T>(), value);
+			auto at_least = mSTL::compare_with(std::greater_equal<T>(), limit);
+			CHECK(mSTL::find_if(first, last, less) ==
+			      std::find_if(first, last, less));
+			CHECK(mSTL::find_if(first, last, at_least) ==
+			      std::find_if(first, last, at_least));
+			CHECK(mSTL::find_if_not(first, last, not_equal) ==
+			      std::find_if_not(first, last, not_equal));
+			CHECK(mSTL::find_if(deq.begin(), deq.end(), at_least) - deq.begin() ==
+			      std::find_if(first, last, at_least) - first);
+			CHECK(mSTL::count_if(first, last, less) ==
+			      std::count_if(first, last, less));
+			CHECK(mSTL::all_of(first, last, less) == std::all_of(first, last, less));
+			CHECK(mSTL::any_of(first, last, at_least) ==
+			      std::any_of(first, last, at_least));
+			CHECK(mSTL::none_of(first, last, not_equal) ==
+			      std::none_of(first, last, not_equal));
+
+			std::vector<T> other(data);
+			if (n != 0)
+				other[rng() % n] = static_cast<T>(range + 1);
+			CHECK(mSTL::mismatch(first, last, other.data()) ==
+			      std::mismatch(first, last, other.data()));
+			CHECK(mSTL::mismatch(first, last, other.data(), std::less_equal<T>()) ==
+			      std::mismatch(first, last, other.data(), std::less_equal<T>()));
+			CHECK(mSTL::mismatch(deq.begin(), deq.end(), other.begin()).second -
+			          other.begin() ==
+			      std::mismatch(first, last, other.data()).second - other.data());
+
+			CHECK(mSTL::adjacent_find(first, last) ==
+			      std::adjacent_find(first, last));
+			CHECK(mSTL::adjacent_find(first, last, std::greater<T>()) ==
+			      std::adjacent_find(first, last, std::greater<T>()));
+			CHECK(mSTL::adjacent_find(deq.begin(), deq.end()) - deq.begin() ==
+			      std::adjacent_find(first, last) - first);
+
+			for (int count = 0; count <= 4; ++count) {
+				CHECK(mSTL::search_n(first, last, count, value) ==
+				      std::search_n(first, last, count, value));
+				CHECK(mSTL::search_n(first, last, count, limit, std::less<T>()) ==
+				      std::search_n(first, last, count, limit, std::less<T>()));
+				CHECK(mSTL::search_n(deq.begin(), deq.end(), count, value) -
+				          deq.begin() ==
+				      std::search_n(first, last, count, value) - first);
+			}
+
+			CHECK(mSTL::is_sorted_until(first, last) ==
+			      std::is_sorted_until(first, last));
+			CHECK(mSTL::is_sorted_until(first, last, std::greater<T>()) ==
+			      std::is_sorted_until(first, last, std::greater<T>()));
+			CHECK(mSTL::is_sorted_until(deq.begin(), deq.end()) - deq.begin() ==
+			      std::is_sorted_until(first, last) - first);
+			CHECK(mSTL::is_sorted(first, last) == std::is_sorted(first, last));
+		}
+	}
+}
+
+TEST_CASE(" non-modifying sequence operations ") {
+	std::mt19937 rng(49);
+
+	SUBCASE(" arithmetic types ") {
+		check_scan<int8_t>(rng);
+		check_scan<uint8_t>(rng);
+		check_scan<char>(rng);
+		check_scan<int16_t>(rng);
+		check_scan<uint16_t>(rng);
+		check_scan<int>(rng);
+		check_scan<unsigned>(rng);
+		check_scan<int64_t>(rng);
+		check_scan<uint64_t>(rng);
+		check_scan<float>(rng);
+		check_scan<double>(rng);
+	}
+
+	SUBCASE(" NaN && mixed types ") {
+		std::vector<double> data(100, 1.0);
+		data[40] = std::nan("");
+		data[70] = 0.5;
+		const double* first = data.data();
+		const double* last = first + data.size();
+		CHECK(mSTL::find(first, last, std::nan("")) == last);
+		CHECK(mSTL::count(first, last, 1.0) == 98);
+		CHECK(mSTL::find_if_not(first, last,
+		                        mSTL::compare_with(std::less_equal<double>(), 1.0)) ==
+		      first + 40);
+		CHECK(mSTL::find_if(first, last,
+		                    mSTL::compare_with(std::not_equal_to<double>(), 1.0)) ==
+		      first + 40);
+		CHECK(mSTL::is_sorted_until(first, last) == first + 70);
+		CHECK(mSTL::mismatch(first, last, first).first == first + 40);
+		CHECK(mSTL::adjacent_find(first + 40, last) == first + 41);
+
+		// value 与元素类型不同时按 *it == value 比较，不截断 value
+		std::vector<uint8_t> bytes(64, 0);
+		bytes[50] = 44;
+		CHECK(mSTL::find(bytes.data(), bytes.data() + 64, 256 + 44) ==
+		      bytes.data() + 64);
+		CHECK(mSTL::count(bytes.data(), bytes.data() + 64, 256) == 0);
+		std::vector<int> ints(64, 3);
+		CHECK(mSTL::find(ints.data(), ints.data() + 64, 3.5) == ints.data() + 64);
+		CHECK(mSTL::search_n(ints.data(), ints.data() + 64, 64, 3L) == ints.data());
+
+		// 任意谓词走标量路径
+		CHECK(mSTL::find_if(ints.begin(), ints.end(),
+		                    [](int x) { return x % 3 == 1; }) == ints.end());
+		CHECK(mSTL::all_of(ints.begin(), ints.end(),
+		                   [](int x) { return x == 3; }));
+	}
+
+	SUBCASE(" kernels of each isa ") {
+		typedef mSTL::simd simd;
+		std::vector<float>    floats = scan_input<float>(999, 50, rng);
+		std::vector<uint64_t> words = scan_input<uint64_t>(999, 50, rng);
+		std::vector<int8_t>   bytes = scan_input<int8_t>(999, 50, rng);
+		floats[500] = std::nan("");
+		for (int level = simd::isa_scalar; level <= simd::isa_avx512; ++level) {
+			simd::isa_level isa = static_cast<simd::isa_level>(level);
+			for (size_t n = 0; n < floats.size(); n += 37) {
+				CHECK(simd::scan_kernels_for<float, simd::op_lt>(isa).find(
+				          floats.data(), n, 3.0f, true) ==
+				      static_cast<size_t>(
+				          std::find_if(floats.begin(), floats.begin() + n,
+				                       [](float x) { return !(x < 3.0f); }) -
+				          floats.begin()));
+				CHECK(simd::scan_kernels_for<uint64_t, simd::op_ge>(isa).count(
+				          words.data(), n, 20) ==
+				      static_cast<size_t>(
+				          std::count_if(words.begin(), words.begin() + n,
+				                        [](uint64_t x) { return x >= 20; })));
+				size_t adjacent = static_cast<size_t>(
+				    std::adjacent_find(bytes.begin(), bytes.begin() + n + 1,
+				                       std::less<int8_t>()) -
+				    bytes.begin());
+				CHECK(simd::scan_kernels_for<int8_t, simd::op_gt>(isa).find_pair(
+				          bytes.data() + 1, bytes.data(), n, false) ==
+				      std::min(adjacent, n));
+			}
+		}
+	}
+}
+
+// 各种典型分布的输入
+std::vector<std::vector<int>> sort_inputs(size_t n) {
+	std::vector<std::vector<int>> inputs;
+	std::mt19937                  rng(static_cast<unsigned>(n) * 7 + 1);
+
+	std::vector<int> data(n);
+	for (size_t i = 0; i < n; ++i)
+		data[i] = static_cast<int>(rng());
+	inputs.push_back(data); // random
+
+	for (size_t i = 0; i < n; ++i)
+		data[i] = static_cast<int>(i);
+	inputs.push_back(data); // sorted
+	std::reverse(data.begin(), data.end());
+	inputs.push_back(data); // reverse
+
+	for (size_t i = 0; i < n; ++i)
+		data[i] = static_cast<int>(i % 97);
+	inputs.push_back(data); // sawtooth
+
+	for (size_t i = 0; i < n; ++i)
+		data[i] = static_cast<int>(rng() % 4);
+	inputs.push_back(data); // few unique
+
+	for (size_t i = 0; i < n; ++i)
+		data[i] = 42;
+	inputs.push_back(data); // all equal
+
+	for (size_t i = 0; i < n; ++i)
+		data[i] = static_cast<int>(i < n / 2 ? i * 2 : (n - i) * 2 + 1);
+	inputs.push_back(data); // organ pipe
+
+	for (size_t i = 0; i < n; ++i)
+		data[i] = static_cast<int>(i);
+	for (size_t i = 0; i < n / 100 + 1 && n > 1; ++i)
+		std::swap(data[rng() % n], data[rng() % n]);
+	inputs.push_back(data); // nearly sorted
+
+	return inputs;
+}
+
+TEST_CASE(" sort ") {
+	const size_t sizes[] = {0, 1, 2, 3, 23, 24, 25, 128, 129, 1000, 50000};
+	for (size_t n : sizes) {
+		for (const std::vector<int>& input : sort_inputs(n)) {
+			std::vector<int> expect(input);
+			std::sort(expect.begin(), expect.end());
+
+			std::vector<int> data(input);
+			mSTL::sort(data.begin(), data.end());
+			CHECK(data == expect);
+
+			// 降序走无分支划分，自定义比较器走普通划分
+			std::sort(expect.begin(), expect.end(), std::greater<int>());
+			data = input;
+			mSTL::sort(data.begin(), data.end(), std::greater<int>());
+			CHECK(data == expect);
+
+			data = input;
+			mSTL::sort(data.begin(), data.end(),
+			           [](int a, int b) { return a > b; });
+			CHECK(data == expect);
+		}
+	}
+
+	SUBCASE(" other iterators && types ") {
+		std::mt19937 rng(3);
+
+		mSTL::vector<double> values;
+		for (int i = 0; i < 10000; ++i)
+			values.push_back(static_cast<double>(rng() % 1000) / 7);
+		std::vector<double> expect(values.begin(), values.end());
+		std::sort(expect.begin(), expect.end());
+		mSTL::sort(values.begin(), values.end());
+		CHECK(std::equal(expect.begin(), expect.end(), values.begin()));
+
+		std::deque<std::string> words;
+		for (int i = 0; i < 3000; ++i)
+			words.push_back(std::to_string(rng() % 500));
+		std::vector<std::string> expect_words(words.begin(), words.end());
+		std::sort(expect_words.begin(), expect_words.end());
+		mSTL::sort(words.begin(), words.end());
+		CHECK(std::equal(expect_words.begin(), expect_words.end(), words.begin()));
+
+		int raw[] = {5, 3, 9, 1, 1, 8};
+		mSTL::sort(raw, raw + 6);
+		CHECK(std::is_sorted(raw, raw + 6));
+	}
+
+	SUBCASE(" adversarial && comparison count ") {
+		// 比较次数为 O(NlogN)：枢轴始终选到极值时应由打乱与堆排序兜底
+		const size_t n = 1 << 16;
+		std::vector<std::vector<int>> inputs = sort_inputs(n);
+
+		// median-of-3 killer
+		std::vector<int> killer(n);
+		for (size_t i = 0; i < n / 2; ++i) {
+			killer[2 * i] = static_cast<int>(i + 1);
+			killer[2 * i + 1] = static_cast<int>(n / 2 + i + 1);
+		}
+		inputs.push_back(killer);
+
+		for (const std::vector<int>& input : inputs) {
+			std::vector<int> data(input);
+			size_t           comparisons = 0;
+			mSTL::sort(data.begin(), data.end(), [&](int a, int b) {
+				++comparisons;
+				return a < b;
+			});
+			CHECK(std::is_sorted(data.begin(), data.end()));
+			CHECK(comparisons < 4 * n * 16);
+		}
+
+		// 堆排序兜底
+		for (const std::vector<int>& input : inputs) {
+			std::vector<int> data(input);
+			mSTL::_heap_sort(data.begin(), data.end(), std::less<int>());
+			CHECK(std::is_sorted(data.begin(), data.end()));
+		}
+
+		// 有序 / 逆序 / 全等输入为线性
+		const size_t linear[] = {1, 2, 5};
+		for (size_t k : linear) {
+			std::vector<int> data(inputs[k]);
+			size_t           comparisons = 0;
+			mSTL::sort(data.begin(), data.end(), [&](int a, int b) {
+				++comparisons;
+				return a < b;
+			});
+			CHECK(comparisons < 4 * n);
+		}
+	}
+}
+
+TEST_CASE(" stable_sort ") {
+	auto by_key = [](const std::pair<int, int>& a, const std::pair<int, int>& b) {
+		return a.first < b.first;
+	};
+
+	const size_t sizes[] = {0, 1, 2, 63, 64, 65, 1000, 5000, 100000};
+	for (size_t n : sizes) {
+		for (const std::vector<int>& keys : sort_inputs(n)) {
+			// 键的取值较少，检查相等元素的相对顺序
+			std::vector<std::pair<int, int>> input(n);
+			for (size_t i = 0; i < n; ++i)
+				input[i] = std::make_pair(keys[i] % 1000, static_cast<int>(i));
+
+			std::vector<std::pair<int, int>> expect(input);
+			std::stable_sort(expect.begin(), expect.end(), by_key);
+
+			std::vector<std::pair<int, int>> data(input);
+			mSTL::stable_sort(data.begin(), data.end(), by_key);
+			CHECK(data == expect);
+		}
+	}
+
+	SUBCASE(" run structured ") {
+		// 若干有序段拼接、整体有序后局部乱序、降序段与升序段交替
+		std::mt19937     rng(21);
+		std::vector<int> data;
+		for (int run = 0; run < 50; ++run) {
+			int start = static_cast<int>(rng() % 100000);
+			int length = static_cast<int>(rng() % 3000);
+			for (int i = 0; i < length; ++i)
+				data.push_back(run % 3 == 0 ? start - i : start + i);
+		}
+		std::vector<int> expect(data);
+		std::sort(expect.begin(), expect.end());
+		mSTL::stable_sort(data.begin(), data.end());
+		CHECK(data == expect);
+
+		std::vector<int> logs(200000);
+		for (size_t i = 0; i < logs.size(); ++i)
+			logs[i] = static_cast<int>(i * 10 + rng() % 50);
+		expect = logs;
+		std::sort(expect.begin(), expect.end());
+		mSTL::stable_sort(logs.begin(), logs.end());
+		CHECK(logs == expect);
+	}
+
+	SUBCASE(" presorted is linear ") {
+		const size_t     n = 1 << 16;
+		std::vector<int> inputs[3] = {sort_inputs(n)[1], sort_inputs(n)[2],
+		                              sort_inputs(n)[5]};
+		for (std::vector<int>& data : inputs) {
+			size_t comparisons = 0;
+			mSTL::stable_sort(data.begin(), data.end(), [&](int a, int b) {
+				++comparisons;
+				return a < b;
+			});
+			CHECK(std::is_sorted(data.begin(), data.end()));
+			CHECK(comparisons < 2 * n);
+		}
+	}
+
+	SUBCASE(" other iterators && types ") {
+		std::mt19937            rng(8);
+		std::deque<std::string> words;
+		for (int i = 0; i < 20000; ++i)
+			words.push_back(std::to_string(rng() % 3000));
+		std::vector<std::string> expect(words.begin(), words.end());
+		std::stable_sort(expect.begin(), expect.end());
+		mSTL::stable_sort(words.begin(), words.end());
+		CHECK(std::equal(expect.begin(), expect.end(), words.begin()));
+
+		// 仅可移动的元素
+		std::vector<std::unique_ptr<int>> pointers;
+		for (int i = 0; i < 5000; ++i)
+			pointers.push_back(std::unique_ptr<int>(new int(rng() % 100)));
+		mSTL::stable_sort(pointers.begin(), pointers.end(),
+		                  [](const std::unique_ptr<int>& a,
+		                     const std::unique_ptr<int>& b) { return *a < *b; });
+		bool sorted = true;
+		for (size_t i = 1; i < pointers.size(); ++i)
+			sorted = sorted && pointers[i] != nullptr && *pointers[i - 1] <= *pointers[i];
+		CHECK(sorted);
+
+		int raw[] = {5, 3, 9, 1, 1, 8};
+		mSTL::stable_sort(raw, raw + 6);
+		CHECK(std::is_sorted(raw, raw + 6));
+	}
+}
+
+TEST_CASE(" parallel sort && stable_sort ") {
+	// 线程池无工作线程时退化为串行，两条路径结果相同
+	const size_t sizes[] = {1000, 100000};
+	for (size_t n : sizes) {
+		for (const std::vector<int>& input : sort_inputs(n)) {
+			std::vector<int> expect(input);
+			std::sort(expect.begin(), expect.end());
+
+			std::vector<int> data(input);
+			mSTL::sort(mSTL::par, data.begin(), data.end());
+			CHECK(data == expect);
+
+			data = input;
+			mSTL::stable_sort(mSTL::par, data.begin(), data.end());
+			CHECK(data == expect);
+
+			std::sort(expect.begin(), expect.end(), std::greater<int>());
+			data = input;
+			mSTL::sort(mSTL::par, data.begin(), data.end(), std::greater<int>());
+			CHECK(data == expect);
+		}
+	}
+
+	SUBCASE(" stability ") {
+		std::mt19937                     rng(11);
+		std::vector<std::pair<int, int>> input(150000);
+		for (size_t i = 0; i < input.size(); ++i)
+			input[i] = std::make_pair(static_cast<int>(rng() % 1000),
+			                          static_cast<int>(i));
+
+		auto by_key = [](const std::pair<int, int>& a,
+		                 const std::pair<int, int>& b) {
+			return a.first < b.first;
+		};
+		std::vector<std::pair<int, int>> expect(input);
+		std::stable_sort(expect.begin(), expect.end(), by_key);
+
+		mSTL::vector<std::pair<int, int>> data(input.begin(), input.end());
+		mSTL::stable_sort(mSTL::par, data.begin(), data.end(), by_key);
+		CHECK(std::equal(expect.begin(), expect.end(), data.begin()));
+	}
+
+	SUBCASE(" non-trivial elements ") {
+		std::mt19937             rng(5);
+		std::deque<std::string> words;
+		for (int i = 0; i < 60000; ++i)
+			words.push_back("word_" + std::to_string(rng() % 20000));
+		std::vector<std::string> expect(words.begin(), words.end());
+		std::sort(expect.begin(), expect.end());
+
+		std::deque<std::string> data(words);
+		mSTL::sort(mSTL::par, data.begin(), data.end());
+		CHECK(std::equal(expect.begin(), expect.end(), data.begin()));
+
+		data = words;
+		mSTL::stable_sort(mSTL::par, data.begin(), data.end());
+		CHECK(std::equal(expect.begin(), expect.end(), data.begin()));
+	}
+
+	SUBCASE(" explicit pools ") {
+		// 单核机器上全局线程池没有工作线程，直接以多线程池驱动并行路径
+		// 255 个工作线程时段数多于每段一个元素所需，靠后的段为空
+		for (size_t threads : {3, 255}) {
+			mSTL::thread_pool pool(threads);
+			for (size_t n : {32769, 100000}) {
+				for (const std::vector<int>& input : sort_inputs(n)) {
+					std::vector<int> expect(input);
+					std::sort(expect.begin(), expect.end());
+
+					std::vector<int> data(input);
+					mSTL::_sample_sort(data.begin(), data.end(), std::less<int>(),
+					                   pool);
+					CHECK(data == expect);
+
+					data = input;
+					mSTL::_parallel_merge_sort(data.begin(), data.end(),
+					                           std::less<int>(), pool);
+					CHECK(data == expect);
+				}
+			}
+		}
+	}
+}
+
+struct record {
+	int    id;
+	double score;
+};
+
+template <class T>
+std::vector<T> radix_inputs(size_t n, unsigned seed) {
+	std::mt19937_64 rng(seed);
+	std::vector<T>  data(n);
+	for (size_t i = 0; i < n; ++i)
+		data[i] = static_cast<T>(rng());
+	return data;
+}
+
+template <class T>
+void check_radix_sort(const std::vector<T>& input) {
+	std::vector<T> expect(input);
+	std::sort(expect.begin(), expect.end());
+
+	std::vector<T> data(input);
+	mSTL::radix_sort(data.begin(), data.end());
+	CHECK(data == expect);
+
+	data = input;
+	mSTL::radix_sort(mSTL::par, data.begin(), data.end());
+	CHECK(data == expect);
+}
+
+TEST_CASE(" radix_sort ") {
+	// 覆盖 American flag sort、LSD 8 位与 11 位数字、并行分桶各路径
+	const size_t sizes[] = {0, 1, 31, 100, 3000, 70000};
+	for (size_t n : sizes) {
+		check_radix_sort(radix_inputs<int>(n, 1));
+		check_radix_sort(radix_inputs<unsigned>(n, 2));
+		check_radix_sort(radix_inputs<long long>(n, 3));
+		check_radix_sort(radix_inputs<unsigned long long>(n, 4));
+		check_radix_sort(radix_inputs<short>(n, 5));
+		check_radix_sort(radix_inputs<signed char>(n, 6));
+
+		// 小范围的值: 高位全部相同的趟被跳过
+		std::vector<long long> small(n);
+		for (size_t i = 0; i < n; ++i)
+			small[i] = static_cast<long long>(i * 7919 % 1000) - 500;
+		check_radix_sort(small);
+
+		std::vector<int> equal(n, 7);
+		check_radix_sort(equal);
+
+		std::mt19937                           rng(static_cast<unsigned>(n));
+		std::uniform_real_distribution<double> real(-1e6, 1e6);
+		std::vector<double>                    doubles(n);
+		std::vector<float>                     floats(n);
+		for (size_t i = 0; i < n; ++i) {
+			doubles[i] = real(rng);
+			floats[i] = static_cast<float>(real(rng)) / 1000;
+		}
+		check_radix_sort(doubles);
+		check_radix_sort(floats);
+	}
+
+	SUBCASE(" msd bucketing ") {
+		// 超过 _RADIX_MSD_THRESHOLD 时先按最高位分桶，浮点数分桶不均时退回 LSD
+		const size_t n = 300000;
+		check_radix_sort(radix_inputs<unsigned>(n, 7));
+		check_radix_sort(radix_inputs<long long>(n, 8));
+
+		std::vector<double> doubles(n);
+		std::mt19937_64     rng(10);
+		for (size_t i = 0; i < n; ++i)
+			doubles[i] = static_cast<double>(static_cast<long long>(rng())) / 1e9;
+		check_radix_sort(doubles);
+	}
+
+	SUBCASE(" parallel msd with explicit pools ") {
+		// 段数多于元素数时靠后的段为空；单核机器上全局线程池不会走到并行分桶
+		for (size_t threads : {3, 255}) {
+			mSTL::thread_pool pool(threads);
+			for (size_t n : {2, 100, 3000, 70000}) {
+				std::vector<unsigned> data = radix_inputs<unsigned>(n, 11);
+				std::vector<unsigned> expect(data);
+				std::sort(expect.begin(), expect.end());
+				mSTL::_radix_encoder<unsigned, mSTL::_radix_identity> encode = {
+				    mSTL::_radix_identity()};
+				mSTL::_radix_sort_msd(data.begin(), n, encode, &pool);
+				CHECK(data == expect);
+			}
+		}
+	}
+
+	SUBCASE(" special float values ") {
+		std::vector<double> data = {3.5,   -0.0, 0.0,  -1e300, 1e-300,
+		                            -2.25, 1e300, -1e-300, 42.0, -42.0};
+		std::vector<double> expect(data);
+		std::sort(expect.begin(), expect.end());
+		mSTL::radix_sort(data.begin(), data.end());
+		CHECK(data == expect);
+		CHECK(std::signbit(data[4]));
+		CHECK(!std::signbit(data[5]));
+	}
+
+	SUBCASE(" key function && containers ") {
+		std::mt19937        rng(9);
+		std::vector<record> records(5000);
+		for (size_t i = 0; i < records.size(); ++i) {
+			records[i].id = static_cast<int>(i);
+			records[i].score = static_cast<double>(rng() % 2000) - 1000.5;
+		}
+
+		auto by_score = [](const record& r) { return r.score; };
+		std::vector<record> data(records);
+		mSTL::radix_sort(data.begin(), data.end(), by_score);
+		CHECK(std::is_sorted(data.begin(), data.end(),
+		                     [](const record& a, const record& b) {
+			                     return a.score < b.score;
+		                     }));
+
+		std::vector<int> ids;
+		for (const record& r : data)
+			ids.push_back(r.id);
+		std::sort(ids.begin(), ids.end());
+		for (size_t i = 0; i < ids.size(); ++i)
+			CHECK(ids[i] == static_cast<int>(i));
+
+		mSTL::vector<std::string> words;
+		for (int i = 0; i < 40000; ++i)
+			words.push_back(std::to_string(rng() % 100000));
+		mSTL::radix_sort(mSTL::par, words.begin(), words.end(),
+		                 [](const std::string& s) { return std::stoi(s); });
+		CHECK(std::is_sorted(words.begin(), words.end(),
+		                     [](const std::string& a, const std::string& b) {
+			                     return std::stoi(a) < std::stoi(b);
+		                     }));
+
+		mSTL::array<unsigned, 300> values;
+		for (size_t i = 0; i < values.size(); ++i)
+			values[i] = static_cast<unsigned>(rng());
+		mSTL::radix_sort(values.begin(), values.end());
+		CHECK(std::is_sorted(values.begin(), values.end()));
+
+		int raw[] = {5, -3, 9, -1, 1, 8, 0};
+		mSTL::radix_sort(raw, raw + 7);
+		CHECK(std::is_sorted(raw, raw + 7));
+	}
+}
+
+// nth_element 的结果: *nth 就位，左侧不大于、右侧不小于，且为输入的排列
+template <class T, class Compare>
+void check_nth_element(const std::vector<T>& input, size_t nth,
+                       const std::vector<T>& result, Compare comp) {
+	std::vector<T> expect(input);
+	std::sort(expect.begin(), expect.end(), comp);
+	CHECK(!comp(result[nth], expect[nth]));
+	CHECK(!comp(expect[nth], result[nth]));
+	for (size_t i = 0; i < nth; ++i)
+		CHECK(!comp(result[nth], result[i]));
+	for (size_t i = nth + 1; i < result.size(); ++i)
+		CHECK(!comp(result[i], result[nth]));
+
+	std::vector<T> sorted(result);
+	std::sort(sorted.begin(), sorted.end(), comp);
+	CHECK(std::equal(sorted.begin(), sorted.end(), expect.begin(),
+	                 [&](const T& a, const T& b) {
+		                 return !comp(a, b) && !comp(b, a);
+	                 }));
+}
+
+TEST_CASE(" selection ") {
+	SUBCASE(" nth_element ") {
+		const size_t sizes[] = {1, 2, 17, 100, 1000, 20000};
+		for (size_t n : sizes) {
+			for (const std::vector<int>& input : sort_inputs(n)) {
+				const size_t positions[] = {0, n / 4, n / 2, n - 1};
+				for (size_t nth : positions) {
+					std::vector<int> data(input);
+					mSTL::nth_element(data.begin(), data.begin() + nth, data.end());
+					check_nth_element(input, nth, data, std::less<int>());
+
+					data = input;
+					mSTL::nth_element(data.begin(), data.begin() + nth, data.end(),
+					                  std::greater<int>());
+					check_nth_element(input, nth, data, std::greater<int>());
+				}
+			}
+		}
+
+		std::vector<int> data(10, 3);
+		mSTL::nth_element(data.begin(), data.end(), data.end());
+		CHECK(data == std::vector<int>(10, 3));
+	}
+
+	SUBCASE(" median of medians is linear ") {
+		// 直接以 bad_allowed = 0 进入中位数的中位数，比较次数应为 O(N)
+		const size_t n = 1 << 16;
+		std::vector<std::vector<int>> inputs = sort_inputs(n);
+
+		std::vector<int> killer(n);
+		for (size_t i = 0; i < n / 2; ++i) {
+			killer[2 * i] = static_cast<int>(i + 1);
+			killer[2 * i + 1] = static_cast<int>(n / 2 + i + 1);
+		}
+		inputs.push_back(killer);
+
+		for (const std::vector<int>& input : inputs) {
+			std::vector<int> data(input);
+			size_t           comparisons = 0;
+			auto             counting = [&](int a, int b) {
+                ++comparisons;
+                return a < b;
+			};
+			mSTL::_introselect(data.begin(), data.begin() + n / 2, data.end(),
+			                   counting, 0);
+			check_nth_element(input, n / 2, data, std::less<int>());
+			CHECK(comparisons < 40 * n);
+
+			data = input;
+			comparisons = 0;
+			mSTL::nth_element(data.begin(), data.begin() + n / 3, data.end(),
+			                  counting);
+			CHECK(comparisons < 40 * n);
+		}
+	}
+
+	SUBCASE(" partial_sort && partial_sort_copy ") {
+		const size_t sizes[] = {0, 1, 5, 100, 3000};
+		for (size_t n : sizes) {
+			for (const std::vector<int>& input : sort_inputs(n)) {
+				std::vector<int> expect(input);
+				std::sort(expect.begin(), expect.end());
+				// 覆盖堆选择与内省选择两条路径
+				const size_t middles[] = {0, 1, n / 20, n / 2, n};
+				for (size_t k : middles) {
+					if (k > n)
+						continue;
+					std::vector<int> data(input);
+					mSTL::partial_sort(data.begin(), data.begin() + k, data.end());
+					CHECK(std::equal(expect.begin(), expect.begin() + k,
+					                 data.begin()));
+					std::sort(data.begin(), data.end());
+					CHECK(data == expect);
+
+					std::vector<int> out(k + 3, -1);
+					std::deque<int>  source(input.begin(), input.end());
+					CHECK(mSTL::partial_sort_copy(source.begin(), source.end(),
+					                              out.begin(), out.begin() + k) ==
+					      out.begin() + k);
+					CHECK(std::equal(expect.begin(), expect.begin() + k, out.begin()));
+
+					std::vector<int>::iterator end = mSTL::partial_sort_copy(
+					    input.begin(), input.end(), out.begin(), out.end());
+					CHECK(end - out.begin() == static_cast<ptrdiff_t>(
+					                               k + 3 < n ? k + 3 : n));
+					CHECK(std::equal(out.begin(), end, expect.begin()));
+				}
+			}
+		}
+
+		std::vector<std::string> words;
+		for (int i = 0; i < 500; ++i)
+			words.push_back("w" + std::to_string(i * 7919 % 500));
+		mSTL::partial_sort(words.begin(), words.begin() + 10, words.end(),
+		                   std::greater<std::string>());
+		std::vector<std::string> expect(words);
+		std::sort(expect.begin(), expect.end(), std::greater<std::string>());
+		CHECK(std::equal(expect.begin(), expect.begin() + 10, words.begin()));
+	}
+
+	SUBCASE(" top_k ") {
+		std::mt19937 rng(45);
+		const size_t ks[] = {0, 1, 7, 100, 999, 1000, 5000};
+
+		// 迭代器为指针且比较器为 std::less / std::greater 时走 SIMD 过滤
+		std::vector<int>    ints(1000);
+		std::vector<float>  floats(1000);
+		std::vector<double> doubles(1000);
+		for (size_t i = 0; i < ints.size(); ++i) {
+			ints[i] = static_cast<int>(rng() % 500) - 250;
+			floats[i] = static_cast<float>(ints[i]) / 3;
+			doubles[i] = static_cast<double>(rng()) / 7;
+		}
+		for (size_t k : ks) {
+			const size_t m = k < ints.size() ? k : ints.size();
+
+			std::vector<int> data(ints), expect(ints);
+			std::sort(expect.begin(), expect.end(), std::greater<int>());
+			CHECK(mSTL::top_k(data.data(), data.data() + data.size(), k) ==
+			      data.data() + m);
+			CHECK(std::equal(expect.begin(), expect.begin() + m, data.begin()));
+			// 输入被原地重排，整个区间仍是原数据的一个排列
+			std::sort(data.begin(), data.end(), std::greater<int>());
+			CHECK(data == expect);
+
+			data = ints;
+			std::sort(expect.begin(), expect.end());
+			mSTL::top_k(data.data(), data.data() + data.size(), k,
+			            std::greater<int>());
+			CHECK(std::equal(expect.begin(), expect.begin() + m, data.begin()));
+
+			// 同一组数据走标量路径
+			data = ints;
+			mSTL::top_k(data.begin(), data.end(), k,
+			            [](int a, int b) { return a > b; });
+			CHECK(std::equal(expect.begin(), expect.begin() + m, data.begin()));
+
+			std::vector<float> f(floats), expect_f(floats);
+			std::sort(expect_f.begin(), expect_f.end(), std::greater<float>());
+			mSTL::top_k(f.data(), f.data() + f.size(), k);
+			CHECK(std::equal(expect_f.begin(), expect_f.begin() + m, f.begin()));
+
+			std::vector<double> d(doubles), expect_d(doubles);
+			std::sort(expect_d.begin(), expect_d.end());
+			mSTL::top_k(d.data(), d.data() + d.size(), k, std::greater<double>());
+			CHECK(std::equal(expect_d.begin(), expect_d.begin() + m, d.begin()));
+
+			// partial_sort 在指针上同样走 SIMD 过滤
+			std::vector<int> p(ints);
+			std::sort(expect.begin(), expect.end());
+			mSTL::partial_sort(p.data(), p.data() + m, p.data() + p.size());
+			CHECK(std::equal(expect.begin(), expect.begin() + m, p.begin()));
+		}
+
+		// 初始堆中没有 NaN 时，NaN 与堆顶比较均为假，不会进入堆
+		std::vector<double> with_nan(100);
+		for (size_t i = 0; i < with_nan.size(); ++i)
+			with_nan[i] = i % 3 == 0 && i >= 5 ? NAN : static_cast<double>(i);
+		double* end = mSTL::top_k(with_nan.data(), with_nan.data() + 100, 5);
+		CHECK(end == with_nan.data() + 5);
+		const double expect_nan[] = {98, 97, 95, 94, 92};
+		CHECK(std::equal(expect_nan, expect_nan + 5, with_nan.data()));
+
+		mSTL::vector<std::string> words;
+		for (int i = 0; i < 300; ++i)
+			words.push_back(std::to_string(rng() % 1000));
+		std::vector<std::string> expect(words.begin(), words.end());
+		std::sort(expect.begin(), expect.end(), std::greater<std::string>());
+		mSTL::top_k(words.begin(), words.end(), 20);
+		CHECK(std::equal(expect.begin(), expect.begin() + 20, words.begin()));
+	}
+}
+
+// D 叉堆: 逐个 push 后 is_heap 成立，pop 出的序列有序；make_heap / sort_heap 同理
+template <size_t Arity>
+void check_dary_heap(const std::vector<int>& input) {
+	std::vector<int> expect(input);
+	std::sort(expect.begin(), expect.end());
+
+	std::vector<int> data;
+	for (int value : input) {
+		data.push_back(value);
+		mSTL::push_heap<Arity>(data.begin(), data.end());
+		CHECK(mSTL::is_heap<Arity>(data.begin(), data.end()));
+	}
+	for (std::vector<int>::iterator last = data.end(); last != data.begin();
+	     --last) {
+		mSTL::pop_heap<Arity>(data.begin(), last);
+		CHECK(mSTL::is_heap<Arity>(data.begin(), last - 1));
+	}
+	CHECK(data == expect);
+
+	data = input;
+	mSTL::make_heap<Arity>(data.begin(), data.end(), std::greater<int>());
+	CHECK(mSTL::is_heap<Arity>(data.begin(), data.end(), std::greater<int>()));
+	mSTL::sort_heap<Arity>(data.begin(), data.end(), std::greater<int>());
+	CHECK(std::equal(expect.rbegin(), expect.rend(), data.begin()));
+}
+
+TEST_CASE(" heap operations ") {
+	const size_t sizes[] = {0, 1, 2, 3, 9, 100, 1000};
+	for (size_t n : sizes) {
+		for (const std::vector<int>& input : sort_inputs(n)) {
+			std::vector<int> expect(input);
+			std::sort(expect.begin(), expect.end());
+
+			std::vector<int> data(input);
+			mSTL::make_heap(data.begin(), data.end());
+			CHECK(std::is_heap(data.begin(), data.end()));
+			CHECK(mSTL::is_heap(data.begin(), data.end()));
+			mSTL::sort_heap(data.begin(), data.end());
+			CHECK(data == expect);
+
+			data.clear();
+			for (int value : input) {
+				data.push_back(value);
+				mSTL::push_heap(data.begin(), data.end());
+				CHECK(std::is_heap(data.begin(), data.end()));
+			}
+			std::vector<int> popped;
+			while (!data.empty()) {
+				mSTL::pop_heap(data.begin(), data.end());
+				popped.push_back(data.back());
+				data.pop_back();
+				CHECK(std::is_heap(data.begin(), data.end()));
+			}
+			CHECK(std::equal(expect.rbegin(), expect.rend(), popped.begin()));
+
+			// is_heap_until 与 std 一致
+			data = input;
+			CHECK(mSTL::is_heap_until(data.begin(), data.end()) ==
+			      std::is_heap_until(data.begin(), data.end()));
+			CHECK(mSTL::is_heap_until(data.begin(), data.end(),
+			                          std::greater<int>()) ==
+			      std::is_heap_until(data.begin(), data.end(),
+			                         std::greater<int>()));
+
+			check_dary_heap<2>(input);
+			check_dary_heap<3>(input);
+			check_dary_heap<4>(input);
+			check_dary_heap<8>(input);
+		}
+	}
+
+	SUBCASE(" is_heap_until with arity ") {
+		// 4 叉堆中下标 1 ~ 4 均为根的子节点，二叉堆中下标 3、4 为下标 1 的子节点
+		std::vector<int> data = {9, 8, 7, 6, 5, 4};
+		CHECK(mSTL::is_heap<4>(data.begin(), data.end()));
+		CHECK(mSTL::is_heap(data.begin(), data.end()));
+		data = {9, 1, 2, 0, 8, 0};
+		CHECK(mSTL::is_heap<4>(data.begin(), data.end()));
+		CHECK(mSTL::is_heap_until(data.begin(), data.end()) == data.begin() + 4);
+		CHECK(mSTL::is_heap_until<8>(data.begin(), data.end()) == data.end());
+	}
+
+	SUBCASE(" priority queue workload ") {
+		// 交替 push / pop，与 std::priority_queue 语义的 std 堆函数对比
+		std::mt19937                  rng(46);
+		std::vector<std::string>      mine, theirs;
+		mSTL::vector<unsigned long long> wide;
+		std::vector<unsigned long long>  wide_expect;
+		for (int i = 0; i < 20000; ++i) {
+			if (rng() % 3 != 0 || mine.empty()) {
+				std::string value = std::to_string(rng() % 10000);
+				mine.push_back(value);
+				mSTL::push_heap<4>(mine.begin(), mine.end());
+				theirs.push_back(value);
+				std::push_heap(theirs.begin(), theirs.end());
+
+				unsigned long long key = rng();
+				wide.push_back(key);
+				mSTL::push_heap<8>(wide.begin(), wide.end(),
+				                   std::greater<unsigned long long>());
+				wide_expect.push_back(key);
+				std::push_heap(wide_expect.begin(), wide_expect.end(),
+				               std::greater<unsigned long long>());
+			} else {
+				mSTL::pop_heap<4>(mine.begin(), mine.end());
+				std::pop_heap(theirs.begin(), theirs.end());
+				CHECK(mine.back() == theirs.back());
+				mine.pop_back();
+				theirs.pop_back();
+
+				mSTL::pop_heap<8>(wide.begin(), wide.end(),
+				                  std::greater<unsigned long long>());
+				std::pop_heap(wide_expect.begin(), wide_expect.end(),
+				              std::greater<unsigned long long>());
+				CHECK(wide.back() == wide_expect.back());
+				wide.pop_back();
+				wide_expect.pop_back();
+			}
+		}
+		CHECK(mSTL::is_heap<4>(mine.begin(), mine.end()));
+	}
+}
+
+// 有序多重集合，元素取值范围 [0, range)
+std::vector<int> sorted_multiset(size_t n, int range, std::mt19937& rng) {
+	std::vector<int> data(n);
+	for (size_t i = 0; i < n; ++i)
+		data[i] = static_cast<int>(rng() % static_cast<unsigned>(range));
+	std::sort(data.begin(), data.end());
+	return data;
+}
+
+// 与 std 版本逐一比较输出 (含重复元素的个数与来源)
+template <class Iterator1, class Iterator2>
+void check_set_operations(Iterator1 first1, Iterator1 last1, Iterator2 first2,
+                          Iterator2 last2) {
+	typedef std::pair<int, int> tagged; // (键, 来源区间)
+	std::vector<tagged>         a, b;
+	for (Iterator1 it = first1; it != last1; ++it)
+		a.push_back(tagged(*it, 1));
+	for (Iterator2 it = first2; it != last2; ++it)
+		b.push_back(tagged(*it, 2));
+	auto key_less = [](const tagged& x, const tagged& y) {
+		return x.first < y.first;
+	};
+
+	std::vector<tagged> expect, result;
+	std::merge(a.begin(), a.end(), b.begin(), b.end(),
+	           std::back_inserter(expect), key_less);
+	mSTL::merge(a.begin(), a.end(), b.begin(), b.end(),
+	            std::back_inserter(result), key_less);
+	CHECK(result == expect);
+
+	expect.clear(), result.clear();
+	std::set_union(a.begin(), a.end(), b.begin(), b.end(),
+	               std::back_inserter(expect), key_less);
+	mSTL::set_union(a.begin(), a.end(), b.begin(), b.end(),
+	                std::back_inserter(result), key_less);
+	CHECK(result == expect);
+
+	expect.clear(), result.clear();
+	std::set_intersection(a.begin(), a.end(), b.begin(), b.end(),
+	                      std::back_inserter(expect), key_less);
+	mSTL::set_intersection(a.begin(), a.end(), b.begin(), b.end(),
+	                       std::back_inserter(result), key_less);
+	CHECK(result == expect);
+
+	expect.clear(), result.clear();
+	std::set_difference(a.begin(), a.end(), b.begin(), b.end(),
+	                    std::back_inserter(expect), key_less);
+	mSTL::set_difference(a.begin(), a.end(), b.begin(), b.end(),
+	                     std::back_inserter(result), key_less);
+	CHECK(result == expect);
+
+	std::vector<int> plain_result;
+	std::vector<int> plain_expect;
+	std::set_difference(first2, last2, first1, last1,
+	                    std::back_inserter(plain_expect));
+	mSTL::set_difference(first2, last2, first1, last1,
+	                     std::back_inserter(plain_result));
+	CHECK(plain_result == plain_expect);
+
+	CHECK(mSTL::includes(first1, last1, first2, last2) ==
+	      std::includes(first1, last1, first2, last2));
+	CHECK(mSTL::includes(first2, last2, first1, last1) ==
+	      std::includes(first2, last2, first1, last1));
+}
+
+TEST_CASE(" sorted range && set operations ") {
+	std::mt19937 rng(47);
+
+	SUBCASE(" balanced && skewed ") {
+		// 长度比从 1 到 1000，覆盖逐个比较与倍增查找两条路径
+		const size_t small_sizes[] = {0, 1, 3, 10, 100};
+		const size_t ratios[] = {1, 2, 15, 16, 17, 100, 1000};
+		const int    ranges[] = {5, 1000, 1000000};
+		for (size_t small : small_sizes) {
+			for (size_t ratio : ratios) {
+				for (int range : ranges) {
+					std::vector<int> a = sorted_multiset(small, range, rng);
+					std::vector<int> b = sorted_multiset(small * ratio + 1, range, rng);
+					check_set_operations(a.begin(), a.end(), b.begin(), b.end());
+					check_set_operations(b.begin(), b.end(), a.begin(), a.end());
+				}
+			}
+		}
+	}
+
+	SUBCASE(" includes ") {
+		std::vector<int> large = sorted_multiset(10000, 3000, rng);
+		std::vector<int> subset;
+		for (size_t i = 0; i < large.size(); i += 97)
+			subset.push_back(large[i]);
+		CHECK(mSTL::includes(large.begin(), large.end(), subset.begin(),
+		                     subset.end()));
+		subset.push_back(subset.back());
+		std::sort(subset.begin(), subset.end());
+		CHECK(mSTL::includes(large.begin(), large.end(), subset.begin(),
+		                     subset.end()) ==
+		      std::includes(large.begin(), large.end(), subset.begin(),
+		                    subset.end()));
+		subset.push_back(5000);
+		CHECK(!mSTL::includes(large.begin(), large.end(), subset.begin(),
+		                      subset.end()));
+		CHECK(mSTL::includes(large.begin(), large.end(), subset.begin(),
+		                     subset.begin()));
+	}
+
+	SUBCASE(" input iterators && custom compare ") {
+		std::vector<int> a = sorted_multiset(50, 40, rng);
+		std::vector<int> b = sorted_multiset(2000, 40, rng);
+		std::deque<int>  da(a.begin(), a.end());
+		check_set_operations(da.begin(), da.end(), b.begin(), b.end());
+
+		std::reverse(a.begin(), a.end());
+		std::reverse(b.begin(), b.end());
+		std::vector<int> expect, result;
+		std::set_intersection(a.begin(), a.end(), b.begin(), b.end(),
+		                      std::back_inserter(expect), std::greater<int>());
+		mSTL::set_intersection(a.data(), a.data() + a.size(), b.data(),
+		                       b.data() + b.size(), std::back_inserter(result),
+		                       std::greater<int>());
+		CHECK(result == expect);
+	}
+
+	SUBCASE(" simd intersect_sorted ") {
+		const size_t sizes[] = {0, 3, 8, 17, 100, 5000};
+		for (size_t na : sizes) {
+			for (size_t nb : sizes) {
+				std::vector<uint32_t> a, b;
+				for (uint32_t v = 0; a.size() < na; v += 1 + rng() % 4)
+					a.push_back(v);
+				for (uint32_t v = 0x7ffffff0u; b.size() < nb; v -= 1 + rng() % 3)
+					b.push_back(v % (static_cast<uint32_t>(na) * 3 + 1) +
+					            (v & 0x80000000u));
+				std::sort(b.begin(), b.end());
+				b.erase(std::unique(b.begin(), b.end()), b.end());
+
+				std::vector<uint32_t> expect;
+				std::set_intersection(a.begin(), a.end(), b.begin(), b.end(),
+				                      std::back_inserter(expect));
+				std::vector<uint32_t> out(a.size() + 1);
+				size_t count = mSTL::simd::intersect_sorted(
+				    a.data(), a.size(), b.data(), b.size(), out.data());
+				out.resize(count);
+				CHECK(out == expect);
+
+				// 结果可以原地写回第一个数组
+				count = mSTL::simd::intersect_sorted(a.data(), a.size(), b.data(),
+				                                     b.size(), a.data());
+				a.resize(count);
+				CHECK(a == expect);
+			}
+		}
+	}
+
+	SUBCASE(" multiway_merge ") {
+		const size_t ks[] = {0, 1, 2, 3, 7, 64, 100};
+		for (size_t k : ks) {
+			// (键, 区间序号, 区间内序号)，相等键应按区间序号输出
+			typedef std::pair<int, std::pair<size_t, size_t>> entry;
+			std::vector<std::vector<entry>> lists(k);
+			std::vector<entry>              expect;
+			for (size_t i = 0; i < k; ++i) {
+				std::vector<int> keys = sorted_multiset(rng() % 200, 50, rng);
+				for (size_t j = 0; j < keys.size(); ++j)
+					lists[i].push_back(entry(keys[j], std::make_pair(i, j)));
+				expect.insert(expect.end(), lists[i].begin(), lists[i].end());
+			}
+			auto key_less = [](const entry& x, const entry& y) {
+				return x.first < y.first;
+			};
+			std::stable_sort(expect.begin(), expect.end(), key_less);
+
+			typedef std::vector<entry>::const_iterator iterator;
+			std::vector<std::pair<iterator, iterator>> ranges;
+			for (const std::vector<entry>& list : lists)
+				ranges.push_back(std::make_pair(list.begin(), list.end()));
+			std::vector<entry> result(expect.size());
+			CHECK(mSTL::multiway_merge(ranges.begin(), ranges.end(),
+			                           result.begin(), key_less) == result.end());
+			CHECK(result == expect);
+			for (const std::pair<iterator, iterator>& range : ranges)
+				CHECK(range.first == range.second);
+		}
+
+		std::vector<std::string> words[3] = {{"a", "d", "g"}, {"b", "e"}, {"c"}};
+		std::pair<std::string*, std::string*> ranges[3];
+		for (size_t i = 0; i < 3; ++i)
+			ranges[i] = std::make_pair(words[i].data(),
+			                           words[i].data() + words[i].size());
+		mSTL::vector<std::string> merged(6);
+		mSTL::multiway_merge(ranges, ranges + 3, merged.begin());
+		CHECK(std::is_sorted(merged.begin(), merged.end()));
+		CHECK(merged[5] == "g");
+	}
+}
+
+TEST_CASE(" binary search ") {
+	std::mt19937 rng(48);
+
+	SUBCASE(" bounds ") {
+		const size_t sizes[] = {0, 1, 2, 7, 64, 1000};
+		for (size_t n : sizes) {
+			std::vector<int> data = sorted_multiset(n, static_cast<int>(n / 3 + 2), rng);
+			std::deque<int>  deq(data.begin(), data.end());
+			mSTL::vector<int> vec(data.begin(), data.end());
+			for (int key = -1; key <= static_cast<int>(n / 3 + 3); ++key) {
+				std::vector<int>::iterator lb =
+				    std::lower_bound(data.begin(), data.end(), key);
+				std::vector<int>::iterator ub =
+				    std::upper_bound(data.begin(), data.end(), key);
+				CHECK(mSTL::lower_bound(data.begin(), data.end(), key) == lb);
+				CHECK(mSTL::upper_bound(data.begin(), data.end(), key) == ub);
+				CHECK(mSTL::equal_range(data.begin(), data.end(), key) ==
+				      std::make_pair(lb, ub));
+				CHECK(mSTL::binary_search(data.begin(), data.end(), key) ==
+				      (lb != ub));
+
+				CHECK(mSTL::lower_bound(deq.begin(), deq.end(), key) - deq.begin() ==
+				      lb - data.begin());
+				CHECK(mSTL::upper_bound(vec.begin(), vec.end(), key) - vec.begin() ==
+				      ub - data.begin());
+			}
+		}
+
+		// 前向迭代器走逐步前进的二分
+		std::vector<int> sorted = sorted_multiset(300, 50, rng);
+		std::list<int>   list(sorted.begin(), sorted.end());
+		for (int key = -1; key <= 51; ++key) {
+			CHECK(std::distance(list.begin(),
+			                    mSTL::lower_bound(list.begin(), list.end(), key)) ==
+			      std::lower_bound(sorted.begin(), sorted.end(), key) -
+			          sorted.begin());
+			CHECK(std::distance(list.begin(),
+			                    mSTL::upper_bound(list.begin(), list.end(), key)) ==
+			      std::upper_bound(sorted.begin(), sorted.end(), key) -
+			          sorted.begin());
+			CHECK(mSTL::binary_search(list.begin(), list.end(), key) ==
+			      std::binary_search(sorted.begin(), sorted.end(), key));
+		}
+
+		std::vector<std::string> words = {"apple", "kiwi", "lemon", "pear"};
+		std::sort(words.begin(), words.end(), std::greater<std::string>());
+		CHECK(mSTL::lower_bound(words.begin(), words.end(), std::string("lime"),
+		                        std::greater<std::string>()) ==
+		      words.begin() + 1);
+	}
+
+	SUBCASE(" lower_bound_many ") {
+		const size_t sizes[] = {0, 1, 5, 1000, 100000};
+		for (size_t n : sizes) {
+			std::vector<int> data = sorted_multiset(n, static_cast<int>(n + 1), rng);
+			std::vector<int> keys(37);
+			for (int& key : keys)
+				key = static_cast<int>(rng() % (n + 3)) - 1;
+
+			std::vector<const int*> result;
+			mSTL::lower_bound_many(data.data(), data.data() + data.size(),
+			                       keys.begin(), keys.end(),
+			                       std::back_inserter(result));
+			REQUIRE(result.size() == keys.size());
+			for (size_t i = 0; i < keys.size(); ++i)
+				CHECK(result[i] == data.data() + (std::lower_bound(data.begin(),
+				                                                   data.end(),
+				                                                   keys[i]) -
+				                                  data.begin()));
+		}
+	}
+
+	SUBCASE(" eytzinger_index ") {
+		const size_t sizes[] = {0, 1, 2, 3, 15, 16, 17, 1000, 65537};
+		for (size_t n : sizes) {
+			std::vector<int> data = sorted_multiset(n, static_cast<int>(n * 2 + 1), rng);
+			mSTL::eytzinger_index<int> index(data.begin(), data.end());
+			CHECK(index.size() == n);
+			CHECK(index.empty() == (n == 0));
+
+			// 按 BFS 顺序存放的仍是同一组元素
+			std::vector<int> stored(index.begin(), index.end());
+			std::sort(stored.begin(), stored.end());
+			CHECK(stored == data);
+
+			std::vector<int> keys;
+			for (size_t i = 0; i < 200; ++i)
+				keys.push_back(static_cast<int>(rng() % (n * 2 + 3)) - 1);
+			std::vector<const int*> many;
+			index.lower_bound_many(keys.begin(), keys.end(),
+			                       std::back_inserter(many));
+			REQUIRE(many.size() == keys.size());
+			for (size_t i = 0; i < keys.size(); ++i) {
+				std::vector<int>::iterator expect =
+				    std::lower_bound(data.begin(), data.end(), keys[i]);
+				const int* found = index.lower_bound(keys[i]);
+				CHECK(many[i] == found);
+				if (expect == data.end()) {
+					CHECK(found == index.end());
+				} else {
+					REQUIRE(found != index.end());
+					CHECK(*found == *expect);
+				}
+				CHECK(index.contains(keys[i]) ==
+				      std::binary_search(data.begin(), data.end(), keys[i]));
+			}
+		}
+
+		std::vector<std::string> words;
+		for (int i = 0; i < 500; ++i)
+			words.push_back(std::to_string(i * 7));
+		std::sort(words.begin(), words.end(), std::greater<std::string>());
+		mSTL::eytzinger_index<std::string, std::greater<std::string>> index(
+		    words.begin(), words.end());
+		CHECK(index.contains(std::string("49")));
+		CHECK(!index.contains(std::string("50")));
+		CHECK(*index.lower_bound(std::string("50")) == "497");
+
+		mSTL::eytzinger_index<std::string, std::greater<std::string>> moved(
+		    std::move(index));
+		CHECK(index.empty());
+		CHECK(moved.size() == 500);
+		CHECK(moved.contains(std::string("3493")));
+		index = std::move(moved);
+		CHECK(index.size() == 500);
+		index.clear();
+		CHECK(index.begin() == index.end());
+	}
+}
+
+// 小值域使最值重复出现，检验首个最小与最后一个最大
+template <class T>
+void check_minmax(std::mt19937& rng) {
+	const size_t sizes[] = {0, 1, 2, 3, 31, 32, 33, 127, 128, 129, 1000, 40000};
+	for (size_t n : sizes) {
+		for (int range : {3, 1000}) {
+			std::vector<T> data = scan_input<T>(n, range, rng);
+			std::shuffle(data.begin(), data.end(), rng);
+			std::deque<T> deq(data.begin(), data.end());
+			T*            first = data.data();
+			T*            last = first + n;
+
+			CHECK(mSTL::max_element(first, last) == std::max_element(first, last));
+			CHECK(mSTL::min_element(first, last) == std::min_element(first, last));
+			CHECK(mSTL::minmax_element(first, last) ==
+			      std::minmax_element(first, last));
+			const T* cfirst = first;
+			CHECK(mSTL::minmax_element(cfirst, cfirst + n) ==
+			      std::minmax_element(cfirst, cfirst + n));
+			CHECK(mSTL::max_element(first, last, std::greater<T>()) ==
+			      std::max_element(first, last, std::greater<T>()));
+			CHECK(mSTL::minmax_element(first, last, std::greater<T>()) ==
+			      std::minmax_element(first, last, std::greater<T>()));
+			CHECK(mSTL::minmax_element(deq.begin(), deq.end()).second -
+			          deq.begin() ==
+			      std::minmax_element(first, last).second - first);
+
+			// 8 位类型下 range / 2 会回绕，取两者的较小值作下界
+			const T lo =
+			    std::min(static_cast<T>(range / 8), static_cast<T>(range / 2));
+			const T hi =
+			    std::max(static_cast<T>(range / 8), static_cast<T>(range / 2));
+			std::vector<T> expect(data);
+			for (T& x : expect)
+				x = std::min(std::max(x, lo), hi);
+			mSTL::clamp(first, last, lo, hi);
+			CHECK(data == expect);
+			mSTL::clamp(deq.begin(), deq.end(), lo, hi);
+			CHECK(std::equal(deq.begin(), deq.end(), expect.begin()));
+		}
+	}
+}
+
+TEST_CASE(" minimum / maximum operations ") {
+	std::mt19937 rng(50);
+
+	SUBCASE(" arithmetic types ") {
+		check_minmax<int8_t>(rng);
+		check_minmax<uint8_t>(rng);
+		check_minmax<char>(rng);
+		check_minmax<int16_t>(rng);
+		check_minmax<uint16_t>(rng);
+		check_minmax<int>(rng);
+		check_minmax<unsigned>(rng);
+		check_minmax<int64_t>(rng);
+		check_minmax<uint64_t>(rng);
+		check_minmax<float>(rng);
+		check_minmax<double>(rng);
+	}
+
+	SUBCASE(" values && initializer lists ") {
+		int a = 1, b = 1;
+		CHECK(&mSTL::max(a, b) == &a);
+		CHECK(&mSTL::min(a, b) == &a);
+		CHECK(&mSTL::minmax(a, b).first == &a);
+		CHECK(&mSTL::minmax(a, b).second == &b);
+		CHECK(mSTL::max(3, 7, std::greater<int>()) == 3);
+		CHECK(mSTL::max({4, 9, 2, 9}) == 9);
+		CHECK(mSTL::min({4, 9, 2, 9}) == 2);
+		CHECK(mSTL::minmax({4, 9, 2, 9}) == std::make_pair(2, 9));
+		CHECK(mSTL::minmax({4, 9, 2}, std::greater<int>()) ==
+		      std::make_pair(9, 2));
+
+		static_assert(mSTL::clamp(5, 1, 3) == 3, "clamp is constexpr");
+		CHECK(mSTL::clamp(-5, 1, 3) == 1);
+		CHECK(mSTL::clamp(2, 1, 3) == 2);
+		CHECK(mSTL::clamp(2, 3, 1, std::greater<int>()) == 2);
+		CHECK(mSTL::clamp(7, 3, 1, std::greater<int>()) == 3);
+		std::string s("m");
+		CHECK(mSTL::clamp(s, std::string("a"), std::string("k")) == "k");
+	}
+
+	SUBCASE(" NaN && signed zero ") {
+		// 含 NaN 时结果依赖比较顺序，应与 std 完全一致
+		const double nan = std::nan("");
+		std::vector<double> data(300, 1.0);
+		data[10] = 5.0;
+		data[100] = nan;
+		data[200] = -3.0;
+		data[250] = 5.0;
+		for (size_t start : {0, 100, 101}) {
+			double* first = data.data() + start;
+			double* last = data.data() + data.size();
+			CHECK(mSTL::max_element(first, last) == std::max_element(first, last));
+			CHECK(mSTL::min_element(first, last) == std::min_element(first, last));
+			CHECK(mSTL::minmax_element(first, last) ==
+			      std::minmax_element(first, last));
+		}
+
+		// ±0.0 相等: 走 simd 路径时仍返回首个最小与最后一个最大
+		// 16 KiB 一块即 4096 个 float，正负零交替分布于多个块
+		std::vector<float> zeros(3 * 4096 + 37);
+		for (size_t i = 0; i < zeros.size(); ++i)
+			zeros[i] = (i / 1000) % 2 == 0 ? 0.0f : -0.0f;
+		float* zfirst = zeros.data();
+		float* zlast = zfirst + zeros.size();
+		CHECK(mSTL::min_element(zfirst, zlast) == zfirst);
+		CHECK(mSTL::max_element(zfirst, zlast) == zfirst);
+		CHECK(mSTL::minmax_element(zfirst, zlast) ==
+		      std::make_pair(zfirst, zlast - 1));
+
+		// 其余元素为 1.0，零位于中间各块
+		for (size_t i = 0; i < zeros.size(); ++i)
+			zeros[i] = 1.0f;
+		zeros[4100] = -0.0f;
+		zeros[8200] = 0.0f;
+		zeros[12300] = -0.0f;
+		CHECK(mSTL::min_element(zfirst, zlast) == std::min_element(zfirst, zlast));
+		CHECK(mSTL::minmax_element(zfirst, zlast) ==
+		      std::minmax_element(zfirst, zlast));
+		CHECK(mSTL::min_element(zfirst, zlast) == zfirst + 4100);
+
+		mSTL::clamp(data.data(), data.data() + data.size(), 0.0, 2.0);
+		CHECK(data[10] == 2.0);
+		CHECK(std::isnan(data[100]));
+		CHECK(data[200] == 0.0);
+		CHECK(data[299] == 1.0);
+	}
+
+	SUBCASE(" kernels of each isa ") {
+		typedef mSTL::simd simd;
+		std::vector<int16_t> shorts = scan_input<int16_t>(999, 30000, rng);
+		std::vector<double>  doubles = scan_input<double>(999, 500, rng);
+		for (int level = simd::isa_scalar; level <= simd::isa_avx512; ++level) {
+			simd::isa_level isa = static_cast<simd::isa_level>(level);
+			for (size_t n = 1; n < shorts.size(); n += 37) {
+				int16_t lo = 0, hi = 0;
+				CHECK(simd::minmax_kernels_for<int16_t>(isa).minmax(
+				    shorts.data(), n, &lo, &hi));
+				CHECK(lo == *std::min_element(shorts.begin(), shorts.begin() + n));
+				CHECK(hi == *std::max_element(shorts.begin(), shorts.begin() + n));
+
+				std::vector<double> clamped(doubles.begin(), doubles.begin() + n);
+				simd::minmax_kernels_for<double>(isa).clamp(clamped.data(), n,
+				                                            -10.0, 20.0);
+				for (size_t i = 0; i < n; ++i)
+					CHECK(clamped[i] ==
+					      std::min(std::max(doubles[i], -10.0), 20.0));
+			}
+		}
+	}
+}
+
+MSTL_TEST_NAMESPACE_END
@@ -6,6 +6,7 @@
 
 #include <array>
 #include <string>
+#include <unordered_set>
 
 MSTL_TEST_NAMESPACE_BEGIN
 
@@ -605,6 +606,41 @@ TEST_CASE(" compare ") {
 	}
 }
 
+TEST_CASE(" compare fast paths && hash ") {
+	m_array<unsigned char, 4> mbytes_a = {1, 2, 200, 4};
+	m_array<unsigned char, 4> mbytes_b = {1, 2, 3, 4};
+	CHECK(mbytes_b < mbytes_a);
+	CHECK_FALSE(mbytes_a < mbytes_b);
+	CHECK_FALSE(mbytes_a == mbytes_b);
+
+	m_array<int, 40> mints_a{}, mints_b{};
+	CHECK(mints_a == mints_b);
+	mints_b[37] = -1;
+	CHECK(mints_b < mints_a);
+	CHECK_FALSE(mints_a == mints_b);
+	CHECK_NE(mints_a.hash(), mints_b.hash());
+	mints_a[37] = -1;
+	CHECK(mints_a == mints_b);
+	CHECK_EQ(mints_a.hash(), mints_b.hash());
+
+	m_array<double, 2> mdoubles_a = {0.0, 1.0};
+	m_array<double, 2> mdoubles_b = {-0.0, 1.0};
+	CHECK(mdoubles_a == mdoubles_b);
+
+	m_array<string, 2> mstrings_a = {"x", "y"};
+	m_array<string, 2> mstrings_b = {"x", "y"};
+	CHECK_EQ(mstrings_a.hash(), mstrings_b.hash());
+
+	m_array<int, 0> mempty_a, mempty_b;
+	CHECK(mempty_a == mempty_b);
+	CHECK_FALSE(mempty_a < mempty_b);
+	CHECK_EQ(mempty_a.hash(), mempty_b.hash());
+
+	std::unordered_set<m_array<int, 40>> keys;
+	keys.insert(mints_a);
+	CHECK_EQ(keys.count(mints_b), 1);
+}
+
 TEST_CASE(" no-member function ( mSTL::get(...) series ) ") {
 
 	///<- string
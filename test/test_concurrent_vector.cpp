@@ -0,0 +1,204 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "test_basic.h"
+
+#include "../include/doctest.h"
+#include "../src/concurrent_vector.h"
+
+#include <algorithm>
+#include <atomic>
+#include <list>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+MSTL_TEST_NAMESPACE_BEGIN
+
+using string = std::string;
+
+template <class T>
+using m_concurrent_vector = mSTL::concurrent_vector<T>;
+
+TEST_CASE(" construct concurrent_vector() && element access ") {
+
+	m_concurrent_vector<int> mcv;
+	CHECK(mcv.empty());
+	CHECK_EQ(mcv.capacity(), 0);
+	CHECK_FALSE(mcv.is_published(0));
+
+	m_concurrent_vector<string> mcv_n(100, "abc");
+	CHECK_EQ(mcv_n.size(), 100);
+	CHECK_GE(mcv_n.capacity(), 100);
+	for (const auto& s : mcv_n)
+		CHECK_EQ(s, "abc");
+
+	m_concurrent_vector<int> mcv_il{1, 2, 3, 4, 5};
+	CHECK_EQ(mcv_il.front(), 1);
+	CHECK_EQ(mcv_il.back(), 5);
+	CHECK_EQ(mcv_il.at(2), 3);
+	CHECK_THROWS(mcv_il.at(5));
+	CHECK(mcv_il.is_published(4));
+
+	auto it = mcv_il.push_back(6);
+	CHECK_EQ(*it, 6);
+	CHECK_EQ(it - mcv_il.begin(), 5);
+
+	it = mcv_il.grow_by({7, 8, 9});
+	CHECK_EQ(*it, 7);
+	CHECK_EQ(mcv_il.size(), 9);
+	CHECK_EQ(mcv_il.back(), 9);
+
+	int index = 9;
+	for (auto rit = mcv_il.rbegin(); rit != mcv_il.rend(); ++rit, --index)
+		CHECK_EQ(*rit, index);
+
+	m_concurrent_vector<int> mcv_copy(mcv_il);
+	CHECK_EQ(mcv_copy, mcv_il);
+
+	m_concurrent_vector<int> mcv_move(std::move(mcv_copy));
+	CHECK_EQ(mcv_copy.size(), 0);
+	CHECK_EQ(mcv_move, mcv_il);
+
+	mcv_move.clear();
+	CHECK(mcv_move.empty());
+	mcv_move.shrink_to_fit();
+	CHECK_EQ(mcv_move.capacity(), 0);
+}
+
+TEST_CASE(" stable address && grow_by ") {
+
+	m_concurrent_vector<string> mcv;
+	std::vector<const string*> address;
+
+	for (int i = 0; i < 3000; ++i)
+		address.push_back(&*mcv.push_back(std::to_string(i)));
+
+	auto it = mcv.grow_by(5000, "x");
+	CHECK_EQ(it - mcv.begin(), 3000);
+	CHECK_EQ(mcv.size(), 8000);
+	CHECK_EQ(mcv[7999], "x");
+
+	for (int i = 0; i < 3000; ++i) {
+		CHECK_EQ(&mcv[i], address[i]);
+		CHECK_EQ(*address[i], std::to_string(i));
+	}
+
+	mcv.reserve(20000);
+	CHECK_GE(mcv.capacity(), 20000);
+	CHECK_EQ(&mcv[0], address[0]);
+
+	// 单趟输入迭代器与双向迭代器
+	std::istringstream in("a bb ccc");
+	it = mcv.grow_by(std::istream_iterator<string>(in),
+	                 std::istream_iterator<string>());
+	CHECK_EQ(it - mcv.begin(), 8000);
+	CHECK_EQ(mcv.size(), 8003);
+	CHECK_EQ(mcv[8002], "ccc");
+
+	std::list<string> words = {"p", "q"};
+	it = mcv.grow_by(words.begin(), words.end());
+	CHECK_EQ(it - mcv.begin(), 8003);
+	CHECK_EQ(mcv.back(), "q");
+}
+
+TEST_CASE(" concurrent push_back && grow_by ") {
+
+	const int threads = 8;
+	const int per_thread = 20000;
+
+	m_concurrent_vector<int> mcv;
+	std::vector<std::thread> workers;
+
+	for (int t = 0; t < threads; ++t) {
+		workers.emplace_back([&mcv, t]() {
+			for (int i = 0; i < per_thread; ++i) {
+				if (i % 100 == 0) {
+					int values[4] = {-1, -1, -1, -1};
+					mcv.grow_by(values, values + 4);
+				}
+				mcv.push_back(t * per_thread + i);
+			}
+		});
+	}
+	for (auto& worker : workers)
+		worker.join();
+
+	CHECK_EQ(mcv.size(), threads * (per_thread + per_thread / 100 * 4));
+
+	// 每个值恰好出现一次
+	std::vector<int> values;
+	for (int value : mcv) {
+		if (value >= 0)
+			values.push_back(value);
+	}
+	std::sort(values.begin(), values.end());
+	REQUIRE_EQ(values.size(), threads * per_thread);
+	for (int i = 0; i < threads * per_thread; ++i)
+		CHECK_EQ(values[i], i);
+}
+
+TEST_CASE(" independent vectors growing on different threads ") {
+
+	// 段内存不经过全局 alloc 内存池，各线程各自的容器与其他容器可同时分配
+	const int                threads = 4;
+	std::vector<int>         ok(threads, 0);
+	std::vector<std::thread> workers;
+	for (int t = 0; t < threads; ++t) {
+		workers.emplace_back([&ok, t]() {
+			bool good = true;
+			for (int round = 0; round < 200; ++round) {
+				m_concurrent_vector<int> mcv;
+				for (int i = 0; i < 100; ++i)
+					mcv.push_back(i);
+				good = good && mcv.size() == 100 && mcv[99] == 99;
+			}
+			ok[t] = good;
+		});
+	}
+	for (auto& worker : workers)
+		worker.join();
+
+	for (int t = 0; t < threads; ++t)
+		CHECK(ok[t]);
+}
+
+TEST_CASE(" concurrent read of published elements ") {
+
+	const int writers = 4;
+	const int per_thread = 20000;
+
+	m_concurrent_vector<string> mcv;
+	std::atomic<bool> done(false);
+	std::atomic<bool> broken(false);
+
+	std::thread reader([&]() {
+		while (!done.load()) {
+			size_t n = mcv.size();
+			for (size_t i = 0; i < n; ++i) {
+				if (mcv.is_published(i) && mcv[i] != string(8, 'w'))
+					broken.store(true);
+			}
+		}
+	});
+
+	std::vector<std::thread> workers;
+	for (int t = 0; t < writers; ++t) {
+		workers.emplace_back([&mcv]() {
+			for (int i = 0; i < per_thread; ++i)
+				mcv.emplace_back(8, 'w');
+		});
+	}
+	for (auto& worker : workers)
+		worker.join();
+	done.store(true);
+	reader.join();
+
+	CHECK_FALSE(broken.load());
+	CHECK_EQ(mcv.size(), writers * per_thread);
+	for (size_t i = 0; i < mcv.size(); ++i) {
+		CHECK(mcv.is_published(i));
+		CHECK_EQ(mcv[i], string(8, 'w'));
+	}
+}
+
+MSTL_TEST_NAMESPACE_END
@@ -0,0 +1,252 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "test_basic.h"
+
+#include "../include/doctest.h"
+#include "../src/inplace_vector.h"
+
+#include <iterator>
+#include <list>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+MSTL_TEST_NAMESPACE_BEGIN
+
+template <class T, size_t N>
+using m_inplace_vector = mSTL::inplace_vector<T, N>;
+template <class T>
+using std_vector = std::vector<T>;
+using string = std::string;
+
+TEST_CASE(" construct inplace_vector() && trivially copyable ") {
+
+	static_assert(std::is_trivially_copyable<m_inplace_vector<int, 8>>::value,
+	              "inplace_vector<int> should be trivially copyable");
+	static_assert(
+	    !std::is_trivially_copyable<m_inplace_vector<string, 8>>::value,
+	    "inplace_vector<string> should not be trivially copyable");
+
+	// 元素个数采用最小可用类型存储
+	CHECK_EQ(sizeof(m_inplace_vector<char, 15>), 16);
+	CHECK_EQ(sizeof(m_inplace_vector<int, 4>), 5 * sizeof(int));
+
+	///<- string
+	m_inplace_vector<string, 4> mivec_s;
+
+	CHECK_EQ(mivec_s.size(), 0);
+	CHECK_EQ(mivec_s.capacity(), 4);
+	CHECK_EQ(mivec_s.max_size(), 4);
+	CHECK(mivec_s.empty());
+
+	///<- int
+	m_inplace_vector<int, 4> mivec_i(3, 7);
+	m_inplace_vector<int, 4> mivec_i_copy = mivec_i;
+
+	CHECK_EQ(mivec_i_copy.size(), 3);
+	CHECK_EQ(mivec_i_copy[2], 7);
+
+	m_inplace_vector<int, 0> mivec_zero;
+	CHECK(mivec_zero.empty());
+	CHECK_EQ(mivec_zero.try_push_back(1), nullptr);
+}
+
+TEST_CASE(" copy construct and move construct && operator= ") {
+
+	///<- string
+	m_inplace_vector<string, 8> mivec_s_1 = {"a", "b", "c"};
+	m_inplace_vector<string, 8> mivec_s_2(mivec_s_1);
+	m_inplace_vector<string, 8> mivec_s_3(std::move(mivec_s_1));
+
+	CHECK_EQ(mivec_s_2.size(), 3);
+	CHECK_EQ(mivec_s_2, mivec_s_3);
+
+	m_inplace_vector<string, 8> mivec_s_4 = {"x"};
+	mivec_s_4 = mivec_s_2;
+	CHECK_EQ(mivec_s_4, mivec_s_2);
+
+	mivec_s_4 = {"p", "q"};
+	CHECK_EQ(mivec_s_4.size(), 2);
+	CHECK_EQ(mivec_s_4[1], "q");
+
+	mivec_s_4 = std::move(mivec_s_3);
+	CHECK_EQ(mivec_s_4, mivec_s_2);
+
+	///<- int
+	std_vector<int>          stdvec_i = {1, 2, 3, 4};
+	m_inplace_vector<int, 4> mivec_i(stdvec_i.begin(), stdvec_i.end());
+
+	CHECK_EQ(mivec_i.size(), 4);
+	for (size_t i = 0; i < stdvec_i.size(); ++i)
+		CHECK_EQ(mivec_i[i], stdvec_i[i]);
+
+	CHECK_THROWS(m_inplace_vector<int, 2>(stdvec_i.begin(), stdvec_i.end()));
+	CHECK_THROWS(m_inplace_vector<int, 2>(3, 1));
+}
+
+TEST_CASE(" push_back && try_push_back && unchecked_push_back ") {
+
+	///<- string
+	m_inplace_vector<string, 4> mivec_s;
+
+	mivec_s.push_back("a");
+	mivec_s.emplace_back(2, 'b');
+	CHECK_NE(mivec_s.try_push_back("c"), nullptr);
+	mivec_s.unchecked_push_back("d");
+
+	CHECK_EQ(mivec_s.size(), 4);
+	CHECK_EQ(mivec_s[1], "bb");
+	CHECK_EQ(mivec_s.try_push_back("e"), nullptr);
+	CHECK_EQ(mivec_s.try_emplace_back(3, 'e'), nullptr);
+	CHECK_THROWS(mivec_s.push_back("e"));
+	CHECK_EQ(mivec_s.size(), 4);
+	CHECK_EQ(mivec_s.back(), "d");
+
+	mivec_s.pop_back();
+	string* pos = mivec_s.try_push_back("f");
+	CHECK_EQ(pos, &mivec_s.back());
+	CHECK_EQ(*pos, "f");
+
+	///<- int
+	m_inplace_vector<int, 16> mivec_i;
+	for (int i = 0; i < 16; ++i)
+		mivec_i.unchecked_push_back(i);
+
+	CHECK_EQ(mivec_i.size(), 16);
+	CHECK_EQ(mivec_i.try_push_back(16), nullptr);
+	CHECK_EQ(mivec_i.at(15), 15);
+	CHECK_THROWS(mivec_i.at(16));
+}
+
+TEST_CASE(" insert && erase && emplace && resize ") {
+
+	///<- string
+	m_inplace_vector<string, 16> mivec_s = {"a", "b"};
+	std_vector<string>           stdvec_s = {"a", "b"};
+
+	mivec_s.insert(mivec_s.begin() + 1, "c");
+	stdvec_s.insert(stdvec_s.begin() + 1, "c");
+	mivec_s.insert(mivec_s.begin(), 3, "d");
+	stdvec_s.insert(stdvec_s.begin(), 3, "d");
+	mivec_s.insert(mivec_s.end(), {"e", "f"});
+	stdvec_s.insert(stdvec_s.end(), {"e", "f"});
+	mivec_s.emplace(mivec_s.begin() + 2, 2, 'g');
+	stdvec_s.emplace(stdvec_s.begin() + 2, 2, 'g');
+
+	CHECK_EQ(mivec_s.size(), stdvec_s.size());
+	for (size_t i = 0; i < stdvec_s.size(); ++i)
+		CHECK_EQ(mivec_s[i], stdvec_s[i]);
+
+	auto mit = mivec_s.erase(mivec_s.begin() + 1, mivec_s.begin() + 4);
+	auto stdit = stdvec_s.erase(stdvec_s.begin() + 1, stdvec_s.begin() + 4);
+	CHECK_EQ(*mit, *stdit);
+
+	mivec_s.erase(mivec_s.begin());
+	stdvec_s.erase(stdvec_s.begin());
+
+	CHECK_EQ(mivec_s.size(), stdvec_s.size());
+	for (size_t i = 0; i < stdvec_s.size(); ++i)
+		CHECK_EQ(mivec_s[i], stdvec_s[i]);
+
+	mivec_s.resize(10, "z");
+	stdvec_s.resize(10, "z");
+	mivec_s.resize(6);
+	stdvec_s.resize(6);
+
+	CHECK_EQ(mivec_s.size(), stdvec_s.size());
+	for (size_t i = 0; i < stdvec_s.size(); ++i)
+		CHECK_EQ(mivec_s[i], stdvec_s[i]);
+
+	CHECK_THROWS(mivec_s.resize(17));
+	CHECK_THROWS(mivec_s.insert(mivec_s.begin(), 11, "y"));
+	CHECK_EQ(mivec_s.size(), 6);
+
+	///<- int
+	m_inplace_vector<int, 8> mivec_i = {1, 2, 3};
+	std_vector<int>          stdvec_i = {10, 11, 12};
+
+	mivec_i.insert(mivec_i.begin() + 1, stdvec_i.begin(), stdvec_i.end());
+	CHECK_EQ(mivec_i.size(), 6);
+	CHECK_EQ(mivec_i[0], 1);
+	CHECK_EQ(mivec_i[1], 10);
+	CHECK_EQ(mivec_i[4], 2);
+	CHECK_EQ(mivec_i[5], 3);
+}
+
+TEST_CASE(" iterator && swap && compare ") {
+
+	///<- string
+	m_inplace_vector<string, 4> mivec_s_1 = {"a"};
+	m_inplace_vector<string, 4> mivec_s_2 = {"b", "c", "d"};
+
+	swap(mivec_s_1, mivec_s_2);
+	CHECK_EQ(mivec_s_1.size(), 3);
+	CHECK_EQ(mivec_s_2.size(), 1);
+	CHECK_EQ(mivec_s_2[0], "a");
+
+	string joined;
+	for (auto it = mivec_s_1.rbegin(); it != mivec_s_1.rend(); ++it)
+		joined += *it;
+	CHECK_EQ(joined, "dcb");
+
+	///<- int
+	std_vector<std_vector<int>> stdvec_i = {{5, 6, 7}, {1, 2, 3}, {8, 9},
+	                                        {5, 6, 7, 8}, {5, 6}};
+	std_vector<int>          stdvec_i_1 = {5, 6, 7};
+	m_inplace_vector<int, 4> mivec_i_1 = {5, 6, 7};
+
+	for (size_t i = 0; i < stdvec_i.size(); ++i) {
+		m_inplace_vector<int, 4> mivec_i(stdvec_i[i].begin(),
+		                                 stdvec_i[i].end());
+
+		CHECK_EQ(stdvec_i_1 == stdvec_i[i], mivec_i_1 == mivec_i);
+		CHECK_EQ(stdvec_i_1 != stdvec_i[i], mivec_i_1 != mivec_i);
+		CHECK_EQ(stdvec_i_1 < stdvec_i[i], mivec_i_1 < mivec_i);
+		CHECK_EQ(stdvec_i_1 > stdvec_i[i], mivec_i_1 > mivec_i);
+		CHECK_EQ(stdvec_i_1 <= stdvec_i[i], mivec_i_1 <= mivec_i);
+		CHECK_EQ(stdvec_i_1 >= stdvec_i[i], mivec_i_1 >= mivec_i);
+	}
+}
+
+TEST_CASE(" range assign && insert with input and forward iterators ") {
+
+	///<- input iterator
+	std::istringstream       in_1("1 2 3");
+	m_inplace_vector<int, 8> mivec_in(std::istream_iterator<int>(in_1),
+	                                  std::istream_iterator<int>{});
+	CHECK_EQ(mivec_in, m_inplace_vector<int, 8>{1, 2, 3});
+
+	std::istringstream in_2("4 5");
+	mivec_in.assign(std::istream_iterator<int>(in_2),
+	                std::istream_iterator<int>{});
+	CHECK_EQ(mivec_in, m_inplace_vector<int, 8>{4, 5});
+
+	std::istringstream in_3("7 8 9");
+	auto it = mivec_in.insert(mivec_in.begin() + 1,
+	                          std::istream_iterator<int>(in_3),
+	                          std::istream_iterator<int>{});
+	CHECK_EQ(it, mivec_in.begin() + 1);
+	CHECK_EQ(mivec_in, m_inplace_vector<int, 8>{4, 7, 8, 9, 5});
+
+	// 超出容量时抛出异常，原有元素保持不变
+	std::istringstream in_4("1 2 3 4");
+	CHECK_THROWS_AS(mivec_in.insert(mivec_in.begin(),
+	                                std::istream_iterator<int>(in_4),
+	                                std::istream_iterator<int>{}),
+	                const char*);
+	CHECK_EQ(mivec_in, m_inplace_vector<int, 8>{4, 7, 8, 9, 5});
+
+	///<- forward iterator
+	std::list<string>           list_s = {"a", "bb", "ccc"};
+	m_inplace_vector<string, 6> mivec_s(list_s.begin(), list_s.end());
+	CHECK_EQ(mivec_s, m_inplace_vector<string, 6>{"a", "bb", "ccc"});
+
+	mivec_s.insert(mivec_s.begin() + 1, list_s.begin(), list_s.end());
+	CHECK_EQ(mivec_s, m_inplace_vector<string, 6>{"a", "a", "bb", "ccc",
+	                                              "bb", "ccc"});
+
+	mivec_s.assign(list_s.rbegin(), list_s.rend());
+	CHECK_EQ(mivec_s, m_inplace_vector<string, 6>{"ccc", "bb", "a"});
+}
+
+MSTL_TEST_NAMESPACE_END
@@ -0,0 +1,136 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "test_basic.h"
+
+#include "../include/doctest.h"
+#include "../src/mmap_vector.h"
+
+#include <cstdio>
+#include <string>
+
+MSTL_TEST_NAMESPACE_BEGIN
+
+using string = std::string;
+
+struct record {
+	int    id;
+	double value;
+};
+
+static const string path = "test_mmap_vector.bin";
+
+static long file_size(const string& name) {
+	struct stat st;
+	return ::stat(name.c_str(), &st) == 0 ? static_cast<long>(st.st_size) : -1;
+}
+
+TEST_CASE(" construct mmap_vector() && read write ") {
+
+	std::remove(path.c_str());
+
+	mSTL::mmap_vector<record> mmv;
+	CHECK_FALSE(mmv.is_open());
+	CHECK(mmv.empty());
+
+	mmv.open(path, mSTL::mmap_mode::read_write);
+	CHECK(mmv.is_open());
+	CHECK_EQ(mmv.size(), 0);
+	CHECK_EQ(mmv.data(), nullptr);
+
+	for (int i = 0; i < 10000; ++i)
+		mmv.push_back(record{i, i * 0.5});
+	mmv.emplace_back(record{-1, -1.0});
+
+	CHECK_EQ(mmv.size(), 10001);
+	CHECK_GE(mmv.capacity(), 10001);
+	CHECK_EQ(mmv.front().id, 0);
+	CHECK_EQ(mmv.back().id, -1);
+	CHECK_EQ(mmv.at(9999).value, 9999 * 0.5);
+	CHECK_THROWS(mmv.at(10001));
+
+	// 引用自身元素
+	mmv.shrink_to_fit();
+	CHECK_EQ(mmv.capacity(), mmv.size());
+	mmv.push_back(mmv[1]);
+	CHECK_EQ(mmv.back().id, 1);
+
+	mmv.pop_back();
+	mmv.pop_back();
+	mmv.advise(mSTL::mmap_advice::sequential);
+	mmv.advise(mSTL::mmap_advice::willneed, 100, 1000);
+	mmv.flush();
+	mmv.close();
+
+	// 关闭时截断为 size() 个元素
+	CHECK_EQ(file_size(path), static_cast<long>(10000 * sizeof(record)));
+
+	mSTL::mmap_vector<record> mmv_ro(path);
+	CHECK_EQ(mmv_ro.mode(), mSTL::mmap_mode::read_only);
+	REQUIRE_EQ(mmv_ro.size(), 10000);
+	for (int i = 0; i < 10000; ++i) {
+		CHECK_EQ(mmv_ro[i].id, i);
+		CHECK_EQ(mmv_ro[i].value, i * 0.5);
+	}
+	CHECK_THROWS(mmv_ro.push_back(record{0, 0}));
+	CHECK_THROWS(mmv_ro.reserve(20000));
+
+	mmv_ro.close();
+	CHECK_EQ(file_size(path), static_cast<long>(10000 * sizeof(record)));
+
+	std::remove(path.c_str());
+}
+
+TEST_CASE(" iterator && span && resize && assign ") {
+
+	std::remove(path.c_str());
+
+	mSTL::mmap_vector<int> mmv(path, mSTL::mmap_mode::read_write,
+	                           mSTL::mmap_flush::sync_on_close);
+	mmv.assign({1, 2, 3, 4, 5});
+	CHECK_EQ(mmv.size(), 5);
+
+	int sum = 0;
+	for (int value : mmv)
+		sum += value;
+	CHECK_EQ(sum, 15);
+
+	int index = 5;
+	for (auto it = mmv.rbegin(); it != mmv.rend(); ++it, --index)
+		CHECK_EQ(*it, index);
+
+	mSTL::span<int> view = mmv.as_span();
+	CHECK_EQ(view.size(), 5);
+	CHECK_EQ(view.data(), mmv.data());
+	view[0] = 10;
+	CHECK_EQ(mmv[0], 10);
+
+	mmv.resize(100000, 7);
+	CHECK_EQ(mmv.size(), 100000);
+	CHECK_EQ(mmv[99999], 7);
+	CHECK_EQ(mmv[4], 5);
+
+	mmv.resize(3);
+	CHECK_EQ(mmv.size(), 3);
+
+	int arr[] = {9, 8, 7, 6};
+	mmv.assign(arr, arr + 4);
+	CHECK_EQ(mmv.size(), 4);
+	CHECK_EQ(mmv[3], 6);
+
+	mSTL::mmap_vector<int> mmv_moved(std::move(mmv));
+	CHECK_FALSE(mmv.is_open());
+	CHECK_EQ(mmv_moved.size(), 4);
+
+	mmv_moved.assign(2, 42);
+	mmv = std::move(mmv_moved);
+	mmv.close();
+
+	mSTL::mmap_vector<int> mmv_ro(path);
+	CHECK_EQ(mmv_ro.size(), 2);
+	CHECK_EQ(mmv_ro[1], 42);
+	mmv_ro.close();
+
+	std::remove(path.c_str());
+	CHECK_THROWS(mmv_ro.open(path));
+}
+
+MSTL_TEST_NAMESPACE_END
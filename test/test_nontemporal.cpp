@@ -0,0 +1,96 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "test_basic.h"
+
+#include "../include/doctest.h"
+#include "../src/nontemporal.h"
+#include "../src/vector.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+MSTL_TEST_NAMESPACE_BEGIN
+
+struct triple {
+	int a, b, c;
+};
+
+TEST_CASE(" nontemporal copy ") {
+	std::vector<unsigned char> src(70000), dest(70000), expect(70000);
+	for (size_t i = 0; i < src.size(); ++i)
+		src[i] = static_cast<unsigned char>(i * 31 + 7);
+
+	// 覆盖各种首尾对齐与长度
+	const size_t offsets[] = {0, 1, 7, 16, 31, 33};
+	const size_t lengths[] = {0, 1, 31, 64, 127, 128, 129, 4096, 65537};
+	for (size_t dest_offset : offsets)
+		for (size_t src_offset : offsets)
+			for (size_t length : lengths) {
+				std::fill(dest.begin(), dest.end(), 0xcc);
+				expect = dest;
+				memcpy(&expect[dest_offset], &src[src_offset], length);
+				mSTL::nontemporal::copy(&dest[dest_offset], &src[src_offset],
+				                        length);
+				CHECK(dest == expect);
+			}
+}
+
+TEST_CASE(" nontemporal fill_n ") {
+	std::vector<long long> buffer(10000, -1);
+	for (size_t offset = 0; offset < 5; ++offset)
+		for (size_t count : {0, 1, 3, 4, 5, 100, 9990}) {
+			std::fill(buffer.begin(), buffer.end(), -1);
+			bool streamed =
+			    mSTL::nontemporal::fill_n(&buffer[offset], count, 42LL);
+			if (streamed) {
+				CHECK_EQ(std::count(buffer.begin(), buffer.end(), 42LL), count);
+				CHECK_EQ(std::count(buffer.begin() + offset,
+				                    buffer.begin() + offset + count, 42LL),
+				         count);
+			}
+		}
+
+	std::vector<short> shorts(1001, 0);
+	if (mSTL::nontemporal::fill_n(&shorts[1], 1000, short(-3)))
+		CHECK_EQ(std::count(shorts.begin() + 1, shorts.end(), short(-3)), 1000);
+	CHECK_EQ(shorts[0], 0);
+
+	// 大小不整除 32 的类型交由调用者处理
+	triple t = {1, 2, 3};
+	triple ts[8];
+	CHECK_FALSE(mSTL::nontemporal::fill_n(ts, 8, t));
+}
+
+TEST_CASE(" vector with nontemporal threshold ") {
+	// 默认关闭，需显式设置阈值
+	CHECK_EQ(mSTL::nontemporal::threshold(), 0);
+	CHECK_FALSE(mSTL::nontemporal::enabled(size_t(1) << 40));
+	CHECK(mSTL::nontemporal::recommended_threshold() >= (size_t(1) << 20));
+
+	size_t old_threshold = mSTL::nontemporal::threshold();
+	mSTL::nontemporal::set_threshold(1024);
+
+	mSTL::vector<int> mvec(size_t(100001), 5);
+	CHECK_EQ(std::count(mvec.begin(), mvec.end(), 5), 100001);
+
+	for (size_t i = 0; i < mvec.size(); ++i)
+		mvec[i] = static_cast<int>(i);
+	mSTL::vector<int> mvec_copy(mvec);
+	CHECK(mvec_copy == mvec);
+
+	// 扩容搬移
+	mvec_copy.reserve(mvec_copy.capacity() * 2 + 3);
+	CHECK(mvec_copy == mvec);
+
+	mvec.assign(size_t(3333), 8);
+	mvec.resize(200003, 9);
+	CHECK_EQ(std::count(mvec.begin(), mvec.end(), 8), 3333);
+	CHECK_EQ(std::count(mvec.begin(), mvec.end(), 9), 200003 - 3333);
+
+	mSTL::vector<double> mvec_d(77777, 0.5);
+	CHECK_EQ(std::count(mvec_d.begin(), mvec_d.end(), 0.5), 77777);
+
+	mSTL::nontemporal::set_threshold(old_threshold);
+}
+
+MSTL_TEST_NAMESPACE_END
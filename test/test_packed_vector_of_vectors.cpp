@@ -0,0 +1,167 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "test_basic.h"
+
+#include "../include/doctest.h"
+#include "../src/packed_vector_of_vectors.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+MSTL_TEST_NAMESPACE_BEGIN
+
+using string = std::string;
+
+template <class T>
+using m_packed_vector_of_vectors = mSTL::packed_vector_of_vectors<T>;
+
+TEST_CASE(" construct packed_vector_of_vectors() && push_row ") {
+
+	m_packed_vector_of_vectors<int> mpv;
+	CHECK(mpv.empty());
+	CHECK_EQ(mpv.rows(), 0);
+	CHECK_EQ(mpv.values_size(), 0);
+	CHECK_EQ(mpv.offsets().size(), 1);
+
+	int arr[] = {1, 2, 3};
+	std::vector<int> sv{4, 5};
+
+	mpv.push_row(arr, arr + 3);
+	mpv.push_row(sv);
+	mpv.push_row();
+	mpv.push_row({6});
+
+	CHECK_EQ(mpv.rows(), 4);
+	CHECK_EQ(mpv.values_size(), 6);
+	CHECK_EQ(mpv.row_size(0), 3);
+	CHECK_EQ(mpv.row_size(1), 2);
+	CHECK_EQ(mpv.row_size(2), 0);
+	CHECK_EQ(mpv[1][1], 5);
+	CHECK(mpv[2].empty());
+	CHECK_EQ(mpv.back().front(), 6);
+	CHECK_THROWS(mpv.at(4));
+
+	// 所有元素按行序连续存放
+	int expect = 1;
+	for (int value : mpv.values())
+		CHECK_EQ(value, expect++);
+	CHECK_EQ(mpv[1].data(), mpv.values().data() + 3);
+
+	mpv.push_to_last_row(7);
+	mpv.emplace_to_last_row(8);
+	CHECK_EQ(mpv.row_size(3), 3);
+	CHECK_EQ(mpv[3][2], 8);
+
+	mpv.pop_row();
+	CHECK_EQ(mpv.rows(), 3);
+	CHECK_EQ(mpv.values_size(), 5);
+
+	mpv[0][0] = 100;
+	CHECK_EQ(mpv.values()[0], 100);
+
+	mpv.clear();
+	CHECK(mpv.empty());
+	CHECK_EQ(mpv.values_size(), 0);
+}
+
+TEST_CASE(" row iterator ") {
+
+	m_packed_vector_of_vectors<string> mpv{{"a"}, {}, {"b", "c"}, {"d", "e", "f"}};
+	CHECK_EQ(mpv.rows(), 4);
+
+	size_t row = 0, total = 0;
+	for (auto it = mpv.begin(); it != mpv.end(); ++it, ++row) {
+		CHECK_EQ((*it).size(), mpv.row_size(row));
+		for (const string& s : *it) {
+			CHECK_EQ(s, mpv.values()[total]);
+			++total;
+		}
+	}
+	CHECK_EQ(total, 6);
+	CHECK_EQ(mpv.end() - mpv.begin(), 4);
+
+	auto it = mpv.begin() + 3;
+	CHECK_EQ(it[-1][1], "c");
+	(*it)[0] = "z";
+	CHECK_EQ(mpv[3][0], "z");
+
+	m_packed_vector_of_vectors<string>::const_iterator cit = it;
+	CHECK_EQ((*cit).back(), "f");
+}
+
+TEST_CASE(" assign_pairs ") {
+
+	std::vector<std::pair<int, string>> pairs{
+	    {2, "c0"}, {0, "a0"}, {2, "c1"}, {0, "a1"}, {4, "e0"}, {2, "c2"}};
+
+	m_packed_vector_of_vectors<string> mpv;
+	mpv.push_row({"old"});
+	mpv.assign_pairs(pairs.begin(), pairs.end());
+
+	CHECK_EQ(mpv.rows(), 5);
+	CHECK_EQ(mpv.values_size(), 6);
+
+	// 行内保持输入顺序
+	CHECK_EQ(mpv.row_size(0), 2);
+	CHECK_EQ(mpv[0][0], "a0");
+	CHECK_EQ(mpv[0][1], "a1");
+	CHECK_EQ(mpv.row_size(1), 0);
+	CHECK_EQ(mpv.row_size(2), 3);
+	CHECK_EQ(mpv[2][2], "c2");
+	CHECK_EQ(mpv.row_size(3), 0);
+	CHECK_EQ(mpv[4][0], "e0");
+
+	mpv.assign_pairs(pairs.begin(), pairs.end(), 8);
+	CHECK_EQ(mpv.rows(), 8);
+	CHECK_EQ(mpv.row_size(7), 0);
+	CHECK_EQ(mpv.offsets().back(), 6);
+
+	mpv.assign_pairs(pairs.end(), pairs.end());
+	CHECK(mpv.empty());
+
+	// 与 vector<vector<T>> 结果一致
+	std::vector<std::pair<size_t, int>> edges;
+	std::vector<std::vector<int>> expect(100);
+	for (int i = 0; i < 5000; ++i) {
+		size_t r = static_cast<size_t>(i * 7919) % 97;
+		edges.emplace_back(r, i);
+		expect[r].push_back(i);
+	}
+
+	m_packed_vector_of_vectors<int> graph;
+	graph.assign_pairs(edges.begin(), edges.end(), 100);
+	REQUIRE_EQ(graph.rows(), 100);
+	for (size_t r = 0; r < 100; ++r) {
+		REQUIRE_EQ(graph.row_size(r), expect[r].size());
+		for (size_t i = 0; i < expect[r].size(); ++i)
+			CHECK_EQ(graph[r][i], expect[r][i]);
+	}
+}
+
+TEST_CASE(" copy && move && swap ") {
+
+	m_packed_vector_of_vectors<string> mpv_1{{"a", "b"}, {"c"}};
+
+	m_packed_vector_of_vectors<string> mpv_2(mpv_1);
+	CHECK_EQ(mpv_1, mpv_2);
+
+	mpv_2.push_row({"d"});
+	CHECK_NE(mpv_1, mpv_2);
+
+	m_packed_vector_of_vectors<string> mpv_3(std::move(mpv_2));
+	CHECK_EQ(mpv_3.rows(), 3);
+	CHECK(mpv_2.empty());
+
+	mpv_2 = mpv_3;
+	CHECK_EQ(mpv_2, mpv_3);
+
+	mpv_1 = std::move(mpv_3);
+	CHECK_EQ(mpv_1.rows(), 3);
+	CHECK_EQ(mpv_1[2][0], "d");
+
+	swap(mpv_1, mpv_3);
+	CHECK_EQ(mpv_3.rows(), 3);
+	CHECK(mpv_1.empty());
+}
+
+MSTL_TEST_NAMESPACE_END
@@ -0,0 +1,226 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "test_basic.h"
+
+#include "../include/doctest.h"
+#include "../src/persistent_vector.h"
+
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+MSTL_TEST_NAMESPACE_BEGIN
+
+using string = std::string;
+
+template <class T>
+using m_persistent_vector = mSTL::persistent_vector<T>;
+
+template <class T>
+static bool same(const m_persistent_vector<T>& pv, const std::vector<T>& sv) {
+	if (pv.size() != sv.size())
+		return false;
+
+	size_t i = 0;
+	for (const T& value : pv) {
+		if (value != sv[i] || pv[i] != sv[i])
+			return false;
+		++i;
+	}
+	return true;
+}
+
+TEST_CASE(" construct persistent_vector() && element access ") {
+
+	m_persistent_vector<int> mpv;
+	CHECK(mpv.empty());
+	CHECK_EQ(mpv.begin(), mpv.end());
+
+	m_persistent_vector<string> mpv_n(1000, "abc");
+	CHECK_EQ(mpv_n.size(), 1000);
+	for (const auto& s : mpv_n)
+		CHECK_EQ(s, "abc");
+
+	m_persistent_vector<int> mpv_il{1, 2, 3, 4, 5};
+	CHECK_EQ(mpv_il.front(), 1);
+	CHECK_EQ(mpv_il.back(), 5);
+	CHECK_EQ(mpv_il.at(2), 3);
+	CHECK_THROWS(mpv_il.at(5));
+
+	std::vector<int> sv;
+	for (int i = 0; i < 40000; ++i)
+		sv.push_back(i * 7);
+	m_persistent_vector<int> mpv_it(sv.begin(), sv.end());
+	CHECK(same(mpv_it, sv));
+
+	auto it = mpv_it.begin() + 1234;
+	CHECK_EQ(*it, 1234 * 7);
+	CHECK_EQ(it[100], 1334 * 7);
+	--it;
+	CHECK_EQ(*it, 1233 * 7);
+	it -= 1000;
+	CHECK_EQ(*it, 233 * 7);
+	CHECK_EQ(mpv_it.end() - it, 40000 - 233);
+
+	int index = 39999;
+	for (auto rit = mpv_it.rbegin(); rit != mpv_it.rend(); ++rit, --index)
+		REQUIRE_EQ(*rit, index * 7);
+}
+
+TEST_CASE(" structural sharing && versions ") {
+
+	// 保留每个版本并逐一验证，覆盖 tail 满、根节点分裂等情况
+	const int n = 1200;
+	std::vector<m_persistent_vector<string>> versions;
+	versions.emplace_back();
+
+	for (int i = 0; i < n; ++i)
+		versions.push_back(versions.back().push_back(std::to_string(i)));
+
+	for (int v = 0; v <= n; v += 37) {
+		REQUIRE_EQ(versions[v].size(), static_cast<size_t>(v));
+		for (int i = 0; i < v; ++i)
+			REQUIRE_EQ(versions[v][i], std::to_string(i));
+	}
+
+	// set 只影响新版本
+	m_persistent_vector<string> full = versions.back();
+	m_persistent_vector<string> changed = full.set(0, "x").set(600, "y").set(n - 1, "z");
+	CHECK_EQ(changed[0], "x");
+	CHECK_EQ(changed[600], "y");
+	CHECK_EQ(changed[n - 1], "z");
+	CHECK_EQ(full[0], "0");
+	CHECK_EQ(full[600], "600");
+	CHECK_EQ(full[n - 1], std::to_string(n - 1));
+	CHECK_THROWS(full.set(n, "out"));
+
+	// pop_back 逐步回退，与对应版本一致
+	m_persistent_vector<string> popped = full;
+	for (int v = n; v > 0; --v) {
+		REQUIRE_EQ(popped, versions[v]);
+		popped = popped.pop_back();
+	}
+	CHECK(popped.empty());
+	CHECK_EQ(full.size(), n);
+
+	// 引用自身元素
+	m_persistent_vector<string> self = full.push_back(full[3]);
+	CHECK_EQ(self.back(), "3");
+	self = self.set(1, self[2]);
+	CHECK_EQ(self[1], "2");
+}
+
+// 各线程从同一快照派生并丢弃新版本，共享节点的引用计数被并发增减
+// 元素较小时叶子节点不超过 128 字节，节点分配不得经过 alloc 内存池
+template <class T, class Make>
+static void check_shared_snapshot(Make make) {
+	m_persistent_vector<T> base;
+	for (int i = 0; i < 2000; ++i)
+		base = base.push_back(make(i));
+
+	const int                threads = 4;
+	std::vector<int>         ok(threads, 0);
+	std::vector<std::thread> workers;
+	for (int t = 0; t < threads; ++t) {
+		workers.emplace_back([&base, &ok, &make, t]() {
+			bool good = true;
+			for (int round = 0; round < 200; ++round) {
+				m_persistent_vector<T> copy = base;
+				m_persistent_vector<T> changed =
+				    copy.set(static_cast<size_t>(round * 7), make(-1))
+				        .push_back(make(-2));
+				good = good && changed.size() == 2001 &&
+				       copy[round * 7] == make(round * 7) &&
+				       changed[round * 7] == make(-1);
+			}
+			ok[t] = good;
+		});
+	}
+	for (std::thread& worker : workers)
+		worker.join();
+
+	for (int t = 0; t < threads; ++t)
+		CHECK(ok[t]);
+	CHECK_EQ(base.size(), 2000);
+	CHECK(base[1999] == make(1999));
+}
+
+TEST_CASE(" snapshots shared across threads ") {
+	check_shared_snapshot<string>([](int i) { return std::to_string(i); });
+	check_shared_snapshot<char>(
+	    [](int i) { return static_cast<char>(i % 100 + 10); });
+	check_shared_snapshot<uint16_t>(
+	    [](int i) { return static_cast<uint16_t>(i + 5); });
+}
+
+TEST_CASE(" transient ") {
+
+	mSTL::transient_vector<int> builder;
+	for (int i = 0; i < 5000; ++i)
+		builder.push_back(i);
+	CHECK_EQ(builder.size(), 5000);
+	builder.set(4000, -1);
+	builder.pop_back();
+	CHECK_EQ(builder.back(), 4998);
+
+	m_persistent_vector<int> base = builder.get_persistent();
+	CHECK(builder.empty());
+	CHECK_EQ(base.size(), 4999);
+	CHECK_EQ(base[4000], -1);
+
+	// transient 修改不影响原版本
+	std::vector<int> expect;
+	for (int value : base)
+		expect.push_back(value);
+	auto edit = base.transient();
+	for (int i = 0; i < 3000; ++i)
+		edit.pop_back();
+	for (int i = 0; i < 100; ++i)
+		edit.set(i, i * 2);
+	for (int i = 0; i < 2000; ++i)
+		edit.emplace_back(-i);
+
+	CHECK(same(base, expect));
+
+	m_persistent_vector<int> derived = edit.get_persistent();
+	REQUIRE_EQ(derived.size(), 3999);
+	CHECK_EQ(derived[99], 198);
+	CHECK_EQ(derived[1998], 1998);
+	CHECK_EQ(derived[1999], 0);
+	CHECK_EQ(derived.back(), -1999);
+
+	// 生成的版本之后不再受 transient 影响
+	edit.push_back(1);
+	CHECK_EQ(derived.size(), 3999);
+	CHECK(same(base, expect));
+
+	// 与 std::vector 交替随机操作对比
+	std::vector<string> sv;
+	mSTL::transient_vector<string> mtv;
+	m_persistent_vector<string> snapshot;
+	std::vector<string> snapshot_expect;
+	unsigned seed = 12345;
+	for (int step = 0; step < 20000; ++step) {
+		seed = seed * 1103515245 + 12345;
+		unsigned op = (seed >> 16) % 10;
+		if (op < 6 || sv.empty()) {
+			sv.push_back(std::to_string(step));
+			mtv.push_back(std::to_string(step));
+		} else if (op < 8) {
+			sv.pop_back();
+			mtv.pop_back();
+		} else if (op < 9) {
+			size_t i = (seed >> 8) % sv.size();
+			sv[i] = "s" + std::to_string(step);
+			mtv.set(i, sv[i]);
+		} else {
+			snapshot = mtv.get_persistent();
+			snapshot_expect = sv;
+			mtv = snapshot.transient();
+		}
+	}
+	CHECK(same(snapshot, snapshot_expect));
+	CHECK(same(mtv.get_persistent(), sv));
+}
+
+MSTL_TEST_NAMESPACE_END
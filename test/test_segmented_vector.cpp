@@ -0,0 +1,195 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "test_basic.h"
+
+#include "../include/doctest.h"
+#include "../src/segmented_vector.h"
+
+#include <string>
+#include <vector>
+
+MSTL_TEST_NAMESPACE_BEGIN
+
+using string = std::string;
+
+template <class T>
+using m_segmented_vector = mSTL::segmented_vector<T>;
+
+TEST_CASE(" segment table index ") {
+
+	using traits = mSTL::_segment_table_traits<4>;
+
+	// 逐个下标验证段号与偏移
+	size_t segment = 0, offset = 0;
+	for (size_t i = 0; i < 100000; ++i) {
+		CHECK_EQ(traits::segment_of(i), segment);
+		CHECK_EQ(traits::offset_of(i, segment), offset);
+
+		if (++offset == traits::segment_size(segment)) {
+			++segment;
+			offset = 0;
+		}
+	}
+
+	CHECK_EQ(traits::segment_base(0), 0);
+	CHECK_EQ(traits::segment_base(1), 16);
+	CHECK_EQ(traits::segment_base(2), 48);
+	CHECK_EQ(traits::segment_of(size_t(-1) - 16), traits::max_segments - 1);
+}
+
+TEST_CASE(" construct segmented_vector() && element access ") {
+
+	m_segmented_vector<int> msv;
+	CHECK(msv.empty());
+	CHECK_EQ(msv.capacity(), 0);
+	CHECK_EQ(msv.begin(), msv.end());
+
+	m_segmented_vector<string> msv_n(100, "abc");
+	CHECK_EQ(msv_n.size(), 100);
+	CHECK_GE(msv_n.capacity(), 100);
+	for (const auto& s : msv_n)
+		CHECK_EQ(s, "abc");
+
+	m_segmented_vector<int> msv_il{1, 2, 3, 4, 5};
+	CHECK_EQ(msv_il.front(), 1);
+	CHECK_EQ(msv_il.back(), 5);
+	CHECK_EQ(msv_il.at(2), 3);
+	CHECK_THROWS(msv_il.at(5));
+
+	std::vector<int> sv(1000);
+	for (int i = 0; i < 1000; ++i)
+		sv[i] = i * 3;
+	m_segmented_vector<int> msv_it(sv.begin(), sv.end());
+	CHECK_EQ(msv_it.size(), 1000);
+	for (int i = 0; i < 1000; ++i)
+		CHECK_EQ(msv_it[i], sv[i]);
+}
+
+TEST_CASE(" stable address && push_back && pop_back && resize ") {
+
+	m_segmented_vector<string> msv;
+	std::vector<const string*> address;
+
+	for (int i = 0; i < 5000; ++i) {
+		msv.push_back(std::to_string(i));
+		address.push_back(&msv.back());
+	}
+
+	// 扩容后已有元素地址不变
+	for (int i = 0; i < 5000; ++i) {
+		CHECK_EQ(&msv[i], address[i]);
+		CHECK_EQ(*address[i], std::to_string(i));
+	}
+
+	// 引用自身元素
+	msv.emplace_back(msv[0]);
+	CHECK_EQ(msv.back(), "0");
+
+	size_t total = 0;
+	for (size_t k = 0; k < msv.segment_count(); ++k) {
+		CHECK_EQ(msv.segment_data(k), &msv[m_segmented_vector<string>::traits_type::segment_base(k)]);
+		total += msv.segment_size(k);
+	}
+	CHECK_EQ(total, msv.size());
+
+	msv.pop_back();
+	CHECK_EQ(msv.size(), 5000);
+
+	size_t capacity = msv.capacity();
+	msv.resize(10);
+	CHECK_EQ(msv.size(), 10);
+	CHECK_EQ(msv.capacity(), capacity);
+	CHECK_EQ(&msv[9], address[9]);
+
+	msv.shrink_to_fit();
+	CHECK_EQ(msv.capacity(), 16);
+	CHECK_EQ(msv[9], "9");
+
+	msv.resize(40, "x");
+	CHECK_EQ(msv.size(), 40);
+	CHECK_EQ(msv[39], "x");
+	CHECK_EQ(&msv[0], address[0]);
+
+	msv.clear();
+	CHECK(msv.empty());
+}
+
+TEST_CASE(" iterator ") {
+
+	m_segmented_vector<int> msv;
+	for (int i = 0; i < 300; ++i)
+		msv.push_back(i);
+
+	int index = 0;
+	for (auto it = msv.begin(); it != msv.end(); ++it, ++index)
+		CHECK_EQ(*it, index);
+	CHECK_EQ(index, 300);
+	CHECK_EQ(msv.end() - msv.begin(), 300);
+
+	auto it = msv.begin() + 100;
+	CHECK_EQ(*it, 100);
+	CHECK_EQ(it[50], 150);
+	--it;
+	CHECK_EQ(*it, 99);
+	it -= 90;
+	CHECK_EQ(*it, 9);
+	*it = -9;
+	CHECK_EQ(msv[9], -9);
+
+	m_segmented_vector<int>::const_iterator cit = it;
+	CHECK_EQ(*cit, -9);
+	CHECK(cit < msv.cend());
+
+	index = 299;
+	for (auto rit = msv.rbegin(); rit != msv.rend(); ++rit, --index) {
+		if (index != 9)
+			CHECK_EQ(*rit, index);
+	}
+	CHECK_EQ(index, -1);
+}
+
+TEST_CASE(" copy && move && swap && compare ") {
+
+	m_segmented_vector<string> msv_1;
+	for (int i = 0; i < 100; ++i)
+		msv_1.push_back(string(i % 10, 'a'));
+
+	m_segmented_vector<string> msv_2(msv_1);
+	CHECK_EQ(msv_1, msv_2);
+
+	msv_2.back() = "z";
+	CHECK_NE(msv_1, msv_2);
+	CHECK_LT(msv_1, msv_2);
+
+	const string* first = &msv_1[0];
+	m_segmented_vector<string> msv_3(std::move(msv_1));
+	CHECK_EQ(msv_1.size(), 0);
+	CHECK_EQ(msv_3.size(), 100);
+	CHECK_EQ(&msv_3[0], first);
+
+	msv_1 = msv_3;
+	CHECK_EQ(msv_1, msv_3);
+
+	m_segmented_vector<string> msv_4;
+	msv_4 = std::move(msv_3);
+	CHECK_EQ(msv_4.size(), 100);
+
+	swap(msv_4, msv_3);
+	CHECK_EQ(msv_4.size(), 0);
+	CHECK_EQ(msv_3.size(), 100);
+	CHECK_EQ(&msv_3[0], first);
+
+	msv_4 = {"a", "b"};
+	CHECK_EQ(msv_4.size(), 2);
+	CHECK_EQ(msv_4[1], "b");
+
+	// 段数不同的两者互换后各自的段均可正常访问与释放
+	msv_4.swap(msv_3);
+	CHECK_EQ(msv_4.size(), 100);
+	CHECK_EQ(&msv_4[0], first);
+	CHECK_EQ(msv_3, (m_segmented_vector<string>{"a", "b"}));
+	msv_3.swap(msv_4);
+	CHECK_EQ(msv_3.size(), 100);
+	CHECK_EQ(msv_4[1], "b");
+}
+
+MSTL_TEST_NAMESPACE_END
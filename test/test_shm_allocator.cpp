@@ -0,0 +1,163 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "test_basic.h"
+
+#include "../include/doctest.h"
+#include "../src/shm_allocator.h"
+#include "../src/vector.h"
+
+#include <cstring>
+#include <string>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+MSTL_TEST_NAMESPACE_BEGIN
+
+template <class T>
+using shm_vector = mSTL::vector<T, mSTL::shm_allocator<T>>;
+
+static const std::string name = "/mstl_test_shm_allocator";
+
+TEST_CASE(" offset_ptr ") {
+
+	int arr[] = {1, 2, 3, 4, 5};
+
+	mSTL::offset_ptr<int> p;
+	CHECK_EQ(p.get(), nullptr);
+	CHECK(p == nullptr);
+	CHECK_FALSE(p);
+
+	p = arr;
+	CHECK_EQ(p.get(), arr);
+	CHECK_EQ(*p, 1);
+	CHECK_EQ(p[4], 5);
+
+	++p;
+	CHECK_EQ(*p, 2);
+	p += 2;
+	CHECK_EQ(*p, 4);
+	CHECK_EQ(*(p - 1), 3);
+	CHECK_EQ(p - arr, 3);
+	p--;
+	CHECK_EQ(*p, 3);
+
+	// 复制到另一位置后仍指向同一目标
+	mSTL::offset_ptr<int> q(p);
+	CHECK_EQ(q.get(), p.get());
+	CHECK_NE(q.offset(), p.offset());
+	CHECK(q == p);
+
+	mSTL::offset_ptr<const int> cq = q;
+	CHECK_EQ(*cq, 3);
+
+	// 整体逐字节复制 (模拟区域被映射到其他地址) 后指向同等偏移处
+	struct node {
+		int                   value;
+		mSTL::offset_ptr<int> self;
+	};
+	char buffer_1[sizeof(node)], buffer_2[sizeof(node)];
+	node* n_1 = ::new (buffer_1) node;
+	n_1->value = 42;
+	n_1->self = &n_1->value;
+	std::memcpy(buffer_2, buffer_1, sizeof(node));
+	node* n_2 = reinterpret_cast<node*>(buffer_2);
+	CHECK_EQ(n_2->self.get(), &n_2->value);
+	CHECK_EQ(*n_2->self, 42);
+}
+
+TEST_CASE(" shm_segment allocate && deallocate ") {
+
+	mSTL::shm_segment::remove(name);
+
+	mSTL::shm_segment segment(name, 1 << 16);
+	REQUIRE(segment.is_open());
+	CHECK_GE(segment.size(), 1 << 16);
+
+	size_t free_size = segment.free_size();
+	void*  p_1 = segment.allocate(100);
+	void*  p_2 = segment.allocate(1);
+	CHECK(segment.contains(p_1));
+	CHECK_EQ(reinterpret_cast<uintptr_t>(p_1) % mSTL::shm_segment::alignment, 0);
+	CHECK_EQ(reinterpret_cast<uintptr_t>(p_2) % mSTL::shm_segment::alignment, 0);
+	CHECK_LT(segment.free_size(), free_size);
+
+	// 空闲块被复用
+	segment.deallocate(p_1);
+	void* p_3 = segment.allocate(64);
+	CHECK_EQ(p_3, p_1);
+
+	// 紧邻顶部的块释放后直接回退
+	segment.deallocate(p_2);
+	void* p_4 = segment.allocate(16);
+	CHECK_EQ(p_4, p_2);
+
+	CHECK_THROWS(segment.allocate(1 << 20));
+
+	// 同一段被再次映射到不同地址
+	mSTL::shm_segment other(name);
+	CHECK_NE(other.base(), segment.base());
+	CHECK_EQ(other.size(), segment.size());
+
+	CHECK(mSTL::shm_segment::remove(name));
+	CHECK_THROWS(mSTL::shm_segment(name));
+}
+
+TEST_CASE(" vector with shm_allocator ") {
+
+	mSTL::shm_segment::remove(name);
+
+	mSTL::shm_segment segment(name, 1 << 20);
+	segment.make_current();
+
+	using table_type = shm_vector<shm_vector<int>>;
+	table_type* table = segment.find_or_construct_root<table_type>();
+	CHECK_EQ(segment.find_or_construct_root<table_type>(), table);
+
+	for (int i = 0; i < 100; ++i) {
+		table->emplace_back();
+		for (int j = 0; j <= i; ++j)
+			table->back().push_back(i * 1000 + j);
+	}
+	CHECK_EQ(table->size(), 100);
+	CHECK_EQ((*table)[99][99], 99099);
+	CHECK(segment.contains(table->data()));
+	CHECK(segment.contains((*table)[50].data()));
+
+	// 以另一地址映射同一段，通过根对象访问
+	mSTL::shm_segment mapping(name);
+	REQUIRE_NE(mapping.base(), segment.base());
+	const table_type* view = mapping.root<table_type>();
+	REQUIRE_NE(view, nullptr);
+	REQUIRE_EQ(view->size(), 100);
+	CHECK(mapping.contains(view->data()));
+	for (int i = 0; i < 100; ++i) {
+		REQUIRE_EQ((*view)[i].size(), static_cast<size_t>(i + 1));
+		CHECK(mapping.contains((*view)[i].data()));
+		CHECK_EQ((*view)[i][i], i * 1000 + i);
+	}
+
+	// 子进程修改后父进程可见
+	pid_t pid = ::fork();
+	if (pid == 0) {
+		mSTL::shm_segment child(name);
+		child.make_current();
+		table_type* t = child.root<table_type>();
+		int ok = t != nullptr && t->size() == 100 && (*t)[10][10] == 10010;
+		if (ok)
+			(*t)[0].push_back(-1);
+		::_exit(ok ? 0 : 1);
+	}
+	int status = 0;
+	::waitpid(pid, &status, 0);
+	CHECK(WIFEXITED(status));
+	CHECK_EQ(WEXITSTATUS(status), 0);
+	CHECK_EQ((*table)[0].size(), 2);
+	CHECK_EQ((*table)[0].back(), -1);
+
+	table->~table_type();
+	segment.close();
+	CHECK_EQ(mSTL::shm_segment::current(), nullptr);
+	mSTL::shm_segment::remove(name);
+}
+
+MSTL_TEST_NAMESPACE_END
@@ -0,0 +1,267 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "test_basic.h"
+
+#include "../include/doctest.h"
+#include "../src/small_vector.h"
+
+#include <string>
+#include <vector>
+
+MSTL_TEST_NAMESPACE_BEGIN
+
+template <class T, size_t N>
+using m_small_vector = mSTL::small_vector<T, N>;
+template <class T>
+using std_vector = std::vector<T>;
+using string = std::string;
+
+TEST_CASE(" construct small_vector() ") {
+
+	///<- string
+	m_small_vector<string, 4> msvec_s;
+
+	CHECK_EQ(msvec_s.size(), 0);
+	CHECK_EQ(msvec_s.capacity(), 4);
+	CHECK(msvec_s.empty());
+	CHECK(msvec_s.is_inline());
+
+	///<- int
+	m_small_vector<int, 8> msvec_i;
+
+	CHECK_EQ(msvec_i.size(), 0);
+	CHECK_EQ(msvec_i.capacity(), 8);
+	CHECK(msvec_i.is_inline());
+
+	// inline 数据位于对象内部
+	CHECK(static_cast<void*>(msvec_i.data()) >= static_cast<void*>(&msvec_i));
+	CHECK(static_cast<void*>(msvec_i.data()) <
+	      static_cast<void*>(&msvec_i + 1));
+	CHECK_EQ(sizeof(m_small_vector<int, 8>),
+	         sizeof(size_t) + 8 * sizeof(int));
+}
+
+TEST_CASE(" construct count, value && range && initializer_list ") {
+
+	///<- string
+	m_small_vector<string, 4>   msvec_s_1(3, "abc");
+	m_small_vector<string, 4>   msvec_s_2(10, "abc");
+	std_vector<string>          stdvec_s(10, "abc");
+	m_small_vector<string, 4>   msvec_s_3(stdvec_s.begin(), stdvec_s.end());
+
+	CHECK_EQ(msvec_s_1.size(), 3);
+	CHECK(msvec_s_1.is_inline());
+	CHECK_EQ(msvec_s_2.size(), 10);
+	CHECK_FALSE(msvec_s_2.is_inline());
+	CHECK_EQ(msvec_s_3.size(), stdvec_s.size());
+
+	for (size_t i = 0; i < stdvec_s.size(); ++i) {
+		CHECK_EQ(msvec_s_2[i], stdvec_s[i]);
+		CHECK_EQ(msvec_s_3[i], stdvec_s[i]);
+	}
+
+	///<- int
+	m_small_vector<int, 4> msvec_i_1(3, 7);
+	m_small_vector<int, 4> msvec_i_2 = {1, 2, 3, 4, 5, 6};
+	std_vector<int>        stdvec_i = {1, 2, 3, 4, 5, 6};
+
+	CHECK_EQ(msvec_i_1.size(), 3);
+	CHECK_EQ(msvec_i_1[2], 7);
+	CHECK_EQ(msvec_i_2.size(), stdvec_i.size());
+	CHECK_FALSE(msvec_i_2.is_inline());
+
+	for (size_t i = 0; i < stdvec_i.size(); ++i)
+		CHECK_EQ(msvec_i_2[i], stdvec_i[i]);
+}
+
+TEST_CASE(" copy construct and move construct && operator= ") {
+
+	///<- inline string
+	m_small_vector<string, 4> msvec_s_1 = {"a", "b", "c"};
+	m_small_vector<string, 4> msvec_s_2(msvec_s_1);
+	m_small_vector<string, 4> msvec_s_3(std::move(msvec_s_1));
+
+	CHECK_EQ(msvec_s_2.size(), 3);
+	CHECK_EQ(msvec_s_3.size(), 3);
+	CHECK_EQ(msvec_s_1.size(), 0);
+	CHECK(msvec_s_3.is_inline());
+	CHECK_EQ(msvec_s_2, msvec_s_3);
+
+	///<- heap int
+	m_small_vector<int, 2> msvec_i_1 = {1, 2, 3, 4, 5};
+	const int*             heap_data = msvec_i_1.data();
+	m_small_vector<int, 2> msvec_i_2(std::move(msvec_i_1));
+
+	CHECK_EQ(msvec_i_2.data(), heap_data);
+	CHECK_EQ(msvec_i_2.size(), 5);
+	CHECK_EQ(msvec_i_1.size(), 0);
+	CHECK(msvec_i_1.is_inline());
+
+	m_small_vector<int, 2> msvec_i_3;
+	msvec_i_3 = msvec_i_2;
+	CHECK_EQ(msvec_i_3, msvec_i_2);
+
+	m_small_vector<int, 2> msvec_i_4 = {9};
+	msvec_i_4 = std::move(msvec_i_3);
+	CHECK_EQ(msvec_i_4, msvec_i_2);
+
+	msvec_i_4 = {7, 8};
+	CHECK_EQ(msvec_i_4.size(), 2);
+	CHECK_EQ(msvec_i_4[1], 8);
+}
+
+TEST_CASE(" push_back && emplace_back && pop_back && resize ") {
+
+	///<- string
+	m_small_vector<string, 4> msvec_s;
+	std_vector<string>        stdvec_s;
+
+	for (int i = 0; i < 50; ++i) {
+		msvec_s.push_back(std::to_string(i));
+		stdvec_s.push_back(std::to_string(i));
+		CHECK_EQ(msvec_s.is_inline(), i < 4);
+	}
+
+	// 引用自身元素
+	msvec_s.push_back(msvec_s[0]);
+	stdvec_s.push_back(stdvec_s[0]);
+	msvec_s.emplace_back(3, 'x');
+	stdvec_s.emplace_back(3, 'x');
+
+	CHECK_EQ(msvec_s.size(), stdvec_s.size());
+	for (size_t i = 0; i < stdvec_s.size(); ++i)
+		CHECK_EQ(msvec_s[i], stdvec_s[i]);
+
+	msvec_s.pop_back();
+	stdvec_s.pop_back();
+	CHECK_EQ(msvec_s.back(), stdvec_s.back());
+
+	msvec_s.resize(10);
+	stdvec_s.resize(10);
+	msvec_s.resize(20, "y");
+	stdvec_s.resize(20, "y");
+
+	CHECK_EQ(msvec_s.size(), stdvec_s.size());
+	for (size_t i = 0; i < stdvec_s.size(); ++i)
+		CHECK_EQ(msvec_s[i], stdvec_s[i]);
+
+	///<- int
+	m_small_vector<int, 8> msvec_i;
+	msvec_i.resize(8, 1);
+	CHECK(msvec_i.is_inline());
+	msvec_i.resize(9, 2);
+	CHECK_FALSE(msvec_i.is_inline());
+	CHECK_EQ(msvec_i[7], 1);
+	CHECK_EQ(msvec_i[8], 2);
+}
+
+TEST_CASE(" insert && erase && emplace ") {
+
+	///<- string
+	m_small_vector<string, 4> msvec_s = {"a", "b"};
+	std_vector<string>        stdvec_s = {"a", "b"};
+
+	msvec_s.insert(msvec_s.begin() + 1, "c");
+	stdvec_s.insert(stdvec_s.begin() + 1, "c");
+	msvec_s.insert(msvec_s.begin(), 3, "d");
+	stdvec_s.insert(stdvec_s.begin(), 3, "d");
+	msvec_s.insert(msvec_s.end(), {"e", "f"});
+	stdvec_s.insert(stdvec_s.end(), {"e", "f"});
+	msvec_s.emplace(msvec_s.begin() + 2, 2, 'g');
+	stdvec_s.emplace(stdvec_s.begin() + 2, 2, 'g');
+
+	CHECK_EQ(msvec_s.size(), stdvec_s.size());
+	for (size_t i = 0; i < stdvec_s.size(); ++i)
+		CHECK_EQ(msvec_s[i], stdvec_s[i]);
+
+	auto mit = msvec_s.erase(msvec_s.begin() + 1, msvec_s.begin() + 4);
+	auto stdit = stdvec_s.erase(stdvec_s.begin() + 1, stdvec_s.begin() + 4);
+	CHECK_EQ(*mit, *stdit);
+
+	msvec_s.erase(msvec_s.begin());
+	stdvec_s.erase(stdvec_s.begin());
+
+	CHECK_EQ(msvec_s.size(), stdvec_s.size());
+	for (size_t i = 0; i < stdvec_s.size(); ++i)
+		CHECK_EQ(msvec_s[i], stdvec_s[i]);
+
+	///<- int
+	m_small_vector<int, 4> msvec_i = {1, 2, 3};
+	std_vector<int>        stdvec_i = {10, 11, 12, 13, 14};
+
+	msvec_i.insert(msvec_i.begin() + 1, stdvec_i.begin(), stdvec_i.end());
+	CHECK_EQ(msvec_i.size(), 8);
+	CHECK_EQ(msvec_i[0], 1);
+	CHECK_EQ(msvec_i[1], 10);
+	CHECK_EQ(msvec_i[5], 14);
+	CHECK_EQ(msvec_i[6], 2);
+	CHECK_EQ(msvec_i[7], 3);
+}
+
+TEST_CASE(" capacity.. reserve && shrink_to_fit && clear ") {
+
+	m_small_vector<int, 4> msvec_i = {1, 2, 3};
+
+	msvec_i.reserve(3);
+	CHECK(msvec_i.is_inline());
+	msvec_i.reserve(32);
+	CHECK_FALSE(msvec_i.is_inline());
+	CHECK_EQ(msvec_i.capacity(), 32);
+
+	msvec_i.shrink_to_fit();
+	CHECK(msvec_i.is_inline());
+	CHECK_EQ(msvec_i.capacity(), 4);
+	CHECK_EQ(msvec_i.size(), 3);
+	CHECK_EQ(msvec_i[2], 3);
+
+	msvec_i.resize(20, 5);
+	msvec_i.reserve(100);
+	msvec_i.shrink_to_fit();
+	CHECK_EQ(msvec_i.capacity(), 20);
+
+	msvec_i.clear();
+	CHECK(msvec_i.empty());
+	CHECK_EQ(msvec_i.capacity(), 20);
+}
+
+TEST_CASE(" iterator && swap && compare ") {
+
+	///<- string
+	m_small_vector<string, 2> msvec_s_1 = {"a"};
+	m_small_vector<string, 2> msvec_s_2 = {"b", "c", "d"};
+
+	swap(msvec_s_1, msvec_s_2);
+	CHECK_EQ(msvec_s_1.size(), 3);
+	CHECK_EQ(msvec_s_2.size(), 1);
+	CHECK_EQ(msvec_s_1[0], "b");
+	CHECK_EQ(msvec_s_2[0], "a");
+
+	string joined;
+	for (auto it = msvec_s_1.begin(); it != msvec_s_1.end(); ++it)
+		joined += *it;
+	CHECK_EQ(joined, "bcd");
+
+	joined.clear();
+	for (auto it = msvec_s_1.rbegin(); it != msvec_s_1.rend(); ++it)
+		joined += *it;
+	CHECK_EQ(joined, "dcb");
+
+	///<- int
+	std_vector<std_vector<int>> stdvec_i = {{5, 6, 7}, {1, 2, 3}, {8, 9},
+	                                        {5, 6, 7, 8}, {5, 6}};
+	std_vector<int>        stdvec_i_1 = {5, 6, 7};
+	m_small_vector<int, 3> msvec_i_1 = {5, 6, 7};
+
+	for (size_t i = 0; i < stdvec_i.size(); ++i) {
+		m_small_vector<int, 3> msvec_i(stdvec_i[i].begin(),
+		                               stdvec_i[i].end());
+
+		CHECK_EQ(stdvec_i_1 == stdvec_i[i], msvec_i_1 == msvec_i);
+		CHECK_EQ(stdvec_i_1 != stdvec_i[i], msvec_i_1 != msvec_i);
+		CHECK_EQ(stdvec_i_1 < stdvec_i[i], msvec_i_1 < msvec_i);
+		CHECK_EQ(stdvec_i_1 > stdvec_i[i], msvec_i_1 > msvec_i);
+		CHECK_EQ(stdvec_i_1 <= stdvec_i[i], msvec_i_1 <= msvec_i);
+		CHECK_EQ(stdvec_i_1 >= stdvec_i[i], msvec_i_1 >= msvec_i);
+	}
+}
+
+MSTL_TEST_NAMESPACE_END
@@ -0,0 +1,205 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "test_basic.h"
+
+#include "../include/doctest.h"
+#include "../src/soa_vector.h"
+
+#include <string>
+#include <tuple>
+#include <vector>
+
+MSTL_TEST_NAMESPACE_BEGIN
+
+using string = std::string;
+using m_soa_vector = mSTL::soa_vector<int, double, string, char>;
+
+TEST_CASE(" construct soa_vector() && layout ") {
+
+	m_soa_vector msoa;
+
+	CHECK_EQ(msoa.size(), 0);
+	CHECK_EQ(msoa.capacity(), 0);
+	CHECK(msoa.empty());
+	CHECK_EQ(msoa.data<0>(), nullptr);
+
+	m_soa_vector msoa_n(10);
+	CHECK_EQ(msoa_n.size(), 10);
+	for (size_t i = 0; i < msoa_n.size(); ++i) {
+		CHECK_EQ(msoa_n.get<0>(i), 0);
+		CHECK_EQ(msoa_n.get<1>(i), 0.0);
+		CHECK_EQ(msoa_n.get<2>(i), string());
+	}
+
+	// 各列连续存放于同一内存块中且满足对齐要求
+	const char* col_0 = reinterpret_cast<const char*>(msoa_n.data<0>());
+	const char* col_1 = reinterpret_cast<const char*>(msoa_n.data<1>());
+	const char* col_2 = reinterpret_cast<const char*>(msoa_n.data<2>());
+	const char* col_3 = reinterpret_cast<const char*>(msoa_n.data<3>());
+
+	CHECK(col_0 < col_1);
+	CHECK(col_1 < col_2);
+	CHECK(col_2 < col_3);
+	CHECK_GE(col_1 - col_0, 10 * sizeof(int));
+	CHECK_EQ(reinterpret_cast<size_t>(col_1) % alignof(double), 0);
+	CHECK_EQ(reinterpret_cast<size_t>(col_2) % alignof(string), 0);
+}
+
+TEST_CASE(" push_back && emplace_back && pop_back && resize ") {
+
+	m_soa_vector msoa;
+	for (int i = 0; i < 100; ++i)
+		msoa.push_back(i, i * 0.5, std::to_string(i), static_cast<char>('a' + i % 26));
+
+	CHECK_EQ(msoa.size(), 100);
+	CHECK_GE(msoa.capacity(), 100);
+
+	for (int i = 0; i < 100; ++i) {
+		CHECK_EQ(msoa.get<0>(i), i);
+		CHECK_EQ(msoa.get<1>(i), i * 0.5);
+		CHECK_EQ(msoa.get<2>(i), std::to_string(i));
+		CHECK_EQ(msoa.get<3>(i), static_cast<char>('a' + i % 26));
+	}
+
+	// 引用自身元素
+	msoa.shrink_to_fit();
+	CHECK_EQ(msoa.capacity(), 100);
+	msoa.emplace_back(msoa.get<0>(0), msoa.get<1>(1), msoa.get<2>(2), 'z');
+	CHECK_EQ(msoa.get<0>(100), 0);
+	CHECK_EQ(msoa.get<1>(100), 0.5);
+	CHECK_EQ(msoa.get<2>(100), "2");
+
+	auto row = msoa.back();
+	CHECK_EQ(std::get<3>(row), 'z');
+	std::get<2>(row) = "changed";
+	CHECK_EQ(msoa.get<2>(100), "changed");
+
+	msoa.pop_back();
+	CHECK_EQ(msoa.size(), 100);
+
+	msoa.resize(10);
+	CHECK_EQ(msoa.size(), 10);
+	CHECK_EQ(msoa.get<2>(9), "9");
+	msoa.resize(20);
+	CHECK_EQ(msoa.get<2>(19), string());
+	CHECK_EQ(msoa.get<0>(19), 0);
+
+	msoa.clear();
+	CHECK(msoa.empty());
+}
+
+TEST_CASE(" column span && row iterator ") {
+
+	mSTL::soa_vector<int, float> msoa;
+	for (int i = 0; i < 64; ++i)
+		msoa.push_back(i, static_cast<float>(i) * 2);
+
+	mSTL::span<int> ids = msoa.column<0>();
+	CHECK_EQ(ids.size(), 64);
+	CHECK_EQ(ids.data(), msoa.data<0>());
+
+	long long sum = 0;
+	for (int id : ids)
+		sum += id;
+	CHECK_EQ(sum, 64 * 63 / 2);
+
+	for (float& value : msoa.column<1>())
+		value += 1;
+
+	const mSTL::soa_vector<int, float>& cref = msoa;
+	mSTL::span<const float> values = cref.column<1>();
+	CHECK_EQ(values[10], 21.0f);
+	CHECK_EQ(values.subspan(60).size(), 4);
+
+	int index = 0;
+	for (auto it = msoa.begin(); it != msoa.end(); ++it, ++index) {
+		CHECK_EQ(std::get<0>(*it), index);
+		CHECK_EQ(std::get<1>(*it), static_cast<float>(index) * 2 + 1);
+	}
+	CHECK_EQ(msoa.end() - msoa.begin(), 64);
+
+	auto it = msoa.begin() + 5;
+	std::get<0>(*it) = 500;
+	CHECK_EQ(msoa.get<0>(5), 500);
+
+	mSTL::soa_vector<int, float>::const_iterator cit = it;
+	CHECK_EQ(std::get<0>(cit[1]), 6);
+}
+
+TEST_CASE(" copy && move && swap ") {
+
+	m_soa_vector msoa_1;
+	for (int i = 0; i < 20; ++i)
+		msoa_1.push_back(i, i * 1.5, string(i, 'x'), 'c');
+
+	m_soa_vector msoa_2(msoa_1);
+	CHECK_EQ(msoa_2.size(), 20);
+	for (int i = 0; i < 20; ++i) {
+		CHECK_EQ(msoa_2.get<0>(i), i);
+		CHECK_EQ(msoa_2.get<2>(i), string(i, 'x'));
+	}
+
+	m_soa_vector msoa_3(std::move(msoa_1));
+	CHECK_EQ(msoa_3.size(), 20);
+	CHECK_EQ(msoa_1.size(), 0);
+
+	m_soa_vector msoa_4;
+	msoa_4.push_back(1, 1.0, "one", '1');
+	msoa_4 = msoa_3;
+	CHECK_EQ(msoa_4.size(), 20);
+	CHECK_EQ(msoa_4.get<2>(19), string(19, 'x'));
+
+	m_soa_vector msoa_5;
+	msoa_5 = std::move(msoa_4);
+	CHECK_EQ(msoa_5.size(), 20);
+
+	swap(msoa_5, msoa_1);
+	CHECK_EQ(msoa_5.size(), 0);
+	CHECK_EQ(msoa_1.size(), 20);
+	CHECK_EQ(msoa_1.get<1>(2), 3.0);
+}
+
+// 拷贝时按需抛出异常，用于检查扩容失败时的资源释放
+struct throwing_value {
+	static bool copy_throws;
+
+	int value = 0;
+
+	throwing_value() = default;
+	explicit throwing_value(int v) : value(v) {}
+	throwing_value(const throwing_value& other) : value(other.value) {
+		if (copy_throws)
+			throw 1;
+	}
+	throwing_value(throwing_value&&) = default;
+	throwing_value& operator=(const throwing_value&) = default;
+};
+bool throwing_value::copy_throws = false;
+
+TEST_CASE(" emplace_back reallocation && exception ") {
+	using m_throwing_soa = mSTL::soa_vector<int, throwing_value>;
+
+	m_throwing_soa msoa;
+	for (int i = 0; i < 32; ++i)
+		msoa.emplace_back(i, throwing_value(i));
+	REQUIRE_EQ(msoa.size(), msoa.capacity());
+
+	const throwing_value extra(32);
+
+	// 新行构造失败时释放新内存块，原有数据保持不变
+	throwing_value::copy_throws = true;
+	CHECK_THROWS_AS(msoa.push_back(32, extra), int);
+	throwing_value::copy_throws = false;
+
+	CHECK_EQ(msoa.size(), 32);
+	CHECK_EQ(msoa.capacity(), 32);
+	for (int i = 0; i < 32; ++i) {
+		CHECK_EQ(msoa.get<0>(i), i);
+		CHECK_EQ(msoa.get<1>(i).value, i);
+	}
+
+	msoa.push_back(32, extra);
+	CHECK_EQ(msoa.size(), 33);
+	CHECK_EQ(msoa.get<1>(32).value, 32);
+}
+
+MSTL_TEST_NAMESPACE_END
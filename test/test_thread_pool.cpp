@@ -0,0 +1,79 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "test_basic.h"
+
+#include "../include/doctest.h"
+#include "../src/thread_pool.h"
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+MSTL_TEST_NAMESPACE_BEGIN
+
+TEST_CASE(" thread_pool parallel_for ") {
+	mSTL::thread_pool pool(3);
+	CHECK_EQ(pool.concurrency(), 4);
+
+	std::vector<int> hits(10007, 0);
+	pool.parallel_for(0, hits.size(), 100, [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i)
+			++hits[i];
+	});
+	for (size_t i = 0; i < hits.size(); ++i)
+		CHECK_EQ(hits[i], 1);
+
+	// 重复提交与空区间
+	std::atomic<size_t> sum(0);
+	for (int round = 0; round < 50; ++round)
+		pool.parallel_for(0, 1000, 7, [&](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; ++i)
+				sum.fetch_add(i, std::memory_order_relaxed);
+		});
+	CHECK_EQ(sum.load(), 50 * (999 * 1000 / 2));
+
+	pool.parallel_for(5, 5, 1, [&](size_t, size_t) { CHECK(false); });
+
+	// 无工作线程时串行执行
+	mSTL::thread_pool serial(0);
+	size_t            chunks = 0;
+	serial.parallel_for(0, 10, 3, [&](size_t, size_t) { ++chunks; });
+	CHECK_EQ(chunks, 4);
+}
+
+TEST_CASE(" thread_pool nested && exception ") {
+	mSTL::thread_pool pool(2);
+
+	std::atomic<size_t> count(0);
+	pool.parallel_for(0, 8, 1, [&](size_t, size_t) {
+		mSTL::thread_pool::instance().parallel_for(
+		    0, 4, 1, [&](size_t, size_t) { count.fetch_add(1); });
+	});
+	CHECK_EQ(count.load(), 32);
+
+	// 嵌套至同一线程池: 调用线程执行的分块内再次调用不应死锁
+	for (int round = 0; round < 30; ++round) {
+		count.store(0);
+		pool.parallel_for(0, 8, 1, [&](size_t, size_t) {
+			pool.parallel_for(0, 4, 1,
+			                  [&](size_t, size_t) { count.fetch_add(1); });
+		});
+		CHECK_EQ(count.load(), 32);
+	}
+
+	std::atomic<size_t> finished(0);
+	CHECK_THROWS_AS(pool.parallel_for(0, 64, 1,
+	                                  [&](size_t begin, size_t) {
+		                                  if (begin == 17)
+			                                  throw std::runtime_error("17");
+		                                  finished.fetch_add(1);
+	                                  }),
+	                std::runtime_error);
+	CHECK_EQ(finished.load(), 63);
+
+	// 异常后仍可继续使用
+	count.store(0);
+	pool.parallel_for(0, 16, 1, [&](size_t, size_t) { count.fetch_add(1); });
+	CHECK_EQ(count.load(), 16);
+}
+
+MSTL_TEST_NAMESPACE_END
@@ -4,7 +4,13 @@
 #include "../include/doctest.h"
 #include "../src/vector.h"
 
+#include <algorithm>
+#include <deque>
+#include <iterator>
+#include <list>
+#include <sstream>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 MSTL_TEST_NAMESPACE_BEGIN
@@ -163,6 +169,95 @@ TEST_CASE(" vector(InputIterator first, InputIterator last) ") {
 	}
 }
 
+TEST_CASE(" range construct && assign && insert with iterator categories ") {
+	// 整型参数选择 count 版本而非区间版本
+	m_vector<int> mvec_n(5, 3);
+	CHECK_EQ(mvec_n.size(), 5);
+	CHECK_EQ(std::count(mvec_n.begin(), mvec_n.end(), 3), 5);
+	mvec_n.assign(2, 4);
+	CHECK_EQ(mvec_n.size(), 2);
+	mvec_n.insert(mvec_n.begin(), 3, 1);
+	CHECK_EQ(mvec_n.size(), 5);
+	CHECK_EQ(mvec_n[2], 1);
+	CHECK_EQ(mvec_n[3], 4);
+
+	// bidirectional iterator
+	std::list<string> list_s = {"a", "b", "c", "d"};
+	m_vector<string>  mvec_s(list_s.begin(), list_s.end());
+	CHECK_EQ(mvec_s.size(), 4);
+	CHECK_EQ(mvec_s.capacity(), 4);
+	CHECK_EQ(mvec_s[3], "d");
+
+	// input iterator
+	std::istringstream in_1("1 2 3 4 5 6 7 8 9 10");
+	m_vector<int>      mvec_i((std::istream_iterator<int>(in_1)),
+	                          std::istream_iterator<int>());
+	CHECK_EQ(mvec_i.size(), 10);
+	for (int i = 0; i < 10; ++i)
+		CHECK_EQ(mvec_i[i], i + 1);
+
+	std::istringstream in_2("7 8");
+	mvec_i.assign(std::istream_iterator<int>(in_2),
+	              std::istream_iterator<int>());
+	CHECK_EQ(mvec_i.size(), 2);
+	CHECK_EQ(mvec_i[1], 8);
+
+	std::istringstream in_3("1 2 3 4 5 6 7 8 9 10 11 12");
+	mvec_i.assign(std::istream_iterator<int>(in_3),
+	              std::istream_iterator<int>());
+	CHECK_EQ(mvec_i.size(), 12);
+	CHECK_EQ(mvec_i[11], 12);
+
+	std::istringstream in_4("-1 -2 -3");
+	auto               pos = mvec_i.insert(mvec_i.begin() + 1,
+	                                       std::istream_iterator<int>(in_4),
+	                                       std::istream_iterator<int>());
+	CHECK_EQ(pos - mvec_i.begin(), 1);
+	CHECK_EQ(mvec_i.size(), 15);
+	CHECK_EQ(mvec_i[0], 1);
+	CHECK_EQ(mvec_i[1], -1);
+	CHECK_EQ(mvec_i[3], -3);
+	CHECK_EQ(mvec_i[4], 2);
+
+	// 非连续 random access iterator 与类型转换
+	std::deque<int>  deque_i = {1, 2, 3, 4, 5};
+	m_vector<double> mvec_d(deque_i.begin(), deque_i.end());
+	CHECK_EQ(mvec_d.size(), 5);
+	CHECK_EQ(mvec_d[4], 5.0);
+
+	int              array_i[] = {9, 8, 7};
+	m_vector<double> mvec_d2(array_i, array_i + 3);
+	CHECK_EQ(mvec_d2[0], 9.0);
+
+	// 赋值 / 插入 bidirectional 区间
+	mvec_s.assign(list_s.rbegin(), list_s.rend());
+	CHECK_EQ(mvec_s.size(), 4);
+	CHECK_EQ(mvec_s[0], "d");
+	mvec_s.insert(mvec_s.begin() + 2, list_s.begin(), list_s.end());
+	CHECK_EQ(mvec_s.size(), 8);
+	CHECK_EQ(mvec_s[2], "a");
+	CHECK_EQ(mvec_s[6], "b");
+
+	// 源区间来自自身
+	mvec_s.assign(mvec_s.begin() + 2, mvec_s.begin() + 6);
+	CHECK_EQ(mvec_s.size(), 4);
+	CHECK_EQ(mvec_s[0], "a");
+	CHECK_EQ(mvec_s[3], "d");
+
+	// vector<bool>
+	std::list<int>     list_b = {1, 0, 0, 1};
+	m_vector<bool>     mvec_b(list_b.begin(), list_b.end());
+	std::istringstream in_5("1 1 0");
+	mvec_b.insert(mvec_b.begin() + 1, std::istream_iterator<int>(in_5),
+	              std::istream_iterator<int>());
+	CHECK_EQ(mvec_b.size(), 7);
+	CHECK_EQ(mvec_b.count(), 4);
+	CHECK(mvec_b[1]);
+	CHECK(mvec_b[2]);
+	CHECK_FALSE(mvec_b[3]);
+	CHECK(mvec_b[6]);
+}
+
 TEST_CASE(" copy contruct and operator= ") {
 
 	///<- string
@@ -1297,9 +1392,318 @@ TEST_CASE(" compare ") {
 	}
 }
 
-// 此用例要求 C++20 版本
-#if 0
-TEST_CASE(" others(earse earse_if) ") {
+TEST_CASE(" compare fast paths && hash ") {
+	// 各类型比较结果与逐元素字典序一致
+	std_vector<int>      values = {0, 1, -1, 127, 128, 255, -128, 65535, -65536};
+	std_vector<m_vector<unsigned char>> mbytes;
+	std_vector<m_vector<signed char>>   msbytes;
+	std_vector<m_vector<int>>           mints;
+	std_vector<m_vector<long long>>     mlongs;
+	std_vector<std_vector<int>>         stdints;
+
+	for (size_t len = 0; len < 4; ++len)
+		for (size_t k = 0; k < values.size() * values.size(); ++k) {
+			std_vector<int> seq;
+			for (size_t j = 0; j < len; ++j)
+				seq.push_back(values[(k / (j + 1) + j) % values.size()]);
+
+			stdints.push_back(seq);
+			mbytes.push_back(m_vector<unsigned char>(seq.begin(), seq.end()));
+			msbytes.push_back(m_vector<signed char>(seq.begin(), seq.end()));
+			mints.push_back(m_vector<int>(seq.begin(), seq.end()));
+			mlongs.push_back(m_vector<long long>(seq.begin(), seq.end()));
+		}
+
+	for (size_t i = 0; i < stdints.size(); ++i)
+		for (size_t j = 0; j < stdints.size(); ++j) {
+			const std_vector<int>& a = stdints[i];
+			const std_vector<int>& b = stdints[j];
+			std_vector<unsigned char> ua(a.begin(), a.end()), ub(b.begin(), b.end());
+			std_vector<signed char>   sa(a.begin(), a.end()), sb(b.begin(), b.end());
+
+			CHECK_EQ(mints[i] == mints[j], a == b);
+			CHECK_EQ(mints[i] < mints[j], a < b);
+			CHECK_EQ(mlongs[i] < mlongs[j], a < b);
+			CHECK_EQ(mbytes[i] == mbytes[j], ua == ub);
+			CHECK_EQ(mbytes[i] < mbytes[j], ua < ub);
+			CHECK_EQ(msbytes[i] < msbytes[j], sa < sb);
+		}
+
+	// 长序列中首个不同位置位于 SIMD 块内部或尾部
+	m_vector<int> long_a(size_t(1000), 5);
+	for (size_t pos : {0, 7, 31, 32, 500, 998, 999}) {
+		m_vector<int> long_b(long_a);
+		CHECK(long_a == long_b);
+		long_b[pos] = -5;
+		CHECK_FALSE(long_a == long_b);
+		CHECK(long_b < long_a);
+		CHECK_FALSE(long_a < long_b);
+	}
+	m_vector<int> prefix(long_a.begin(), long_a.begin() + 999);
+	CHECK(prefix < long_a);
+	CHECK_FALSE(long_a < prefix);
+
+	// 浮点数不可按位比较: -0.0 == 0.0，NaN != NaN
+	m_vector<double> zero_a = {0.0, 1.0};
+	m_vector<double> zero_b = {-0.0, 1.0};
+	CHECK(zero_a == zero_b);
+	CHECK_FALSE(zero_a < zero_b);
+	m_vector<double> nan_a = {std::numeric_limits<double>::quiet_NaN()};
+	CHECK_FALSE(nan_a == nan_a);
+
+	// hash
+	CHECK_EQ(mints[5].hash(), m_vector<int>(mints[5]).hash());
+	CHECK_EQ(long_a.hash(), m_vector<int>(long_a).hash());
+	CHECK_NE(long_a.hash(), prefix.hash());
+	CHECK_NE(m_vector<int>{1, 2}.hash(), m_vector<int>{2, 1}.hash());
+	CHECK_EQ(m_vector<string>{"a", "b"}.hash(),
+	         m_vector<string>{"a", "b"}.hash());
+	CHECK_NE(m_vector<string>{"a", "b"}.hash(),
+	         m_vector<string>{"b", "a"}.hash());
+
+	std::unordered_map<m_vector<int>, int> cache;
+	for (size_t i = 0; i < mints.size(); ++i)
+		cache[mints[i]] = static_cast<int>(i);
+	for (size_t i = 0; i < mints.size(); ++i)
+		CHECK(mints[static_cast<size_t>(cache[mints[i]])] == mints[i]);
+
+	m_vector<bool> bits_a = {true, false, true};
+	m_vector<bool> bits_b = {true, false, true};
+	CHECK_EQ(bits_a.hash(), bits_b.hash());
+	bits_b.push_back(false);
+	CHECK_NE(bits_a.hash(), bits_b.hash());
+}
+
+TEST_CASE(" vector<bool> construct && element access && iterator ") {
+
+	std_vector<bool> stdvec_b_1(100, true);
+	m_vector<bool>   mvec_b_1(100, true);
+
+	CHECK_EQ(mvec_b_1.size(), stdvec_b_1.size());
+	CHECK_EQ(mvec_b_1.num_words(), 2);
+	CHECK_EQ(mvec_b_1.count(), 100);
+
+	std_vector<bool> stdvec_b_2;
+	for (int i = 0; i < 200; ++i)
+		stdvec_b_2.push_back(i % 3 == 0);
+
+	m_vector<bool> mvec_b_2(stdvec_b_2.begin(), stdvec_b_2.end());
+	m_vector<bool> mvec_b_3(mvec_b_2);
+	m_vector<bool> mvec_b_4 = {true, false, true};
+
+	CHECK_EQ(mvec_b_2.size(), stdvec_b_2.size());
+	CHECK_EQ(mvec_b_4.size(), 3);
+	CHECK(mvec_b_4[0]);
+	CHECK_FALSE(mvec_b_4[1]);
+	CHECK(mvec_b_4.back());
+
+	for (size_t i = 0; i < stdvec_b_2.size(); ++i) {
+		CHECK_EQ(mvec_b_2[i], stdvec_b_2[i]);
+		CHECK_EQ(mvec_b_3.at(i), stdvec_b_2[i]);
+	}
+
+	size_t index = 0;
+	for (auto it = mvec_b_2.cbegin(); it != mvec_b_2.cend(); ++it, ++index)
+		CHECK_EQ(*it, stdvec_b_2[index]);
+	CHECK_EQ(index, stdvec_b_2.size());
+	CHECK_EQ(mvec_b_2.end() - mvec_b_2.begin(), 200);
+
+	auto rit = mvec_b_2.rbegin();
+	for (size_t i = stdvec_b_2.size(); i > 0; --i, ++rit)
+		CHECK_EQ(*rit, stdvec_b_2[i - 1]);
+
+	// 代理引用
+	mvec_b_2[1] = true;
+	mvec_b_2[0].flip();
+	m_vector<bool>::swap(mvec_b_2[2], mvec_b_2[3]);
+	CHECK(mvec_b_2[1]);
+	CHECK_FALSE(mvec_b_2[0]);
+	CHECK(mvec_b_2[2]);
+	CHECK_FALSE(mvec_b_2[3]);
+
+	*(mvec_b_2.begin() + 130) = true;
+	CHECK(mvec_b_2[130]);
+
+	m_vector<bool> mvec_b_5(std::move(mvec_b_3));
+	CHECK_EQ(mvec_b_3.size(), 0);
+	CHECK_EQ(mvec_b_5.size(), 200);
+}
+
+TEST_CASE(" vector<bool> modifiers ") {
+
+	std_vector<bool> stdvec_b;
+	m_vector<bool>   mvec_b;
+
+	for (int i = 0; i < 150; ++i) {
+		stdvec_b.push_back(i % 5 == 1);
+		mvec_b.push_back(i % 5 == 1);
+	}
+
+	stdvec_b.insert(stdvec_b.begin() + 10, 70, true);
+	mvec_b.insert(mvec_b.begin() + 10, 70, true);
+	stdvec_b.insert(stdvec_b.begin() + 3, false);
+	mvec_b.insert(mvec_b.begin() + 3, false);
+	stdvec_b.insert(stdvec_b.end(), {true, true, false});
+	mvec_b.insert(mvec_b.end(), {true, true, false});
+
+	CHECK_EQ(mvec_b.size(), stdvec_b.size());
+	for (size_t i = 0; i < stdvec_b.size(); ++i)
+		CHECK_EQ(mvec_b[i], stdvec_b[i]);
+
+	stdvec_b.erase(stdvec_b.begin() + 5, stdvec_b.begin() + 90);
+	mvec_b.erase(mvec_b.begin() + 5, mvec_b.begin() + 90);
+	stdvec_b.erase(stdvec_b.begin());
+	mvec_b.erase(mvec_b.begin());
+	stdvec_b.pop_back();
+	mvec_b.pop_back();
+
+	CHECK_EQ(mvec_b.size(), stdvec_b.size());
+	for (size_t i = 0; i < stdvec_b.size(); ++i)
+		CHECK_EQ(mvec_b[i], stdvec_b[i]);
+	CHECK_EQ(mvec_b.count(),
+	         static_cast<size_t>(
+	             std::count(stdvec_b.begin(), stdvec_b.end(), true)));
+
+	stdvec_b.resize(300, true);
+	mvec_b.resize(300, true);
+	stdvec_b.resize(140);
+	mvec_b.resize(140);
+
+	CHECK_EQ(mvec_b.size(), stdvec_b.size());
+	for (size_t i = 0; i < stdvec_b.size(); ++i)
+		CHECK_EQ(mvec_b[i], stdvec_b[i]);
+	CHECK_EQ(mvec_b.count(),
+	         static_cast<size_t>(
+	             std::count(stdvec_b.begin(), stdvec_b.end(), true)));
+
+	mvec_b.shrink_to_fit();
+	CHECK_EQ(mvec_b.capacity(), 192);
+
+	mvec_b.clear();
+	CHECK(mvec_b.empty());
+	CHECK_EQ(mvec_b.count(), 0);
+}
+
+TEST_CASE(" vector<bool> fill && count && find && bit operations ") {
+
+	m_vector<bool> mvec_b(130);
+
+	CHECK_EQ(mvec_b.count(), 0);
+	CHECK_EQ(mvec_b.find_first(), m_vector<bool>::npos);
+
+	mvec_b.fill(true);
+	CHECK_EQ(mvec_b.count(), 130);
+	mvec_b.flip();
+	CHECK_EQ(mvec_b.count(), 0);
+
+	mvec_b[3] = true;
+	mvec_b[64] = true;
+	mvec_b[129] = true;
+
+	CHECK_EQ(mvec_b.find_first(), 3);
+	CHECK_EQ(mvec_b.find_next(3), 64);
+	CHECK_EQ(mvec_b.find_next(64), 129);
+	CHECK_EQ(mvec_b.find_next(129), m_vector<bool>::npos);
+
+	// 扩容后末尾新增位不应被计入
+	mvec_b.resize(200);
+	CHECK_EQ(mvec_b.count(), 3);
+	mvec_b.flip();
+	CHECK_EQ(mvec_b.count(), 197);
+	mvec_b.flip();
+
+	m_vector<bool> mvec_b_1(200), mvec_b_2(200);
+	for (size_t i = 0; i < 200; ++i) {
+		mvec_b_1[i] = i % 2 == 0;
+		mvec_b_2[i] = i % 3 == 0;
+	}
+
+	m_vector<bool> mvec_and = mvec_b_1, mvec_or = mvec_b_1,
+	               mvec_xor = mvec_b_1;
+	mvec_and &= mvec_b_2;
+	mvec_or |= mvec_b_2;
+	mvec_xor ^= mvec_b_2;
+
+	for (size_t i = 0; i < 200; ++i) {
+		CHECK_EQ(mvec_and[i], (i % 2 == 0) && (i % 3 == 0));
+		CHECK_EQ(mvec_or[i], (i % 2 == 0) || (i % 3 == 0));
+		CHECK_EQ(mvec_xor[i], (i % 2 == 0) != (i % 3 == 0));
+	}
+	CHECK_EQ(mvec_and.count(), 34);
+}
+
+TEST_CASE(" vector<bool> compare ") {
+
+	std_vector<std_vector<bool>> stdvec_b = {
+	    {true, false, true}, {true}, {false, true}, {true, false, true, false},
+	    {true, false, false}, {true, true}, {}};
+
+	std_vector<bool> stdvec_b_1 = {true, false, true};
+	m_vector<bool>   mvec_b_1 = {true, false, true};
+
+	for (size_t i = 0; i < stdvec_b.size(); ++i) {
+		m_vector<bool> mvec_b(stdvec_b[i].begin(), stdvec_b[i].end());
+
+		CHECK_EQ(stdvec_b_1 == stdvec_b[i], mvec_b_1 == mvec_b);
+		CHECK_EQ(stdvec_b_1 != stdvec_b[i], mvec_b_1 != mvec_b);
+		CHECK_EQ(stdvec_b_1 < stdvec_b[i], mvec_b_1 < mvec_b);
+		CHECK_EQ(stdvec_b_1 > stdvec_b[i], mvec_b_1 > mvec_b);
+		CHECK_EQ(stdvec_b_1 <= stdvec_b[i], mvec_b_1 <= mvec_b);
+		CHECK_EQ(stdvec_b_1 >= stdvec_b[i], mvec_b_1 >= mvec_b);
+	}
+
+	m_vector<bool> mvec_b_2(300, false), mvec_b_3(300, false);
+	mvec_b_3[250] = true;
+	CHECK(mvec_b_2 < mvec_b_3);
+	CHECK(mvec_b_2 != mvec_b_3);
+	mvec_b_2[250] = true;
+	CHECK(mvec_b_2 == mvec_b_3);
+}
+
+TEST_CASE(" parallel first touch construct ") {
+	size_t old_threshold = mSTL::parallel_construct::threshold();
+	mSTL::parallel_construct::set_threshold(4096);
+
+	// 单核机器上全局线程池没有工作线程，使用显式的多线程池驱动并行路径
+	mSTL::thread_pool pool(3);
+	mSTL::parallel_construct::set_pool(&pool);
+
+	const size_t count = 1 << 20;
+	CHECK(mSTL::parallel_construct::enabled(count * sizeof(int)));
+
+	m_vector<int> mvec(count, 7);
+	CHECK_EQ(mvec.size(), count);
+	CHECK_EQ(std::count(mvec.begin(), mvec.end(), 7), count);
+
+	mvec.resize(count * 2 + 3, 9);
+	CHECK_EQ(mvec.size(), count * 2 + 3);
+	CHECK_EQ(std::count(mvec.begin(), mvec.end(), 7), count);
+	CHECK_EQ(std::count(mvec.begin(), mvec.end(), 9), count + 3);
+
+	mvec.assign(count + 1, -1);
+	CHECK_EQ(mvec.size(), count + 1);
+	CHECK_EQ(std::count(mvec.begin(), mvec.end(), -1), count + 1);
+
+	for (size_t i = 0; i < mvec.size(); ++i)
+		mvec[i] = static_cast<int>(i);
+	m_vector<int> mvec_copy(mvec);
+	CHECK_EQ(mvec_copy.size(), mvec.size());
+	CHECK(mvec_copy == mvec);
+
+	// 非 POD 类型始终串行构造
+	m_vector<string> mvec_s(10000, "s");
+	CHECK_EQ(std::count(mvec_s.begin(), mvec_s.end(), "s"), 10000);
+
+	// 关闭后结果一致
+	mSTL::parallel_construct::set_threshold(0);
+	m_vector<int> mvec_serial(count, 7);
+	CHECK_EQ(std::count(mvec_serial.begin(), mvec_serial.end(), 7), count);
+
+	mSTL::parallel_construct::set_threshold(old_threshold);
+	mSTL::parallel_construct::set_pool(nullptr);
+}
+
+TEST_CASE(" others(erase erase_if erase_indices) ") {
 	std_vector<string> stdvec_s;
 	m_vector<string>   mvec_s;
 
@@ -1308,51 +1712,93 @@ TEST_CASE(" others(earse earse_if) ") {
 		mvec_s.insert((mvec_s.begin() + i * 5), {"p", "q", "r", "s", "t"});
 	}
 
+	// 相邻的待移除元素不会被跳过
+	stdvec_s.insert(stdvec_s.begin(), {"p", "p"});
+	mvec_s.insert(mvec_s.begin(), {"p", "p"});
+
 	string p_s = "p";
 
 	size_t msize_s_1 = erase(mvec_s, p_s);
-	size_t stdsize_s_1 = std::erase(stdvec_s, p_s);
+	size_t stdsize_s_1 = stdvec_s.end() - std::remove(stdvec_s.begin(),
+	                                                  stdvec_s.end(), p_s);
+	stdvec_s.erase(stdvec_s.end() - stdsize_s_1, stdvec_s.end());
 
 	CHECK_EQ(mvec_s.size(), stdvec_s.size());
 	CHECK_EQ(msize_s_1, stdsize_s_1);
+	CHECK_EQ(msize_s_1, 42);
 
-	for (int i = 0; i < 40; ++i)
+	for (size_t i = 0; i < mvec_s.size(); ++i)
 		CHECK_EQ(mvec_s[i], stdvec_s[i]);
 
-	string r_s = "r";
+	string t_s = "t";
 
-	size_t msize_s_2 = erase(mvec_s, r_s);
-	size_t stdsize_s_2 = std::erase(stdvec_s, r_s);
+	size_t msize_s_2 =
+	    erase_if(mvec_s, [t_s](const string& s) { return s == t_s; });
+	size_t stdsize_s_2 =
+	    stdvec_s.end() -
+	    std::remove_if(stdvec_s.begin(), stdvec_s.end(),
+	                   [t_s](const string& s) { return s == t_s; });
+	stdvec_s.erase(stdvec_s.end() - stdsize_s_2, stdvec_s.end());
 
 	CHECK_EQ(mvec_s.size(), stdvec_s.size());
-	CHECK_EQ(msize_s_1, stdsize_s_1);
+	CHECK_EQ(msize_s_2, stdsize_s_2);
 
-	for (int i = 0; i < 40; ++i)
+	for (size_t i = 0; i < mvec_s.size(); ++i)
 		CHECK_EQ(mvec_s[i], stdvec_s[i]);
 
-	/*
-
-	string t_s = "t";
+	CHECK_EQ(erase(mvec_s, string("x")), 0);
+	CHECK_EQ(mvec_s.size(), 120);
 
-	size_t msize_s_3 = erase_if(mvec_s, [t_s](string s) { return s == t_s; });
-	size_t stdsize_s_3 =
-	    std::erase_if(stdvec_s, [t_s](string s) { return s == t_s; });
+	// 下标须升序，允许重复，超出 size() 的被忽略
+	size_t msize_s_3 = erase_indices(mvec_s, {0, 1, 1, 5, 119, 500});
+	CHECK_EQ(msize_s_3, 4);
+	stdvec_s.erase(stdvec_s.begin() + 119);
+	stdvec_s.erase(stdvec_s.begin() + 5);
+	stdvec_s.erase(stdvec_s.begin(), stdvec_s.begin() + 2);
 
 	CHECK_EQ(mvec_s.size(), stdvec_s.size());
-	CHECK_EQ(msize_s_1, stdsize_s_1);
-
-	for (int i = 0; i < 40; ++i)
+	for (size_t i = 0; i < mvec_s.size(); ++i)
 		CHECK_EQ(mvec_s[i], stdvec_s[i]);
 
-	size_t msize_s_4 = erase_if(mvec_s, [](string s) { return true; });
-	size_t stdsize_s_4 = std::erase_if(stdvec_s, [](string s) { return true; });
+	CHECK_EQ(erase_if(mvec_s, [](const string&) { return true; }), 116);
+	CHECK_EQ(mvec_s.size(), 0);
+	CHECK_EQ(erase_indices(mvec_s, {0, 1}), 0);
 
-	CHECK_EQ(mvec_s.size(), stdvec_s.size());
-	CHECK_EQ(msize_s_1, stdsize_s_1);
+	// POD 类型，无分支压缩路径
+	m_vector<int>   mvec_i;
+	std_vector<int> stdvec_i;
+	for (int i = 0; i < 1000; ++i) {
+		mvec_i.push_back(i * 7919 % 1009);
+		stdvec_i.push_back(i * 7919 % 1009);
+	}
 
-	CHECK_EQ(mvec_s.size(), 0);
-	*/
+	CHECK_EQ(erase_if(mvec_i, [](int x) { return x % 3 == 0; }),
+	         std::count_if(stdvec_i.begin(), stdvec_i.end(),
+	                       [](int x) { return x % 3 == 0; }));
+	stdvec_i.erase(std::remove_if(stdvec_i.begin(), stdvec_i.end(),
+	                              [](int x) { return x % 3 == 0; }),
+	               stdvec_i.end());
+	CHECK_EQ(mvec_i.size(), stdvec_i.size());
+	for (size_t i = 0; i < mvec_i.size(); ++i)
+		CHECK_EQ(mvec_i[i], stdvec_i[i]);
+
+	std_vector<size_t> indices;
+	for (size_t i = 0; i < mvec_i.size(); i += 3)
+		indices.push_back(i);
+	CHECK_EQ(erase_indices(mvec_i, indices), indices.size());
+	for (size_t i = indices.size(); i-- > 0;)
+		stdvec_i.erase(stdvec_i.begin() + indices[i]);
+	CHECK_EQ(mvec_i.size(), stdvec_i.size());
+	for (size_t i = 0; i < mvec_i.size(); ++i)
+		CHECK_EQ(mvec_i[i], stdvec_i[i]);
+
+	// vector<bool>
+	m_vector<bool> mvec_b;
+	for (int i = 0; i < 100; ++i)
+		mvec_b.push_back(i % 3 == 0);
+	CHECK_EQ(erase(mvec_b, true), 34);
+	CHECK_EQ(mvec_b.size(), 66);
+	CHECK_EQ(mvec_b.count(), 0);
 }
-#endif
 
 MSTL_TEST_NAMESPACE_END
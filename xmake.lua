@@ -1,5 +1,6 @@
 add_rules("mode.debug")
 set_languages("c++11")
+add_syslinks("pthread")
 
 target("test_vector")
     set_kind("binary")
@@ -8,6 +9,151 @@ target("test_vector")
     add_files("src/detail/alloc.cpp")
     add_files("test/test_vector.cpp")
 
+target("test_small_vector")
+    set_kind("binary")
+    add_cxxflags("-g")
+    add_files("src/detail/alloc.cpp")
+    add_files("test/test_small_vector.cpp")
+
+target("test_inplace_vector")
+    set_kind("binary")
+    add_cxxflags("-g")
+    add_files("src/detail/alloc.cpp")
+    add_files("test/test_inplace_vector.cpp")
+
+target("test_soa_vector")
+    set_kind("binary")
+    add_cxxflags("-g")
+    add_files("src/detail/alloc.cpp")
+    add_files("test/test_soa_vector.cpp")
+
+target("test_segmented_vector")
+    set_kind("binary")
+    add_cxxflags("-g")
+    add_files("src/detail/alloc.cpp")
+    add_files("test/test_segmented_vector.cpp")
+
+target("test_concurrent_vector")
+    set_kind("binary")
+    add_cxxflags("-g")
+    add_files("src/detail/alloc.cpp")
+    add_files("test/test_concurrent_vector.cpp")
+
+target("concurrent_vector_compare")
+    set_kind("binary")
+    add_cxxflags("-O2")
+    add_files("src/detail/alloc.cpp")
+    add_files("test/performance/concurrent_vector_compare.cpp")
+
+target("test_packed_vector_of_vectors")
+    set_kind("binary")
+    add_cxxflags("-g")
+    add_files("src/detail/alloc.cpp")
+    add_files("test/test_packed_vector_of_vectors.cpp")
+
+target("test_mmap_vector")
+    set_kind("binary")
+    add_cxxflags("-g")
+    add_files("src/detail/alloc.cpp")
+    add_files("test/test_mmap_vector.cpp")
+
+target("test_shm_allocator")
+    set_kind("binary")
+    add_cxxflags("-g")
+    add_files("src/detail/alloc.cpp")
+    add_files("test/test_shm_allocator.cpp")
+    add_syslinks("rt")
+
+target("test_persistent_vector")
+    set_kind("binary")
+    add_cxxflags("-g")
+    add_files("src/detail/alloc.cpp")
+    add_files("test/test_persistent_vector.cpp")
+
+target("test_thread_pool")
+    set_kind("binary")
+    add_cxxflags("-g")
+    add_files("src/detail/alloc.cpp")
+    add_files("test/test_thread_pool.cpp")
+
+target("test_nontemporal")
+    set_kind("binary")
+    add_cxxflags("-g")
+    add_files("src/detail/alloc.cpp")
+    add_files("test/test_nontemporal.cpp")
+
+target("nontemporal_compare")
+    set_kind("binary")
+    add_cxxflags("-O2")
+    add_files("src/detail/alloc.cpp")
+    add_files("test/performance/nontemporal_compare.cpp")
+
+target("test_algorithm")
+    set_kind("binary")
+    add_cxxflags("-g")
+    add_files("src/detail/alloc.cpp")
+    add_files("test/test_algorithm.cpp")
+
+target("sort_compare")
+    set_kind("binary")
+    add_cxxflags("-O2")
+    add_files("src/detail/alloc.cpp")
+    add_files("test/performance/sort_compare.cpp")
+
+target("parallel_sort_compare")
+    set_kind("binary")
+    add_cxxflags("-O2")
+    add_files("src/detail/alloc.cpp")
+    add_files("test/performance/parallel_sort_compare.cpp")
+
+target("radix_sort_compare")
+    set_kind("binary")
+    add_cxxflags("-O2")
+    add_files("src/detail/alloc.cpp")
+    add_files("test/performance/radix_sort_compare.cpp")
+
+target("stable_sort_compare")
+    set_kind("binary")
+    add_cxxflags("-O2")
+    add_files("src/detail/alloc.cpp")
+    add_files("test/performance/stable_sort_compare.cpp")
+
+target("selection_compare")
+    set_kind("binary")
+    add_cxxflags("-O2")
+    add_files("src/detail/alloc.cpp")
+    add_files("test/performance/selection_compare.cpp")
+
+target("heap_compare")
+    set_kind("binary")
+    add_cxxflags("-O2")
+    add_files("src/detail/alloc.cpp")
+    add_files("test/performance/heap_compare.cpp")
+
+target("set_operations_compare")
+    set_kind("binary")
+    add_cxxflags("-O2")
+    add_files("src/detail/alloc.cpp")
+    add_files("test/performance/set_operations_compare.cpp")
+
+target("binary_search_compare")
+    set_kind("binary")
+    add_cxxflags("-O2")
+    add_files("src/detail/alloc.cpp")
+    add_files("test/performance/binary_search_compare.cpp")
+
+target("scan_compare")
+    set_kind("binary")
+    add_cxxflags("-O2")
+    add_files("src/detail/alloc.cpp")
+    add_files("test/performance/scan_compare.cpp")
+
+target("minmax_compare")
+    set_kind("binary")
+    add_cxxflags("-O2")
+    add_files("src/detail/alloc.cpp")
+    add_files("test/performance/minmax_compare.cpp")
+
 target("test_array")
     set_kind("binary")
     add_cxxflags("-g")